@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#include "AdaptiveConstraintSolver.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gz {
+namespace physics {
+namespace bullet_featherstone {
+
+/////////////////////////////////////////////////
+void AdaptiveConstraintSolver::ResetStatistics()
+{
+  this->statistics = SolverStatistics();
+}
+
+/////////////////////////////////////////////////
+const SolverStatistics &AdaptiveConstraintSolver::Statistics() const
+{
+  return this->statistics;
+}
+
+/////////////////////////////////////////////////
+btScalar AdaptiveConstraintSolver::solveGroupCacheFriendlyIterations(
+    btCollisionObject **_bodies,
+    int _numBodies,
+    btPersistentManifold **_manifolds,
+    int _numManifolds,
+    btTypedConstraint **_constraints,
+    int _numConstraints,
+    const btContactSolverInfo &_info,
+    btIDebugDraw *_debugDrawer)
+{
+  // Same as btSequentialImpulseConstraintSolver, except for the minimum
+  // number of iterations and the statistics
+  this->solveGroupCacheFriendlySplitImpulseIterations(
+      _bodies, _numBodies, _manifolds, _numManifolds, _constraints,
+      _numConstraints, _info, _debugDrawer);
+
+  const int maxIterations =
+      std::max(this->m_maxOverrideNumSolverIterations, _info.m_numIterations);
+  const int minIterations = std::min(
+      static_cast<int>(this->minIterations), maxIterations);
+
+  int iteration = 0;
+  while (iteration < maxIterations)
+  {
+    this->m_leastSquaresResidual = this->solveSingleIteration(
+        iteration, _bodies, _numBodies, _manifolds, _numManifolds,
+        _constraints, _numConstraints, _info, _debugDrawer);
+    ++iteration;
+
+    if (iteration >= minIterations &&
+        this->m_leastSquaresResidual < _info.m_leastSquaresResidualThreshold)
+    {
+      break;
+    }
+  }
+
+  ++this->statistics.solves;
+  this->statistics.iterations = std::max(
+      this->statistics.iterations, static_cast<std::size_t>(iteration));
+  this->statistics.residual = std::max(this->statistics.residual,
+      std::sqrt(static_cast<double>(this->m_leastSquaresResidual)));
+  return 0;
+}
+
+}  // namespace bullet_featherstone
+}  // namespace physics
+}  // namespace gz
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#ifndef GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_ADAPTIVECONSTRAINTSOLVER_HH_
+#define GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_ADAPTIVECONSTRAINTSOLVER_HH_
+
+#include <cstddef>
+
+#include <BulletDynamics/Featherstone/btMultiBodyConstraintSolver.h>
+
+#include <gz/physics/ForwardStep.hh>
+
+namespace gz {
+namespace physics {
+namespace bullet_featherstone {
+
+/// \brief A multibody constraint solver that runs a minimum number of
+/// iterations before it stops on its residual, and that reports its
+/// iterations.
+///
+/// Like Bullet's solver, it stops once the largest squared change of an
+/// impulse during an iteration is below
+/// btContactSolverInfo::m_leastSquaresResidualThreshold, and it runs at most
+/// btContactSolverInfo::m_numIterations iterations.
+class AdaptiveConstraintSolver : public btMultiBodyConstraintSolver
+{
+  /// \brief Clear the statistics, before a step.
+  public: void ResetStatistics();
+
+  /// \brief Statistics of the solves since the last reset. The residual is
+  /// the largest change of an impulse during the last iteration of a solve.
+  /// \return Solver statistics
+  public: const SolverStatistics &Statistics() const;
+
+  /// \brief Minimum number of iterations of a solve
+  public: std::size_t minIterations = 1;
+
+  // Documentation inherited
+  protected: btScalar solveGroupCacheFriendlyIterations(
+      btCollisionObject **_bodies,
+      int _numBodies,
+      btPersistentManifold **_manifolds,
+      int _numManifolds,
+      btTypedConstraint **_constraints,
+      int _numConstraints,
+      const btContactSolverInfo &_info,
+      btIDebugDraw *_debugDrawer) override;
+
+  /// \brief Statistics of the solves since the last reset
+  private: SolverStatistics statistics;
+};
+
+}  // namespace bullet_featherstone
+}  // namespace physics
+}  // namespace gz
+
+#endif
@@ -32,7 +32,7 @@ WorldInfo::WorldInfo(std::string name_)
   this->dispatcher =
     std::make_unique<btCollisionDispatcher>(collisionConfiguration.get());
   this->broadphase = std::make_unique<btDbvtBroadphase>();
-  this->solver = std::make_unique<btMultiBodyConstraintSolver>();
+  this->solver = std::make_unique<AdaptiveConstraintSolver>();
   this->world = std::make_unique<btMultiBodyDynamicsWorld>(
     dispatcher.get(), broadphase.get(), solver.get(),
     collisionConfiguration.get());
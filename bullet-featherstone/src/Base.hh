@@ -37,7 +37,9 @@
 #include <Eigen/Geometry>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -47,8 +49,13 @@
 
 #include <gz/common/Console.hh>
 #include <gz/math/eigen3/Conversions.hh>
+#include <gz/physics/EngineMemoryResource.hh>
+#include <gz/physics/Geometry.hh>
 #include <gz/physics/Implements.hh>
 
+#include "AdaptiveConstraintSolver.hh"
+#include "JointServoMotor.hh"
+
 namespace gz {
 namespace physics {
 namespace bullet_featherstone {
@@ -63,19 +70,46 @@ namespace bullet_featherstone {
 // Note: For Bullet library it's important the order in which the elements
 // are destroyed. The current implementation relies on C++ destroying the
 // elements in the opposite order stated in the structure
+struct JointInfo;
+struct ModelInfo;
+
 struct WorldInfo
 {
   std::string name;
   std::unique_ptr<btDefaultCollisionConfiguration> collisionConfiguration;
   std::unique_ptr<btCollisionDispatcher> dispatcher;
   std::unique_ptr<btBroadphaseInterface> broadphase;
-  std::unique_ptr<btMultiBodyConstraintSolver> solver;
+  std::unique_ptr<AdaptiveConstraintSolver> solver;
   std::unique_ptr<btMultiBodyDynamicsWorld> world;
 
   std::unordered_map<int, std::size_t> modelIndexToEntityId;
   std::unordered_map<std::string, std::size_t> modelNameToEntityId;
   int nextModelIndex = 0;
 
+  /// Joints declared with SetJointVelocityCommandBatchFeature, in the order
+  /// of the velocity commands.
+  std::vector<std::shared_ptr<JointInfo>> velocityCommandJoints;
+
+  /// Models declared with SetFreeGroupWorldStateBatch, in the order of the
+  /// poses and velocities.
+  std::vector<std::shared_ptr<ModelInfo>> freeGroupBatch;
+
+  /// Contact wrenches that acted on the links of this world during the last
+  /// step, by link ID. They are computed when they are first requested after
+  /// a step, see GetLinkContactWrenchFromLastStepFeature.
+  std::unordered_map<std::size_t, Wrench3d> linkContactWrenches;
+
+  /// Whether linkContactWrenches is up to date with the last step
+  bool linkContactWrenchesValid = false;
+
+  /// Links whose motion is swept before each step, see
+  /// ContinuousCollisionFeature
+  std::unordered_set<std::size_t> continuousCollisionLinks;
+
+  /// Size of the steps of this world. It is updated from the step size of
+  /// the ForwardStep::Input, so each world keeps its own.
+  double stepSize = 0.001;
+
   explicit WorldInfo(std::string name);
 };
 
@@ -98,6 +132,9 @@ struct ModelInfo
   /// constraints.
   std::unordered_set<std::size_t> external_constraints;
 
+  /// Constraint that enforces the joint coupling of this model, if any
+  std::shared_ptr<btMultiBodyConstraint> jointCoupling = nullptr;
+
   ModelInfo(
     std::string _name,
     Identity _world,
@@ -171,11 +208,22 @@ struct JointInfo
   std::size_t indexInGzModel = 0;
   btScalar effort = 0;
 
+  /// The velocity target of the motor, used to skip unchanged commands.
+  btScalar velocityCommand = std::numeric_limits<btScalar>::quiet_NaN();
+
   std::shared_ptr<btMultiBodyJointMotor> motor = nullptr;
   std::shared_ptr<btMultiBodyJointLimitConstraint> jointLimits = nullptr;
   std::shared_ptr<btMultiBodyFixedConstraint> fixedConstraint = nullptr;
   std::shared_ptr<btMultiBodyGearConstraint> gearConstraint = nullptr;
   std::shared_ptr<btMultiBodyJointFeedback> jointFeedback = nullptr;
+  /// Servo motors of the joint, indexed by degree of freedom. They are
+  /// created on the first servo command of each axis.
+  std::vector<std::shared_ptr<JointServoMotor>> servos;
+  std::shared_ptr<JointServoMotor> springDamper = nullptr;
+
+  /// The explicit joint damping of the link, saved while the spring damper
+  /// replaces it and restored when the spring damper is cleared.
+  btScalar savedJointDamping = 0;
 };
 
 inline btMatrix3x3 convertMat(const Eigen::Matrix3d& mat)
@@ -257,7 +305,8 @@ inline Eigen::Isometry3d GetWorldTransformOfLink(
   return convert(body.getBaseWorldTransform()) * model.baseInertiaToLinkFrame;
 }
 
-class Base : public Implements3d<FeatureList<Feature>>
+class Base : public Implements3d<
+    FeatureList<Feature, EngineMemoryResourceFeature>>
 {
   // Note: Entity ID 0 is reserved for the "engine"
   public: std::size_t entityCount = 1;
@@ -269,17 +318,32 @@ class Base : public Implements3d<FeatureList<Feature>>
 
   public: inline Identity InitiateEngine(std::size_t /*_engineID*/) override
   {
+    // The memory resource can only be chosen before the engine is used
+    this->memoryResource.MarkInUse();
     return this->GenerateIdentity(0);
   }
 
+  public: inline Identity InitiateEngineWithMemoryResource(
+      std::size_t _engineID,
+      std::pmr::memory_resource &_memoryResource) override
+  {
+    if (!this->memoryResource.SetUpstream(&_memoryResource))
+    {
+      gzerr << "Unable to use the requested memory resource: the engine "
+            << "was already initiated with another resource.\n";
+    }
+    return this->InitiateEngine(_engineID);
+  }
+
   public: inline Identity AddWorld(WorldInfo _worldInfo)
   {
     const auto id = this->GetNextEntity();
-    auto world = std::make_shared<WorldInfo>(std::move(_worldInfo));
+    auto world = this->memoryResource.MakeShared<WorldInfo>(
+      std::move(_worldInfo));
     this->worlds[id] = world;
     auto worldID = this->GenerateIdentity(id, world);
 
-    auto worldModel = std::make_shared<ModelInfo>(
+    auto worldModel = this->memoryResource.MakeShared<ModelInfo>(
       world->name, worldID,
       Eigen::Isometry3d::Identity(), nullptr);
     this->models[id] = worldModel;
@@ -297,7 +361,7 @@ class Base : public Implements3d<FeatureList<Feature>>
     std::shared_ptr<btMultiBody> _body)
   {
     const auto id = this->GetNextEntity();
-    auto model = std::make_shared<ModelInfo>(
+    auto model = this->memoryResource.MakeShared<ModelInfo>(
       std::move(_name), std::move(_worldID),
       std::move(_baseInertialToLinkFrame), std::move(_body));
 
@@ -322,7 +386,7 @@ class Base : public Implements3d<FeatureList<Feature>>
     std::shared_ptr<btMultiBody> _body)
   {
     const auto id = this->GetNextEntity();
-    auto model = std::make_shared<ModelInfo>(
+    auto model = this->memoryResource.MakeShared<ModelInfo>(
       std::move(_name), std::move(_worldID),
       std::move(_baseInertialToLinkFrame), std::move(_body));
 
@@ -336,7 +400,7 @@ class Base : public Implements3d<FeatureList<Feature>>
   public: inline Identity AddLink(LinkInfo _linkInfo)
   {
     const auto id = this->GetNextEntity();
-    auto link = std::make_shared<LinkInfo>(std::move(_linkInfo));
+    auto link = this->memoryResource.MakeShared<LinkInfo>(std::move(_linkInfo));
     this->links[id] = link;
 
     auto *model = this->ReferenceInterface<ModelInfo>(_linkInfo.model);
@@ -355,21 +419,23 @@ class Base : public Implements3d<FeatureList<Feature>>
 
   public: inline Identity AddCollision(CollisionInfo _collisionInfo)
   {
-   const auto id = this->GetNextEntity();
-   auto collision = std::make_shared<CollisionInfo>(std::move(_collisionInfo));
-   this->collisions[id] = collision;
-   auto *link = this->ReferenceInterface<LinkInfo>(_collisionInfo.link);
-   collision->indexInLink = static_cast<int>(link->collisionEntityIds.size());
-   link->collisionEntityIds.push_back(id);
-   link->collisionNameToEntityId[collision->name] = id;
-
-   return this->GenerateIdentity(id, collision);
+    const auto id = this->GetNextEntity();
+    auto collision = this->memoryResource.MakeShared<CollisionInfo>(
+      std::move(_collisionInfo));
+    this->collisions[id] = collision;
+    auto *link = this->ReferenceInterface<LinkInfo>(_collisionInfo.link);
+    collision->indexInLink = static_cast<int>(link->collisionEntityIds.size());
+    link->collisionEntityIds.push_back(id);
+    link->collisionNameToEntityId[collision->name] = id;
+
+    return this->GenerateIdentity(id, collision);
   }
 
   public: inline Identity AddJoint(JointInfo _jointInfo)
   {
     const auto id = this->GetNextEntity();
-    auto joint = std::make_shared<JointInfo>(std::move(_jointInfo));
+    auto joint = this->memoryResource.MakeShared<JointInfo>(
+      std::move(_jointInfo));
     this->joints[id] = joint;
 
     auto *model = this->ReferenceInterface<ModelInfo>(joint->model);
@@ -383,7 +449,8 @@ class Base : public Implements3d<FeatureList<Feature>>
   public: inline Identity addConstraint(JointInfo _jointInfo)
   {
     const auto id = this->GetNextEntity();
-    auto joint = std::make_shared<JointInfo>(std::move(_jointInfo));
+    auto joint = this->memoryResource.MakeShared<JointInfo>(
+      std::move(_jointInfo));
     this->joints[id] = joint;
 
     return this->GenerateIdentity(id, joint);
@@ -404,6 +471,26 @@ class Base : public Implements3d<FeatureList<Feature>>
     }
     model->nestedModelEntityIds.clear();
 
+    // Drop the model from the batches declared in its world, which would
+    // otherwise keep using its joints and multibody after it is removed.
+    auto *world = this->ReferenceInterface<WorldInfo>(model->world);
+    if (world)
+    {
+      auto &joints = world->velocityCommandJoints;
+      joints.erase(std::remove_if(joints.begin(), joints.end(),
+          [&](const std::shared_ptr<JointInfo> &_joint)
+          {
+            return _joint->model.id == _modelID.id;
+          }), joints.end());
+
+      auto &groups = world->freeGroupBatch;
+      groups.erase(std::remove_if(groups.begin(), groups.end(),
+          [&](const std::shared_ptr<ModelInfo> &_group)
+          {
+            return _group.get() == model;
+          }), groups.end());
+    }
+
     // remove references in parent model or world model
     auto parentModelIt = this->models.find(_parentID);
     if (parentModelIt != this->models.end())
@@ -432,7 +519,6 @@ class Base : public Implements3d<FeatureList<Feature>>
     }
 
     // Remove model from world
-    auto *world = this->ReferenceInterface<WorldInfo>(model->world);
     if (!world)
       return false;
     if (world->modelIndexToEntityId.erase(model->indexInWorld) == 0)
@@ -443,6 +529,11 @@ class Base : public Implements3d<FeatureList<Feature>>
     world->modelNameToEntityId.erase(model->name);
 
     // Remove all constraints related to this model
+    if (model->jointCoupling)
+    {
+      world->world->removeMultiBodyConstraint(model->jointCoupling.get());
+      model->jointCoupling.reset();
+    }
     for (const auto jointID : model->jointEntityIds)
     {
       const auto joint = this->joints.at(jointID);
@@ -458,6 +549,17 @@ class Base : public Implements3d<FeatureList<Feature>>
       {
         world->world->removeMultiBodyConstraint(joint->jointLimits.get());
       }
+      for (const auto &servo : joint->servos)
+      {
+        if (servo)
+        {
+          world->world->removeMultiBodyConstraint(servo.get());
+        }
+      }
+      if (joint->springDamper)
+      {
+        world->world->removeMultiBodyConstraint(joint->springDamper.get());
+      }
       this->joints.erase(jointID);
     }
     // \todo(iche033) Remove external constraints related to this model
@@ -512,11 +614,20 @@ class Base : public Implements3d<FeatureList<Feature>>
   public: using CollisionInfoPtr = std::shared_ptr<CollisionInfo>;
   public: using JointInfoPtr  = std::shared_ptr<JointInfo>;
 
-  public: std::unordered_map<std::size_t, WorldInfoPtr> worlds;
-  public: std::unordered_map<std::size_t, ModelInfoPtr> models;
-  public: std::unordered_map<std::size_t, LinkInfoPtr> links;
-  public: std::unordered_map<std::size_t, CollisionInfoPtr> collisions;
-  public: std::unordered_map<std::size_t, JointInfoPtr> joints;
+  /// \brief Memory resource of the info structs and of the entity maps. It
+  /// is declared first so that it outlives them.
+  public: EngineMemoryResource memoryResource;
+
+  public: std::pmr::unordered_map<std::size_t, WorldInfoPtr> worlds{
+      &this->memoryResource};
+  public: std::pmr::unordered_map<std::size_t, ModelInfoPtr> models{
+      &this->memoryResource};
+  public: std::pmr::unordered_map<std::size_t, LinkInfoPtr> links{
+      &this->memoryResource};
+  public: std::pmr::unordered_map<std::size_t, CollisionInfoPtr> collisions{
+      &this->memoryResource};
+  public: std::pmr::unordered_map<std::size_t, JointInfoPtr> joints{
+      &this->memoryResource};
 
   public: std::vector<std::unique_ptr<btTriangleMesh>> triangleMeshes;
   public: std::vector<std::unique_ptr<btGImpactMeshShape>> meshesGImpact;
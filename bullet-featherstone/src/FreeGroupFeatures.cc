@@ -18,6 +18,9 @@
 #include "FreeGroupFeatures.hh"
 
 #include <memory>
+#include <vector>
+
+#include <gz/common/Console.hh>
 
 namespace gz {
 namespace physics {
@@ -98,6 +101,90 @@ void FreeGroupFeatures::SetFreeGroupWorldPose(
   }
 }
 
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::SetWorldFreeGroupBatch(
+    const Identity &_worldID,
+    const std::vector<BaseFreeGroup3dPtr> &_groups)
+{
+  auto *world = this->ReferenceInterface<WorldInfo>(_worldID);
+
+  // Free groups in bullet-featherstone are always represented by ModelInfo,
+  // so the batch only needs to hold on to the models.
+  std::vector<std::shared_ptr<ModelInfo>> models;
+  models.reserve(_groups.size());
+  for (const auto &group : _groups)
+  {
+    if (!group)
+    {
+      gzerr << "Unable to declare free group batch: invalid free group.\n";
+      return false;
+    }
+
+    const auto modelIt = this->models.find(group->FullIdentity().id);
+    if (modelIt == this->models.end() ||
+        modelIt->second->world.id != _worldID.id)
+    {
+      gzerr << "Unable to declare free group batch: free group ["
+            << group->FullIdentity().id << "] is not in this world.\n";
+      return false;
+    }
+    models.push_back(modelIt->second);
+  }
+
+  world->freeGroupBatch = std::move(models);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::SetWorldFreeGroupPoses(
+    const Identity &_worldID,
+    const std::vector<PoseType> &_poses)
+{
+  const auto *world = this->ReferenceInterface<WorldInfo>(_worldID);
+  const auto &models = world->freeGroupBatch;
+  if (_poses.size() != models.size())
+  {
+    gzerr << "Unable to set free group poses: expected [" << models.size()
+          << "] poses, got [" << _poses.size() << "].\n";
+    return false;
+  }
+
+  for (std::size_t i = 0; i < models.size(); ++i)
+  {
+    const auto &model = models[i];
+    model->body->setBaseWorldTransform(
+        convertTf(_poses[i] * model->baseInertiaToLinkFrame.inverse()));
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::SetWorldFreeGroupVelocities(
+    const Identity &_worldID,
+    const std::vector<LinearVelocity> &_linearVelocities,
+    const std::vector<AngularVelocity> &_angularVelocities)
+{
+  const auto *world = this->ReferenceInterface<WorldInfo>(_worldID);
+  const auto &models = world->freeGroupBatch;
+  if (_linearVelocities.size() != models.size() ||
+      _angularVelocities.size() != models.size())
+  {
+    gzerr << "Unable to set free group velocities: expected ["
+          << models.size() << "] linear and angular velocities, got ["
+          << _linearVelocities.size() << "] and ["
+          << _angularVelocities.size() << "].\n";
+    return false;
+  }
+
+  for (std::size_t i = 0; i < models.size(); ++i)
+  {
+    btMultiBody *body = models[i]->body.get();
+    body->setBaseVel(convertVec(_linearVelocities[i]));
+    body->setBaseOmega(convertVec(_angularVelocities[i]));
+  }
+  return true;
+}
+
 }  // namespace bullet_featherstone
 }  // namespace physics
 }  // namespace gz
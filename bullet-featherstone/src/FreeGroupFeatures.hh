@@ -18,6 +18,8 @@
 #ifndef GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_FREEGROUPFEATURES_HH_
 #define GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_FREEGROUPFEATURES_HH_
 
+#include <vector>
+
 #include <gz/physics/FreeGroup.hh>
 
 #include "Base.hh"
@@ -29,7 +31,8 @@ namespace bullet_featherstone {
 struct FreeGroupFeatureList : gz::physics::FeatureList<
   FindFreeGroupFeature,
   SetFreeGroupWorldPose,
-  SetFreeGroupWorldVelocity
+  SetFreeGroupWorldVelocity,
+  SetFreeGroupWorldStateBatch
 > { };
 
 class FreeGroupFeatures
@@ -56,6 +59,20 @@ class FreeGroupFeatures
   void SetFreeGroupWorldAngularVelocity(
       const Identity &_groupID,
       const AngularVelocity &_angularVelocity) override;
+
+  // ----- SetFreeGroupWorldStateBatch -----
+  bool SetWorldFreeGroupBatch(
+      const Identity &_worldID,
+      const std::vector<BaseFreeGroup3dPtr> &_groups) override;
+
+  bool SetWorldFreeGroupPoses(
+      const Identity &_worldID,
+      const std::vector<PoseType> &_poses) override;
+
+  bool SetWorldFreeGroupVelocities(
+      const Identity &_worldID,
+      const std::vector<LinearVelocity> &_linearVelocities,
+      const std::vector<AngularVelocity> &_angularVelocities) override;
 };
 
 }  // namespace bullet_featherstone
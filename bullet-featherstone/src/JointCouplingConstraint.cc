@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <BulletDynamics/Featherstone/btMultiBodyLinkCollider.h>
+#include <LinearMath/btScalar.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "JointCouplingConstraint.hh"
+
+namespace gz {
+namespace physics {
+namespace bullet_featherstone {
+
+/////////////////////////////////////////////////
+JointCouplingConstraint::JointCouplingConstraint(
+    btMultiBody *_body,
+    std::vector<Axis> _followers,
+    std::vector<Axis> _leaders,
+    std::vector<Term> _terms,
+    std::vector<btScalar> _offsets)
+#if BT_BULLET_VERSION >= 289
+  : btMultiBodyConstraint(_body, _body, -1, -1,
+        static_cast<int>(_followers.size()), false,
+        MULTIBODY_CONSTRAINT_GEAR),
+#else
+  : btMultiBodyConstraint(_body, _body, -1, -1,
+        static_cast<int>(_followers.size()), false),
+#endif
+    followers(std::move(_followers)),
+    leaders(std::move(_leaders)),
+    offsets(std::move(_offsets))
+{
+  this->offsets.resize(this->followers.size(), btScalar(0));
+  this->rows.resize(this->followers.size());
+  for (const Term &term : _terms)
+  {
+    this->rows[term.follower].emplace_back(term.leader, term.multiplier);
+  }
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::setErp(btScalar _erp)
+{
+  this->erp = _erp;
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::finalizeMultiDof()
+{
+  this->allocateJacobiansMultiDof();
+
+  // The first 6 entries of the jacobian belong to the floating base, followed
+  // by every degree of freedom of the links in order. Only the jacobian of
+  // body A is used since body A and body B are the same multibody.
+  for (int row = 0; row < this->getNumRows(); ++row)
+  {
+    btScalar *jacA = this->jacobianA(row);
+    btScalar *jacB = this->jacobianB(row);
+    std::fill(jacA, jacA + this->m_jacSizeA, btScalar(0));
+    std::fill(jacB, jacB + (this->m_jacSizeBoth - this->m_jacSizeA),
+              btScalar(0));
+
+    const Axis &follower = this->followers[row];
+    jacA[6 + this->m_bodyA->getLink(follower.link).m_dofOffset +
+         follower.dof] += btScalar(1);
+    for (const auto &[leaderIndex, multiplier] : this->rows[row])
+    {
+      const Axis &leader = this->leaders[leaderIndex];
+      jacA[6 + this->m_bodyA->getLink(leader.link).m_dofOffset +
+           leader.dof] -= multiplier;
+    }
+  }
+
+  this->m_numDofsFinalized = this->m_jacSizeBoth;
+}
+
+/////////////////////////////////////////////////
+int JointCouplingConstraint::getIslandIdA() const
+{
+  if (const auto *col = this->m_bodyA->getBaseCollider())
+    return col->getIslandTag();
+
+  for (int i = 0; i < this->m_bodyA->getNumLinks(); ++i)
+  {
+    if (const auto *col = this->m_bodyA->getLink(i).m_collider)
+      return col->getIslandTag();
+  }
+  return -1;
+}
+
+/////////////////////////////////////////////////
+int JointCouplingConstraint::getIslandIdB() const
+{
+  return this->getIslandIdA();
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::createConstraintRows(
+    btMultiBodyConstraintArray &_constraintRows,
+    btMultiBodyJacobianData &_data,
+    const btContactSolverInfo &_infoGlobal)
+{
+  if (this->m_numDofsFinalized != this->m_jacSizeBoth)
+    this->finalizeMultiDof();
+
+  const btVector3 dummy(0, 0, 0);
+  for (int row = 0; row < this->getNumRows(); ++row)
+  {
+    const Axis &follower = this->followers[row];
+    btScalar positionError =
+        this->m_bodyA->getJointPosMultiDof(follower.link)[follower.dof] -
+        this->offsets[row];
+    for (const auto &[leaderIndex, multiplier] : this->rows[row])
+    {
+      const Axis &leader = this->leaders[leaderIndex];
+      positionError -= multiplier *
+          this->m_bodyA->getJointPosMultiDof(leader.link)[leader.dof];
+    }
+
+    btScalar desiredVelocity = 0;
+    if (this->erp != btScalar(0))
+    {
+      desiredVelocity =
+          -this->erp * positionError / _infoGlobal.m_timeStep;
+    }
+
+    btMultiBodySolverConstraint &constraintRow =
+        _constraintRows.expandNonInitializing();
+    constraintRow.m_orgConstraint = this;
+    constraintRow.m_orgDofIndex = row;
+    this->fillMultiBodyConstraint(
+        constraintRow, _data, this->jacobianA(row), this->jacobianB(row),
+        dummy, dummy, dummy, dummy, btScalar(0), _infoGlobal,
+        -this->m_maxAppliedImpulse, this->m_maxAppliedImpulse,
+        false, 1, false, desiredVelocity);
+  }
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::debugDraw(btIDebugDraw *)
+{
+  // Nothing to draw
+}
+
+}  // namespace bullet_featherstone
+}  // namespace physics
+}  // namespace gz
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_JOINTCOUPLINGCONSTRAINT_HH_
+#define GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_JOINTCOUPLINGCONSTRAINT_HH_
+
+#include <BulletDynamics/Featherstone/btMultiBody.h>
+#include <BulletDynamics/Featherstone/btMultiBodyConstraint.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace gz {
+namespace physics {
+namespace bullet_featherstone {
+
+/// \brief A multibody constraint that enforces a linear coupling between the
+/// generalized coordinates of the links of a single btMultiBody:
+///
+/// q_followers = A * q_leaders + b
+///
+/// Every follower is one row of the constraint, so the whole coupling is
+/// handed to the solver as one block per model. The jacobian is constant and
+/// is only filled once when the constraint is finalized. Every coupled link
+/// must have one position per degree of freedom, which excludes spherical
+/// joints.
+class JointCouplingConstraint : public btMultiBodyConstraint
+{
+  /// \brief A single degree of freedom of a link of the multibody
+  public: struct Axis
+  {
+    int link;
+    int dof;
+  };
+
+  /// \brief A single nonzero entry of A
+  public: struct Term
+  {
+    std::size_t follower;
+    std::size_t leader;
+    btScalar multiplier;
+  };
+
+  /// \brief Constructor
+  /// \param[in] _body Multibody that contains every coupled link
+  /// \param[in] _followers Follower axes (rows)
+  /// \param[in] _leaders Leader axes (columns)
+  /// \param[in] _terms Nonzero entries of A
+  /// \param[in] _offsets Offsets b, one per follower
+  public: JointCouplingConstraint(
+      btMultiBody *_body,
+      std::vector<Axis> _followers,
+      std::vector<Axis> _leaders,
+      std::vector<Term> _terms,
+      std::vector<btScalar> _offsets);
+
+  /// \brief Set the fraction of the position error that is corrected in a
+  /// single time step.
+  /// \param[in] _erp Error reduction parameter
+  public: void setErp(btScalar _erp);
+
+  // Documentation inherited
+  public: void finalizeMultiDof() override;
+
+  // Documentation inherited
+  public: int getIslandIdA() const override;
+
+  // Documentation inherited
+  public: int getIslandIdB() const override;
+
+  // Documentation inherited
+  public: void createConstraintRows(
+      btMultiBodyConstraintArray &_constraintRows,
+      btMultiBodyJacobianData &_data,
+      const btContactSolverInfo &_infoGlobal) override;
+
+  // Documentation inherited
+  public: void debugDraw(btIDebugDraw *_drawer) override;
+
+  /// \brief Follower axes
+  private: std::vector<Axis> followers;
+
+  /// \brief Leader axes
+  private: std::vector<Axis> leaders;
+
+  /// \brief Nonzero entries of A grouped by row. Each entry is a pair of
+  /// (leader index, multiplier).
+  private: std::vector<std::vector<std::pair<std::size_t, btScalar>>> rows;
+
+  /// \brief Offsets b
+  private: std::vector<btScalar> offsets;
+
+  /// \brief Error reduction parameter
+  private: btScalar erp = btScalar(0.3);
+};
+
+}  // namespace bullet_featherstone
+}  // namespace physics
+}  // namespace gz
+
+#endif  // GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_JOINTCOUPLINGCONSTRAINT_HH_
@@ -18,11 +18,16 @@
 #include "JointFeatures.hh"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <sdf/Joint.hh>
 
+#include "JointCouplingConstraint.hh"
+
 namespace gz {
 namespace physics {
 namespace bullet_featherstone {
@@ -282,20 +287,186 @@ void JointFeatures::SetJointVelocityCommand(
     return;
   }
 
-  if (!jointInfo->motor)
+  this->EnsureJointMotor(jointInfo);
+  jointInfo->velocityCommand = static_cast<btScalar>(_value);
+  jointInfo->motor->setVelocityTarget(jointInfo->velocityCommand);
+}
+
+/////////////////////////////////////////////////
+void JointFeatures::EnsureJointMotor(JointInfo *_jointInfo)
+{
+  if (_jointInfo->motor)
+    return;
+
+  auto modelInfo = this->ReferenceInterface<ModelInfo>(_jointInfo->model);
+  _jointInfo->motor = std::make_shared<btMultiBodyJointMotor>(
+    modelInfo->body.get(),
+    std::get<InternalJoint>(_jointInfo->identifier).indexInBtModel,
+    0,
+    static_cast<btScalar>(0),
+    static_cast<btScalar>(_jointInfo->effort));
+  auto *world = this->ReferenceInterface<WorldInfo>(modelInfo->world);
+  world->world->addMultiBodyConstraint(_jointInfo->motor.get());
+}
+
+/////////////////////////////////////////////////
+bool JointFeatures::SetWorldVelocityCommandJoints(
+    const Identity &_worldID,
+    const std::vector<BaseJoint3dPtr> &_joints)
+{
+  auto *world = this->ReferenceInterface<WorldInfo>(_worldID);
+
+  std::vector<std::shared_ptr<JointInfo>> joints;
+  joints.reserve(_joints.size());
+  for (const auto &joint : _joints)
   {
-    auto modelInfo = this->ReferenceInterface<ModelInfo>(jointInfo->model);
-    jointInfo->motor = std::make_shared<btMultiBodyJointMotor>(
-      modelInfo->body.get(),
-      std::get<InternalJoint>(jointInfo->identifier).indexInBtModel,
-      0,
-      static_cast<btScalar>(0),
-      static_cast<btScalar>(jointInfo->effort));
-    auto *world = this->ReferenceInterface<WorldInfo>(modelInfo->world);
-    world->world->addMultiBodyConstraint(jointInfo->motor.get());
+    if (!joint)
+    {
+      gzerr << "Unable to declare velocity command joints: invalid joint.\n";
+      return false;
+    }
+
+    const auto jointIt = this->joints.find(joint->FullIdentity().id);
+    if (jointIt == this->joints.end())
+    {
+      gzerr << "Unable to declare velocity command joints: joint ["
+            << joint->FullIdentity().id << "] does not exist.\n";
+      return false;
+    }
+
+    const auto &jointInfo = jointIt->second;
+    const auto *identifier =
+        std::get_if<InternalJoint>(&jointInfo->identifier);
+    const auto *modelInfo =
+        this->ReferenceInterface<ModelInfo>(jointInfo->model);
+    if (!identifier || modelInfo->world.id != _worldID.id ||
+        modelInfo->body->getLink(identifier->indexInBtModel).m_dofCount != 1)
+    {
+      gzerr << "Unable to declare velocity command joints: joint ["
+            << jointInfo->name << "] is not a single degree of freedom joint "
+            << "of a model in this world.\n";
+      return false;
+    }
+    joints.push_back(jointInfo);
+  }
+
+  // Create all of the motors up front so that setting the commands does not
+  // have to add constraints to the world.
+  for (const auto &jointInfo : joints)
+    this->EnsureJointMotor(jointInfo.get());
+
+  world->velocityCommandJoints = std::move(joints);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool JointFeatures::SetWorldJointVelocityCommands(
+    const Identity &_worldID,
+    const std::vector<double> &_velocities)
+{
+  auto *world = this->ReferenceInterface<WorldInfo>(_worldID);
+  auto &joints = world->velocityCommandJoints;
+  if (_velocities.size() != joints.size())
+  {
+    gzerr << "Unable to set velocity commands: expected ["
+          << joints.size() << "] velocities, got [" << _velocities.size()
+          << "].\n";
+    return false;
+  }
+
+  for (std::size_t i = 0; i < joints.size(); ++i)
+  {
+    JointInfo *jointInfo = joints[i].get();
+    const auto value = static_cast<btScalar>(_velocities[i]);
+
+    // Take extra care that the value is finite. A nan can cause the Bullet
+    // constraint solver to fail, which will in turn either cause a crash or
+    // collisions to fail
+    if (!std::isfinite(value))
+    {
+      gzerr << "Invalid joint velocity value [" << value
+             << "] commanded on joint [" << jointInfo->name
+             << "]. The command will be ignored\n";
+      continue;
+    }
+
+    // Skip motors whose command has not changed
+    if (value == jointInfo->velocityCommand)
+      continue;
+
+    jointInfo->velocityCommand = value;
+    jointInfo->motor->setVelocityTarget(value);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void JointFeatures::SetJointSpringDamper(
+    const Identity &_id, std::size_t _dof, double _stiffness,
+    double _damping, double _restPosition)
+{
+  auto *jointInfo = this->ReferenceInterface<JointInfo>(_id);
+
+  // Take extra care that the values are finite. A nan can cause the Bullet
+  // constraint solver to fail, which will in turn either cause a crash or
+  // collisions to fail
+  if (!std::isfinite(_stiffness) || !std::isfinite(_damping) ||
+      !std::isfinite(_restPosition) || _stiffness < 0.0 || _damping < 0.0)
+  {
+    gzerr << "Invalid joint spring damper values [" << _stiffness << ", "
+           << _damping << ", " << _restPosition << "] set on joint ["
+           << jointInfo->name << " DOF " << _dof
+           << "]. The command will be ignored\n";
+    return;
+  }
+
+  const auto *identifier = std::get_if<InternalJoint>(&jointInfo->identifier);
+  if (!identifier)
+  {
+    gzerr << "Unable to set spring damper of joint [" << jointInfo->name
+           << "], which is not an internal joint of a model.\n";
+    return;
+  }
+
+  auto *modelInfo = this->ReferenceInterface<ModelInfo>(jointInfo->model);
+  auto &link = modelInfo->body->getLink(identifier->indexInBtModel);
+  if (_dof >= static_cast<std::size_t>(link.m_dofCount) ||
+      link.m_posVarCount != link.m_dofCount)
+  {
+    gzerr << "Unable to set spring damper of joint [" << jointInfo->name
+           << " DOF " << _dof << "]. Only revolute and prismatic joints are "
+           << "supported.\n";
+    return;
+  }
+
+  auto *world = this->ReferenceInterface<WorldInfo>(modelInfo->world);
+  if (_stiffness == 0.0 && _damping == 0.0)
+  {
+    if (jointInfo->springDamper)
+    {
+      world->world->removeMultiBodyConstraint(jointInfo->springDamper.get());
+      jointInfo->springDamper.reset();
+      link.m_jointDamping = jointInfo->savedJointDamping;
+    }
+    return;
   }
 
-  jointInfo->motor->setVelocityTarget(static_cast<btScalar>(_value));
+  if (!jointInfo->springDamper)
+  {
+    // The spring and damper are enforced implicitly by a soft constraint,
+    // which replaces the explicit joint damping of the link while it is
+    // installed.
+    jointInfo->savedJointDamping = link.m_jointDamping;
+    link.m_jointDamping = 0;
+    jointInfo->springDamper = std::make_shared<JointServoMotor>(
+      modelInfo->body.get(), identifier->indexInBtModel,
+      static_cast<int>(_dof));
+    world->world->addMultiBodyConstraint(jointInfo->springDamper.get());
+  }
+
+  jointInfo->springDamper->SetCommand(
+      static_cast<btScalar>(_restPosition), static_cast<btScalar>(_stiffness),
+      static_cast<btScalar>(_damping), btScalar(0));
 }
 
 /////////////////////////////////////////////////
@@ -466,6 +637,149 @@ bool JointFeatures::SetJointMimicConstraint(
   world->world->addMultiBodyConstraint(followerJoint->gearConstraint.get());
   return true;
 }
+
+/////////////////////////////////////////////////
+bool JointFeatures::SetModelJointCoupling(
+    const Identity &_modelID,
+    const SetJointCouplingFeature::JointCoupling<FeaturePolicy3d> &_coupling)
+{
+  auto *model = this->ReferenceInterface<ModelInfo>(_modelID);
+
+  // Every axis of the coupling must be an internal joint of the multibody of
+  // this model.
+  auto toAxes = [&](
+      const std::vector<SetJointCouplingFeature::JointAxis<FeaturePolicy3d>>
+          &_axes,
+      std::vector<JointCouplingConstraint::Axis> &_out) -> bool
+  {
+    _out.reserve(_axes.size());
+    for (const auto &axis : _axes)
+    {
+      if (!axis.joint)
+      {
+        gzerr << "Unable to set joint coupling of model [" << model->name
+              << "]: invalid joint.\n";
+        return false;
+      }
+
+      const auto *joint =
+          this->ReferenceInterface<JointInfo>(axis.joint->FullIdentity());
+      const auto *identifier = std::get_if<InternalJoint>(&joint->identifier);
+      if (!identifier ||
+          this->ReferenceInterface<ModelInfo>(joint->model)->body !=
+              model->body)
+      {
+        gzerr << "Unable to set joint coupling of model [" << model->name
+              << "]: joint [" << joint->name << "] is not an internal joint "
+              << "of the model.\n";
+        return false;
+      }
+
+      const auto &link = model->body->getLink(identifier->indexInBtModel);
+      const int dofCount = link.m_dofCount;
+      if (axis.dof >= static_cast<std::size_t>(dofCount))
+      {
+        gzerr << "Unable to set joint coupling of model [" << model->name
+              << "]: axis [" << axis.dof << "] is out of range for joint ["
+              << joint->name << "] with [" << dofCount << "] degrees of "
+              << "freedom.\n";
+        return false;
+      }
+
+      // The positions of spherical joints are stored as a quaternion, so
+      // they cannot be coupled linearly.
+      if (link.m_posVarCount != dofCount)
+      {
+        gzerr << "Unable to set joint coupling of model [" << model->name
+              << "]: joint [" << joint->name << "] does not have one "
+              << "position per degree of freedom. bullet-featherstone "
+              << "doesn't support coupling spherical joints.\n";
+        return false;
+      }
+      _out.push_back(
+          {identifier->indexInBtModel, static_cast<int>(axis.dof)});
+    }
+    return true;
+  };
+
+  std::vector<JointCouplingConstraint::Axis> followers;
+  std::vector<JointCouplingConstraint::Axis> leaders;
+  if (!toAxes(_coupling.followers, followers) ||
+      !toAxes(_coupling.leaders, leaders))
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < followers.size(); ++i)
+  {
+    for (std::size_t j = i + 1; j < followers.size(); ++j)
+    {
+      if (followers[i].link == followers[j].link &&
+          followers[i].dof == followers[j].dof)
+      {
+        gzerr << "Unable to set joint coupling of model [" << model->name
+              << "]: follower axes [" << i << "] and [" << j << "] refer "
+              << "to the same degree of freedom.\n";
+        return false;
+      }
+    }
+  }
+
+  std::vector<JointCouplingConstraint::Term> terms;
+  terms.reserve(_coupling.terms.size());
+  for (const auto &term : _coupling.terms)
+  {
+    if (term.follower >= followers.size() || term.leader >= leaders.size())
+    {
+      gzerr << "Unable to set joint coupling of model [" << model->name
+            << "]: term (" << term.follower << ", " << term.leader
+            << ") is out of range.\n";
+      return false;
+    }
+    terms.push_back(
+        {term.follower, term.leader, static_cast<btScalar>(term.multiplier)});
+  }
+
+  if (!_coupling.offsets.empty() &&
+      _coupling.offsets.size() != followers.size())
+  {
+    gzerr << "Unable to set joint coupling of model [" << model->name
+          << "]: expected [" << followers.size() << "] offsets, got ["
+          << _coupling.offsets.size() << "].\n";
+    return false;
+  }
+
+  this->RemoveModelJointCoupling(_modelID);
+  if (followers.empty())
+    return true;
+
+  auto constraint = std::make_shared<JointCouplingConstraint>(
+      model->body.get(), std::move(followers), std::move(leaders),
+      std::move(terms),
+      std::vector<btScalar>(
+          _coupling.offsets.begin(), _coupling.offsets.end()));
+  // Use the same impulse bound as the gear constraint of mimic joints
+  constraint->setMaxAppliedImpulse(btScalar(1e8));
+  constraint->setErp(btScalar(0.3));
+  constraint->finalizeMultiDof();
+
+  auto *world = this->ReferenceInterface<WorldInfo>(model->world);
+  world->world->addMultiBodyConstraint(constraint.get());
+  model->jointCoupling = constraint;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void JointFeatures::RemoveModelJointCoupling(const Identity &_modelID)
+{
+  auto *model = this->ReferenceInterface<ModelInfo>(_modelID);
+  if (!model->jointCoupling)
+    return;
+
+  auto *world = this->ReferenceInterface<WorldInfo>(model->world);
+  world->world->removeMultiBodyConstraint(model->jointCoupling.get());
+  model->jointCoupling.reset();
+}
 }  // namespace bullet_featherstone
 }  // namespace physics
 }  // namespace gz
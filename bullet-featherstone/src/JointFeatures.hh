@@ -19,6 +19,7 @@
 #define GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_JOINTFEATURES_HH_
 
 #include <string>
+#include <vector>
 
 #include <gz/physics/FixedJoint.hh>
 #include <gz/physics/Joint.hh>
@@ -37,6 +38,8 @@ struct JointFeatureList : FeatureList<
   GetBasicJointProperties,
 
   SetJointVelocityCommandFeature,
+  SetJointVelocityCommandBatchFeature,
+  SetJointSpringDamperFeature,
 
   SetJointTransformFromParentFeature,
   AttachFixedJointFeature,
@@ -51,6 +54,8 @@ struct JointFeatureList : FeatureList<
 
   SetMimicConstraintFeature,
 
+  SetJointCouplingFeature,
+
   FixedJointCast
 > { };
 
@@ -127,6 +132,25 @@ class JointFeatures :
     const Identity &_id, const std::size_t _dof,
     const double _value) override;
 
+  // ----- Batched joint commands -----
+  public: bool SetWorldVelocityCommandJoints(
+    const Identity &_worldID,
+    const std::vector<BaseJoint3dPtr> &_joints) override;
+
+  public: bool SetWorldJointVelocityCommands(
+    const Identity &_worldID,
+    const std::vector<double> &_velocities) override;
+
+  /// \brief Create the joint motor used for velocity commands, if the joint
+  /// does not have one yet, and add it to the world.
+  /// \param[in] _jointInfo Joint to create the motor for
+  private: void EnsureJointMotor(JointInfo *_jointInfo);
+
+  // ----- Spring damper -----
+  public: void SetJointSpringDamper(
+    const Identity &_id, std::size_t _dof, double _stiffness,
+    double _damping, double _restPosition) override;
+
   // ----- AttachFixedJointFeature -----
   public: Identity AttachFixedJoint(
       const Identity &_childID,
@@ -153,6 +177,14 @@ class JointFeatures :
       double _multiplier,
       double _offset,
       double _reference) override;
+
+  // ----- Joint coupling -----
+  public: bool SetModelJointCoupling(
+      const Identity &_modelID,
+      const SetJointCouplingFeature::JointCoupling<FeaturePolicy3d> &_coupling)
+      override;
+
+  public: void RemoveModelJointCoupling(const Identity &_modelID) override;
 };
 }  // namespace bullet_featherstone
 }  // namespace physics
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include "JointServoMotor.hh"
+
+namespace gz {
+namespace physics {
+namespace bullet_featherstone {
+
+/////////////////////////////////////////////////
+JointServoMotor::JointServoMotor(btMultiBody *_body, int _link, int _dof)
+  : btMultiBodyJointMotor(_body, _link, _dof, btScalar(0), btScalar(0)),
+    dof(_dof)
+{
+}
+
+/////////////////////////////////////////////////
+void JointServoMotor::SetCommand(btScalar _position, btScalar _stiffness,
+                                 btScalar _damping, btScalar _maxEffort)
+{
+  this->target = _position;
+  this->stiffness = _stiffness;
+  this->damping = _damping;
+  this->maxEffort = _maxEffort;
+  this->active = true;
+}
+
+/////////////////////////////////////////////////
+void JointServoMotor::Deactivate()
+{
+  this->active = false;
+}
+
+/////////////////////////////////////////////////
+void JointServoMotor::finalizeMultiDof()
+{
+  this->allocateJacobiansMultiDof();
+
+  btScalar *jacA = this->jacobianA(0);
+  std::fill(jacA, jacA + this->m_jacSizeBoth, btScalar(0));
+  jacA[6 + this->m_bodyA->getLink(this->m_linkA).m_dofOffset + this->dof] =
+      btScalar(1);
+
+  this->m_numDofsFinalized = this->m_jacSizeBoth;
+}
+
+/////////////////////////////////////////////////
+void JointServoMotor::createConstraintRows(
+    btMultiBodyConstraintArray &_constraintRows,
+    btMultiBodyJacobianData &_data,
+    const btContactSolverInfo &_infoGlobal)
+{
+  if (!this->active)
+    return;
+
+  if (this->m_numDofsFinalized != this->m_jacSizeBoth)
+    this->finalizeMultiDof();
+
+  // Implicit PD as a soft constraint on the joint velocity v:
+  //   v + cfm * impulse = kp * (target - q) / (h * kp + kd)
+  //   cfm = 1 / (h * (h * kp + kd))
+  const btScalar h = _infoGlobal.m_timeStep;
+  const btScalar gain = h * this->stiffness + this->damping;
+  if (gain <= btScalar(0))
+    return;
+
+  const btScalar position =
+      this->m_bodyA->getJointPosMultiDof(this->m_linkA)[this->dof];
+  const btScalar desiredVelocity =
+      this->stiffness * (this->target - position) / gain;
+  const btScalar cfm = btScalar(1) / (h * gain);
+  const btScalar maxImpulse = this->maxEffort > btScalar(0) ?
+      this->maxEffort * h : btScalar(1e8);
+
+  const btVector3 dummy(0, 0, 0);
+  btMultiBodySolverConstraint &constraintRow =
+      _constraintRows.expandNonInitializing();
+  constraintRow.m_orgConstraint = this;
+  constraintRow.m_orgDofIndex = 0;
+  this->fillMultiBodyConstraint(
+      constraintRow, _data, this->jacobianA(0), this->jacobianB(0),
+      dummy, dummy, dummy, dummy, btScalar(0), _infoGlobal,
+      -maxImpulse, maxImpulse, false, 1, false, desiredVelocity);
+
+  // fillMultiBodyConstraint sets up a rigid row, with m_jacDiagABInv being
+  // the inverse of the effective inverse mass. Add the constraint force
+  // mixing term to the diagonal so the solver converges to the soft
+  // constraint above.
+  if (constraintRow.m_jacDiagABInv > btScalar(0))
+  {
+    const btScalar invMass = btScalar(1) / constraintRow.m_jacDiagABInv;
+    const btScalar jacDiagABInv = btScalar(1) / (invMass + cfm);
+    constraintRow.m_rhs *= invMass * jacDiagABInv;
+    constraintRow.m_jacDiagABInv = jacDiagABInv;
+    constraintRow.m_cfm = cfm * jacDiagABInv;
+  }
+}
+
+}  // namespace bullet_featherstone
+}  // namespace physics
+}  // namespace gz
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_JOINTSERVOMOTOR_HH_
+#define GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_JOINTSERVOMOTOR_HH_
+
+#include <BulletDynamics/Featherstone/btMultiBody.h>
+#include <BulletDynamics/Featherstone/btMultiBodyJointMotor.h>
+
+namespace gz {
+namespace physics {
+namespace bullet_featherstone {
+
+/// \brief A joint motor that drives one degree of freedom of a link towards
+/// a target position with a PD law whose stiffness and damping are given in
+/// physical units.
+///
+/// The gains of btMultiBodyJointMotor are dimensionless, so this motor
+/// replaces its constraint row with a soft constraint that integrates the PD
+/// law implicitly, which stays stable for stiff gains at large time steps.
+/// It is used for both servo commands and joint springs and dampers.
+class JointServoMotor : public btMultiBodyJointMotor
+{
+  /// \brief Constructor
+  /// \param[in] _body Multibody that contains the link
+  /// \param[in] _link Index of the link in the multibody
+  /// \param[in] _dof Degree of freedom of the link to servo
+  public: JointServoMotor(btMultiBody *_body, int _link, int _dof);
+
+  /// \brief Set the servo command of the next step and activate the motor.
+  /// \param[in] _position Target position
+  /// \param[in] _stiffness Proportional gain
+  /// \param[in] _damping Derivative gain
+  /// \param[in] _maxEffort Maximum force or torque that the servo can apply.
+  /// Values that are not positive mean unlimited.
+  public: void SetCommand(btScalar _position, btScalar _stiffness,
+                          btScalar _damping, btScalar _maxEffort);
+
+  /// \brief Deactivate the motor, so that it adds no constraint rows until
+  /// the next command is set.
+  public: void Deactivate();
+
+  // Documentation inherited
+  public: void finalizeMultiDof() override;
+
+  // Documentation inherited
+  public: void createConstraintRows(
+      btMultiBodyConstraintArray &_constraintRows,
+      btMultiBodyJacobianData &_data,
+      const btContactSolverInfo &_infoGlobal) override;
+
+  /// \brief Degree of freedom of the link to servo
+  private: int dof;
+
+  /// \brief Target position
+  private: btScalar target = 0;
+
+  /// \brief Proportional gain
+  private: btScalar stiffness = 0;
+
+  /// \brief Derivative gain
+  private: btScalar damping = 0;
+
+  /// \brief Maximum effort, not positive if unlimited
+  private: btScalar maxEffort = 0;
+
+  /// \brief Whether a command was set for the next step
+  private: bool active = false;
+};
+
+}  // namespace bullet_featherstone
+}  // namespace physics
+}  // namespace gz
+
+#endif  // GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_JOINTSERVOMOTOR_HH_
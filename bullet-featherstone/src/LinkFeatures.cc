@@ -17,6 +17,8 @@
 
 #include "LinkFeatures.hh"
 
+#include <cmath>
+
 namespace gz {
 namespace physics {
 namespace bullet_featherstone {
@@ -75,6 +77,78 @@ void LinkFeatures::AddLinkExternalTorqueInWorld(
   }
 }
 
+/////////////////////////////////////////////////
+bool LinkFeatures::SetLinkContinuousCollision(
+    const Identity &_id, const ContinuousCollisionParameters &_parameters)
+{
+  auto *link = this->ReferenceInterface<LinkInfo>(_id);
+  auto *model = this->ReferenceInterface<ModelInfo>(link->model);
+  auto *world = this->ReferenceInterface<WorldInfo>(model->world);
+
+  if (!_parameters.enabled)
+  {
+    if (link->collider)
+    {
+      link->collider->setCcdMotionThreshold(0);
+      link->collider->setCcdSweptSphereRadius(0);
+    }
+    world->continuousCollisionLinks.erase(_id.id);
+    return true;
+  }
+
+  if (!(_parameters.motionThreshold >= 0.0) ||
+      !std::isfinite(_parameters.motionThreshold) ||
+      !(_parameters.sweptSphereRadius > 0.0) ||
+      !std::isfinite(_parameters.sweptSphereRadius))
+  {
+    gzerr << "Ignoring continuous collision parameters with a negative "
+          << "motion threshold or a swept sphere radius that is not "
+          << "positive.\n";
+    return false;
+  }
+
+  if (link->indexInModel.has_value() || !model->body ||
+      model->body->hasFixedBase())
+  {
+    gzerr << "Continuous collision detection is only supported on the "
+          << "canonical link of a free-floating model. Link [" << link->name
+          << "] is not.\n";
+    return false;
+  }
+
+  if (!link->collider)
+  {
+    gzerr << "Link [" << link->name << "] has no collision to sweep.\n";
+    return false;
+  }
+
+  // The collider keeps the parameters. Bullet only sweeps rigid bodies
+  // itself, so the multibody links are swept by SimulationFeatures.
+  link->collider->setCcdMotionThreshold(
+      static_cast<btScalar>(_parameters.motionThreshold));
+  link->collider->setCcdSweptSphereRadius(
+      static_cast<btScalar>(_parameters.sweptSphereRadius));
+  world->continuousCollisionLinks.insert(_id.id);
+  return true;
+}
+
+/////////////////////////////////////////////////
+ContinuousCollisionParameters LinkFeatures::GetLinkContinuousCollision(
+    const Identity &_id) const
+{
+  ContinuousCollisionParameters parameters;
+  const auto *link = this->ReferenceInterface<LinkInfo>(_id);
+  const auto *model = this->ReferenceInterface<ModelInfo>(link->model);
+  const auto *world = this->ReferenceInterface<WorldInfo>(model->world);
+  if (world->continuousCollisionLinks.count(_id.id) == 0 || !link->collider)
+    return parameters;
+
+  parameters.enabled = true;
+  parameters.motionThreshold = link->collider->getCcdMotionThreshold();
+  parameters.sweptSphereRadius = link->collider->getCcdSweptSphereRadius();
+  return parameters;
+}
+
 }
 }
 }
@@ -18,6 +18,7 @@
 #ifndef GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_LINKFEATURES_HH_
 #define GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_LINKFEATURES_HH_
 
+#include <gz/physics/ContinuousCollision.hh>
 #include <gz/physics/Link.hh>
 
 #include "Base.hh"
@@ -27,7 +28,8 @@ namespace physics {
 namespace bullet_featherstone {
 
 struct LinkFeatureList : FeatureList<
-  AddLinkExternalForceTorque
+  AddLinkExternalForceTorque,
+  ContinuousCollisionFeature
 > { };
 
 class LinkFeatures :
@@ -42,6 +44,14 @@ class LinkFeatures :
 
   public: void AddLinkExternalTorqueInWorld(
       const Identity &_id, const AngularVectorType &_torque) override;
+
+  // ----- Continuous collision detection -----
+  public: bool SetLinkContinuousCollision(
+      const Identity &_id,
+      const ContinuousCollisionParameters &_parameters) override;
+
+  public: ContinuousCollisionParameters GetLinkContinuousCollision(
+      const Identity &_id) const override;
 };
 
 }
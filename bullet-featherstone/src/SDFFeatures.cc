@@ -1173,6 +1173,9 @@ bool SDFFeatures::AddSdfCollision(
       linkInfo->collider = std::make_unique<btMultiBodyLinkCollider>(
         model->body.get(), linkIndexInModel);
 
+      // The link ID lets contacts find the link of a collider directly
+      linkInfo->collider->setUserIndex(static_cast<int>(_linkID));
+
       linkInfo->shape->addChildShape(btInertialToCollision, shape.get());
 
       linkInfo->collider->setCollisionShape(linkInfo->shape.get());
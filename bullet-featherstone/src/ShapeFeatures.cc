@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace gz {
 namespace physics {
@@ -47,6 +48,110 @@ AlignedBox3d ShapeFeatures::GetShapeAxisAlignedBoundingBox(
   return math::eigen3::convert(math::AxisAlignedBox());
 }
 
+/////////////////////////////////////////////////
+/// \brief Merge the world bounding box of the collider of a link into _box.
+/// \return True if the link has a collider.
+static bool ExtendLinkAxisAlignedBoundingBox(
+    const ModelInfo &_model, const LinkInfo &_link, AlignedBox3d &_box)
+{
+  if (!_link.collider || !_link.shape)
+    return false;
+
+  // Use the current transform of the link rather than the one cached in the
+  // collider, which is only updated when the world is stepped.
+  const btTransform tf = _link.indexInModel.has_value() ?
+      GetWorldTransformOfLinkInertiaFrame(*_model.body, *_link.indexInModel) :
+      _model.body->getBaseWorldTransform();
+
+  btVector3 minBox(0, 0, 0);
+  btVector3 maxBox(0, 0, 0);
+  _link.shape->getAabb(tf, minBox, maxBox);
+  _box.extend(convert(minBox));
+  _box.extend(convert(maxBox));
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ShapeFeatures::ExtendModelAxisAlignedBoundingBox(
+    const ModelInfo &_model, AlignedBox3d &_box) const
+{
+  bool hasCollider = false;
+  for (const auto linkID : _model.linkEntityIds)
+  {
+    hasCollider |= ExtendLinkAxisAlignedBoundingBox(
+        _model, *this->links.at(linkID), _box);
+  }
+
+  for (const auto nestedModelID : _model.nestedModelEntityIds)
+  {
+    hasCollider |= this->ExtendModelAxisAlignedBoundingBox(
+        *this->models.at(nestedModelID), _box);
+  }
+  return hasCollider;
+}
+
+/////////////////////////////////////////////////
+void ShapeFeatures::AppendLinkAxisAlignedBoundingBoxes(
+    const ModelInfo &_model,
+    std::vector<std::size_t> &_linkIds,
+    std::vector<AlignedBox3d> &_boxes) const
+{
+  for (const auto linkID : _model.linkEntityIds)
+  {
+    AlignedBox3d box;
+    if (ExtendLinkAxisAlignedBoundingBox(_model, *this->links.at(linkID), box))
+    {
+      _linkIds.push_back(linkID);
+      _boxes.push_back(box);
+    }
+  }
+
+  for (const auto nestedModelID : _model.nestedModelEntityIds)
+  {
+    this->AppendLinkAxisAlignedBoundingBoxes(
+        *this->models.at(nestedModelID), _linkIds, _boxes);
+  }
+}
+
+/////////////////////////////////////////////////
+void ShapeFeatures::GetWorldModelAxisAlignedBoundingBoxes(
+    const Identity &_worldID,
+    std::vector<std::size_t> &_modelIds,
+    std::vector<AlignedBox3d> &_boxes) const
+{
+  _modelIds.clear();
+  _boxes.clear();
+
+  // The world model shares the ID of the world and holds its top level models
+  const auto &worldModel = this->models.at(_worldID);
+  for (const auto modelID : worldModel->nestedModelEntityIds)
+  {
+    AlignedBox3d box;
+    if (this->ExtendModelAxisAlignedBoundingBox(*this->models.at(modelID), box))
+    {
+      _modelIds.push_back(modelID);
+      _boxes.push_back(box);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ShapeFeatures::GetWorldLinkAxisAlignedBoundingBoxes(
+    const Identity &_worldID,
+    std::vector<std::size_t> &_linkIds,
+    std::vector<AlignedBox3d> &_boxes) const
+{
+  _linkIds.clear();
+  _boxes.clear();
+
+  const auto &worldModel = this->models.at(_worldID);
+  for (const auto modelID : worldModel->nestedModelEntityIds)
+  {
+    this->AppendLinkAxisAlignedBoundingBoxes(
+        *this->models.at(modelID), _linkIds, _boxes);
+  }
+}
+
 /////////////////////////////////////////////////
 Identity ShapeFeatures::CastToBoxShape(
       const Identity &_shapeID) const
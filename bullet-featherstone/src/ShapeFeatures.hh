@@ -18,6 +18,7 @@
 #ifndef GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_SHAPEFEATURES_HH_
 #define GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_SHAPEFEATURES_HH_
 
+#include <gz/physics/GetBoundingBox.hh>
 #include <gz/physics/Shape.hh>
 #include <gz/physics/BoxShape.hh>
 #include <gz/physics/CapsuleShape.hh>
@@ -26,6 +27,7 @@
 #include <gz/physics/SphereShape.hh>
 
 #include <string>
+#include <vector>
 
 #include "Base.hh"
 
@@ -35,6 +37,7 @@ namespace bullet_featherstone {
 
 struct ShapeFeatureList : FeatureList<
   GetShapeBoundingBox,
+  GetWorldEntityBoundingBoxes,
 
   GetBoxShapeProperties,
   AttachBoxShapeFeature,
@@ -60,6 +63,29 @@ class ShapeFeatures :
   public: AlignedBox3d GetShapeAxisAlignedBoundingBox(
               const Identity &_shapeID) const override;
 
+  public: void GetWorldModelAxisAlignedBoundingBoxes(
+              const Identity &_worldID,
+              std::vector<std::size_t> &_modelIds,
+              std::vector<AlignedBox3d> &_boxes) const override;
+
+  public: void GetWorldLinkAxisAlignedBoundingBoxes(
+              const Identity &_worldID,
+              std::vector<std::size_t> &_linkIds,
+              std::vector<AlignedBox3d> &_boxes) const override;
+
+  /// \brief Merge the world bounding boxes of the colliders of a model and
+  /// its nested models into _box.
+  /// \return True if the model has any colliders.
+  private: bool ExtendModelAxisAlignedBoundingBox(
+              const ModelInfo &_model, AlignedBox3d &_box) const;
+
+  /// \brief Append the world bounding boxes of the colliders of every link
+  /// of a model and its nested models.
+  private: void AppendLinkAxisAlignedBoundingBoxes(
+              const ModelInfo &_model,
+              std::vector<std::size_t> &_linkIds,
+              std::vector<AlignedBox3d> &_boxes) const;
+
   // ----- Box Features -----
   public: Identity CastToBoxShape(
       const Identity &_shapeID) const override;
@@ -19,14 +19,88 @@
 
 #include <gz/math/eigen3/Conversions.hh>
 
+#include <cmath>
 #include <limits>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace gz {
 namespace physics {
 namespace bullet_featherstone {
 
+namespace {
+/////////////////////////////////////////////////
+/// \brief Check whether a collision object is a link collider of a
+/// multibody.
+bool IsPartOf(const btCollisionObject *_object, const btMultiBody *_body)
+{
+  const auto *collider = btMultiBodyLinkCollider::upcast(_object);
+  return collider && collider->m_multiBody == _body;
+}
+
+/////////////////////////////////////////////////
+/// \brief Collects the collision objects that the colliders of a multibody
+/// touch.
+struct TouchingCallback : public btCollisionWorld::ContactResultCallback
+{
+  explicit TouchingCallback(const btMultiBody *_body)
+    : body(_body)
+  {
+  }
+
+  btScalar addSingleResult(
+      btManifoldPoint &/*_point*/,
+      const btCollisionObjectWrapper *_object0, int /*_partId0*/,
+      int /*_index0*/,
+      const btCollisionObjectWrapper *_object1, int /*_partId1*/,
+      int /*_index1*/) override
+  {
+    for (const auto *wrapper : {_object0, _object1})
+    {
+      const auto *object = wrapper->getCollisionObject();
+      if (!IsPartOf(object, this->body))
+        this->touching.insert(object);
+    }
+    return 0;
+  }
+
+  const btMultiBody *body;
+  std::unordered_set<const btCollisionObject *> touching;
+};
+
+/////////////////////////////////////////////////
+/// \brief Finds the first collision hit by a sphere swept along the motion
+/// of a multibody, ignoring the multibody itself and the collisions that it
+/// already touches.
+struct SweepCallback : public btCollisionWorld::ClosestConvexResultCallback
+{
+  SweepCallback(const btVector3 &_from, const btVector3 &_to,
+                const TouchingCallback &_touching)
+    : ClosestConvexResultCallback(_from, _to),
+      touching(_touching)
+  {
+  }
+
+  bool needsCollision(btBroadphaseProxy *_proxy) const override
+  {
+    const auto *object =
+        static_cast<const btCollisionObject *>(_proxy->m_clientObject);
+    if (IsPartOf(object, this->touching.body) ||
+        this->touching.touching.count(object) > 0)
+    {
+      return false;
+    }
+    return ClosestConvexResultCallback::needsCollision(_proxy);
+  }
+
+  const TouchingCallback &touching;
+};
+}  // namespace
+
 /////////////////////////////////////////////////
 void SimulationFeatures::WorldForwardStep(
     const Identity &_worldID,
@@ -35,23 +109,47 @@ void SimulationFeatures::WorldForwardStep(
     const ForwardStep::Input & _u)
 {
   const auto worldInfo = this->ReferenceInterface<WorldInfo>(_worldID);
+  worldInfo->linkContactWrenchesValid = false;
+
   auto *dtDur =
     _u.Query<std::chrono::steady_clock::duration>();
   if (dtDur)
   {
     std::chrono::duration<double> dt = *dtDur;
-    stepSize = dt.count();
+    worldInfo->stepSize = dt.count();
   }
 
-  worldInfo->world->stepSimulation(static_cast<btScalar>(this->stepSize), 1,
-                                   static_cast<btScalar>(this->stepSize));
+  // A world that plays back a state log does not run its dynamics
+  const auto replayIt = this->stateReplays.find(_worldID.id);
+  if (replayIt != this->stateReplays.end())
+  {
+    const std::size_t next = replayIt->second.next;
+    if (next < replayIt->second.log->StepCount())
+      this->WorldSeekStateLog(_worldID, next);
+    this->WriteStepOutput(_h);
+    return;
+  }
+
+  if (const auto *servos = _u.Query<JointServoCommands>())
+    this->ApplyServoCommands(_worldID, *servos);
+
+  if (!worldInfo->continuousCollisionLinks.empty())
+    this->SweepContinuousCollisionLinks(*worldInfo);
+
+  worldInfo->solver->ResetStatistics();
+  const auto dt = static_cast<btScalar>(worldInfo->stepSize);
+  worldInfo->world->stepSimulation(dt, 1, dt);
+
+  // Servo commands only act during the step they are passed to
+  for (auto *servo : this->activeServos)
+    servo->Deactivate();
+  this->activeServos.clear();
 
   for (auto & m : this->models)
   {
     if (m.second->body)
     {
-      m.second->body->checkMotionAndSleepIfRequired(
-          static_cast<btScalar>(this->stepSize));
+      m.second->body->checkMotionAndSleepIfRequired(dt);
       btMultiBodyLinkCollider* col = m.second->body->getBaseCollider();
       if (col && col->getActivationState() != DISABLE_DEACTIVATION)
         col->setActivationState(ACTIVE_TAG);
@@ -65,8 +163,419 @@ void SimulationFeatures::WorldForwardStep(
     }
   }
 
+  this->WriteStepOutput(_h);
+  if (_h.Has<SolverStatistics>())
+    _h.Get<SolverStatistics>() = worldInfo->solver->Statistics();
+
+  const auto recorderIt = this->stateRecorders.find(_worldID.id);
+  if (recorderIt != this->stateRecorders.end())
+  {
+    recorderIt->second.time += worldInfo->stepSize;
+    this->RecordState(_worldID, recorderIt->second);
+  }
+}
+
+/////////////////////////////////////////////////
+void SimulationFeatures::SweepContinuousCollisionLinks(WorldInfo &_worldInfo)
+{
+  const auto dt = static_cast<btScalar>(_worldInfo.stepSize);
+  for (auto it = _worldInfo.continuousCollisionLinks.begin();
+       it != _worldInfo.continuousCollisionLinks.end();)
+  {
+    const auto linkIt = this->links.find(*it);
+    if (linkIt == this->links.end())
+    {
+      it = _worldInfo.continuousCollisionLinks.erase(it);
+      continue;
+    }
+    ++it;
+
+    btMultiBodyLinkCollider *collider = linkIt->second->collider.get();
+    const auto *model =
+        this->ReferenceInterface<ModelInfo>(linkIt->second->model);
+    btMultiBody *body = model->body.get();
+    if (!collider || !body || !body->isAwake())
+      continue;
+
+    const btVector3 velocity = body->getBaseVel();
+    const btVector3 motion = velocity * dt;
+    const btScalar distance = motion.length();
+    if (distance <= collider->getCcdMotionThreshold() ||
+        distance <= btScalar(0))
+    {
+      continue;
+    }
+
+    const btBroadphaseProxy *handle = collider->getBroadphaseHandle();
+    TouchingCallback touching(body);
+    touching.m_collisionFilterGroup = handle->m_collisionFilterGroup;
+    touching.m_collisionFilterMask = handle->m_collisionFilterMask;
+    _worldInfo.world->contactTest(collider, touching);
+
+    // The sphere only moves, since the swept sphere has no orientation
+    btTransform from = collider->getWorldTransform();
+    btTransform to = from;
+    to.setOrigin(from.getOrigin() + motion);
+    SweepCallback sweep(from.getOrigin(), to.getOrigin(), touching);
+    sweep.m_collisionFilterGroup = handle->m_collisionFilterGroup;
+    sweep.m_collisionFilterMask = handle->m_collisionFilterMask;
+    const btSphereShape sphere(collider->getCcdSweptSphereRadius());
+    _worldInfo.world->convexSweepTest(&sphere, from, to, sweep);
+    if (!sweep.hasHit())
+      continue;
+
+    // Keep the velocity of the link along the surface, and reduce its
+    // velocity towards the surface so that it reaches it during the step.
+    // The link is larger than its swept sphere, so it ends the step in
+    // contact.
+    btVector3 normal = sweep.m_hitNormalWorld;
+    if (normal.dot(motion) > btScalar(0))
+      normal = -normal;
+    const btScalar approach = -velocity.dot(normal);
+    if (approach <= btScalar(0))
+      continue;
+
+    body->setBaseVel(velocity +
+        (btScalar(1) - sweep.m_closestHitFraction) * approach * normal);
+  }
+}
+
+/////////////////////////////////////////////////
+void SimulationFeatures::WriteStepOutput(ForwardStep::Output &_h)
+{
   this->WriteRequiredData(_h);
   this->Write(_h.Get<ChangedWorldPoses>());
+
+  // The pose stream is only encoded when the caller asked for it
+  if (_h.Has<ChangedWorldPosesStream>())
+    this->Write(_h.Get<ChangedWorldPosesStream>());
+}
+
+/////////////////////////////////////////////////
+bool SimulationFeatures::WorldStartStateRecording(
+    const Identity &_worldID, const std::string &_path,
+    const StateLogOptions &_options)
+{
+  auto log = std::make_unique<StateLogWriter>();
+  if (!log->Open(_path, _options))
+  {
+    gzerr << "Unable to create state log [" << _path << "].\n";
+    return false;
+  }
+
+  // Replacing a recording in progress closes its log
+  StateRecorder recorder;
+  recorder.log = std::move(log);
+  this->stateRecorders[_worldID.id] = std::move(recorder);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SimulationFeatures::WorldStopStateRecording(const Identity &_worldID)
+{
+  const auto it = this->stateRecorders.find(_worldID.id);
+  if (it == this->stateRecorders.end())
+    return false;
+
+  const bool written = it->second.log->Close();
+  this->stateRecorders.erase(it);
+  return written;
+}
+
+/////////////////////////////////////////////////
+bool SimulationFeatures::WorldLoadStateLog(
+    const Identity &_worldID, const std::string &_path)
+{
+  auto log = std::make_unique<StateLogReader>();
+  if (!log->Open(_path))
+  {
+    gzerr << "Unable to read state log [" << _path << "].\n";
+    return false;
+  }
+
+  this->stateReplays[_worldID.id] = StateReplay{std::move(log), 0};
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SimulationFeatures::WorldUnloadStateLog(const Identity &_worldID)
+{
+  this->stateReplays.erase(_worldID.id);
+}
+
+/////////////////////////////////////////////////
+std::size_t SimulationFeatures::GetWorldStateLogStepCount(
+    const Identity &_worldID) const
+{
+  const auto it = this->stateReplays.find(_worldID.id);
+  if (it == this->stateReplays.end())
+    return 0;
+  return it->second.log->StepCount();
+}
+
+/////////////////////////////////////////////////
+bool SimulationFeatures::WorldSeekStateLog(
+    const Identity &_worldID, const std::size_t _index)
+{
+  const auto it = this->stateReplays.find(_worldID.id);
+  if (it == this->stateReplays.end() ||
+      _index >= it->second.log->StepCount())
+  {
+    return false;
+  }
+
+  // Steps only hold what changed since the previous step, so the state of
+  // _index is rebuilt from its key frame, unless we are already on the way.
+  auto &replay = it->second;
+  const std::size_t keyFrame = replay.log->KeyFrameOf(_index);
+  const std::size_t first =
+      (keyFrame <= replay.next && replay.next <= _index) ?
+      replay.next : keyFrame;
+
+  StateLogStep step;
+  for (std::size_t i = first; i <= _index; ++i)
+  {
+    replay.log->Step(i, step);
+    this->ApplyLoggedStep(step);
+  }
+
+  // Update the link transforms from the new joint positions, since no step
+  // will do it for us.
+  btAlignedObjectArray<btQuaternion> worldToLocal;
+  btAlignedObjectArray<btVector3> localOrigin;
+  for (const auto &[id, model] : this->models)
+  {
+    if (model->world.id != _worldID.id || !model->body)
+      continue;
+
+    model->body->forwardKinematics(worldToLocal, localOrigin);
+    model->body->updateCollisionObjectWorldTransforms(
+        worldToLocal, localOrigin);
+  }
+
+  replay.next = _index + 1;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SimulationFeatures::RecordState(
+    const Identity &_worldID, StateRecorder &_recorder) const
+{
+  StateLogWriter &log = *_recorder.log;
+  log.BeginStep(_recorder.step++, _recorder.time);
+
+  for (const auto &[id, info] : this->links)
+  {
+    const auto *model = this->ReferenceInterface<ModelInfo>(info->model);
+    if (model->world.id != _worldID.id)
+      continue;
+
+    const Eigen::Isometry3d tf = GetWorldTransformOfLink(*model, *info);
+    const Eigen::Quaterniond rot(tf.linear());
+
+    // Velocities are the ones reported by FrameDataRelativeToWorld
+    btVector3 v = model->body->getBaseVel();
+    btVector3 w = model->body->getBaseOmega();
+    if (info->indexInModel.has_value())
+    {
+      const auto &link = model->body->getLink(*info->indexInModel);
+      v = link.m_absFrameTotVelocity.getLinear();
+      w = link.m_absFrameTotVelocity.getAngular();
+    }
+
+    log.AddLink(StateLogLink{
+        id,
+        {tf.translation().x(), tf.translation().y(), tf.translation().z(),
+         rot.w(), rot.x(), rot.y(), rot.z()},
+        {v.x(), v.y(), v.z()},
+        {w.x(), w.y(), w.z()}});
+  }
+
+  for (const auto &[id, info] : this->joints)
+  {
+    const auto *identifier = std::get_if<InternalJoint>(&info->identifier);
+    if (!identifier)
+      continue;
+
+    const auto *model = this->ReferenceInterface<ModelInfo>(info->model);
+    if (model->world.id != _worldID.id)
+      continue;
+
+    // Ball joints store their position as a quaternion, which is not
+    // logged per degree of freedom.
+    const int index = identifier->indexInBtModel;
+    const auto &link = model->body->getLink(index);
+    if (link.m_posVarCount != link.m_dofCount)
+      continue;
+
+    const btScalar *positions = model->body->getJointPosMultiDof(index);
+    const btScalar *velocities = model->body->getJointVelMultiDof(index);
+    for (int dof = 0; dof < link.m_dofCount; ++dof)
+    {
+      log.AddJoint(StateLogJoint{
+          id, static_cast<uint64_t>(dof), positions[dof], velocities[dof]});
+    }
+  }
+
+  for (const auto &contact : this->GetContactsFromLastStep(_worldID))
+  {
+    StateLogContact record{};
+    record.collision1 = contact.collision1.id;
+    record.collision2 = contact.collision2.id;
+    record.point[0] = contact.point.x();
+    record.point[1] = contact.point.y();
+    record.point[2] = contact.point.z();
+
+    const auto *extra = contact.extraData.Query<
+        SimulationFeatures::ExtraContactData>();
+    if (extra)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        record.normal[i] = extra->normal[i];
+        record.force[i] = extra->force[i];
+      }
+      record.depth = extra->depth;
+    }
+    log.AddContact(record);
+  }
+
+  log.EndStep();
+}
+
+/////////////////////////////////////////////////
+void SimulationFeatures::ApplyLoggedStep(const StateLogStep &_step)
+{
+  for (std::size_t i = 0; i < _step.linkCount; ++i)
+  {
+    const StateLogLink &record = _step.links[i];
+    const auto linkIt = this->links.find(record.entity);
+    if (linkIt == this->links.end() ||
+        linkIt->second->indexInModel.has_value())
+    {
+      // Links other than the base follow from the joint positions
+      continue;
+    }
+
+    const auto *model =
+        this->ReferenceInterface<ModelInfo>(linkIt->second->model);
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.translation() =
+        Eigen::Vector3d(record.pose[0], record.pose[1], record.pose[2]);
+    tf.linear() = Eigen::Quaterniond(
+        record.pose[3], record.pose[4], record.pose[5], record.pose[6])
+        .normalized().toRotationMatrix();
+    model->body->setBaseWorldTransform(
+        convertTf(tf * model->baseInertiaToLinkFrame.inverse()));
+    model->body->setBaseVel(btVector3(
+        static_cast<btScalar>(record.linearVelocity[0]),
+        static_cast<btScalar>(record.linearVelocity[1]),
+        static_cast<btScalar>(record.linearVelocity[2])));
+    model->body->setBaseOmega(btVector3(
+        static_cast<btScalar>(record.angularVelocity[0]),
+        static_cast<btScalar>(record.angularVelocity[1]),
+        static_cast<btScalar>(record.angularVelocity[2])));
+  }
+
+  for (std::size_t i = 0; i < _step.jointCount; ++i)
+  {
+    const StateLogJoint &record = _step.joints[i];
+    const auto jointIt = this->joints.find(record.entity);
+    if (jointIt == this->joints.end())
+      continue;
+
+    const auto *identifier =
+        std::get_if<InternalJoint>(&jointIt->second->identifier);
+    if (!identifier)
+      continue;
+
+    const auto *model =
+        this->ReferenceInterface<ModelInfo>(jointIt->second->model);
+    const int index = identifier->indexInBtModel;
+    if (record.dof >=
+        static_cast<uint64_t>(model->body->getLink(index).m_dofCount))
+    {
+      continue;
+    }
+
+    model->body->getJointPosMultiDof(index)[record.dof] =
+        static_cast<btScalar>(record.position);
+    model->body->getJointVelMultiDof(index)[record.dof] =
+        static_cast<btScalar>(record.velocity);
+  }
+}
+
+/////////////////////////////////////////////////
+void SimulationFeatures::ApplyServoCommands(
+    const Identity &_worldID, const JointServoCommands &_servos)
+{
+  const std::size_t count = _servos.joints.size();
+  if (_servos.dofs.size() != count || _servos.positions.size() != count ||
+      _servos.gains.size() != count)
+  {
+    gzerr << "Ignoring servo commands: expected [" << count << "] dofs, "
+          << "positions and gains, got [" << _servos.dofs.size() << "], ["
+          << _servos.positions.size() << "] and [" << _servos.gains.size()
+          << "].\n";
+    return;
+  }
+
+  auto *world = this->ReferenceInterface<WorldInfo>(_worldID);
+  this->activeServos.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const auto jointIt = this->joints.find(_servos.joints[i]);
+    if (jointIt == this->joints.end())
+    {
+      gzerr << "Ignoring servo command for joint [" << _servos.joints[i]
+            << "], which does not exist.\n";
+      continue;
+    }
+
+    auto *jointInfo = jointIt->second.get();
+    const auto *identifier =
+        std::get_if<InternalJoint>(&jointInfo->identifier);
+    const auto *model = this->ReferenceInterface<ModelInfo>(jointInfo->model);
+    if (!identifier || model->world.id != _worldID.id)
+    {
+      gzerr << "Ignoring servo command for joint [" << jointInfo->name
+            << "], which is not an internal joint of a model in this "
+            << "world.\n";
+      continue;
+    }
+
+    const auto &link = model->body->getLink(identifier->indexInBtModel);
+    const std::size_t dof = _servos.dofs[i];
+    const double target = _servos.positions[i];
+    const double kp = _servos.gains[i].P;
+    const double kd = _servos.gains[i].D;
+    // Take extra care that the values are finite. A nan can cause the Bullet
+    // constraint solver to fail.
+    if (dof >= static_cast<std::size_t>(link.m_dofCount) ||
+        link.m_posVarCount != link.m_dofCount ||
+        !std::isfinite(target) || !std::isfinite(kp) || !std::isfinite(kd) ||
+        kp < 0.0 || kd < 0.0)
+    {
+      gzerr << "Ignoring invalid servo command for axis [" << dof
+            << "] of joint [" << jointInfo->name << "].\n";
+      continue;
+    }
+
+    if (jointInfo->servos.size() <= dof)
+      jointInfo->servos.resize(static_cast<std::size_t>(link.m_dofCount));
+    auto &servo = jointInfo->servos[dof];
+    if (!servo)
+    {
+      servo = std::make_shared<JointServoMotor>(
+          model->body.get(), identifier->indexInBtModel,
+          static_cast<int>(dof));
+      world->world->addMultiBodyConstraint(servo.get());
+    }
+    servo->SetCommand(
+        static_cast<btScalar>(target), static_cast<btScalar>(kp),
+        static_cast<btScalar>(kd), jointInfo->effort);
+    this->activeServos.push_back(servo.get());
+  }
 }
 
 /////////////////////////////////////////////////
@@ -81,6 +590,15 @@ SimulationFeatures::GetContactsFromLastStep(const Identity &_worldID) const
   }
 
   int numManifolds = world->world->getDispatcher()->getNumManifolds();
+  std::size_t numContactPoints = 0;
+  for (int i = 0; i < numManifolds; i++)
+  {
+    numContactPoints += static_cast<std::size_t>(
+        world->world->getDispatcher()->getManifoldByIndexInternal(i)
+            ->getNumContacts());
+  }
+  outContacts.reserve(numContactPoints);
+
   for (int i = 0; i < numManifolds; i++)
   {
     btPersistentManifold* contactManifold =
@@ -92,21 +610,23 @@ SimulationFeatures::GetContactsFromLastStep(const Identity &_worldID) const
     std::size_t collision1ID = std::numeric_limits<std::size_t>::max();
     std::size_t collision2ID = std::numeric_limits<std::size_t>::max();
 
-    for (const auto & link : this->links)
+    // The user index of a collider is the ID of its link
+    const auto linkA = obA ? this->links.find(
+        static_cast<std::size_t>(obA->getUserIndex())) : this->links.end();
+    if (linkA != this->links.end())
     {
-      if (obA == link.second->collider.get())
+      for (const auto &v : linkA->second->collisionNameToEntityId)
       {
-        for (const auto &v : link.second->collisionNameToEntityId)
-        {
-          collision1ID = v.second;
-        }
+        collision1ID = v.second;
       }
-      if (obB == link.second->collider.get())
+    }
+    const auto linkB = obB ? this->links.find(
+        static_cast<std::size_t>(obB->getUserIndex())) : this->links.end();
+    if (linkB != this->links.end())
+    {
+      for (const auto &v : linkB->second->collisionNameToEntityId)
       {
-        for (const auto &v : link.second->collisionNameToEntityId)
-        {
-          collision2ID = v.second;
-        }
+        collision2ID = v.second;
       }
     }
     int numContacts = contactManifold->getNumContacts();
@@ -118,10 +638,7 @@ SimulationFeatures::GetContactsFromLastStep(const Identity &_worldID) const
       // Add normal, depth and wrench to extraData.
       auto& extraContactData =
         extraData.Get<SimulationFeatures::ExtraContactData>();
-      extraContactData.force =
-        convert(btVector3(pt.m_appliedImpulse,
-                          pt.m_appliedImpulse,
-                          pt.m_appliedImpulse));
+      extraContactData.force = this->ContactForceOnA(pt, world->stepSize);
       extraContactData.normal = convert(pt.m_normalWorldOnB);
       extraContactData.depth = pt.getDistance();
 
@@ -134,6 +651,95 @@ SimulationFeatures::GetContactsFromLastStep(const Identity &_worldID) const
   return outContacts;
 }
 
+/////////////////////////////////////////////////
+Wrench3d SimulationFeatures::GetLinkContactWrenchFromLastStep(
+    const Identity &_linkID) const
+{
+  Wrench3d wrench{Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero()};
+
+  const auto linkIt = this->links.find(_linkID.id);
+  if (linkIt == this->links.end())
+    return wrench;
+
+  const auto *model =
+      this->ReferenceInterface<ModelInfo>(linkIt->second->model);
+  auto *world = this->ReferenceInterface<WorldInfo>(model->world);
+  if (!world)
+    return wrench;
+
+  // The wrenches of all the links of the world are computed together, the
+  // first time one of them is requested after a step
+  if (!world->linkContactWrenchesValid)
+  {
+    world->linkContactWrenches.clear();
+
+    const auto addForce = [&](const btCollisionObject *_body,
+                              const Eigen::Vector3d &_force,
+                              const btVector3 &_point)
+    {
+      const auto *collider = dynamic_cast<const btMultiBodyLinkCollider *>(
+          _body);
+      if (!collider)
+        return;
+
+      const auto it = this->links.find(
+          static_cast<std::size_t>(collider->getUserIndex()));
+      if (it == this->links.end())
+        return;
+
+      const auto *linkModel =
+          this->ReferenceInterface<ModelInfo>(it->second->model);
+      const Eigen::Vector3d origin =
+          GetWorldTransformOfLink(*linkModel, *it->second).translation();
+
+      auto wrenchIt = world->linkContactWrenches.find(it->first);
+      if (wrenchIt == world->linkContactWrenches.end())
+      {
+        wrenchIt = world->linkContactWrenches.emplace(
+            it->first, Wrench3d{Eigen::Vector3d::Zero(),
+                                Eigen::Vector3d::Zero()}).first;
+      }
+      wrenchIt->second.force += _force;
+      wrenchIt->second.torque += (convert(_point) - origin).cross(_force);
+    };
+
+    auto *dispatcher = world->world->getDispatcher();
+    for (int i = 0; i < dispatcher->getNumManifolds(); ++i)
+    {
+      const btPersistentManifold *manifold =
+          dispatcher->getManifoldByIndexInternal(i);
+      for (int j = 0; j < manifold->getNumContacts(); ++j)
+      {
+        const btManifoldPoint &pt = manifold->getContactPoint(j);
+        const Eigen::Vector3d force =
+            this->ContactForceOnA(pt, world->stepSize);
+        addForce(manifold->getBody0(), force, pt.getPositionWorldOnA());
+        addForce(manifold->getBody1(), -force, pt.getPositionWorldOnB());
+      }
+    }
+    world->linkContactWrenchesValid = true;
+  }
+
+  const auto wrenchIt = world->linkContactWrenches.find(_linkID.id);
+  if (wrenchIt != world->linkContactWrenches.end())
+    wrench = wrenchIt->second;
+  return wrench;
+}
+
+/////////////////////////////////////////////////
+Eigen::Vector3d SimulationFeatures::ContactForceOnA(
+    const btManifoldPoint &_pt, const double _stepSize) const
+{
+  // The solver stores the impulses of the last step. The friction impulses
+  // are only written back when warm starting is enabled, which it is by
+  // default.
+  const btVector3 impulse =
+      _pt.m_normalWorldOnB * _pt.m_appliedImpulse +
+      _pt.m_lateralFrictionDir1 * _pt.m_appliedImpulseLateral1 +
+      _pt.m_lateralFrictionDir2 * _pt.m_appliedImpulseLateral2;
+  return convert(impulse) / _stepSize;
+}
+
 /////////////////////////////////////////////////
 void SimulationFeatures::Write(WorldPoses &_worldPoses) const
 {
@@ -157,8 +763,6 @@ void SimulationFeatures::Write(ChangedWorldPoses &_changedPoses) const
   _changedPoses.entries.clear();
   _changedPoses.entries.reserve(this->links.size());
 
-  std::unordered_map<std::size_t, math::Pose3d> newPoses;
-
   for (const auto &[id, info] : this->links)
   {
     const auto &model = this->ReferenceInterface<ModelInfo>(info->model);
@@ -172,16 +776,37 @@ void SimulationFeatures::Write(ChangedWorldPoses &_changedPoses) const
         !iter->second.Rot().Equal(wp.pose.Rot(), 1e-6))
     {
       _changedPoses.entries.push_back(wp);
-      newPoses[id] = wp.pose;
+      this->prevLinkPoses[id] = wp.pose;
     }
+  }
+
+  // The poses are updated in place so that they can be used to check for
+  // updates in the next iteration. Drop the links that were removed so that
+  // we aren't caching data for them.
+  for (auto iter = this->prevLinkPoses.begin();
+       iter != this->prevLinkPoses.end();)
+  {
+    if (this->links.find(iter->first) != this->links.end())
+      ++iter;
     else
-      newPoses[id] = iter->second;
+      iter = this->prevLinkPoses.erase(iter);
   }
+}
 
-  // Save the new poses so that they can be used to check for updates in the
-  // next iteration. Re-setting this->prevLinkPoses with the contents of
-  // newPoses ensures that we aren't caching data for links that were removed
-  this->prevLinkPoses = std::move(newPoses);
+/////////////////////////////////////////////////
+void SimulationFeatures::Write(ChangedWorldPosesStream &_stream) const
+{
+  this->poseStreamEncoder.BeginFrame(_stream.frame);
+  for (const auto &[id, info] : this->links)
+  {
+    const auto &model = this->ReferenceInterface<ModelInfo>(info->model);
+    const Eigen::Isometry3d tf = GetWorldTransformOfLink(*model, *info);
+    const Eigen::Quaterniond rot(tf.linear());
+    this->poseStreamEncoder.Add(
+        id, tf.translation().x(), tf.translation().y(),
+        tf.translation().z(), rot.w(), rot.x(), rot.y(), rot.z());
+  }
+  this->poseStreamEncoder.EndFrame();
 }
 }  // namespace bullet_featherstone
 }  // namespace physics
@@ -18,12 +18,17 @@
 #ifndef GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_SIMULATIONFEATURES_HH_
 #define GZ_PHYSICS_BULLET_FEATHERSTONE_SRC_SIMULATIONFEATURES_HH_
 
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <gz/physics/CanWriteData.hh>
 #include <gz/physics/ForwardStep.hh>
 #include <gz/physics/GetContacts.hh>
+#include <gz/physics/PoseStream.hh>
+#include <gz/physics/StateLog.hh>
+#include <gz/physics/StateRecording.hh>
 
 #include "Base.hh"
 
@@ -33,7 +38,10 @@ namespace bullet_featherstone {
 
 struct SimulationFeatureList : gz::physics::FeatureList<
   ForwardStep,
-  GetContactsFromLastStepFeature
+  GetContactsFromLastStepFeature,
+  GetLinkContactWrenchFromLastStepFeature,
+  RecordWorldState,
+  ReplayWorldState
 > { };
 
 class SimulationFeatures :
@@ -55,14 +63,117 @@ class SimulationFeatures :
   public: void Write(WorldPoses &_worldPoses) const;
   public: void Write(ChangedWorldPoses &_changedPoses) const;
 
+  /// \brief Encode the link poses straight from the multibody transforms.
+  /// \param[out] _stream Stream frame of this step
+  public: void Write(ChangedWorldPosesStream &_stream) const;
+
   public: std::vector<ContactInternal> GetContactsFromLastStep(
       const Identity &_worldID) const override;
 
-  private: double stepSize = 0.001;
+  // Documentation inherited
+  public: Wrench3d GetLinkContactWrenchFromLastStep(
+      const Identity &_linkID) const override;
+
+  /// \brief Get the force that a contact point applied to the first body of
+  /// its manifold during the last step, i.e. the normal force plus the two
+  /// friction forces. The second body received the opposite force.
+  /// \param[in] _pt Contact point
+  /// \param[in] _stepSize Size of the last step of the world of the contact
+  /// \return Force in the world frame
+  private: Eigen::Vector3d ContactForceOnA(
+      const btManifoldPoint &_pt, double _stepSize) const;
+
+  // Documentation inherited
+  public: bool WorldStartStateRecording(
+      const Identity &_worldID, const std::string &_path,
+      const StateLogOptions &_options) override;
+
+  // Documentation inherited
+  public: bool WorldStopStateRecording(const Identity &_worldID) override;
+
+  // Documentation inherited
+  public: bool WorldLoadStateLog(
+      const Identity &_worldID, const std::string &_path) override;
+
+  // Documentation inherited
+  public: void WorldUnloadStateLog(const Identity &_worldID) override;
+
+  // Documentation inherited
+  public: std::size_t GetWorldStateLogStepCount(
+      const Identity &_worldID) const override;
+
+  // Documentation inherited
+  public: bool WorldSeekStateLog(
+      const Identity &_worldID, std::size_t _index) override;
+
+  /// \brief Write the output of a step.
+  /// \param[out] _h Step output
+  private: void WriteStepOutput(ForwardStep::Output &_h);
+
+  /// \brief A state log that is being recorded
+  private: struct StateRecorder
+  {
+    std::unique_ptr<StateLogWriter> log;
+
+    /// \brief Number of steps recorded so far
+    uint64_t step = 0;
+
+    /// \brief Simulation time since the recording started. Bullet does not
+    /// keep track of the simulation time, so it is accumulated here.
+    double time = 0.0;
+  };
+
+  /// \brief Append the current state of a world to its state log.
+  /// \param[in] _worldID World to record
+  /// \param[in] _recorder Recorder of the world
+  private: void RecordState(const Identity &_worldID,
+                            StateRecorder &_recorder) const;
+
+  /// \brief Set the state of the links and joints of a logged step
+  /// kinematically. The base links are placed directly, and every other link
+  /// follows from the joint positions.
+  /// \param[in] _step Logged step
+  private: void ApplyLoggedStep(const StateLogStep &_step);
+
+  /// \brief Activate the servo motors of the joints commanded in _servos
+  /// for the next step.
+  /// \param[in] _worldID World that is about to be stepped
+  /// \param[in] _servos Servo commands of this step
+  private: void ApplyServoCommands(
+      const Identity &_worldID, const JointServoCommands &_servos);
+
+  /// \brief Sweep the motion of the links of a world that use continuous
+  /// collision detection, and slow the links down that would otherwise pass
+  /// through a collision during the step.
+  /// \param[in] _worldInfo World that is about to be stepped
+  private: void SweepContinuousCollisionLinks(WorldInfo &_worldInfo);
+
+  /// \brief Servo motors that are active during the current step. The
+  /// buffer is kept between steps to avoid reallocating it every step.
+  private: std::vector<JointServoMotor *> activeServos;
 
   /// \brief link poses from the most recent pose change/update.
   /// The key is the link's ID, and the value is the link's pose
   private: mutable std::unordered_map<std::size_t, math::Pose3d> prevLinkPoses;
+
+  /// \brief Encoder of ChangedWorldPosesStream. It keeps the poses that were
+  /// last sent so that each frame only carries deltas.
+  private: mutable PoseStreamEncoder poseStreamEncoder;
+
+  /// \brief Worlds that are being recorded, by world ID
+  private: std::unordered_map<std::size_t, StateRecorder> stateRecorders;
+
+  /// \brief A state log that is being played back
+  private: struct StateReplay
+  {
+    std::unique_ptr<StateLogReader> log;
+
+    /// \brief Index of the next step to play back
+    std::size_t next = 0;
+  };
+
+  /// \brief State logs of the worlds that are being played back, by world ID
+  private: std::unordered_map<std::size_t, StateReplay> stateReplays;
 };
 
 }  // namespace bullet_featherstone
@@ -15,7 +15,9 @@
  *
  */
 
+#include <cmath>
 #include <string>
+#include <unordered_set>
 
 #include <gz/common/Console.hh>
 
@@ -25,6 +27,78 @@ namespace gz {
 namespace physics {
 namespace bullet_featherstone {
 
+namespace {
+/////////////////////////////////////////////////
+/// \brief Approximate size of one element of a std::unordered_map. Each
+/// element is a separate node that holds the value, a next pointer and the
+/// cached hash, and it adds about one pointer to the bucket array.
+template <typename MapT>
+constexpr std::size_t HashMapEntrySize()
+{
+  return sizeof(typename MapT::value_type) + 3 * sizeof(void *);
+}
+
+/////////////////////////////////////////////////
+/// \brief Approximate size of an info structure created with
+/// std::make_shared, which shares its allocation with the control block.
+template <typename InfoT>
+constexpr std::size_t SharedInfoSize()
+{
+  return sizeof(InfoT) + 2 * sizeof(void *);
+}
+
+/////////////////////////////////////////////////
+/// \brief Approximate size of a collision shape, including the triangle
+/// meshes and bounding volume hierarchies of GImpact shapes.
+std::size_t CollisionShapeSize(const btCollisionShape &_shape)
+{
+  if (_shape.isCompound())
+  {
+    const auto &compound = static_cast<const btCompoundShape &>(_shape);
+    std::size_t size = sizeof(btCompoundShape);
+    for (int i = 0; i < compound.getNumChildShapes(); ++i)
+    {
+      size += sizeof(btCompoundShapeChild) +
+          CollisionShapeSize(*compound.getChildShape(i));
+    }
+    return size;
+  }
+
+  if (_shape.getShapeType() == GIMPACT_SHAPE_PROXYTYPE)
+  {
+    const auto &gimpact = static_cast<const btGImpactMeshShape &>(_shape);
+    std::size_t size = sizeof(btGImpactMeshShape);
+
+    // The triangle meshes are owned by Base::triangleMeshes, but each of them
+    // is used by a single shape, so they are counted here.
+    const auto *mesh = dynamic_cast<const btTriangleIndexVertexArray *>(
+        gimpact.getMeshInterface());
+    if (mesh)
+    {
+      const auto &parts = mesh->getIndexedMeshArray();
+      for (int i = 0; i < parts.size(); ++i)
+      {
+        size += static_cast<std::size_t>(
+            parts[i].m_numVertices * parts[i].m_vertexStride +
+            parts[i].m_numTriangles * parts[i].m_triangleIndexStride);
+      }
+    }
+
+    for (int i = 0; i < gimpact.getMeshPartCount(); ++i)
+    {
+      const btGImpactMeshShapePart *part = gimpact.getMeshPart(i);
+      size += sizeof(btGImpactMeshShapePart) +
+          static_cast<std::size_t>(part->getBoxSet()->getNodeCount()) *
+          sizeof(BT_QUANTIZED_BVH_NODE);
+    }
+    return size;
+  }
+
+  // Primitive shapes only hold a few parameters
+  return sizeof(btConvexInternalShape);
+}
+}  // namespace
+
 /////////////////////////////////////////////////
 void WorldFeatures::SetWorldGravity(
     const Identity &_id, const LinearVectorType &_gravity)
@@ -52,6 +126,157 @@ WorldFeatures::LinearVectorType WorldFeatures::GetWorldGravity(
     return WorldFeatures::LinearVectorType(0, 0, 0);
   }
 }
+
+/////////////////////////////////////////////////
+WorldMemoryUsage WorldFeatures::GetWorldMemoryUsage(const Identity &_id) const
+{
+  WorldMemoryUsage usage;
+  const auto *worldInfo = this->ReferenceInterface<WorldInfo>(_id);
+  if (!worldInfo)
+    return usage;
+
+  usage.entityBookkeeping += HashMapEntrySize<decltype(this->worlds)>() +
+      SharedInfoSize<WorldInfo>() +
+      worldInfo->modelIndexToEntityId.size() *
+      HashMapEntrySize<decltype(worldInfo->modelIndexToEntityId)>() +
+      worldInfo->modelNameToEntityId.size() *
+      HashMapEntrySize<decltype(worldInfo->modelNameToEntityId)>();
+
+  std::unordered_set<const btMultiBody *> bodies;
+  for (const auto &[id, model] : this->models)
+  {
+    if (model->world.id != _id.id)
+      continue;
+
+    usage.entityBookkeeping += HashMapEntrySize<decltype(this->models)>() +
+        SharedInfoSize<ModelInfo>() +
+        (model->linkEntityIds.size() + model->jointEntityIds.size() +
+         model->nestedModelEntityIds.size()) * sizeof(std::size_t) +
+        model->linkNameToEntityId.size() *
+        HashMapEntrySize<decltype(model->linkNameToEntityId)>() +
+        model->jointNameToEntityId.size() *
+        HashMapEntrySize<decltype(model->jointNameToEntityId)>() +
+        model->nestedModelNameToEntityId.size() *
+        HashMapEntrySize<decltype(model->nestedModelNameToEntityId)>();
+
+    // Nested models share the multibody of their parent model
+    if (!model->body || !bodies.insert(model->body.get()).second)
+      continue;
+
+    // Besides its links, a multibody keeps a few scalars and vectors per
+    // degree of freedom and a rotation matrix per link for Featherstone's
+    // algorithm.
+    const auto links = static_cast<std::size_t>(model->body->getNumLinks());
+    const auto dofs = static_cast<std::size_t>(model->body->getNumDofs());
+    usage.articulatedBodies += sizeof(btMultiBody) +
+        links * sizeof(btMultibodyLink) +
+        (links + 1) * (sizeof(btMultiBodyLinkCollider) +
+                       sizeof(btMatrix3x3) + 2 * sizeof(btVector3)) +
+        (6 + dofs) * (2 * sizeof(btScalar) + 2 * sizeof(btVector3));
+  }
+
+  for (const auto &[id, link] : this->links)
+  {
+    const auto *model = this->ReferenceInterface<ModelInfo>(link->model);
+    if (model->world.id != _id.id)
+      continue;
+
+    usage.entityBookkeeping += HashMapEntrySize<decltype(this->links)>() +
+        SharedInfoSize<LinkInfo>() +
+        link->collisionEntityIds.size() * sizeof(std::size_t) +
+        link->collisionNameToEntityId.size() *
+        HashMapEntrySize<decltype(link->collisionNameToEntityId)>();
+    if (link->shape)
+      usage.collisionGeometry += sizeof(btCompoundShape);
+
+    for (const auto collisionID : link->collisionEntityIds)
+    {
+      const auto collisionIt = this->collisions.find(collisionID);
+      if (collisionIt == this->collisions.end())
+        continue;
+
+      usage.entityBookkeeping +=
+          HashMapEntrySize<decltype(this->collisions)>() +
+          SharedInfoSize<CollisionInfo>();
+      if (collisionIt->second->collider)
+      {
+        usage.collisionGeometry +=
+            sizeof(btCompoundShapeChild) +
+            CollisionShapeSize(*collisionIt->second->collider);
+      }
+    }
+  }
+
+  for (const auto &[id, joint] : this->joints)
+  {
+    const auto *model = this->ReferenceInterface<ModelInfo>(joint->model);
+    if (!model || model->world.id != _id.id)
+      continue;
+
+    usage.entityBookkeeping += HashMapEntrySize<decltype(this->joints)>() +
+        SharedInfoSize<JointInfo>();
+  }
+
+  // The manifolds and overlapping pairs are kept from one step to the next,
+  // and the multibody constraints include joint limits, motors and the
+  // constraints between models.
+  const auto &world = *worldInfo->world;
+  usage.contactCaches +=
+      static_cast<std::size_t>(world.getDispatcher()->getNumManifolds()) *
+      sizeof(btPersistentManifold) +
+      static_cast<std::size_t>(world.getBroadphase()->getOverlappingPairCache()
+          ->getNumOverlappingPairs()) * sizeof(btBroadphasePair) +
+      static_cast<std::size_t>(world.getNumMultiBodyConstraints()) *
+      sizeof(btMultiBodyConstraint);
+
+  return usage;
+}
+
+/////////////////////////////////////////////////
+bool WorldFeatures::SetWorldSolverIterations(const Identity &_id,
+    const SolverIterationParameters &_parameters)
+{
+  auto *worldInfo = this->ReferenceInterface<WorldInfo>(_id);
+  if (!worldInfo)
+    return false;
+
+  if (!(_parameters.residualTolerance >= 0.0) ||
+      !std::isfinite(_parameters.residualTolerance) ||
+      _parameters.maxIterations == 0u ||
+      _parameters.minIterations > _parameters.maxIterations)
+  {
+    gzerr << "Ignoring solver iteration parameters with an invalid residual "
+          << "tolerance or iteration range.\n";
+    return false;
+  }
+
+  // Bullet compares the largest squared change of an impulse
+  auto &solverInfo = worldInfo->world->getSolverInfo();
+  solverInfo.m_numIterations = static_cast<int>(_parameters.maxIterations);
+  solverInfo.m_leastSquaresResidualThreshold = static_cast<btScalar>(
+      _parameters.residualTolerance * _parameters.residualTolerance);
+  worldInfo->solver->minIterations = _parameters.minIterations;
+  return true;
+}
+
+/////////////////////////////////////////////////
+SolverIterationParameters WorldFeatures::GetWorldSolverIterations(
+    const Identity &_id) const
+{
+  SolverIterationParameters parameters;
+  const auto *worldInfo = this->ReferenceInterface<WorldInfo>(_id);
+  if (!worldInfo)
+    return parameters;
+
+  const auto &solverInfo = worldInfo->world->getSolverInfo();
+  parameters.residualTolerance = std::sqrt(
+      static_cast<double>(solverInfo.m_leastSquaresResidualThreshold));
+  parameters.minIterations = worldInfo->solver->minIterations;
+  parameters.maxIterations =
+      static_cast<std::size_t>(solverInfo.m_numIterations);
+  return parameters;
+}
+
 }
 }
 }
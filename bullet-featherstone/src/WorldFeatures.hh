@@ -29,7 +29,9 @@ namespace physics {
 namespace bullet_featherstone {
 
 struct WorldFeatureList : FeatureList<
-  Gravity
+  GetWorldMemoryUsage,
+  Gravity,
+  SolverIterations
 > { };
 
 class WorldFeatures :
@@ -42,6 +44,18 @@ class WorldFeatures :
 
   // Documentation inherited
   public: LinearVectorType GetWorldGravity(const Identity &_id) const override;
+
+  // Documentation inherited
+  public: WorldMemoryUsage GetWorldMemoryUsage(const Identity &_id)
+      const override;
+
+  // Documentation inherited
+  public: bool SetWorldSolverIterations(const Identity &_id,
+      const SolverIterationParameters &_parameters) override;
+
+  // Documentation inherited
+  public: SolverIterationParameters GetWorldSolverIterations(
+      const Identity &_id) const override;
 };
 
 }
@@ -36,6 +36,7 @@ namespace physics {
 namespace bullet_featherstone {
 
 struct BulletFeatures : FeatureList <
+  EngineMemoryResourceFeature,
   EntityManagementFeatureList,
   SimulationFeatureList,
   FreeGroupFeatureList,
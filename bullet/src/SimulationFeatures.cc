@@ -69,8 +69,6 @@ void SimulationFeatures::Write(ChangedWorldPoses &_changedPoses) const
   _changedPoses.entries.clear();
   _changedPoses.entries.reserve(this->links.size());
 
-  std::unordered_map<std::size_t, math::Pose3d> newPoses;
-
   for (const auto &[id, info] : this->links)
   {
     // make sure the link exists
@@ -87,17 +85,23 @@ void SimulationFeatures::Write(ChangedWorldPoses &_changedPoses) const
           !iter->second.Rot().Equal(wp.pose.Rot(), 1e-6))
       {
         _changedPoses.entries.push_back(wp);
-        newPoses[id] = wp.pose;
+        this->prevLinkPoses[id] = wp.pose;
       }
-      else
-        newPoses[id] = iter->second;
     }
   }
 
-  // Save the new poses so that they can be used to check for updates in the
-  // next iteration. Re-setting this->prevLinkPoses with the contents of
-  // newPoses ensures that we aren't caching data for links that were removed
-  this->prevLinkPoses = std::move(newPoses);
+  // The poses are updated in place so that they can be used to check for
+  // updates in the next iteration. Drop the links that were removed so that
+  // we aren't caching data for them.
+  for (auto iter = this->prevLinkPoses.begin();
+       iter != this->prevLinkPoses.end();)
+  {
+    const auto linkIt = this->links.find(iter->first);
+    if (linkIt != this->links.end() && linkIt->second)
+      ++iter;
+    else
+      iter = this->prevLinkPoses.erase(iter);
+  }
 }
 
 }  // namespace bullet
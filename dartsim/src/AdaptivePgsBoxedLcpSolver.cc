@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "AdaptivePgsBoxedLcpSolver.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Row stride of the A matrices of DART's boxed LCP solvers, which
+/// pad their rows like ODE does
+int RowStride(const int _n)
+{
+  return _n > 1 ? (((_n - 1) | 3) + 1) : _n;
+}
+}
+
+/////////////////////////////////////////////////
+AdaptivePgsBoxedLcpSolver::AdaptivePgsBoxedLcpSolver(
+    std::shared_ptr<SolverIterationState> _state)
+  : state(std::move(_state))
+{
+}
+
+/////////////////////////////////////////////////
+bool AdaptivePgsBoxedLcpSolver::solve(
+    const int _n,
+    double *_A,
+    double *_x,
+    double *_b,
+    const int _nub,
+    double *_lo,
+    double *_hi,
+    int *_findex,
+    const bool _earlyTermination)
+{
+  const int stride = RowStride(_n);
+  const SolverIterationParameters &parameters = this->state->parameters;
+
+  // Diagonal entries below the epsilon of the options are treated as zero,
+  // like DART's PGS solver does
+  const double epsilon = this->getOption().mEpsilonForDivision;
+
+  this->rows.clear();
+  this->inverseDiagonal.resize(static_cast<std::size_t>(_n));
+  for (int i = 0; i < _n; ++i)
+  {
+    const double diagonal = _A[stride * i + i];
+    if (diagonal < epsilon)
+    {
+      _x[i] = 0.0;
+      continue;
+    }
+    this->rows.push_back(i);
+    this->inverseDiagonal[i] = 1.0 / diagonal;
+  }
+
+  std::size_t iterations = 0;
+  double residual = 0.0;
+  while (iterations < parameters.maxIterations)
+  {
+    residual = 0.0;
+    for (const int i : this->rows)
+    {
+      const double *row = _A + stride * i;
+      double newX = _b[i];
+      for (int j = 0; j < _n; ++j)
+        newX -= row[j] * _x[j];
+      newX = _x[i] + newX * this->inverseDiagonal[i];
+
+      if (i >= _nub)
+      {
+        double lo = _lo[i];
+        double hi = _hi[i];
+        if (_findex[i] >= 0)
+        {
+          // Friction is bounded by the impulse of its normal row
+          hi = std::abs(_hi[i] * _x[_findex[i]]);
+          lo = -hi;
+        }
+        newX = std::min(std::max(newX, lo), hi);
+      }
+
+      residual = std::max(residual, std::abs(newX - _x[i]));
+      _x[i] = newX;
+    }
+    ++iterations;
+
+    // With early termination, the constraint solver falls back to its
+    // secondary solver as soon as this one diverges
+    if (_earlyTermination && !std::isfinite(residual))
+      break;
+
+    if (iterations >= parameters.minIterations &&
+        residual < parameters.residualTolerance)
+    {
+      break;
+    }
+  }
+
+  SolverStatistics &statistics = this->state->statistics;
+  ++statistics.solves;
+  statistics.iterations = std::max(statistics.iterations, iterations);
+  statistics.residual = std::max(statistics.residual, residual);
+
+  return std::isfinite(residual);
+}
+
+}
+}
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_DARTSIM_SRC_ADAPTIVEPGSBOXEDLCPSOLVER_HH_
+#define GZ_PHYSICS_DARTSIM_SRC_ADAPTIVEPGSBOXEDLCPSOLVER_HH_
+
+#include <memory>
+#include <vector>
+
+#include <dart/constraint/PgsBoxedLcpSolver.hpp>
+
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/World.hh>
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+/// \brief Iteration parameters of the solver of a world, and the statistics
+/// of the solves of the current step
+struct SolverIterationState
+{
+  /// \brief Iteration parameters. The defaults match the iteration budget
+  /// of DART's PGS solver.
+  SolverIterationParameters parameters{1e-6, 1u, 30u};
+
+  /// \brief Statistics of the current step
+  SolverStatistics statistics;
+};
+
+/// \brief A projected Gauss-Seidel solver that stops iterating as soon as
+/// the largest change of an impulse during an iteration is below the
+/// residual tolerance of its world, and that reports its iterations.
+///
+/// It derives from DART's PGS solver, so that worlds keep reporting the same
+/// solver type. Like DART's PGS solver, it starts from the impulses that it
+/// is given, which makes it benefit from warm starting. The iteration
+/// parameters of the world replace the iteration count and the stopping
+/// tolerances of the options of DART's solver, while the epsilon for division
+/// of the options is honoured. Worlds only use it once their iteration
+/// parameters are set.
+///
+/// It gives up as soon as an iteration diverges when the constraint solver
+/// allows early termination, so that the secondary solver takes over.
+class AdaptivePgsBoxedLcpSolver : public dart::constraint::PgsBoxedLcpSolver
+{
+  /// \brief Constructor
+  /// \param[in] _state Iteration parameters and statistics of the world
+  public: explicit AdaptivePgsBoxedLcpSolver(
+      std::shared_ptr<SolverIterationState> _state);
+
+  // Documentation inherited
+  public: bool solve(
+      int _n,
+      double *_A,
+      double *_x,
+      double *_b,
+      int _nub,
+      double *_lo,
+      double *_hi,
+      int *_findex,
+      bool _earlyTermination) override;
+
+  /// \brief Iteration parameters and statistics of the world
+  private: std::shared_ptr<SolverIterationState> state;
+
+  /// \brief Rows that take part in the iterations
+  private: std::vector<int> rows;
+
+  /// \brief Inverse of the diagonal of A, by row
+  private: std::vector<double> inverseDiagonal;
+};
+
+}
+}
+}
+
+#endif
@@ -18,6 +18,8 @@
 #ifndef GZ_PHYSICS_DARTSIM_BASE_HH_
 #define GZ_PHYSICS_DARTSIM_BASE_HH_
 
+#include <dart/collision/CollisionDetector.hpp>
+#include <dart/collision/CollisionGroup.hpp>
 #include <dart/constraint/ConstraintSolver.hpp>
 #include <dart/constraint/WeldJointConstraint.hpp>
 #include <dart/dynamics/BodyNode.hpp>
@@ -27,6 +29,7 @@
 #include <dart/simulation/World.hpp>
 
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -37,10 +40,17 @@
 #include <gz/common/Console.hh>
 #include <gz/math/eigen3/Conversions.hh>
 #include <gz/math/Inertial.hh>
+#include <gz/physics/ContinuousCollision.hh>
+#include <gz/physics/EngineMemoryResource.hh>
 #include <gz/physics/Implements.hh>
+#include <gz/physics/LevelOfDetail.hh>
+#include <gz/physics/Sleep.hh>
 
 #include <sdf/Types.hh>
 
+#include "AdaptivePgsBoxedLcpSolver.hh"
+#include "ContactWarmStart.hh"
+
 #if DART_VERSION_AT_LEAST(6, 13, 0)
 // The BodyNode::getShapeNodes method was deprecated in dart 6.13.0
 // in favor of an iterator approach with BodyNode::eachShapeNode
@@ -97,6 +107,100 @@ struct ModelInfo
   std::vector<std::shared_ptr<LinkInfo>> links {};
   std::vector<std::shared_ptr<JointInfo>> joints {};
   std::vector<std::size_t> nestedModels = {};
+
+  /// \brief Constraint that enforces the joint coupling of this model, if any
+  dart::constraint::ConstraintBasePtr jointCoupling;
+
+  /// \brief Whether the skeleton of this model was put to sleep, see
+  /// SleepFeature
+  bool sleeping = false;
+
+  /// \brief Time in seconds that the skeleton of this model has been at rest
+  double restTime = 0.0;
+
+  /// \brief Whether the skeleton of this model was demoted to a kinematic
+  /// proxy, see LevelOfDetailFeature
+  bool proxy = false;
+
+  /// \brief Whether this model is a focus of the level of detail of its
+  /// world
+  bool levelOfDetailFocus = false;
+
+  /// \brief Time in seconds that this model has been idle outside the
+  /// promotion distance of the focus models
+  double idleTime = 0.0;
+
+  /// \brief Velocities of the skeleton when it was demoted, restored when it
+  /// is promoted
+  Eigen::VectorXd proxyVelocities;
+};
+
+/// \brief Sleep state of a world, see SleepFeature
+struct WorldSleepInfo
+{
+  SleepParameters parameters;
+
+  /// \brief Collision group of the sleeping skeletons. It is created from
+  /// the collision detector of the world when the first skeleton goes to
+  /// sleep.
+  dart::collision::CollisionGroupPtr sleepingGroup;
+
+  /// \brief Number of sleeping models
+  std::size_t sleepingCount = 0;
+};
+
+/// \brief Level of detail state of a world, see LevelOfDetailFeature
+struct WorldLevelOfDetailInfo
+{
+  LevelOfDetailParameters parameters;
+
+  /// \brief Collision group of the kinematic proxies. It is created from the
+  /// collision detector of the world when the first model is demoted.
+  dart::collision::CollisionGroupPtr proxyGroup;
+
+  /// \brief Number of kinematic proxies
+  std::size_t proxyCount = 0;
+};
+
+/// \brief FreeGroups declared with SetWorldFreeGroupBatch. The root
+/// BodyNodes of all groups are stored contiguously, so setting the state of a
+/// batch does not need to look up any entities.
+struct FreeGroupBatch
+{
+  struct Group
+  {
+    /// \brief Canonical link of the group
+    dart::dynamics::BodyNodePtr link;
+
+    /// \brief Range of the root BodyNodes of this group in roots
+    std::size_t rootsBegin;
+    std::size_t rootsEnd;
+
+    /// \brief End of the roots of the group's own skeleton. Only these are
+    /// moved by the velocity setters, while the pose setter also moves the
+    /// roots of nested models up to rootsEnd.
+    std::size_t velocityRootsEnd;
+  };
+
+  std::vector<Group> groups;
+
+  /// \brief Root BodyNodes of all groups. Each one has a FreeJoint parent.
+  std::vector<dart::dynamics::BodyNodePtr> roots;
+};
+
+/// \brief Continuous collision state of a link, see
+/// ContinuousCollisionFeature
+struct ContinuousCollisionInfo
+{
+  ContinuousCollisionParameters parameters;
+
+  /// \brief Collision group of the shapes of the link. It is created from
+  /// the collision detector of its world when the link is first swept.
+  dart::collision::CollisionGroupPtr group;
+
+  /// \brief Whether a warning was printed because the motion of the link
+  /// needed more samples than the sweep collides
+  bool warnedSampleCap = false;
 };
 
 struct ShapeInfo
@@ -119,13 +223,26 @@ struct ShapeInfo
 template <typename Value1, typename Key2 = Value1>
 struct EntityStorage
 {
+  /// \brief Constructor
+  /// \param[in] _memoryResource Memory resource of the maps
+  explicit EntityStorage(std::pmr::memory_resource *_memoryResource =
+                             std::pmr::get_default_resource())
+    : idToObject(_memoryResource),
+      objectToID(_memoryResource),
+      indexInContainerToID(_memoryResource),
+      idToIndexInContainer(_memoryResource),
+      idToContainerID(_memoryResource)
+  {
+  }
+
   /// \brief Map from an entity ID to its corresponding object
-  std::unordered_map<std::size_t, Value1> idToObject;
+  std::pmr::unordered_map<std::size_t, Value1> idToObject;
 
   /// \brief Map from an object pointer (or other unique key) to its entity ID
-  std::unordered_map<Key2, std::size_t> objectToID;
+  std::pmr::unordered_map<Key2, std::size_t> objectToID;
 
-  using IndexMap = std::unordered_map<std::size_t, std::vector<std::size_t>>;
+  using IndexMap =
+      std::pmr::unordered_map<std::size_t, std::vector<std::size_t>>;
   /// \brief The key represents the parent ID. The value represents a vector of
   /// the objects' IDs. The key of the vector is the object's index within its
   /// container. This is used by World and Model objects, which don't know their
@@ -141,10 +258,10 @@ struct EntityStorage
   IndexMap indexInContainerToID;
 
   /// \brief Map from an entity ID to its index within its container
-  std::unordered_map<std::size_t, std::size_t> idToIndexInContainer;
+  std::pmr::unordered_map<std::size_t, std::size_t> idToIndexInContainer;
 
   /// \brief Map from an entity ID to the ID of its container
-  std::unordered_map<std::size_t, std::size_t> idToContainerID;
+  std::pmr::unordered_map<std::size_t, std::size_t> idToContainerID;
 
   Value1 &operator[](const std::size_t _id)
   {
@@ -258,7 +375,8 @@ struct EntityStorage
   }
 };
 
-class Base : public Implements3d<FeatureList<Feature>>
+class Base : public Implements3d<
+    FeatureList<Feature, EngineMemoryResourceFeature>>
 {
   public: using DartWorld = dart::simulation::World;
   public: using DartWorldPtr = dart::simulation::WorldPtr;
@@ -278,6 +396,9 @@ class Base : public Implements3d<FeatureList<Feature>>
 
   public: inline Identity InitiateEngine(std::size_t /*_engineID*/) override
   {
+    // The memory resource can only be chosen before the engine is used
+    this->memoryResource.MarkInUse();
+
     this->GetNextEntity();
 
     // Create a 0th entry in this map
@@ -288,6 +409,18 @@ class Base : public Implements3d<FeatureList<Feature>>
     return this->GenerateIdentity(0);
   }
 
+  public: inline Identity InitiateEngineWithMemoryResource(
+      std::size_t _engineID,
+      std::pmr::memory_resource &_memoryResource) override
+  {
+    if (!this->memoryResource.SetUpstream(&_memoryResource))
+    {
+      gzerr << "Unable to use the requested memory resource: the engine "
+            << "was already initiated with another resource.\n";
+    }
+    return this->InitiateEngine(_engineID);
+  }
+
   public: inline std::size_t GetNextEntity()
   {
     return entityCount++;
@@ -305,7 +438,7 @@ class Base : public Implements3d<FeatureList<Feature>>
     this->frames[id] = dart::dynamics::Frame::World();
     auto model = dart::dynamics::Skeleton::create("");
 
-    auto modelInfo = std::make_shared<ModelInfo>();
+    auto modelInfo = this->memoryResource.MakeShared<ModelInfo>();
     modelInfo->model = model;
     modelInfo->localName = _name;
     this->modelProxiesToWorld.AddEntity(id, modelInfo, _world, 0);
@@ -317,7 +450,7 @@ class Base : public Implements3d<FeatureList<Feature>>
       const ModelInfo &_info, const std::size_t _worldID)
   {
     const std::size_t id = this->GetNextEntity();
-    auto entry = std::make_shared<ModelInfo>(_info);
+    auto entry = this->memoryResource.MakeShared<ModelInfo>(_info);
 
     const dart::simulation::WorldPtr &world = worlds[_worldID];
     world->addSkeleton(entry->model);
@@ -337,7 +470,7 @@ class Base : public Implements3d<FeatureList<Feature>>
               const std::size_t _worldID)
   {
     const std::size_t id = this->GetNextEntity();
-    auto entry = std::make_shared<ModelInfo>(_info);
+    auto entry = this->memoryResource.MakeShared<ModelInfo>(_info);
 
     const dart::simulation::WorldPtr &world = worlds[_worldID];
     world->addSkeleton(entry->model);
@@ -355,7 +488,7 @@ class Base : public Implements3d<FeatureList<Feature>>
         std::optional<math::Inertiald> _inertial = std::nullopt)
   {
     const std::size_t id = this->GetNextEntity();
-    auto linkInfo = std::make_shared<LinkInfo>();
+    auto linkInfo = this->memoryResource.MakeShared<LinkInfo>();
     linkInfo->link = _bn;
     // The name of the BodyNode during creation is assumed to be the
     // Gazebo-specified name.
@@ -490,7 +623,7 @@ class Base : public Implements3d<FeatureList<Feature>>
       const std::string &_fullName, std::size_t _modelID)
   {
     const std::size_t id = this->GetNextEntity();
-    auto jointInfo = std::make_shared<JointInfo>();
+    auto jointInfo = this->memoryResource.MakeShared<JointInfo>();
     jointInfo->joint = _joint;
     this->joints.AddEntity(id, jointInfo, _joint, _modelID);
 
@@ -511,7 +644,8 @@ class Base : public Implements3d<FeatureList<Feature>>
       const ShapeInfo &_info)
   {
     const std::size_t id = this->GetNextEntity();
-    this->shapes.idToObject[id] = std::make_shared<ShapeInfo>(_info);
+    this->shapes.idToObject[id] =
+        this->memoryResource.MakeShared<ShapeInfo>(_info);
     this->shapes.objectToID[_info.node] = id;
     this->frames[id] = _info.node.get();
 
@@ -524,12 +658,21 @@ class Base : public Implements3d<FeatureList<Feature>>
     const auto &world = this->worlds.at(_worldID);
     auto modelInfo = this->models.at(_modelID);
     auto skel = modelInfo->model;
+    this->WakeModel(_worldID, *modelInfo);
+    this->PromoteModel(_worldID, *modelInfo);
     // Remove the contents of the skeleton from local entity storage containers
     for (auto &nestedModel : modelInfo->nestedModels)
     {
       this->RemoveModelImpl(_worldID, nestedModel);
     }
     modelInfo->nestedModels.clear();
+    this->RemoveFromFreeGroupBatch(_worldID, skel.get());
+
+    if (modelInfo->jointCoupling)
+    {
+      world->getConstraintSolver()->removeConstraint(modelInfo->jointCoupling);
+      modelInfo->jointCoupling.reset();
+    }
 
     for (auto &jt : skel->getJoints())
     {
@@ -572,6 +715,49 @@ class Base : public Implements3d<FeatureList<Feature>>
     return true;
   }
 
+  /// \brief Drop the groups and roots of a skeleton from the free group
+  /// batch of its world, so that the batch does not keep a removed model
+  /// alive.
+  /// \param[in] _worldID ID of the world of the skeleton
+  /// \param[in] _skel Skeleton that is being removed
+  public: void RemoveFromFreeGroupBatch(
+              const std::size_t _worldID,
+              const dart::dynamics::Skeleton *_skel)
+  {
+    auto batchIt = this->freeGroupBatches.find(_worldID);
+    if (batchIt == this->freeGroupBatches.end())
+      return;
+
+    const FreeGroupBatch &batch = batchIt->second;
+    FreeGroupBatch pruned;
+    pruned.groups.reserve(batch.groups.size());
+    pruned.roots.reserve(batch.roots.size());
+    for (const FreeGroupBatch::Group &group : batch.groups)
+    {
+      if (group.link->getSkeleton().get() == _skel)
+        continue;
+
+      const auto keepRoots = [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t r = _begin; r < _end; ++r)
+        {
+          if (batch.roots[r]->getSkeleton().get() != _skel)
+            pruned.roots.push_back(batch.roots[r]);
+        }
+      };
+
+      FreeGroupBatch::Group entry;
+      entry.link = group.link;
+      entry.rootsBegin = pruned.roots.size();
+      keepRoots(group.rootsBegin, group.velocityRootsEnd);
+      entry.velocityRootsEnd = pruned.roots.size();
+      keepRoots(group.velocityRootsEnd, group.rootsEnd);
+      entry.rootsEnd = pruned.roots.size();
+      pruned.groups.push_back(std::move(entry));
+    }
+    batchIt->second = std::move(pruned);
+  }
+
   public: inline std::size_t GetWorldOfModelImpl(
               const std::size_t &_modelID) const
   {
@@ -644,6 +830,292 @@ class Base : public Implements3d<FeatureList<Feature>>
     }
   }
 
+  /// \brief Check whether the skeleton of a model can go to sleep. Models
+  /// that are tied to others by constraints stay awake.
+  /// \param[in] _modelInfo Model to check
+  /// \return True if the model can go to sleep
+  public: static bool CanSleep(const ModelInfo &_modelInfo)
+  {
+    if (!_modelInfo.model || !_modelInfo.model->isMobile() ||
+        _modelInfo.model->getNumBodyNodes() == 0 || _modelInfo.jointCoupling)
+    {
+      return false;
+    }
+
+    for (const auto &link : _modelInfo.links)
+    {
+      if (!link->weldedNodes.empty())
+        return false;
+    }
+    return true;
+  }
+
+  /// \brief Put the skeleton of a model to sleep. The skeleton is made
+  /// immobile, and it is moved from the collision group of the constraint
+  /// solver to the sleeping collision group of its world.
+  /// \param[in] _worldID World of the model
+  /// \param[in] _modelInfo Model to put to sleep
+  /// \return True if the model is sleeping
+  public: bool SleepModel(std::size_t _worldID, ModelInfo &_modelInfo)
+  {
+    if (_modelInfo.sleeping)
+      return true;
+    if (!CanSleep(_modelInfo))
+      return false;
+
+    const auto &world = this->worlds.at(_worldID);
+    auto *solver = world->getConstraintSolver();
+    WorldSleepInfo &sleep = this->worldSleep[_worldID];
+    if (!sleep.sleepingGroup)
+    {
+      sleep.sleepingGroup =
+          solver->getCollisionDetector()->createCollisionGroupAsSharedPtr();
+    }
+
+    const DartSkeletonPtr &skel = _modelInfo.model;
+    skel->resetVelocities();
+    skel->resetAccelerations();
+    skel->setMobile(false);
+    solver->removeSkeleton(skel);
+    sleep.sleepingGroup->subscribeTo(skel);
+
+    _modelInfo.sleeping = true;
+    _modelInfo.restTime = 0.0;
+    ++sleep.sleepingCount;
+    ++this->sleepingModelCount;
+    return true;
+  }
+
+  /// \brief Wake the skeleton of a model up if it is sleeping.
+  /// \param[in] _worldID World of the model
+  /// \param[in] _modelInfo Model to wake up
+  public: void WakeModel(std::size_t _worldID, ModelInfo &_modelInfo)
+  {
+    if (!_modelInfo.sleeping)
+      return;
+
+    const auto &world = this->worlds.at(_worldID);
+    WorldSleepInfo &sleep = this->worldSleep[_worldID];
+    const DartSkeletonPtr &skel = _modelInfo.model;
+    sleep.sleepingGroup->unsubscribeFrom(skel.get());
+    skel->setMobile(true);
+    world->getConstraintSolver()->addSkeleton(skel);
+
+    _modelInfo.sleeping = false;
+    _modelInfo.restTime = 0.0;
+    --sleep.sleepingCount;
+    --this->sleepingModelCount;
+  }
+
+  /// \brief Wake the model of a skeleton up if it is sleeping. Features that
+  /// write to the state of a skeleton or apply forces to it call this first.
+  /// \param[in] _skel Skeleton that is written to
+  public: void WakeSkeleton(const DartSkeletonPtr &_skel)
+  {
+    // Awake and static skeletons are told apart without a lookup
+    if (this->sleepingModelCount == 0 || !_skel || _skel->isMobile())
+      return;
+
+    const auto it = this->models.objectToID.find(_skel);
+    if (it == this->models.objectToID.end())
+      return;
+
+    auto &modelInfo = *this->models.idToObject.at(it->second);
+    if (modelInfo.sleeping)
+      this->WakeModel(this->GetWorldOfModelImpl(it->second), modelInfo);
+  }
+
+  /// \brief Wake every sleeping model of a world up.
+  /// \param[in] _worldID World to wake up
+  public: void WakeWorld(std::size_t _worldID)
+  {
+    auto sleepIt = this->worldSleep.find(_worldID);
+    if (sleepIt == this->worldSleep.end())
+      return;
+
+    if (sleepIt->second.sleepingCount > 0)
+    {
+      for (const auto &[id, modelInfo] : this->models.idToObject)
+      {
+        if (modelInfo && modelInfo->sleeping &&
+            this->GetWorldOfModelImpl(id) == _worldID)
+        {
+          this->WakeModel(_worldID, *modelInfo);
+        }
+      }
+    }
+
+    // The group is created again from the collision detector that the world
+    // uses when a model next goes to sleep
+    sleepIt->second.sleepingGroup.reset();
+  }
+
+  /// \brief Demote the skeleton of a model to a kinematic proxy. The
+  /// skeleton is woken up if it is sleeping, its velocities are saved, and
+  /// it is made immobile and moved from the collision group of the
+  /// constraint solver to the proxy collision group of its world.
+  /// \param[in] _worldID World of the model
+  /// \param[in] _modelInfo Model to demote
+  /// \return True if the model is a kinematic proxy
+  public: bool DemoteModel(std::size_t _worldID, ModelInfo &_modelInfo)
+  {
+    if (_modelInfo.proxy)
+      return true;
+
+    // Sleeping models are immobile, so they are checked once awake
+    this->WakeModel(_worldID, _modelInfo);
+    if (!CanSleep(_modelInfo))
+      return false;
+
+    const auto &world = this->worlds.at(_worldID);
+    auto *solver = world->getConstraintSolver();
+    WorldLevelOfDetailInfo &lod = this->worldLevelOfDetail[_worldID];
+    if (!lod.proxyGroup)
+    {
+      lod.proxyGroup =
+          solver->getCollisionDetector()->createCollisionGroupAsSharedPtr();
+    }
+
+    const DartSkeletonPtr &skel = _modelInfo.model;
+    _modelInfo.proxyVelocities = skel->getVelocities();
+    skel->resetVelocities();
+    skel->resetAccelerations();
+    skel->clearExternalForces();
+    skel->setMobile(false);
+    solver->removeSkeleton(skel);
+    lod.proxyGroup->subscribeTo(skel);
+
+    _modelInfo.proxy = true;
+    _modelInfo.idleTime = 0.0;
+    ++lod.proxyCount;
+    ++this->kinematicProxyCount;
+    return true;
+  }
+
+  /// \brief Promote the skeleton of a model back to full dynamics if it is
+  /// a kinematic proxy, and restore the velocities it was demoted with.
+  /// \param[in] _worldID World of the model
+  /// \param[in] _modelInfo Model to promote
+  public: void PromoteModel(std::size_t _worldID, ModelInfo &_modelInfo)
+  {
+    if (!_modelInfo.proxy)
+      return;
+
+    const auto &world = this->worlds.at(_worldID);
+    WorldLevelOfDetailInfo &lod = this->worldLevelOfDetail[_worldID];
+    const DartSkeletonPtr &skel = _modelInfo.model;
+    lod.proxyGroup->unsubscribeFrom(skel.get());
+
+    // Forces applied while the skeleton was a proxy are discarded
+    skel->clearExternalForces();
+    skel->setMobile(true);
+    if (static_cast<std::size_t>(_modelInfo.proxyVelocities.size()) ==
+        skel->getNumDofs())
+    {
+      skel->setVelocities(_modelInfo.proxyVelocities);
+    }
+    world->getConstraintSolver()->addSkeleton(skel);
+
+    _modelInfo.proxy = false;
+    _modelInfo.idleTime = 0.0;
+    _modelInfo.restTime = 0.0;
+    _modelInfo.proxyVelocities.resize(0);
+    --lod.proxyCount;
+    --this->kinematicProxyCount;
+  }
+
+  /// \brief Promote the model of a skeleton if it is a kinematic proxy.
+  /// Features that tie a skeleton to another one or that write its
+  /// velocities call this first.
+  /// \param[in] _skel Skeleton to promote
+  public: void PromoteSkeleton(const DartSkeletonPtr &_skel)
+  {
+    if (this->kinematicProxyCount == 0 || !_skel || _skel->isMobile())
+      return;
+
+    const auto it = this->models.objectToID.find(_skel);
+    if (it == this->models.objectToID.end())
+      return;
+
+    auto &modelInfo = *this->models.idToObject.at(it->second);
+    if (modelInfo.proxy)
+      this->PromoteModel(this->GetWorldOfModelImpl(it->second), modelInfo);
+  }
+
+  /// \brief Promote every kinematic proxy of a world.
+  /// \param[in] _worldID World to promote
+  public: void PromoteWorld(std::size_t _worldID)
+  {
+    auto lodIt = this->worldLevelOfDetail.find(_worldID);
+    if (lodIt == this->worldLevelOfDetail.end())
+      return;
+
+    if (lodIt->second.proxyCount > 0)
+    {
+      for (const auto &[id, modelInfo] : this->models.idToObject)
+      {
+        if (modelInfo && modelInfo->proxy &&
+            this->GetWorldOfModelImpl(id) == _worldID)
+        {
+          this->PromoteModel(_worldID, *modelInfo);
+        }
+      }
+    }
+
+    // The group is created again from the collision detector that the world
+    // uses when a model is next demoted
+    lodIt->second.proxyGroup.reset();
+  }
+
+  /// \brief Get the contact impulses of a world, creating them if needed.
+  /// \param[in] _worldID ID of the world
+  /// \return Contact impulses of the world
+  public: const std::shared_ptr<ContactImpulseCache> &ContactImpulseCacheOf(
+      const std::size_t _worldID)
+  {
+    auto &cache = this->contactImpulseCaches[_worldID];
+    if (!cache)
+      cache = std::make_shared<ContactImpulseCache>();
+    return cache;
+  }
+
+#ifdef DART_HAS_CONTACT_SURFACE
+  /// \brief Make a contact surface handler that warm starts contacts the
+  /// last handler of the constraint solver of a world, so that it creates
+  /// the contact constraints. The same handler is moved to the end if it was
+  /// added before, so the chain of handlers does not grow.
+  /// \param[in] _worldID ID of the world
+  public: void InstallWarmStartHandler(const std::size_t _worldID)
+  {
+    auto *solver = this->worlds.at(_worldID)->getConstraintSolver();
+    auto &handler = this->warmStartHandlers[_worldID];
+    if (handler)
+    {
+      solver->removeContactSurfaceHandler(handler);
+    }
+    else
+    {
+      handler = std::make_shared<WarmStartContactSurfaceHandler>();
+      handler->impulseCache = this->ContactImpulseCacheOf(_worldID);
+    }
+    solver->addContactSurfaceHandler(handler);
+    handler->impulseCache->handlerInstalled = true;
+  }
+#endif
+
+  /// \brief Get the solver iteration state of a world, creating it if
+  /// needed.
+  /// \param[in] _worldID ID of the world
+  /// \return Solver iteration state of the world
+  public: const std::shared_ptr<SolverIterationState> &SolverIterationStateOf(
+      const std::size_t _worldID)
+  {
+    auto &state = this->solverIterations[_worldID];
+    if (!state)
+      state = std::make_shared<SolverIterationState>();
+    return state;
+  }
+
   public: ModelInfoPtr GetModelInfo(std::size_t _modelID) const
   {
     auto modelProxy = this->modelProxiesToWorld.MaybeAt(_modelID);
@@ -654,27 +1126,82 @@ class Base : public Implements3d<FeatureList<Feature>>
     return this->models.at(_modelID);
   }
 
-  public: EntityStorage<DartWorldPtr, std::string> worlds;
-  public: EntityStorage<ModelInfoPtr, DartConstSkeletonPtr> models;
-  public: EntityStorage<LinkInfoPtr, const DartBodyNode*> links;
-  public: EntityStorage<JointInfoPtr, const DartJoint*> joints;
-  public: EntityStorage<ShapeInfoPtr, const DartShapeNode*> shapes;
-  public: std::unordered_map<std::size_t, dart::dynamics::Frame*> frames;
-  public: EntityStorage<ModelInfoPtr, DartWorldPtr> modelProxiesToWorld;
+  /// \brief Memory resource of the info structs and of the entity maps. It
+  /// is declared first so that it outlives them.
+  public: EngineMemoryResource memoryResource;
+
+  public: EntityStorage<DartWorldPtr, std::string> worlds{
+      &this->memoryResource};
+  public: EntityStorage<ModelInfoPtr, DartConstSkeletonPtr> models{
+      &this->memoryResource};
+  public: EntityStorage<LinkInfoPtr, const DartBodyNode*> links{
+      &this->memoryResource};
+  public: EntityStorage<JointInfoPtr, const DartJoint*> joints{
+      &this->memoryResource};
+  public: EntityStorage<ShapeInfoPtr, const DartShapeNode*> shapes{
+      &this->memoryResource};
+  public: std::pmr::unordered_map<std::size_t, dart::dynamics::Frame*> frames{
+      &this->memoryResource};
+  public: EntityStorage<ModelInfoPtr, DartWorldPtr> modelProxiesToWorld{
+      &this->memoryResource};
 
   /// \brief Map from the fully qualified link name (including the world name)
   /// to the BodyNode object. This is useful for keeping track of BodyNodes even
   /// as they move to other skeletons.
-  public: std::unordered_map<std::string, DartBodyNode*> linksByName;
+  public: std::pmr::unordered_map<std::string, DartBodyNode*> linksByName{
+      &this->memoryResource};
 
   /// \brief Map from the fully qualified joint name (including the world name)
   /// to the dart Joint object. This is useful for keeping track of
   /// dart Joints even as they move to other skeletons.
-  public: std::unordered_map<std::string, DartJoint*> jointsByName;
+  public: std::pmr::unordered_map<std::string, DartJoint*> jointsByName{
+      &this->memoryResource};
 
   /// \brief Map from welded body nodes to the LinkInfo for the original link
   /// they are welded to. This is useful when detaching joints.
-  public: std::unordered_map<DartBodyNode*, LinkInfo*> linkByWeldedNode;
+  public: std::pmr::unordered_map<DartBodyNode*, LinkInfo*> linkByWeldedNode{
+      &this->memoryResource};
+
+  /// \brief Sleep state of the worlds, by world ID
+  public: std::pmr::unordered_map<std::size_t, WorldSleepInfo> worldSleep{
+      &this->memoryResource};
+
+  /// \brief Number of sleeping models in all the worlds, so that writes to
+  /// awake worlds skip looking their models up
+  public: std::size_t sleepingModelCount = 0;
+
+  /// \brief Level of detail state of the worlds, by world ID
+  public: std::pmr::unordered_map<std::size_t, WorldLevelOfDetailInfo>
+      worldLevelOfDetail{&this->memoryResource};
+
+  /// \brief Number of kinematic proxies in all the worlds
+  public: std::size_t kinematicProxyCount = 0;
+
+  /// \brief Contact impulses used to warm start the solver, by world ID
+  public: std::pmr::unordered_map<std::size_t,
+      std::shared_ptr<ContactImpulseCache>> contactImpulseCaches{
+      &this->memoryResource};
+
+#ifdef DART_HAS_CONTACT_SURFACE
+  /// \brief Contact surface handlers that only warm start contacts, by world
+  /// ID, see InstallWarmStartHandler
+  public: std::pmr::unordered_map<std::size_t,
+      std::shared_ptr<WarmStartContactSurfaceHandler>> warmStartHandlers{
+      &this->memoryResource};
+#endif
+
+  /// \brief Solver iteration parameters and statistics, by world ID
+  public: std::pmr::unordered_map<std::size_t,
+      std::shared_ptr<SolverIterationState>> solverIterations{
+      &this->memoryResource};
+
+  /// \brief FreeGroups declared for the worlds, by world ID
+  public: std::pmr::unordered_map<std::size_t, FreeGroupBatch>
+      freeGroupBatches{&this->memoryResource};
+
+  /// \brief Links whose motion is swept before each step, by link ID
+  public: std::pmr::unordered_map<std::size_t, ContinuousCollisionInfo>
+      continuousCollisionLinks{&this->memoryResource};
 
   /// \brief A debug function to list the models and their immediate
   /// nested models, links and joints.
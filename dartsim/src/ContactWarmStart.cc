@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ContactWarmStart.hh"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#ifdef DART_HAS_CONTACT_SURFACE
+#include <dart/collision/CollisionObject.hpp>
+#include <dart/collision/Contact.hpp>
+#include <dart/dynamics/ShapeFrame.hpp>
+#endif
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+namespace
+{
+/////////////////////////////////////////////////
+bool ByFrames(const ContactImpulseCache::Entry &_a,
+              const ContactImpulseCache::Entry &_b)
+{
+  const std::less<const void *> less;
+  if (_a.frame1 != _b.frame1)
+    return less(_a.frame1, _b.frame1);
+  return less(_a.frame2, _b.frame2);
+}
+}
+
+/////////////////////////////////////////////////
+void ContactImpulseCache::NextStep()
+{
+  // Both vectors keep their capacity, so that steps with a steady number of
+  // contacts do not allocate
+  std::swap(this->previous, this->current);
+  this->current.clear();
+  std::sort(this->previous.begin(), this->previous.end(), ByFrames);
+  this->warmStartedCount = 0;
+}
+
+/////////////////////////////////////////////////
+const ContactImpulseCache::Entry *ContactImpulseCache::Find(
+    const void *_frame1, const void *_frame2,
+    const Eigen::Vector3d &_localPoint) const
+{
+  Entry key;
+  key.frame1 = _frame1;
+  key.frame2 = _frame2;
+  const auto range = std::equal_range(
+      this->previous.begin(), this->previous.end(), key, ByFrames);
+
+  const Entry *closest = nullptr;
+  double closestDistance2 = this->parameters.matchingDistance *
+      this->parameters.matchingDistance;
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    const double distance2 = (it->localPoint - _localPoint).squaredNorm();
+    if (distance2 <= closestDistance2)
+    {
+      closest = &*it;
+      closestDistance2 = distance2;
+    }
+  }
+  return closest;
+}
+
+/////////////////////////////////////////////////
+void ContactImpulseCache::Add(const Entry &_entry)
+{
+  this->current.push_back(_entry);
+}
+
+/////////////////////////////////////////////////
+std::size_t ContactImpulseCache::MemoryUsage() const
+{
+  return sizeof(*this) +
+      (this->previous.capacity() + this->current.capacity()) * sizeof(Entry);
+}
+
+#ifdef DART_HAS_CONTACT_SURFACE
+/////////////////////////////////////////////////
+WarmStartContactConstraint::WarmStartContactConstraint(
+    dart::collision::Contact &_contact,
+    const double _timeStep,
+    const dart::constraint::ContactSurfaceParams &_params,
+    std::shared_ptr<ContactImpulseCache> _cache)
+  : dart::constraint::ContactConstraint(_contact, _timeStep, _params),
+    cache(std::move(_cache))
+{
+  const auto *shapeFrame1 = _contact.collisionObject1->getShapeFrame();
+  this->frame1 = shapeFrame1;
+  this->frame2 = _contact.collisionObject2->getShapeFrame();
+  this->localPoint = shapeFrame1->getWorldTransform().inverse() *
+      _contact.point;
+}
+
+/////////////////////////////////////////////////
+void WarmStartContactConstraint::getInformation(
+    dart::constraint::ConstraintInfo *_info)
+{
+  // The base class fills the rows of the constraint and zeroes x
+  dart::constraint::ContactConstraint::getInformation(_info);
+
+  const auto *entry =
+      this->cache->Find(this->frame1, this->frame2, this->localPoint);
+  if (!entry || entry->dimension != this->getDimension())
+    return;
+
+  for (std::size_t i = 0; i < entry->dimension; ++i)
+    _info->x[i] = this->cache->parameters.factor * entry->impulse[i];
+  ++this->cache->warmStartedCount;
+}
+
+/////////////////////////////////////////////////
+void WarmStartContactConstraint::applyImpulse(double *_lambda)
+{
+  dart::constraint::ContactConstraint::applyImpulse(_lambda);
+
+  ContactImpulseCache::Entry entry;
+  entry.frame1 = this->frame1;
+  entry.frame2 = this->frame2;
+  entry.localPoint = this->localPoint;
+  entry.dimension = std::min<std::size_t>(this->getDimension(), 3u);
+  entry.impulse.fill(0.0);
+  std::copy(_lambda, _lambda + entry.dimension, entry.impulse.begin());
+  this->cache->Add(entry);
+}
+
+/////////////////////////////////////////////////
+dart::constraint::ContactConstraintPtr
+WarmStartContactSurfaceHandler::createConstraint(
+    dart::collision::Contact &_contact,
+    const size_t _numContactsOnCollisionObject,
+    const double _timeStep) const
+{
+  if (!this->impulseCache || !this->impulseCache->parameters.enabled)
+  {
+    auto constraint = ContactSurfaceHandler::createConstraint(
+        _contact, _numContactsOnCollisionObject, _timeStep);
+    this->ConfigureConstraint(*constraint);
+    return constraint;
+  }
+
+  const auto params =
+      this->createParams(_contact, _numContactsOnCollisionObject);
+  auto constraint = std::make_shared<WarmStartContactConstraint>(
+      _contact, _timeStep, params, this->impulseCache);
+  this->ConfigureConstraint(*constraint);
+  return constraint;
+}
+
+/////////////////////////////////////////////////
+void WarmStartContactSurfaceHandler::ConfigureConstraint(
+    dart::constraint::ContactConstraint &_constraint) const
+{
+  const auto *parent =
+      dynamic_cast<const WarmStartContactSurfaceHandler *>(this->mParent.get());
+  if (parent)
+    parent->ConfigureConstraint(_constraint);
+}
+#endif
+
+}
+}
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_DARTSIM_SRC_CONTACTWARMSTART_HH_
+#define GZ_PHYSICS_DARTSIM_SRC_CONTACTWARMSTART_HH_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include <dart/config.hpp>
+#ifdef DART_HAS_CONTACT_SURFACE
+#include <dart/constraint/ContactConstraint.hpp>
+#include <dart/constraint/ContactSurface.hpp>
+#endif
+
+#include <gz/physics/World.hh>
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+/// \brief Contact impulses of the last two steps of a world, used to warm
+/// start the constraint solver. The impulses of a step are recorded when the
+/// solver applies them, and looked up by the contacts of the next step.
+class ContactImpulseCache
+{
+  /// \brief Impulse of a single contact
+  public: struct Entry
+  {
+    /// \brief First shape frame of the contact
+    const void *frame1;
+
+    /// \brief Second shape frame of the contact
+    const void *frame2;
+
+    /// \brief Contact point in the frame of the first shape
+    Eigen::Vector3d localPoint;
+
+    /// \brief Impulse along the normal and the friction directions
+    std::array<double, 3> impulse;
+
+    /// \brief Number of used entries of impulse
+    std::size_t dimension;
+  };
+
+  /// \brief Start a new step: the impulses recorded during the step that
+  /// just finished become the ones that the new step looks up.
+  public: void NextStep();
+
+  /// \brief Find the impulse of the previous step that matches a contact.
+  /// \param[in] _frame1 First shape frame of the contact
+  /// \param[in] _frame2 Second shape frame of the contact
+  /// \param[in] _localPoint Contact point in the frame of the first shape
+  /// \return The closest contact of the previous step between the same
+  /// shapes, or nullptr if none is within the matching distance
+  public: const Entry *Find(const void *_frame1, const void *_frame2,
+                            const Eigen::Vector3d &_localPoint) const;
+
+  /// \brief Record the impulse that the solver applied to a contact.
+  /// \param[in] _entry Contact and its impulse
+  public: void Add(const Entry &_entry);
+
+  /// \brief Approximate memory used by the cache, in bytes.
+  /// \return Size of the cached impulses
+  public: std::size_t MemoryUsage() const;
+
+  /// \brief Warm starting parameters of the world
+  public: SolverWarmStartParameters parameters;
+
+  /// \brief Number of contacts of the current step that were warm started
+  public: std::size_t warmStartedCount = 0;
+
+  /// \brief Whether a contact surface handler that warm starts contacts was
+  /// added to the constraint solver of the world
+  public: bool handlerInstalled = false;
+
+  /// \brief Impulses of the previous step, sorted by shape frames
+  private: std::vector<Entry> previous;
+
+  /// \brief Impulses of the current step
+  private: std::vector<Entry> current;
+};
+
+#ifdef DART_HAS_CONTACT_SURFACE
+/// \brief A contact constraint whose initial guess is the impulse of the
+/// matching contact of the previous step, and which records the impulse
+/// that it applies for the next step.
+class WarmStartContactConstraint : public dart::constraint::ContactConstraint
+{
+  /// \brief Constructor
+  /// \param[in] _contact Contact of the constraint
+  /// \param[in] _timeStep Time step of the world
+  /// \param[in] _params Contact surface parameters
+  /// \param[in] _cache Contact impulses of the world
+  public: WarmStartContactConstraint(
+      dart::collision::Contact &_contact,
+      double _timeStep,
+      const dart::constraint::ContactSurfaceParams &_params,
+      std::shared_ptr<ContactImpulseCache> _cache);
+
+  // Documentation inherited
+  protected: void getInformation(
+      dart::constraint::ConstraintInfo *_info) override;
+
+  // Documentation inherited
+  protected: void applyImpulse(double *_lambda) override;
+
+  /// \brief Contact impulses of the world
+  private: std::shared_ptr<ContactImpulseCache> cache;
+
+  /// \brief First shape frame of the contact
+  private: const void *frame1;
+
+  /// \brief Second shape frame of the contact
+  private: const void *frame2;
+
+  /// \brief Contact point in the frame of the first shape
+  private: Eigen::Vector3d localPoint;
+};
+
+/// \brief A contact surface handler that creates warm started contact
+/// constraints when warm starting is enabled in its world. The contact
+/// surface handlers of the plugin derive from it, so that whichever of them
+/// was added last to a constraint solver creates the constraints.
+class WarmStartContactSurfaceHandler
+    : public dart::constraint::ContactSurfaceHandler
+{
+  // Documentation inherited
+  public: dart::constraint::ContactConstraintPtr createConstraint(
+      dart::collision::Contact &_contact,
+      size_t _numContactsOnCollisionObject,
+      double _timeStep) const override;
+
+  /// \brief Set the properties of a new contact constraint that are not
+  /// part of the contact surface parameters. By default, the closest parent
+  /// handler of the plugin does it.
+  /// \param[in] _constraint Constraint to configure
+  public: virtual void ConfigureConstraint(
+      dart::constraint::ContactConstraint &_constraint) const;
+
+  /// \brief Contact impulses of the world of the handler
+  public: std::shared_ptr<ContactImpulseCache> impulseCache;
+};
+#endif
+
+}
+}
+}
+
+#endif
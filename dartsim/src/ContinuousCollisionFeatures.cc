@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+
+#include <gz/common/Console.hh>
+
+#include "ContinuousCollisionFeatures.hh"
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+/////////////////////////////////////////////////
+bool ContinuousCollisionFeatures::SetLinkContinuousCollision(
+    const Identity &_linkID,
+    const ContinuousCollisionParameters &_parameters)
+{
+  if (!_parameters.enabled)
+  {
+    this->continuousCollisionLinks.erase(_linkID.id);
+    return true;
+  }
+
+  if (!(_parameters.motionThreshold >= 0.0) ||
+      !std::isfinite(_parameters.motionThreshold) ||
+      !(_parameters.sweptSphereRadius > 0.0) ||
+      !std::isfinite(_parameters.sweptSphereRadius))
+  {
+    gzerr << "Ignoring continuous collision parameters with a negative "
+          << "motion threshold or a swept sphere radius that is not "
+          << "positive.\n";
+    return false;
+  }
+
+  const auto linkInfo = this->links.MaybeAt(_linkID.id);
+  if (!linkInfo)
+    return false;
+
+  // Sleeping skeletons are immobile too, but they can move again
+  DartBodyNode *bn = (*linkInfo)->link.get();
+  const auto skel = bn->getSkeleton();
+  const auto modelIt = this->models.objectToID.find(skel);
+  const bool sleeping = modelIt != this->models.objectToID.end() &&
+      this->models.idToObject.at(modelIt->second)->sleeping;
+  if (!dynamic_cast<const dart::dynamics::FreeJoint *>(bn->getParentJoint()) ||
+      (!skel->isMobile() && !sleeping))
+  {
+    gzerr << "Continuous collision detection is only supported on the "
+          << "canonical link of a free-floating model. Link ["
+          << (*linkInfo)->name << "] is not.\n";
+    return false;
+  }
+
+  this->continuousCollisionLinks[_linkID.id].parameters = _parameters;
+  return true;
+}
+
+/////////////////////////////////////////////////
+ContinuousCollisionParameters
+ContinuousCollisionFeatures::GetLinkContinuousCollision(
+    const Identity &_linkID) const
+{
+  const auto it = this->continuousCollisionLinks.find(_linkID.id);
+  if (it == this->continuousCollisionLinks.end())
+    return ContinuousCollisionParameters();
+  return it->second.parameters;
+}
+
+}
+}
+}
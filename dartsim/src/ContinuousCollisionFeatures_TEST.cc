@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <gz/plugin/Loader.hh>
+#include <gz/physics/RequestEngine.hh>
+
+#include <gz/physics/ContinuousCollision.hh>
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/FrameSemantics.hh>
+#include <gz/physics/FreeGroup.hh>
+#include <gz/physics/GetEntities.hh>
+#include <gz/physics/Sleep.hh>
+#include <gz/physics/sdf/ConstructWorld.hh>
+
+#include <sdf/Root.hh>
+#include <sdf/World.hh>
+
+#include "test/common_test/Worlds.hh"
+
+struct TestFeatureList : gz::physics::FeatureList<
+    gz::physics::ForwardStep,
+    gz::physics::sdf::ConstructSdfWorld,
+    gz::physics::GetEntities,
+    gz::physics::LinkFrameSemantics,
+    gz::physics::FindFreeGroupFeature,
+    gz::physics::SetFreeGroupWorldVelocity,
+    gz::physics::SleepFeature,
+    gz::physics::ContinuousCollisionFeature
+> { };
+
+using namespace gz;
+
+//////////////////////////////////////////////////
+TEST(ContinuousCollisionFeatures, Parameters)
+{
+  gz::plugin::Loader loader;
+  loader.LoadLib(dartsim_plugin_LIB);
+
+  gz::plugin::PluginPtr dartsim =
+      loader.Instantiate("gz::physics::dartsim::Plugin");
+  auto engine = gz::physics::RequestEngine3d<TestFeatureList>::From(dartsim);
+  ASSERT_NE(nullptr, engine);
+
+  sdf::Root root;
+  const sdf::Errors errors = root.Load(common_test::worlds::kThinWallSdf);
+  ASSERT_TRUE(errors.empty()) << errors;
+  auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+  ASSERT_NE(nullptr, world);
+
+  auto link = world->GetModel("ball")->GetLink(0);
+  EXPECT_FALSE(link->GetContinuousCollision().enabled);
+
+  // A swept sphere is required
+  physics::ContinuousCollisionParameters parameters;
+  parameters.enabled = true;
+  EXPECT_FALSE(link->SetContinuousCollision(parameters));
+  EXPECT_FALSE(link->GetContinuousCollision().enabled);
+
+  parameters.motionThreshold = -1.0;
+  parameters.sweptSphereRadius = 0.04;
+  EXPECT_FALSE(link->SetContinuousCollision(parameters));
+
+  parameters.motionThreshold = 0.01;
+  ASSERT_TRUE(link->SetContinuousCollision(parameters));
+  EXPECT_TRUE(link->GetContinuousCollision().enabled);
+  EXPECT_DOUBLE_EQ(0.01, link->GetContinuousCollision().motionThreshold);
+  EXPECT_DOUBLE_EQ(0.04, link->GetContinuousCollision().sweptSphereRadius);
+
+  parameters.enabled = false;
+  EXPECT_TRUE(link->SetContinuousCollision(parameters));
+  EXPECT_FALSE(link->GetContinuousCollision().enabled);
+
+  // Links of static models never move
+  parameters.enabled = true;
+  EXPECT_FALSE(world->GetModel("wall")->GetLink(0)
+      ->SetContinuousCollision(parameters));
+}
+
+//////////////////////////////////////////////////
+/// \brief The thin wall world, where the wall is a box that can sleep
+const std::string kSleepingWallWorld = R"(
+<sdf version="1.9">
+  <world name="sleeping_wall">
+    <gravity>0 0 0</gravity>
+    <model name="wall">
+      <pose>1 0 0 0 0 0</pose>
+      <link name="wall_link">
+        <inertial>
+          <inertia>
+            <ixx>1000</ixx>
+            <iyy>1000</iyy>
+            <izz>1000</izz>
+          </inertia>
+          <mass>1000</mass>
+        </inertial>
+        <collision name="wall_collision">
+          <geometry><box><size>0.02 2 2</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="ball">
+      <link name="ball_link">
+        <inertial>
+          <inertia>
+            <ixx>0.00001</ixx>
+            <iyy>0.00001</iyy>
+            <izz>0.00001</izz>
+          </inertia>
+          <mass>0.01</mass>
+        </inertial>
+        <collision name="ball_collision">
+          <geometry><sphere><radius>0.05</radius></sphere></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+//////////////////////////////////////////////////
+TEST(ContinuousCollisionFeatures, SleepingModelsAreSwept)
+{
+  gz::plugin::Loader loader;
+  loader.LoadLib(dartsim_plugin_LIB);
+
+  gz::plugin::PluginPtr dartsim =
+      loader.Instantiate("gz::physics::dartsim::Plugin");
+  auto engine = gz::physics::RequestEngine3d<TestFeatureList>::From(dartsim);
+  ASSERT_NE(nullptr, engine);
+
+  sdf::Root root;
+  const sdf::Errors errors = root.LoadSdfString(kSleepingWallWorld);
+  ASSERT_TRUE(errors.empty()) << errors;
+  auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+  ASSERT_NE(nullptr, world);
+
+  physics::SleepParameters sleepParameters;
+  sleepParameters.enabled = true;
+  sleepParameters.timeThreshold = 10.0;
+  world->SetSleepParameters(sleepParameters);
+  ASSERT_TRUE(world->GetModel("wall")->SetSleeping(true));
+
+  auto ball = world->GetModel("ball");
+  physics::ContinuousCollisionParameters parameters;
+  parameters.enabled = true;
+  parameters.sweptSphereRadius = 0.04;
+  ASSERT_TRUE(ball->GetLink(0)->SetContinuousCollision(parameters));
+
+  // The ball travels 10 times the thickness of the wall in a step, so it
+  // would pass through the sleeping wall without the sweep
+  auto freeGroup = ball->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  freeGroup->SetWorldLinearVelocity(Eigen::Vector3d(200, 0, 0));
+
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+  for (std::size_t i = 0; i < 50; ++i)
+    world->Step(output, state, input);
+
+  EXPECT_FALSE(world->GetModel("wall")->IsSleeping());
+  EXPECT_GT(1.0,
+      ball->GetLink(0)->FrameDataRelativeToWorld().pose.translation().x());
+}
@@ -17,6 +17,10 @@
 
 #include "FreeGroupFeatures.hh"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <dart/constraint/ConstraintSolver.hpp>
 #include <dart/dynamics/FreeJoint.hpp>
 #include <gz/common/Console.hh>
@@ -156,6 +160,7 @@ void FreeGroupFeatures::SetFreeGroupWorldPose(
   {
     if (nullptr != info.link)
     {
+      this->WakeSkeleton(info.link->getSkeleton());
       static_cast<dart::dynamics::FreeJoint*>(info.link->getParentJoint())
         ->setTransform(_pose);
     }
@@ -167,6 +172,7 @@ void FreeGroupFeatures::SetFreeGroupWorldPose(
     return;
   }
 
+  this->WakeSkeleton(info.link->getSkeleton());
   const Eigen::Isometry3d tfChange =
       _pose * info.link->getWorldTransform().inverse();
 
@@ -200,6 +206,8 @@ void FreeGroupFeatures::SetFreeGroupWorldLinearVelocity(
     const Identity &_groupID, const LinearVelocity &_linearVelocity)
 {
   const FreeGroupInfo &info = GetCanonicalInfo(_groupID);
+  this->WakeSkeleton(info.link->getSkeleton());
+  this->PromoteSkeleton(info.link->getSkeleton());
   if (!info.model)
   {
     static_cast<dart::dynamics::FreeJoint*>(info.link->getParentJoint())
@@ -225,6 +233,8 @@ void FreeGroupFeatures::SetFreeGroupWorldAngularVelocity(
     const Identity &_groupID, const AngularVelocity &_angularVelocity)
 {
   const FreeGroupInfo &info = GetCanonicalInfo(_groupID);
+  this->WakeSkeleton(info.link->getSkeleton());
+  this->PromoteSkeleton(info.link->getSkeleton());
   if (!info.model)
   {
     static_cast<dart::dynamics::FreeJoint*>(info.link->getParentJoint())
@@ -251,6 +261,176 @@ void FreeGroupFeatures::SetFreeGroupWorldAngularVelocity(
   }
 }
 
+/////////////////////////////////////////////////
+void FreeGroupFeatures::CollectFreeGroupRoots(
+    std::size_t _modelID,
+    std::vector<dart::dynamics::BodyNodePtr> &_roots) const
+{
+  const auto &modelInfo = this->models.at(_modelID);
+  const auto &skeleton = modelInfo->model;
+  for (std::size_t i = 0; i < skeleton->getNumTrees(); ++i)
+  {
+    dart::dynamics::BodyNodePtr bn = skeleton->getRootBodyNode(i);
+    if (std::find(_roots.begin(), _roots.end(), bn) == _roots.end())
+      _roots.push_back(bn);
+  }
+
+  // Nested models whose BodyNodes have been moved to another skeleton have no
+  // trees of their own, so they do not add any roots.
+  for (const auto &nestedModel : modelInfo->nestedModels)
+    this->CollectFreeGroupRoots(nestedModel, _roots);
+}
+
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::SetWorldFreeGroupBatch(
+    const Identity &_worldID,
+    const std::vector<BaseFreeGroup3dPtr> &_groups)
+{
+  FreeGroupBatch batch;
+  batch.groups.reserve(_groups.size());
+  for (const auto &group : _groups)
+  {
+    if (!group)
+    {
+      gzerr << "Unable to declare free group batch: invalid free group.\n";
+      return false;
+    }
+
+    const Identity groupID = group->FullIdentity();
+    const FreeGroupInfo &info = this->GetCanonicalInfo(groupID);
+    if (nullptr == info.link)
+    {
+      gzerr << "No link for free group with id [" << groupID.id
+            << "] found. Unable to declare free group batch.\n";
+      return false;
+    }
+
+    const std::size_t modelID =
+        this->models.objectToID.at(info.link->getSkeleton());
+    if (this->GetWorldOfModelImpl(modelID) != _worldID.id)
+    {
+      gzerr << "Unable to declare free group batch: free group ["
+            << groupID.id << "] is not in this world.\n";
+      return false;
+    }
+
+    FreeGroupBatch::Group entry;
+    entry.link = info.link;
+    entry.rootsBegin = batch.roots.size();
+    if (info.model)
+    {
+      // Same as the per-group setters: the velocity setters only move the
+      // trees of the group's own skeleton, while the pose setter also moves
+      // the trees of its nested models.
+      for (std::size_t i = 0; i < info.model->getNumTrees(); ++i)
+        batch.roots.push_back(info.model->getRootBodyNode(i));
+      entry.velocityRootsEnd = batch.roots.size();
+      for (const auto &nestedModel : this->models.at(groupID.id)->nestedModels)
+        this->CollectFreeGroupRoots(nestedModel, batch.roots);
+    }
+    else
+    {
+      batch.roots.push_back(info.link);
+      entry.velocityRootsEnd = batch.roots.size();
+    }
+    entry.rootsEnd = batch.roots.size();
+    batch.groups.push_back(std::move(entry));
+  }
+
+  this->freeGroupBatches[_worldID.id] = std::move(batch);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::SetWorldFreeGroupPoses(
+    const Identity &_worldID,
+    const std::vector<PoseType> &_poses)
+{
+  const auto batchIt = this->freeGroupBatches.find(_worldID.id);
+  const std::size_t numGroups = batchIt == this->freeGroupBatches.end() ?
+      0u : batchIt->second.groups.size();
+  if (_poses.size() != numGroups)
+  {
+    gzerr << "Unable to set free group poses: expected [" << numGroups
+          << "] poses, got [" << _poses.size() << "].\n";
+    return false;
+  }
+  if (0u == numGroups)
+    return true;
+
+  const FreeGroupBatch &batch = batchIt->second;
+  for (std::size_t i = 0; i < numGroups; ++i)
+  {
+    const FreeGroupBatch::Group &group = batch.groups[i];
+    const Eigen::Isometry3d tfChange =
+        _poses[i] * group.link->getWorldTransform().inverse();
+
+    for (std::size_t r = group.rootsBegin; r < group.rootsEnd; ++r)
+    {
+      dart::dynamics::BodyNode *bn = batch.roots[r].get();
+      this->WakeSkeleton(bn->getSkeleton());
+      static_cast<dart::dynamics::FreeJoint*>(bn->getParentJoint())
+          ->setTransform(tfChange * bn->getTransform());
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::SetWorldFreeGroupVelocities(
+    const Identity &_worldID,
+    const std::vector<LinearVelocity> &_linearVelocities,
+    const std::vector<AngularVelocity> &_angularVelocities)
+{
+  const auto batchIt = this->freeGroupBatches.find(_worldID.id);
+  const std::size_t numGroups = batchIt == this->freeGroupBatches.end() ?
+      0u : batchIt->second.groups.size();
+  if (_linearVelocities.size() != numGroups ||
+      _angularVelocities.size() != numGroups)
+  {
+    gzerr << "Unable to set free group velocities: expected [" << numGroups
+          << "] linear and angular velocities, got ["
+          << _linearVelocities.size() << "] and ["
+          << _angularVelocities.size() << "].\n";
+    return false;
+  }
+  if (0u == numGroups)
+    return true;
+
+  const FreeGroupBatch &batch = batchIt->second;
+  for (std::size_t i = 0; i < numGroups; ++i)
+  {
+    const FreeGroupBatch::Group &group = batch.groups[i];
+
+    // Proxies are promoted first, so that the velocities they are promoted
+    // with do not overwrite the new ones
+    this->PromoteSkeleton(group.link->getSkeleton());
+    const Eigen::Vector3d delta_v =
+        _linearVelocities[i] - group.link->getLinearVelocity();
+    const Eigen::Vector3d delta_w =
+        _angularVelocities[i] - group.link->getAngularVelocity();
+    const Eigen::Vector3d origin = group.link->getTransform().translation();
+
+    // Same as SetFreeGroupWorldLinearVelocity followed by
+    // SetFreeGroupWorldAngularVelocity, in a single pass over the roots.
+    for (std::size_t r = group.rootsBegin; r < group.velocityRootsEnd; ++r)
+    {
+      dart::dynamics::BodyNode *bn = batch.roots[r].get();
+      this->WakeSkeleton(bn->getSkeleton());
+      const Eigen::Vector3d offset = bn->getTransform().translation() - origin;
+      const Eigen::Vector3d v = bn->getLinearVelocity();
+      const Eigen::Vector3d w = bn->getAngularVelocity();
+
+      dart::dynamics::FreeJoint *fj =
+          static_cast<dart::dynamics::FreeJoint*>(bn->getParentJoint());
+
+      fj->setLinearVelocity(v + delta_v + delta_w.cross(offset));
+      fj->setAngularVelocity(w + delta_w);
+    }
+  }
+  return true;
+}
+
 }
 }
 }
@@ -18,6 +18,9 @@
 #ifndef GZ_PHYSICS_DARTSIM_SRC_FREEGROUPFEATURES_HH_
 #define GZ_PHYSICS_DARTSIM_SRC_FREEGROUPFEATURES_HH_
 
+#include <unordered_map>
+#include <vector>
+
 #include <gz/physics/FreeGroup.hh>
 
 #include "Base.hh"
@@ -29,7 +32,8 @@ namespace dartsim {
 struct FreeGroupFeatureList : FeatureList<
   FindFreeGroupFeature,
   SetFreeGroupWorldPose,
-  SetFreeGroupWorldVelocity
+  SetFreeGroupWorldVelocity,
+  SetFreeGroupWorldStateBatch
   // Note: FreeGroupFrameSemantics is covered in KinematicsFeatures.hh
 > { };
 
@@ -67,6 +71,26 @@ class FreeGroupFeatures
   void SetFreeGroupWorldAngularVelocity(
       const Identity &_groupID,
       const AngularVelocity &_angularVelocity) override;
+
+  // ----- SetFreeGroupWorldStateBatch -----
+  bool SetWorldFreeGroupBatch(
+      const Identity &_worldID,
+      const std::vector<BaseFreeGroup3dPtr> &_groups) override;
+
+  bool SetWorldFreeGroupPoses(
+      const Identity &_worldID,
+      const std::vector<PoseType> &_poses) override;
+
+  bool SetWorldFreeGroupVelocities(
+      const Identity &_worldID,
+      const std::vector<LinearVelocity> &_linearVelocities,
+      const std::vector<AngularVelocity> &_angularVelocities) override;
+
+  /// \brief Append the root BodyNodes of every tree of a model and its
+  /// nested models to _roots, skipping any that are already present.
+  void CollectFreeGroupRoots(
+      std::size_t _modelID,
+      std::vector<dart::dynamics::BodyNodePtr> &_roots) const;
 };
 
 }
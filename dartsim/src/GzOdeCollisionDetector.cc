@@ -16,7 +16,9 @@
 */
 
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
+#include <vector>
 
 #include <dart/collision/CollisionObject.hpp>
 
@@ -89,12 +91,17 @@ void GzOdeCollisionDetector::LimitCollisionPairMaxContacts(
     std::numeric_limits<std::size_t>::max())
     return;
 
-  auto allContacts = _result->getContacts();
+  // The containers of the previous call are gone
+  this->scratch.Reset();
+
+  const auto &contacts = _result->getContacts();
+  std::pmr::vector<Contact> allContacts(
+      contacts.begin(), contacts.end(), &this->scratch);
   _result->clear();
 
-  std::unordered_map<dart::collision::CollisionObject *,
-      std::unordered_map<dart::collision::CollisionObject *, std::size_t>>
-      contactMap;
+  std::pmr::unordered_map<dart::collision::CollisionObject *,
+      std::pmr::unordered_map<dart::collision::CollisionObject *, std::size_t>>
+      contactMap(&this->scratch);
 
   for (auto &contact : allContacts)
   {
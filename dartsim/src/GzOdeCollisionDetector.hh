@@ -20,6 +20,8 @@
 
 #include <dart/collision/ode/OdeCollisionDetector.hpp>
 
+#include <gz/physics/ScratchArena.hh>
+
 namespace dart {
 namespace collision {
 
@@ -66,6 +68,12 @@ class GzOdeCollisionDetector : public dart::collision::OdeCollisionDetector
   private: std::size_t maxCollisionPairContacts =
       std::numeric_limits<std::size_t>::max();
 
+  /// \brief Memory of the temporary containers of
+  /// LimitCollisionPairMaxContacts. Each world has its own collision
+  /// detector, so this is a per-world arena. It is reset every time the
+  /// contacts are limited, which happens once per step.
+  private: gz::physics::ScratchArena scratch;
+
   private: static Registrar<GzOdeCollisionDetector> mRegistrar;
 };
 
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <dart/dynamics/BodyNode.hpp>
+
+#include "JointCouplingConstraint.hh"
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+/////////////////////////////////////////////////
+JointCouplingConstraint::JointCouplingConstraint(
+    const dart::dynamics::SkeletonPtr &_skeleton,
+    std::vector<Axis> _followers,
+    std::vector<Axis> _leaders,
+    std::vector<Term> _terms,
+    std::vector<double> _offsets)
+  : ConstraintBase(),
+    skeleton(_skeleton),
+    followers(std::move(_followers)),
+    leaders(std::move(_leaders)),
+    offsets(std::move(_offsets))
+{
+  this->offsets.resize(this->followers.size(), 0.0);
+  this->rows.resize(this->followers.size());
+  for (const Term &term : _terms)
+  {
+    this->rows[term.follower].emplace_back(term.leader, term.multiplier);
+  }
+
+  auto addBodyNode = [this](const Axis &_axis)
+  {
+    auto *bn = _axis.joint->getChildBodyNode();
+    if (std::find(this->bodyNodes.begin(), this->bodyNodes.end(), bn) ==
+        this->bodyNodes.end())
+    {
+      this->bodyNodes.push_back(bn);
+    }
+  };
+  for (const Axis &axis : this->followers)
+    addBodyNode(axis);
+  for (const Axis &axis : this->leaders)
+    addBodyNode(axis);
+
+  this->positionError.resize(this->followers.size(), 0.0);
+  this->rowVelocity.resize(this->followers.size(), 0.0);
+  this->oldX.resize(this->followers.size(), 0.0);
+  this->mDim = this->followers.size();
+}
+
+/////////////////////////////////////////////////
+const std::string &JointCouplingConstraint::getStaticType()
+{
+  static const std::string name = "GzJointCouplingConstraint";
+  return name;
+}
+
+#if DART_VERSION_AT_LEAST(6, 10, 0)
+/////////////////////////////////////////////////
+const std::string &JointCouplingConstraint::getType() const
+{
+  return getStaticType();
+}
+#endif
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::SetErrorReductionParameter(double _erp)
+{
+  this->erp = std::clamp(_erp, 0.0, 1.0);
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::update()
+{
+  for (std::size_t i = 0; i < this->followers.size(); ++i)
+  {
+    const Axis &follower = this->followers[i];
+    double position = follower.joint->getPosition(follower.dof);
+    double velocity = follower.joint->getVelocity(follower.dof);
+    for (const auto &[leaderIndex, multiplier] : this->rows[i])
+    {
+      const Axis &leader = this->leaders[leaderIndex];
+      position -= multiplier * leader.joint->getPosition(leader.dof);
+      velocity -= multiplier * leader.joint->getVelocity(leader.dof);
+    }
+    this->positionError[i] = position - this->offsets[i];
+    this->rowVelocity[i] = velocity;
+  }
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::getInformation(
+    dart::constraint::ConstraintInfo *_info)
+{
+  for (std::size_t i = 0; i < this->mDim; ++i)
+  {
+    _info->b[i] = -this->erp * this->positionError[i] * _info->invTimeStep
+        - this->rowVelocity[i];
+    _info->lo[i] = -std::numeric_limits<double>::infinity();
+    _info->hi[i] = std::numeric_limits<double>::infinity();
+    _info->w[i] = 0.0;
+    _info->x[i] = this->oldX[i];
+    _info->findex[i] = -1;
+  }
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::AddRowImpulse(std::size_t _row, double _value)
+{
+  const Axis &follower = this->followers[_row];
+  follower.joint->setConstraintImpulse(follower.dof,
+      follower.joint->getConstraintImpulse(follower.dof) + _value);
+  for (const auto &[leaderIndex, multiplier] : this->rows[_row])
+  {
+    const Axis &leader = this->leaders[leaderIndex];
+    leader.joint->setConstraintImpulse(leader.dof,
+        leader.joint->getConstraintImpulse(leader.dof)
+        - multiplier * _value);
+  }
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::UpdateBiasImpulses()
+{
+  // Each call walks from the body node to the root, recomputing every body
+  // on the way from the (already updated) bias impulses of its children, so
+  // the order in which the body nodes are visited does not matter.
+  for (auto *bn : this->bodyNodes)
+    this->skeleton->updateBiasImpulse(bn);
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::applyUnitImpulse(std::size_t _index)
+{
+  this->skeleton->clearConstraintImpulses();
+  this->AddRowImpulse(_index, 1.0);
+  this->UpdateBiasImpulses();
+  this->skeleton->updateVelocityChange();
+  this->AddRowImpulse(_index, -1.0);
+
+  this->appliedImpulseIndex = _index;
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::getVelocityChange(double *_vel, bool _withCfm)
+{
+  const bool impulseApplied = this->skeleton->isImpulseApplied();
+  for (std::size_t i = 0; i < this->mDim; ++i)
+  {
+    if (!impulseApplied)
+    {
+      _vel[i] = 0.0;
+      continue;
+    }
+
+    const Axis &follower = this->followers[i];
+    double velocityChange = follower.joint->getVelocityChange(follower.dof);
+    for (const auto &[leaderIndex, multiplier] : this->rows[i])
+    {
+      const Axis &leader = this->leaders[leaderIndex];
+      velocityChange -=
+          multiplier * leader.joint->getVelocityChange(leader.dof);
+    }
+    _vel[i] = velocityChange;
+  }
+
+  // Add small values to the diagonal to keep it away from singular, similar
+  // to cfm in ODE.
+  if (_withCfm)
+  {
+    _vel[this->appliedImpulseIndex] +=
+        _vel[this->appliedImpulseIndex] * this->cfm;
+  }
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::excite()
+{
+  this->skeleton->setImpulseApplied(true);
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::unexcite()
+{
+  this->skeleton->setImpulseApplied(false);
+}
+
+/////////////////////////////////////////////////
+void JointCouplingConstraint::applyImpulse(double *_lambda)
+{
+  for (std::size_t i = 0; i < this->mDim; ++i)
+  {
+    this->AddRowImpulse(i, _lambda[i]);
+    this->oldX[i] = _lambda[i];
+  }
+}
+
+/////////////////////////////////////////////////
+bool JointCouplingConstraint::isActive() const
+{
+  return this->mDim > 0;
+}
+
+/////////////////////////////////////////////////
+dart::dynamics::SkeletonPtr JointCouplingConstraint::getRootSkeleton() const
+{
+  return ConstraintBase::getRootSkeleton(this->skeleton);
+}
+
+}
+}
+}
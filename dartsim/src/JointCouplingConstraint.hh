@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_DARTSIM_SRC_JOINTCOUPLINGCONSTRAINT_HH_
+#define GZ_PHYSICS_DARTSIM_SRC_JOINTCOUPLINGCONSTRAINT_HH_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dart/config.hpp>
+#include <dart/constraint/ConstraintBase.hpp>
+#include <dart/dynamics/Joint.hpp>
+#include <dart/dynamics/Skeleton.hpp>
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+/// \brief A bilateral constraint that enforces a linear coupling between the
+/// generalized positions of joint axes of a single skeleton:
+///
+/// q_followers = A * q_leaders + b
+///
+/// Each follower is one row of the constraint, so the whole coupling is
+/// solved as one block by the LCP solver. Unlike DART's mimic motor, the
+/// constraint impulses act on both the followers and the leaders.
+class JointCouplingConstraint : public dart::constraint::ConstraintBase
+{
+  /// \brief A single axis of a joint
+  public: struct Axis
+  {
+    dart::dynamics::JointPtr joint;
+    std::size_t dof;
+  };
+
+  /// \brief A single nonzero entry of A
+  public: struct Term
+  {
+    std::size_t follower;
+    std::size_t leader;
+    double multiplier;
+  };
+
+  /// \brief Constructor
+  /// \param[in] _skeleton Skeleton that contains every joint of the coupling
+  /// \param[in] _followers Follower axes (rows)
+  /// \param[in] _leaders Leader axes (columns)
+  /// \param[in] _terms Nonzero entries of A
+  /// \param[in] _offsets Offsets b, one per follower
+  public: JointCouplingConstraint(
+      const dart::dynamics::SkeletonPtr &_skeleton,
+      std::vector<Axis> _followers,
+      std::vector<Axis> _leaders,
+      std::vector<Term> _terms,
+      std::vector<double> _offsets);
+
+  /// \brief Get the type of this constraint
+  public: static const std::string &getStaticType();
+
+#if DART_VERSION_AT_LEAST(6, 10, 0)
+  // Documentation inherited
+  public: const std::string &getType() const override;
+#endif
+
+  /// \brief Set the fraction of the position error that is corrected in a
+  /// single time step.
+  /// \param[in] _erp Error reduction parameter in [0, 1]
+  public: void SetErrorReductionParameter(double _erp);
+
+  // Documentation inherited
+  public: void update() override;
+
+  // Documentation inherited
+  public: void getInformation(dart::constraint::ConstraintInfo *_info)
+      override;
+
+  // Documentation inherited
+  public: void applyUnitImpulse(std::size_t _index) override;
+
+  // Documentation inherited
+  public: void getVelocityChange(double *_vel, bool _withCfm) override;
+
+  // Documentation inherited
+  public: void excite() override;
+
+  // Documentation inherited
+  public: void unexcite() override;
+
+  // Documentation inherited
+  public: void applyImpulse(double *_lambda) override;
+
+  // Documentation inherited
+  public: bool isActive() const override;
+
+  // Documentation inherited
+  public: dart::dynamics::SkeletonPtr getRootSkeleton() const override;
+
+  /// \brief Add _value to the constraint impulse of row _row on every joint
+  /// axis that participates in that row.
+  private: void AddRowImpulse(std::size_t _row, double _value);
+
+  /// \brief Propagate the current joint constraint impulses through the
+  /// skeleton.
+  private: void UpdateBiasImpulses();
+
+  /// \brief Skeleton containing all of the coupled joints
+  private: dart::dynamics::SkeletonPtr skeleton;
+
+  /// \brief Follower axes
+  private: std::vector<Axis> followers;
+
+  /// \brief Leader axes
+  private: std::vector<Axis> leaders;
+
+  /// \brief Nonzero entries of A grouped by row. Each entry is a pair of
+  /// (leader index, multiplier).
+  private: std::vector<std::vector<std::pair<std::size_t, double>>> rows;
+
+  /// \brief Offsets b
+  private: std::vector<double> offsets;
+
+  /// \brief Child body nodes of every coupled joint, used to propagate the
+  /// constraint impulses towards the root of the skeleton.
+  private: std::vector<dart::dynamics::BodyNode *> bodyNodes;
+
+  /// \brief Position error of every row computed in update()
+  private: std::vector<double> positionError;
+
+  /// \brief Velocity of every row computed in update()
+  private: std::vector<double> rowVelocity;
+
+  /// \brief Impulse of every row from the previous step, used to warm start
+  /// the LCP solver.
+  private: std::vector<double> oldX;
+
+  /// \brief Error reduction parameter
+  private: double erp = 0.3;
+
+  /// \brief Constraint force mixing
+  private: double cfm = 1e-9;
+
+  /// \brief Index of the row whose unit impulse was last applied
+  private: std::size_t appliedImpulseIndex = 0;
+};
+
+using JointCouplingConstraintPtr = std::shared_ptr<JointCouplingConstraint>;
+
+}
+}
+}
+
+#endif  // GZ_PHYSICS_DARTSIM_SRC_JOINTCOUPLINGCONSTRAINT_HH_
@@ -15,6 +15,10 @@
  *
 */
 
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #include <dart/dynamics/BodyNode.hpp>
 #include <dart/dynamics/Joint.hpp>
 #include <dart/dynamics/FreeJoint.hpp>
@@ -22,6 +26,7 @@
 #include <dart/dynamics/RevoluteJoint.hpp>
 #include <dart/dynamics/WeldJoint.hpp>
 
+#include "JointCouplingConstraint.hh"
 #include "JointFeatures.hh"
 
 namespace gz {
@@ -79,6 +84,7 @@ void JointFeatures::SetJointPosition(
            << "]. The value will be ignored\n";
     return;
   }
+  this->WakeSkeleton(joint->getSkeleton());
   joint->setPosition(_dof, _value);
 }
 
@@ -98,6 +104,8 @@ void JointFeatures::SetJointVelocity(
            << "]. The value will be ignored\n";
     return;
   }
+  this->WakeSkeleton(joint->getSkeleton());
+  this->PromoteSkeleton(joint->getSkeleton());
   joint->setVelocity(_dof, _value);
 }
 
@@ -117,6 +125,7 @@ void JointFeatures::SetJointAcceleration(
            << "]. The value will be ignored\n";
     return;
   }
+  this->WakeSkeleton(joint->getSkeleton());
   joint->setAcceleration(_dof, _value);
 }
 
@@ -136,6 +145,9 @@ void JointFeatures::SetJointForce(
            << "]. The value will be ignored\n";
     return;
   }
+  // A zero force does not move a sleeping model
+  if (_value != 0.0)
+    this->WakeSkeleton(joint->getSkeleton());
   if (joint->getActuatorType() != dart::dynamics::Joint::FORCE)
   {
     joint->setActuatorType(dart::dynamics::Joint::FORCE);
@@ -181,6 +193,9 @@ void JointFeatures::SetJointVelocityCommand(
     }
   }
 
+  // A sleeping model already has a zero velocity
+  if (_value != 0.0)
+    this->WakeSkeleton(joint->getSkeleton());
   joint->setCommand(_dof, _value);
 }
 
@@ -324,6 +339,32 @@ void JointFeatures::SetJointMaxEffort(
   joint->setForceUpperLimit(_dof, _value);
 }
 
+/////////////////////////////////////////////////
+void JointFeatures::SetJointSpringDamper(
+    const Identity &_id, std::size_t _dof, double _stiffness,
+    double _damping, double _restPosition)
+{
+  auto joint = this->ReferenceInterface<JointInfo>(_id)->joint;
+
+  // Take extra care that the values are valid. A nan can cause the DART
+  // constraint solver to fail, which will in turn either cause a crash or
+  // collisions to fail
+  if (!std::isfinite(_stiffness) || !std::isfinite(_damping) ||
+      !std::isfinite(_restPosition) || _stiffness < 0.0 || _damping < 0.0)
+  {
+    gzerr << "Invalid joint spring damper values [" << _stiffness << ", "
+           << _damping << ", " << _restPosition << "] set on joint ["
+           << joint->getName() << " DOF " << _dof
+           << "]. The command will be ignored\n";
+    return;
+  }
+
+  // DART integrates joint springs and dampers implicitly.
+  joint->setSpringStiffness(_dof, _stiffness);
+  joint->setDampingCoefficient(_dof, _damping);
+  joint->setRestPosition(_dof, _restPosition);
+}
+
 /////////////////////////////////////////////////
 std::size_t JointFeatures::GetJointDegreesOfFreedom(const Identity &_id) const
 {
@@ -348,16 +389,18 @@ Pose3d JointFeatures::GetJointTransformToChild(const Identity &_id) const
 void JointFeatures::SetJointTransformFromParent(
     const Identity &_id, const Pose3d &_pose)
 {
-  this->ReferenceInterface<JointInfo>(_id)
-      ->joint->setTransformFromParentBodyNode(_pose);
+  auto joint = this->ReferenceInterface<JointInfo>(_id)->joint;
+  this->WakeSkeleton(joint->getSkeleton());
+  joint->setTransformFromParentBodyNode(_pose);
 }
 
 /////////////////////////////////////////////////
 void JointFeatures::SetJointTransformToChild(
     const Identity &_id, const Pose3d &_pose)
 {
-  this->ReferenceInterface<JointInfo>(_id)
-      ->joint->setTransformFromChildBodyNode(_pose.inverse());
+  auto joint = this->ReferenceInterface<JointInfo>(_id)->joint;
+  this->WakeSkeleton(joint->getSkeleton());
+  joint->setTransformFromChildBodyNode(_pose.inverse());
 }
 
 /////////////////////////////////////////////////
@@ -432,6 +475,8 @@ void JointFeatures::DetachJoint(const Identity &_jointId)
     }
   }
 
+  this->WakeSkeleton(child->getSkeleton());
+  this->PromoteSkeleton(child->getSkeleton());
   dart::dynamics::FreeJoint *freeJoint;
   if (skeleton)
   {
@@ -495,6 +540,16 @@ Identity JointFeatures::AttachFixedJoint(
     }
   }
 
+  // Sleeping skeletons and kinematic proxies must not have their body nodes
+  // moved
+  this->WakeSkeleton(bn->getSkeleton());
+  this->PromoteSkeleton(bn->getSkeleton());
+  if (parentBn)
+  {
+    this->WakeSkeleton(parentBn->getSkeleton());
+    this->PromoteSkeleton(parentBn->getSkeleton());
+  }
+
   // Get the model of child link and fully scoped joint name.
   auto modelID = this->GetModelOfLinkImpl(_childID);
   const std::string fullJointName =
@@ -602,6 +657,16 @@ Identity JointFeatures::AttachRevoluteJoint(
     }
   }
 
+  // Sleeping skeletons and kinematic proxies must not have their body nodes
+  // moved
+  this->WakeSkeleton(bn->getSkeleton());
+  this->PromoteSkeleton(bn->getSkeleton());
+  if (parentBn)
+  {
+    this->WakeSkeleton(parentBn->getSkeleton());
+    this->PromoteSkeleton(parentBn->getSkeleton());
+  }
+
   // Get the model of child link and fully scoped joint name.
   auto modelID = this->GetModelOfLinkImpl(_childID);
   const std::string fullJointName =
@@ -680,6 +745,16 @@ Identity JointFeatures::AttachPrismaticJoint(
     }
   }
 
+  // Sleeping skeletons and kinematic proxies must not have their body nodes
+  // moved
+  this->WakeSkeleton(bn->getSkeleton());
+  this->PromoteSkeleton(bn->getSkeleton());
+  if (parentBn)
+  {
+    this->WakeSkeleton(parentBn->getSkeleton());
+    this->PromoteSkeleton(parentBn->getSkeleton());
+  }
+
   // Get the model of child link and fully scoped joint name.
   auto modelID = this->GetModelOfLinkImpl(_childID);
   const std::string fullJointName =
@@ -723,6 +798,136 @@ Wrench3d JointFeatures::GetJointTransmittedWrenchInJointFrame(
   wrenchOut.force = transmittedWrenchInJoint.tail<3>();
   return wrenchOut;
 }
+
+/////////////////////////////////////////////////
+bool JointFeatures::SetModelJointCoupling(
+    const Identity &_modelID,
+    const SetJointCouplingFeature::JointCoupling<FeaturePolicy3d> &_coupling)
+{
+  auto modelInfo = this->ReferenceInterface<ModelInfo>(_modelID);
+  const auto &skeleton = modelInfo->model;
+  if (!skeleton)
+  {
+    gzerr << "Unable to set joint coupling: the model does not have a "
+          << "skeleton.\n";
+    return false;
+  }
+
+  // Every axis of the coupling must belong to the skeleton of this model,
+  // since the constraint propagates its impulses through a single skeleton.
+  auto toAxes = [&](
+      const std::vector<SetJointCouplingFeature::JointAxis<FeaturePolicy3d>>
+          &_axes,
+      std::vector<JointCouplingConstraint::Axis> &_out) -> bool
+  {
+    _out.reserve(_axes.size());
+    for (const auto &axis : _axes)
+    {
+      if (!axis.joint)
+      {
+        gzerr << "Unable to set joint coupling of model ["
+              << skeleton->getName() << "]: invalid joint.\n";
+        return false;
+      }
+
+      const auto &joint =
+          this->ReferenceInterface<JointInfo>(axis.joint->FullIdentity())
+              ->joint;
+      if (!joint || joint->getSkeleton() != skeleton)
+      {
+        gzerr << "Unable to set joint coupling of model ["
+              << skeleton->getName() << "]: joint ["
+              << (joint ? joint->getName() : "") << "] does not belong to "
+              << "the model.\n";
+        return false;
+      }
+
+      if (axis.dof >= joint->getNumDofs())
+      {
+        gzerr << "Unable to set joint coupling of model ["
+              << skeleton->getName() << "]: axis [" << axis.dof
+              << "] is out of range for joint [" << joint->getName()
+              << "] with [" << joint->getNumDofs() << "] degrees of "
+              << "freedom.\n";
+        return false;
+      }
+      _out.push_back({joint, axis.dof});
+    }
+    return true;
+  };
+
+  std::vector<JointCouplingConstraint::Axis> followers;
+  std::vector<JointCouplingConstraint::Axis> leaders;
+  if (!toAxes(_coupling.followers, followers) ||
+      !toAxes(_coupling.leaders, leaders))
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < followers.size(); ++i)
+  {
+    for (std::size_t j = i + 1; j < followers.size(); ++j)
+    {
+      if (followers[i].joint == followers[j].joint &&
+          followers[i].dof == followers[j].dof)
+      {
+        gzerr << "Unable to set joint coupling of model ["
+              << skeleton->getName() << "]: axis [" << followers[i].dof
+              << "] of joint [" << followers[i].joint->getName()
+              << "] is a follower more than once.\n";
+        return false;
+      }
+    }
+  }
+
+  std::vector<JointCouplingConstraint::Term> terms;
+  terms.reserve(_coupling.terms.size());
+  for (const auto &term : _coupling.terms)
+  {
+    if (term.follower >= followers.size() || term.leader >= leaders.size())
+    {
+      gzerr << "Unable to set joint coupling of model ["
+            << skeleton->getName() << "]: term (" << term.follower << ", "
+            << term.leader << ") is out of range.\n";
+      return false;
+    }
+    terms.push_back({term.follower, term.leader, term.multiplier});
+  }
+
+  if (!_coupling.offsets.empty() &&
+      _coupling.offsets.size() != followers.size())
+  {
+    gzerr << "Unable to set joint coupling of model ["
+          << skeleton->getName() << "]: expected [" << followers.size()
+          << "] offsets, got [" << _coupling.offsets.size() << "].\n";
+    return false;
+  }
+
+  this->RemoveModelJointCoupling(_modelID);
+  if (followers.empty())
+    return true;
+
+  auto world = this->worlds.at(this->GetWorldOfModelImpl(_modelID));
+  auto constraint = std::make_shared<JointCouplingConstraint>(
+      skeleton, std::move(followers), std::move(leaders), std::move(terms),
+      std::vector<double>(
+          _coupling.offsets.begin(), _coupling.offsets.end()));
+  world->getConstraintSolver()->addConstraint(constraint);
+  modelInfo->jointCoupling = constraint;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void JointFeatures::RemoveModelJointCoupling(const Identity &_modelID)
+{
+  auto modelInfo = this->ReferenceInterface<ModelInfo>(_modelID);
+  if (!modelInfo->jointCoupling)
+    return;
+
+  auto world = this->worlds.at(this->GetWorldOfModelImpl(_modelID));
+  world->getConstraintSolver()->removeConstraint(modelInfo->jointCoupling);
+  modelInfo->jointCoupling.reset();
+}
 }
 }
 }
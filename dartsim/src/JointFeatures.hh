@@ -56,7 +56,9 @@ struct JointFeatureList : FeatureList<
   SetJointPositionLimitsFeature,
   SetJointVelocityLimitsFeature,
   SetJointEffortLimitsFeature,
-  GetJointTransmittedWrench
+  SetJointSpringDamperFeature,
+  GetJointTransmittedWrench,
+  SetJointCouplingFeature
 > { };
 
 class JointFeatures :
@@ -200,9 +202,22 @@ class JointFeatures :
       const Identity &_id, std::size_t _dof,
       double _value) override;
 
+  // ----- Spring damper -----
+  public: void SetJointSpringDamper(
+      const Identity &_id, std::size_t _dof, double _stiffness,
+      double _damping, double _restPosition) override;
+
   // ----- Transmitted wrench -----
   public: Wrench3d GetJointTransmittedWrenchInJointFrame(
       const Identity &_id) const override;
+
+  // ----- Joint coupling -----
+  public: bool SetModelJointCoupling(
+      const Identity &_modelID,
+      const SetJointCouplingFeature::JointCoupling<FeaturePolicy3d> &_coupling)
+      override;
+
+  public: void RemoveModelJointCoupling(const Identity &_modelID) override;
 };
 
 }
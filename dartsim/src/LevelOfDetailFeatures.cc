@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+
+#include <gz/common/Console.hh>
+
+#include "LevelOfDetailFeatures.hh"
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+/////////////////////////////////////////////////
+bool LevelOfDetailFeatures::SetWorldLevelOfDetailParameters(
+    const Identity &_worldID, const LevelOfDetailParameters &_parameters)
+{
+  if (!(_parameters.promotionDistance >= 0.0) ||
+      !(_parameters.demotionDistance >= _parameters.promotionDistance) ||
+      !(_parameters.idleTime >= 0.0) ||
+      !std::isfinite(_parameters.idleTime) ||
+      !(_parameters.linearVelocityThreshold >= 0.0) ||
+      !(_parameters.angularVelocityThreshold >= 0.0))
+  {
+    gzerr << "Ignoring level of detail parameters with negative or invalid "
+          << "thresholds, or with a demotion distance smaller than the "
+          << "promotion distance.\n";
+    return false;
+  }
+
+  this->worldLevelOfDetail[_worldID.id].parameters = _parameters;
+  if (!_parameters.enabled)
+    this->PromoteWorld(_worldID.id);
+  return true;
+}
+
+/////////////////////////////////////////////////
+LevelOfDetailParameters LevelOfDetailFeatures::GetWorldLevelOfDetailParameters(
+    const Identity &_worldID) const
+{
+  const auto it = this->worldLevelOfDetail.find(_worldID.id);
+  if (it == this->worldLevelOfDetail.end())
+    return LevelOfDetailParameters();
+  return it->second.parameters;
+}
+
+/////////////////////////////////////////////////
+std::size_t LevelOfDetailFeatures::GetWorldKinematicProxyCount(
+    const Identity &_worldID) const
+{
+  const auto it = this->worldLevelOfDetail.find(_worldID.id);
+  if (it == this->worldLevelOfDetail.end())
+    return 0u;
+  return it->second.proxyCount;
+}
+
+/////////////////////////////////////////////////
+bool LevelOfDetailFeatures::GetModelKinematicProxy(
+    const Identity &_modelID) const
+{
+  const auto modelInfo = this->models.MaybeAt(_modelID.id);
+  return modelInfo && (*modelInfo)->proxy;
+}
+
+/////////////////////////////////////////////////
+bool LevelOfDetailFeatures::SetModelKinematicProxy(
+    const Identity &_modelID, bool _proxy)
+{
+  const auto modelInfo = this->models.MaybeAt(_modelID.id);
+  if (!modelInfo)
+    return false;
+
+  const std::size_t worldID = this->GetWorldOfModelImpl(_modelID.id);
+  if (!_proxy)
+  {
+    this->PromoteModel(worldID, **modelInfo);
+    return true;
+  }
+
+  if ((*modelInfo)->levelOfDetailFocus)
+  {
+    gzerr << "Unable to demote model [" << (*modelInfo)->localName << "]: "
+          << "it is a focus of the level of detail of its world.\n";
+    return false;
+  }
+  return this->DemoteModel(worldID, **modelInfo);
+}
+
+/////////////////////////////////////////////////
+bool LevelOfDetailFeatures::GetModelLevelOfDetailFocus(
+    const Identity &_modelID) const
+{
+  const auto modelInfo = this->models.MaybeAt(_modelID.id);
+  return modelInfo && (*modelInfo)->levelOfDetailFocus;
+}
+
+/////////////////////////////////////////////////
+void LevelOfDetailFeatures::SetModelLevelOfDetailFocus(
+    const Identity &_modelID, bool _focus)
+{
+  const auto modelInfo = this->models.MaybeAt(_modelID.id);
+  if (!modelInfo)
+    return;
+
+  (*modelInfo)->levelOfDetailFocus = _focus;
+  if (_focus)
+    this->PromoteModel(this->GetWorldOfModelImpl(_modelID.id), **modelInfo);
+}
+
+}
+}
+}
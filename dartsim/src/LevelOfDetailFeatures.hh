@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_DARTSIM_SRC_LEVELOFDETAILFEATURES_HH_
+#define GZ_PHYSICS_DARTSIM_SRC_LEVELOFDETAILFEATURES_HH_
+
+#include <gz/physics/LevelOfDetail.hh>
+
+#include "Base.hh"
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+struct LevelOfDetailFeatureList : FeatureList<
+  LevelOfDetailFeature
+> { };
+
+class LevelOfDetailFeatures :
+    public virtual Base,
+    public virtual Implements3d<LevelOfDetailFeatureList>
+{
+  // Documentation inherited
+  public: bool SetWorldLevelOfDetailParameters(
+      const Identity &_worldID,
+      const LevelOfDetailParameters &_parameters) override;
+
+  // Documentation inherited
+  public: LevelOfDetailParameters GetWorldLevelOfDetailParameters(
+      const Identity &_worldID) const override;
+
+  // Documentation inherited
+  public: std::size_t GetWorldKinematicProxyCount(
+      const Identity &_worldID) const override;
+
+  // Documentation inherited
+  public: bool GetModelKinematicProxy(const Identity &_modelID) const override;
+
+  // Documentation inherited
+  public: bool SetModelKinematicProxy(
+      const Identity &_modelID, bool _proxy) override;
+
+  // Documentation inherited
+  public: bool GetModelLevelOfDetailFocus(
+      const Identity &_modelID) const override;
+
+  // Documentation inherited
+  public: void SetModelLevelOfDetailFocus(
+      const Identity &_modelID, bool _focus) override;
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,395 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <gz/plugin/Loader.hh>
+#include <gz/physics/RequestEngine.hh>
+
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/FreeGroup.hh>
+#include <gz/physics/FrameSemantics.hh>
+#include <gz/physics/GetEntities.hh>
+#include <gz/physics/LevelOfDetail.hh>
+#include <gz/physics/Link.hh>
+#include <gz/physics/sdf/ConstructWorld.hh>
+
+#include <sdf/Root.hh>
+#include <sdf/World.hh>
+
+struct TestFeatureList : gz::physics::FeatureList<
+    gz::physics::ForwardStep,
+    gz::physics::sdf::ConstructSdfWorld,
+    gz::physics::GetEntities,
+    gz::physics::LinkFrameSemantics,
+    gz::physics::AddLinkExternalForceTorque,
+    gz::physics::FindFreeGroupFeature,
+    gz::physics::SetFreeGroupWorldPose,
+    gz::physics::SetFreeGroupWorldVelocity,
+    gz::physics::LevelOfDetailFeature
+> { };
+
+using namespace gz;
+
+using TestEnginePtr = physics::Engine3dPtr<TestFeatureList>;
+using TestWorldPtr = physics::World3dPtr<TestFeatureList>;
+
+//////////////////////////////////////////////////
+/// \brief A world with a ground plane, a robot and boxes at increasing
+/// distances from it. The farthest box hovers above the ground.
+const std::string kBoxesWorld = R"(
+<sdf version="1.9">
+  <world name="default">
+    <model name="ground">
+      <static>true</static>
+      <link name="link">
+        <collision name="collision">
+          <geometry><plane><normal>0 0 1</normal></plane></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="robot">
+      <pose>0 0 0.5 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="box5">
+      <pose>5 0 0.5 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="box50">
+      <pose>50 0 0.5 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="box100">
+      <pose>100 0 5 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+//////////////////////////////////////////////////
+/// \brief A world with a ground plane, a robot, a beam that lies between
+/// the promotion and demotion distances of the robot, and a box beyond the
+/// demotion distance that touches the end of the beam.
+const std::string kBeamWorld = R"(
+<sdf version="1.9">
+  <world name="default">
+    <model name="ground">
+      <static>true</static>
+      <link name="link">
+        <collision name="collision">
+          <geometry><plane><normal>0 0 1</normal></plane></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="robot">
+      <pose>0 0 0.5 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="beam">
+      <pose>25 0 0.5 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>12 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+    <model name="box">
+      <pose>31.49 0 0.5 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>
+  </world>
+</sdf>)";
+
+//////////////////////////////////////////////////
+class LevelOfDetailFeaturesFixture : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    gz::plugin::Loader loader;
+    loader.LoadLib(dartsim_plugin_LIB);
+
+    gz::plugin::PluginPtr dartsim =
+        loader.Instantiate("gz::physics::dartsim::Plugin");
+
+    this->engine =
+        gz::physics::RequestEngine3d<TestFeatureList>::From(dartsim);
+    ASSERT_NE(nullptr, this->engine);
+
+    sdf::Root root;
+    const sdf::Errors errors = root.LoadSdfString(kBoxesWorld);
+    ASSERT_TRUE(errors.empty()) << errors;
+    this->world = this->engine->ConstructWorld(*root.WorldByIndex(0));
+    ASSERT_NE(nullptr, this->world);
+  }
+
+  /// \brief Step the world
+  /// \param[in] _count Number of steps
+  protected: void Step(std::size_t _count)
+  {
+    physics::ForwardStep::Output output;
+    physics::ForwardStep::State state;
+    physics::ForwardStep::Input input;
+    for (std::size_t i = 0; i < _count; ++i)
+      this->world->Step(output, state, input);
+  }
+
+  /// \brief Get the world pose of the link of a model
+  /// \param[in] _model Name of the model
+  /// \return Pose of the link
+  protected: physics::Pose3d LinkPose(const std::string &_model)
+  {
+    return this->world->GetModel(_model)->GetLink(0)
+        ->FrameDataRelativeToWorld().pose;
+  }
+
+  protected: TestEnginePtr engine;
+  protected: TestWorldPtr world;
+};
+
+//////////////////////////////////////////////////
+TEST_F(LevelOfDetailFeaturesFixture, Parameters)
+{
+  // Automatic level of detail is disabled by default
+  EXPECT_FALSE(this->world->GetLevelOfDetailParameters().enabled);
+  EXPECT_EQ(0u, this->world->GetKinematicProxyCount());
+
+  physics::LevelOfDetailParameters parameters;
+  parameters.enabled = true;
+  parameters.promotionDistance = 10.0;
+  parameters.demotionDistance = 15.0;
+  EXPECT_TRUE(this->world->SetLevelOfDetailParameters(parameters));
+  EXPECT_TRUE(this->world->GetLevelOfDetailParameters().enabled);
+  EXPECT_DOUBLE_EQ(15.0,
+      this->world->GetLevelOfDetailParameters().demotionDistance);
+
+  // Invalid parameters are ignored
+  parameters.demotionDistance = 5.0;
+  EXPECT_FALSE(this->world->SetLevelOfDetailParameters(parameters));
+  EXPECT_DOUBLE_EQ(15.0,
+      this->world->GetLevelOfDetailParameters().demotionDistance);
+
+  // Static and focus models are never demoted
+  EXPECT_FALSE(this->world->GetModel("ground")->SetKinematicProxy(true));
+  this->world->GetModel("robot")->SetLevelOfDetailFocus(true);
+  EXPECT_TRUE(this->world->GetModel("robot")->IsLevelOfDetailFocus());
+  EXPECT_FALSE(this->world->GetModel("robot")->SetKinematicProxy(true));
+
+  EXPECT_TRUE(this->world->GetModel("box5")->SetKinematicProxy(true));
+  EXPECT_TRUE(this->world->GetModel("box5")->IsKinematicProxy());
+  EXPECT_EQ(1u, this->world->GetKinematicProxyCount());
+
+  // Disabling level of detail promotes every proxy
+  parameters.enabled = false;
+  parameters.demotionDistance = 15.0;
+  EXPECT_TRUE(this->world->SetLevelOfDetailParameters(parameters));
+  EXPECT_FALSE(this->world->GetModel("box5")->IsKinematicProxy());
+  EXPECT_EQ(0u, this->world->GetKinematicProxyCount());
+}
+
+//////////////////////////////////////////////////
+TEST_F(LevelOfDetailFeaturesFixture, DistantModelsAreDemoted)
+{
+  physics::LevelOfDetailParameters parameters;
+  parameters.enabled = true;
+  ASSERT_TRUE(this->world->SetLevelOfDetailParameters(parameters));
+  this->world->GetModel("robot")->SetLevelOfDetailFocus(true);
+
+  this->Step(1);
+  EXPECT_FALSE(this->world->GetModel("box5")->IsKinematicProxy());
+  EXPECT_TRUE(this->world->GetModel("box50")->IsKinematicProxy());
+  EXPECT_TRUE(this->world->GetModel("box100")->IsKinematicProxy());
+  EXPECT_EQ(2u, this->world->GetKinematicProxyCount());
+
+  // Proxies keep their pose
+  const auto hoveringPose = this->LinkPose("box100");
+  this->Step(100);
+  EXPECT_TRUE(hoveringPose.isApprox(this->LinkPose("box100")));
+
+  // Their pose can be scripted, and forces applied to them are discarded
+  auto freeGroup = this->world->GetModel("box50")->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  freeGroup->SetWorldPose(physics::Pose3d(Eigen::Translation3d(60, 0, 0.5)));
+  this->world->GetModel("box50")->GetLink(0)->AddExternalForce(
+      Eigen::Vector3d(0, 0, 1000));
+  this->Step(10);
+  EXPECT_TRUE(this->world->GetModel("box50")->IsKinematicProxy());
+  EXPECT_NEAR(60.0, this->LinkPose("box50").translation().x(), 1e-9);
+  EXPECT_NEAR(0.5, this->LinkPose("box50").translation().z(), 1e-9);
+
+  // Moving the focus promotes the proxies it comes close to, and demotes the
+  // models it leaves behind
+  freeGroup = this->world->GetModel("robot")->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  freeGroup->SetWorldPose(physics::Pose3d(Eigen::Translation3d(97, 0, 0.5)));
+  this->Step(1);
+  EXPECT_FALSE(this->world->GetModel("box100")->IsKinematicProxy());
+  EXPECT_TRUE(this->world->GetModel("box5")->IsKinematicProxy());
+  EXPECT_TRUE(this->world->GetModel("box50")->IsKinematicProxy());
+
+  // The promoted box falls
+  this->Step(100);
+  EXPECT_LT(this->LinkPose("box100").translation().z(),
+            hoveringPose.translation().z() - 0.5);
+}
+
+//////////////////////////////////////////////////
+TEST_F(LevelOfDetailFeaturesFixture, VelocitiesArePreserved)
+{
+  // The hovering box falls for a while before it is demoted
+  this->Step(100);
+  auto link = this->world->GetModel("box100")->GetLink(0);
+  const auto before = link->FrameDataRelativeToWorld();
+  ASSERT_LT(before.linearVelocity.z(), -0.5);
+
+  auto model = this->world->GetModel("box100");
+  ASSERT_TRUE(model->SetKinematicProxy(true));
+  this->Step(100);
+  const auto frozen = link->FrameDataRelativeToWorld();
+  EXPECT_TRUE(before.pose.isApprox(frozen.pose));
+  EXPECT_NEAR(0.0, frozen.linearVelocity.norm(), 1e-9);
+
+  ASSERT_TRUE(model->SetKinematicProxy(false));
+  EXPECT_TRUE(before.linearVelocity.isApprox(
+      link->FrameDataRelativeToWorld().linearVelocity));
+}
+
+//////////////////////////////////////////////////
+TEST_F(LevelOfDetailFeaturesFixture, VelocityWritesPromote)
+{
+  this->Step(100);
+  auto model = this->world->GetModel("box100");
+  ASSERT_TRUE(model->SetKinematicProxy(true));
+
+  // The velocity that is written to the proxy replaces the one it was
+  // demoted with
+  auto freeGroup = model->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  const Eigen::Vector3d velocity(1.0, 2.0, 3.0);
+  freeGroup->SetWorldLinearVelocity(velocity);
+  EXPECT_FALSE(model->IsKinematicProxy());
+  EXPECT_TRUE(velocity.isApprox(
+      model->GetLink(0)->FrameDataRelativeToWorld().linearVelocity));
+
+  // It is kept when the model is demoted and promoted again
+  ASSERT_TRUE(model->SetKinematicProxy(true));
+  ASSERT_TRUE(model->SetKinematicProxy(false));
+  EXPECT_TRUE(velocity.isApprox(
+      model->GetLink(0)->FrameDataRelativeToWorld().linearVelocity));
+}
+
+//////////////////////////////////////////////////
+TEST_F(LevelOfDetailFeaturesFixture, TouchedProxiesArePromoted)
+{
+  ASSERT_TRUE(this->world->GetModel("box5")->SetKinematicProxy(true));
+
+  // The robot falls onto the proxy, which must not let it sink in
+  auto freeGroup = this->world->GetModel("robot")->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  freeGroup->SetWorldPose(physics::Pose3d(Eigen::Translation3d(5, 0, 2.0)));
+  for (std::size_t i = 0; i < 1000 &&
+       this->world->GetModel("box5")->IsKinematicProxy(); ++i)
+  {
+    this->Step(1);
+  }
+  EXPECT_FALSE(this->world->GetModel("box5")->IsKinematicProxy());
+  EXPECT_GT(this->LinkPose("robot").translation().z(), 1.4);
+}
+
+//////////////////////////////////////////////////
+TEST_F(LevelOfDetailFeaturesFixture, ModelsTouchingDynamicModelsAreKept)
+{
+  sdf::Root root;
+  const sdf::Errors errors = root.LoadSdfString(kBeamWorld);
+  ASSERT_TRUE(errors.empty()) << errors;
+  this->world = this->engine->ConstructWorld(*root.WorldByIndex(0));
+  ASSERT_NE(nullptr, this->world);
+
+  physics::LevelOfDetailParameters parameters;
+  parameters.enabled = true;
+  ASSERT_TRUE(this->world->SetLevelOfDetailParameters(parameters));
+  this->world->GetModel("robot")->SetLevelOfDetailFocus(true);
+
+  // The beam is neither promoted nor demoted by its distance. The box is far
+  // enough to be demoted, but the beam would promote it again right away.
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    this->Step(1);
+    EXPECT_FALSE(this->world->GetModel("beam")->IsKinematicProxy());
+    EXPECT_FALSE(this->world->GetModel("box")->IsKinematicProxy());
+  }
+
+  // Once the box no longer touches the beam, it is demoted
+  auto freeGroup = this->world->GetModel("box")->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  freeGroup->SetWorldPose(physics::Pose3d(Eigen::Translation3d(35, 0, 0.5)));
+  this->Step(2);
+  EXPECT_TRUE(this->world->GetModel("box")->IsKinematicProxy());
+  EXPECT_EQ(1u, this->world->GetKinematicProxyCount());
+}
+
+//////////////////////////////////////////////////
+TEST_F(LevelOfDetailFeaturesFixture, IdleModelsAreDemoted)
+{
+  physics::LevelOfDetailParameters parameters;
+  parameters.enabled = true;
+  parameters.idleTime = 0.2;
+  ASSERT_TRUE(this->world->SetLevelOfDetailParameters(parameters));
+
+  // Without focus models, only the boxes that rest are demoted
+  this->Step(300);
+  EXPECT_TRUE(this->world->GetModel("robot")->IsKinematicProxy());
+  EXPECT_TRUE(this->world->GetModel("box5")->IsKinematicProxy());
+  EXPECT_TRUE(this->world->GetModel("box50")->IsKinematicProxy());
+  EXPECT_FALSE(this->world->GetModel("ground")->IsKinematicProxy());
+
+  // The hovering box falls for 1 s, then rests on the ground
+  for (std::size_t i = 0; i < 5000 &&
+       !this->world->GetModel("box100")->IsKinematicProxy(); ++i)
+  {
+    this->Step(1);
+  }
+  EXPECT_TRUE(this->world->GetModel("box100")->IsKinematicProxy());
+  EXPECT_NEAR(0.5, this->LinkPose("box100").translation().z(), 1e-2);
+  EXPECT_EQ(4u, this->world->GetKinematicProxyCount());
+}
@@ -30,6 +30,7 @@ void LinkFeatures::AddLinkExternalForceInWorld(
     const LinearVectorType &_position)
 {
   auto bn = this->ReferenceInterface<LinkInfo>(_id)->link;
+  this->WakeSkeleton(bn->getSkeleton());
   bn->addExtForce(_force, _position, false, false);
 }
 
@@ -38,6 +39,7 @@ void LinkFeatures::AddLinkExternalTorqueInWorld(
     const Identity &_id, const AngularVectorType &_torque)
 {
   auto bn = this->ReferenceInterface<LinkInfo>(_id)->link;
+  this->WakeSkeleton(bn->getSkeleton());
   bn->addExtTorque(_torque, false);
 }
 
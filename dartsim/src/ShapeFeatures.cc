@@ -18,6 +18,7 @@
 #include "ShapeFeatures.hh"
 
 #include <memory>
+#include <vector>
 
 #include <dart/dynamics/BoxShape.hpp>
 #include <dart/dynamics/CapsuleShape.hpp>
@@ -27,6 +28,7 @@
 #include <dart/dynamics/MeshShape.hpp>
 #include <dart/dynamics/PlaneShape.hpp>
 #include <dart/dynamics/Shape.hpp>
+#include <dart/dynamics/ShapeNode.hpp>
 #include <dart/dynamics/SphereShape.hpp>
 
 #include <gz/common/Mesh.hh>
@@ -507,6 +509,119 @@ AlignedBox3d ShapeFeatures::GetShapeAxisAlignedBoundingBox(
   return AlignedBox3d(box.getMin(), box.getMax());
 }
 
+/////////////////////////////////////////////////
+/// \brief Merge the world bounding boxes of the collision shapes of a body
+/// node into _box.
+/// \return True if the body node has any collision shapes.
+static bool ExtendLinkAxisAlignedBoundingBox(
+    const dart::dynamics::BodyNode *_bn, AlignedBox3d &_box)
+{
+  const std::size_t numShapes =
+      _bn->getNumShapeNodesWith<dart::dynamics::CollisionAspect>();
+  for (std::size_t i = 0; i < numShapes; ++i)
+  {
+    const dart::dynamics::ShapeNode *sn =
+        _bn->getShapeNodeWith<dart::dynamics::CollisionAspect>(i);
+    const dart::math::BoundingBox &box = sn->getShape()->getBoundingBox();
+    const Eigen::Isometry3d &tf = sn->getWorldTransform();
+
+    // Transform the center and extents of the local box instead of its
+    // eight corners.
+    const Eigen::Vector3d center = tf * (0.5 * (box.getMin() + box.getMax()));
+    const Eigen::Vector3d halfExtents =
+        tf.linear().cwiseAbs() * (0.5 * (box.getMax() - box.getMin()));
+    _box.extend(center - halfExtents);
+    _box.extend(center + halfExtents);
+  }
+  return numShapes > 0;
+}
+
+/////////////////////////////////////////////////
+bool ShapeFeatures::ExtendModelAxisAlignedBoundingBox(
+    const ModelInfo &_modelInfo, AlignedBox3d &_box) const
+{
+  bool hasCollision = false;
+  for (const auto &linkInfo : _modelInfo.links)
+  {
+    hasCollision |=
+        ExtendLinkAxisAlignedBoundingBox(linkInfo->link.get(), _box);
+  }
+
+  for (const auto &nestedModel : _modelInfo.nestedModels)
+  {
+    const auto nestedModelInfo = this->models.MaybeAt(nestedModel);
+    if (nestedModelInfo)
+    {
+      hasCollision |=
+          this->ExtendModelAxisAlignedBoundingBox(**nestedModelInfo, _box);
+    }
+  }
+  return hasCollision;
+}
+
+/////////////////////////////////////////////////
+void ShapeFeatures::GetWorldModelAxisAlignedBoundingBoxes(
+    const Identity &_worldID,
+    std::vector<std::size_t> &_modelIds,
+    std::vector<AlignedBox3d> &_boxes) const
+{
+  _modelIds.clear();
+  _boxes.clear();
+
+  const auto indexIt = this->models.indexInContainerToID.find(_worldID);
+  if (indexIt == this->models.indexInContainerToID.end())
+    return;
+
+  for (const std::size_t modelID : indexIt->second)
+  {
+    // If the model doesn't exist in "models", it has been removed.
+    const auto modelInfo = this->models.MaybeAt(modelID);
+    if (!modelInfo)
+      continue;
+
+    AlignedBox3d box;
+    if (this->ExtendModelAxisAlignedBoundingBox(**modelInfo, box))
+    {
+      _modelIds.push_back(modelID);
+      _boxes.push_back(box);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ShapeFeatures::GetWorldLinkAxisAlignedBoundingBoxes(
+    const Identity &_worldID,
+    std::vector<std::size_t> &_linkIds,
+    std::vector<AlignedBox3d> &_boxes) const
+{
+  _linkIds.clear();
+  _boxes.clear();
+
+  // The world holds the skeletons of nested models too, so walking its
+  // skeletons visits every link exactly once.
+  const auto &world = this->worlds.at(_worldID);
+  for (std::size_t i = 0; i < world->getNumSkeletons(); ++i)
+  {
+    const auto &skeleton = world->getSkeleton(i);
+    for (std::size_t j = 0; j < skeleton->getNumBodyNodes(); ++j)
+    {
+      const DartBodyNode *bn = skeleton->getBodyNode(j);
+
+      // Skip body nodes that are not links, e.g. welded mirror nodes.
+      const auto linkIt = this->links.objectToID.find(bn);
+      if (linkIt == this->links.objectToID.end())
+        continue;
+
+      AlignedBox3d box;
+      if (ExtendLinkAxisAlignedBoundingBox(bn, box))
+      {
+        _linkIds.push_back(linkIt->second);
+        _boxes.push_back(box);
+      }
+    }
+  }
+}
+
 #if DART_VERSION_AT_LEAST(6, 10, 0)
 /////////////////////////////////////////////////
 double ShapeFeatures::GetShapeFrictionPyramidPrimarySlipCompliance(
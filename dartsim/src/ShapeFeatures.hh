@@ -19,7 +19,9 @@
 #define GZ_PHYSICS_DARTSIM_SRC_SHAPEFEATURES_HH_
 
 #include <string>
+#include <vector>
 
+#include <gz/physics/GetBoundingBox.hh>
 #include <gz/physics/Shape.hh>
 #include <gz/physics/BoxShape.hh>
 #include <gz/physics/CapsuleShape.hh>
@@ -44,6 +46,7 @@ struct ShapeFeatureList : FeatureList<
   SetShapeFrictionPyramidSlipCompliance,
 #endif
   GetShapeBoundingBox,
+  GetWorldEntityBoundingBoxes,
 
   GetBoxShapeProperties,
   // dartsim cannot yet update shape properties without reloading the model into
@@ -201,6 +204,22 @@ class ShapeFeatures :
   public: AlignedBox3d GetShapeAxisAlignedBoundingBox(
               const Identity &_shapeID) const override;
 
+  public: void GetWorldModelAxisAlignedBoundingBoxes(
+              const Identity &_worldID,
+              std::vector<std::size_t> &_modelIds,
+              std::vector<AlignedBox3d> &_boxes) const override;
+
+  public: void GetWorldLinkAxisAlignedBoundingBoxes(
+              const Identity &_worldID,
+              std::vector<std::size_t> &_linkIds,
+              std::vector<AlignedBox3d> &_boxes) const override;
+
+  /// \brief Merge the world bounding boxes of the collision shapes of a
+  /// model and its nested models into _box.
+  /// \return True if the model has any collision shapes.
+  private: bool ExtendModelAxisAlignedBoundingBox(
+              const ModelInfo &_modelInfo, AlignedBox3d &_box) const;
+
   // ----- Plane Features -----
   public: Identity CastToPlaneShape(
       const Identity &_shapeID) const override;
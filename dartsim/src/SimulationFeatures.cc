@@ -15,13 +15,21 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
-
+#include <dart/collision/CollisionFilter.hpp>
+#include <dart/collision/CollisionGroup.hpp>
 #include <dart/collision/CollisionObject.hpp>
+#include <dart/collision/CollisionOption.hpp>
 #include <dart/collision/CollisionResult.hpp>
 #include <dart/constraint/ConstraintSolver.hpp>
 #include <dart/constraint/ContactConstraint.hpp>
@@ -65,6 +73,105 @@ namespace gz {
 namespace physics {
 namespace dartsim {
 
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Check whether all the links of a skeleton move slower than the
+/// given thresholds
+bool IsAtRest(const dart::dynamics::Skeleton &_skel,
+    const double _linearVelocityThreshold,
+    const double _angularVelocityThreshold)
+{
+  const double linear2 = _linearVelocityThreshold * _linearVelocityThreshold;
+  const double angular2 =
+      _angularVelocityThreshold * _angularVelocityThreshold;
+  for (std::size_t i = 0; i < _skel.getNumBodyNodes(); ++i)
+  {
+    const auto *bn = _skel.getBodyNode(i);
+    if (bn->getLinearVelocity().squaredNorm() > linear2 ||
+        bn->getAngularVelocity().squaredNorm() > angular2)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Filter of the collisions between the awake and the sleeping
+/// skeletons of a world. Sleeping skeletons are not in the collision group
+/// of the constraint solver, so any awake skeleton that touches one must
+/// wake it up, or it would sink into it. Static skeletons never do. The
+/// same goes for kinematic proxies, which are promoted instead.
+class WakeUpCollisionFilter : public dart::collision::CollisionFilter
+{
+  // Documentation inherited
+  public: bool ignoresCollision(
+      const dart::collision::CollisionObject *_object1,
+      const dart::collision::CollisionObject *_object2) const override
+  {
+    for (const auto *object : {_object1, _object2})
+    {
+      const auto *shapeNode = object->getShapeFrame()->asShapeNode();
+      if (shapeNode && shapeNode->getBodyNodePtr()->getSkeleton()->isMobile())
+        return false;
+    }
+    return true;
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the skeleton of the shape of a collision object.
+/// \param[in] _object Collision object
+/// \return Skeleton of the shape, or nullptr if it is not a shape node
+const dart::dynamics::Skeleton *SkeletonOf(
+    const dart::collision::CollisionObject *_object)
+{
+  const auto *shapeNode = _object->getShapeFrame()->asShapeNode();
+  return shapeNode ? shapeNode->getSkeleton().get() : nullptr;
+}
+
+/////////////////////////////////////////////////
+/// \brief Filter of the collisions of a swept link. It ignores the other
+/// links of its skeleton and the collisions that the link touches before it
+/// moves, which the solver already handles, on top of the collision filter
+/// of the world.
+class SweepCollisionFilter : public dart::collision::CollisionFilter
+{
+  // Documentation inherited
+  public: bool ignoresCollision(
+      const dart::collision::CollisionObject *_object1,
+      const dart::collision::CollisionObject *_object2) const override
+  {
+    if (SkeletonOf(_object1) == SkeletonOf(_object2) ||
+        this->touching.count(_object1) > 0 ||
+        this->touching.count(_object2) > 0)
+    {
+      return true;
+    }
+    return this->worldFilter &&
+        this->worldFilter->ignoresCollision(_object1, _object2);
+  }
+
+  /// \brief Collision filter of the world
+  public: std::shared_ptr<dart::collision::CollisionFilter> worldFilter;
+
+  /// \brief Collision objects that the link touches before it moves
+  public: std::unordered_set<const dart::collision::CollisionObject *>
+      touching;
+};
+
+/// \brief Largest number of poses at which a swept link is collided, so
+/// that a link that travels many times its swept sphere radius in a step
+/// does not stall the step. Such links are sampled more sparsely, and a
+/// warning is printed the first time it happens to a link.
+constexpr std::size_t kMaxSweepSamples = 64u;
+
+/// \brief Number of bisections that refine the first pose at which a swept
+/// link touches a collision
+constexpr std::size_t kSweepBisections = 5u;
+}
+
 void SimulationFeatures::WorldForwardStep(
     const Identity &_worldID,
     ForwardStep::Output & _h,
@@ -88,9 +195,46 @@ void SimulationFeatures::WorldForwardStep(
     }
   }
 
+  // A world that plays back a state log does not run its dynamics
+  const auto replayIt = this->stateReplays.find(_worldID.id);
+  if (replayIt != this->stateReplays.end())
+  {
+    const std::size_t next = replayIt->second.next;
+    if (next < replayIt->second.log->StepCount())
+      this->WorldSeekStateLog(_worldID, next);
+    this->WriteStepOutput(_h);
+    return;
+  }
+
+  auto sleepIt = this->worldSleep.find(_worldID.id);
+  WorldSleepInfo *sleep = sleepIt != this->worldSleep.end() &&
+      sleepIt->second.parameters.enabled ? &sleepIt->second : nullptr;
+  if (sleep && sleep->sleepingCount > 0)
+    this->WakeTouchedModels(world, *sleep);
+
+  auto lodIt = this->worldLevelOfDetail.find(_worldID.id);
+  WorldLevelOfDetailInfo *lod = lodIt != this->worldLevelOfDetail.end() ?
+      &lodIt->second : nullptr;
+  if (lod && lod->proxyCount > 0)
+    this->PromoteTouchedModels(world, *lod);
+
+  const auto impulseIt = this->contactImpulseCaches.find(_worldID.id);
+  if (impulseIt != this->contactImpulseCaches.end())
+    impulseIt->second->NextStep();
+
+  const auto iterationsIt = this->solverIterations.find(_worldID.id);
+  SolverIterationState *iterations =
+      iterationsIt != this->solverIterations.end() ?
+      iterationsIt->second.get() : nullptr;
+  if (iterations)
+    iterations->statistics = SolverStatistics();
+
   for (const auto &[id, info] : this->links.idToObject)
   {
-    if (info && info->inertial->FluidAddedMass().has_value())
+    // Forces on immobile skeletons, which include the sleeping ones, are
+    // never applied or cleared
+    if (info && info->inertial->FluidAddedMass().has_value() &&
+        info->link->getSkeleton()->isMobile())
     {
       auto com = Eigen::Vector3d(info->inertial->Pose().Pos().X(),
                                  info->inertial->Pose().Pos().Y(),
@@ -104,10 +248,749 @@ void SimulationFeatures::WorldForwardStep(
   }
 
   // TODO(MXG): Parse input
+  if (const auto *servos = _u.Query<JointServoCommands>())
+    this->ApplyServoCommands(world, *servos);
+
+  if (!this->continuousCollisionLinks.empty())
+    this->SweepContinuousCollisionLinks(world, sleep, lod);
+
   world->step();
+  this->RestoreServoAxes();
+
+  if (sleep)
+    this->UpdateSleep(_worldID.id, world, *sleep);
+
+  if (lod && lod->parameters.enabled)
+    this->UpdateLevelOfDetail(_worldID.id, world, *lod);
+
+  // Worlds that never used the PGS solver did not iterate
+  if (_h.Has<SolverStatistics>())
+  {
+    _h.Get<SolverStatistics>() =
+        iterations ? iterations->statistics : SolverStatistics();
+  }
+
+  this->WriteStepOutput(_h);
+
+  const auto recorderIt = this->stateRecorders.find(_worldID.id);
+  if (recorderIt != this->stateRecorders.end())
+    this->RecordState(_worldID, *world, *recorderIt->second);
+  // TODO(MXG): Fill in state
+}
+
+void SimulationFeatures::SweepContinuousCollisionLinks(DartWorld *_world,
+    const WorldSleepInfo *_sleep, const WorldLevelOfDetailInfo *_lod)
+{
+  GZ_PROFILE("SimulationFeatures::SweepContinuousCollisionLinks");
+
+  auto *solver = _world->getConstraintSolver();
+  const auto &detector = solver->getCollisionDetector();
+  const double dt = _world->getTimeStep();
+
+  // Sleeping models and kinematic proxies are left out of the collision
+  // group of the solver, but fast links must not pass through them either
+  std::vector<dart::collision::CollisionGroup *> groups = {
+      solver->getCollisionGroup().get()};
+  if (_sleep && _sleep->sleepingCount > 0)
+    groups.push_back(_sleep->sleepingGroup.get());
+  if (_lod && _lod->proxyCount > 0)
+    groups.push_back(_lod->proxyGroup.get());
+
+  auto filter = std::make_shared<SweepCollisionFilter>();
+  filter->worldFilter = solver->getCollisionOption().collisionFilter;
+  const dart::collision::CollisionOption option(true, 100u, filter);
+  dart::collision::CollisionResult result;
+  dart::collision::CollisionResult groupResult;
+
+  // Collide the group of a link with every group, and gather the contacts
+  const auto collide = [&](dart::collision::CollisionGroup &_group)
+  {
+    result.clear();
+    for (auto *group : groups)
+    {
+      groupResult.clear();
+      if (_group.collide(group, option, &groupResult))
+      {
+        for (const auto &contact : groupResult.getContacts())
+          result.addContact(contact);
+      }
+    }
+    return result.isCollision();
+  };
+
+  // Sleeping models and proxies that a link hits are woken up and promoted
+  // once every link was swept
+  std::vector<DartSkeletonPtr> hitSkeletons;
+
+  for (auto it = this->continuousCollisionLinks.begin();
+       it != this->continuousCollisionLinks.end();)
+  {
+    const auto linkInfo = this->links.MaybeAt(it->first);
+    if (!linkInfo)
+    {
+      it = this->continuousCollisionLinks.erase(it);
+      continue;
+    }
+
+    ContinuousCollisionInfo &info = (it++)->second;
+    DartBodyNode *bn = (*linkInfo)->link.get();
+    const DartSkeletonPtr skel = bn->getSkeleton();
+    auto *joint = dynamic_cast<dart::dynamics::FreeJoint *>(
+        bn->getParentJoint());
+
+    // Sleeping skeletons and the skeletons of other worlds are not stepped
+    if (!joint || !skel->isMobile() || !_world->hasSkeleton(skel))
+      continue;
+
+    const Eigen::Vector3d velocity = bn->getLinearVelocity();
+    const Eigen::Vector3d motion = velocity * dt;
+    const double distance = motion.norm();
+    if (distance <= info.parameters.motionThreshold || distance <= 0.0)
+      continue;
+
+    if (!info.group || info.group->getCollisionDetector() != detector.get())
+    {
+      info.group = detector->createCollisionGroupAsSharedPtr();
+      info.group->subscribeTo(dart::dynamics::ConstBodyNodePtr(bn));
+    }
+
+    filter->touching.clear();
+    if (collide(*info.group))
+    {
+      for (const auto &contact : result.getContacts())
+      {
+        for (const auto *object :
+             {contact.collisionObject1, contact.collisionObject2})
+        {
+          if (SkeletonOf(object) != skel.get())
+            filter->touching.insert(object);
+        }
+      }
+    }
+
+    // Collide the link at poses along its motion, at most a swept sphere
+    // radius apart, until it touches something
+    const Eigen::Vector6d positions = joint->getPositions();
+    const Eigen::Isometry3d start = bn->getWorldTransform();
+    const auto collideAt = [&](const double _fraction)
+    {
+      Eigen::Isometry3d tf = start;
+      tf.translation() += _fraction * motion;
+      joint->setTransform(tf);
+      return collide(*info.group);
+    };
+
+    const std::size_t needed = static_cast<std::size_t>(std::ceil(
+        distance / info.parameters.sweptSphereRadius));
+    const std::size_t samples = std::min(kMaxSweepSamples, needed);
+    if (needed > kMaxSweepSamples && !info.warnedSampleCap)
+    {
+      gzwarn << "Link [" << bn->getName() << "] of model ["
+             << skel->getName() << "] travels [" << distance
+             << "] m in a step, more than [" << kMaxSweepSamples
+             << "] times its swept sphere radius of ["
+             << info.parameters.sweptSphereRadius << "] m. Its sweep is "
+             << "sampled more sparsely and may miss thin collisions."
+             << std::endl;
+      info.warnedSampleCap = true;
+    }
+    double free = 0.0;
+    double hit = 0.0;
+    for (std::size_t i = 1; i <= samples; ++i)
+    {
+      const double fraction =
+          static_cast<double>(i) / static_cast<double>(samples);
+      if (collideAt(fraction))
+      {
+        hit = fraction;
+        break;
+      }
+      free = fraction;
+    }
+
+    if (hit > 0.0)
+    {
+      // The link ends the step slightly inside the collision that it hits,
+      // so that the discrete contact of the next step resolves it
+      for (std::size_t i = 0; i < kSweepBisections; ++i)
+      {
+        const double middle = 0.5 * (free + hit);
+        if (collideAt(middle))
+          hit = middle;
+        else
+          free = middle;
+      }
+      if (!collideAt(hit))
+        hit = 0.0;
+    }
+    joint->setPositions(positions);
+
+    if (hit <= 0.0)
+      continue;
+
+    // Keep the velocity of the link along the surface, and reduce its
+    // velocity towards the surface so that it reaches it during the step
+    double approach = 0.0;
+    Eigen::Vector3d normal = Eigen::Vector3d::Zero();
+    for (const auto &contact : result.getContacts())
+    {
+      // Contact normals point from the second object to the first one
+      const bool first = SkeletonOf(contact.collisionObject1) == skel.get();
+      const Eigen::Vector3d n =
+          first ? contact.normal : Eigen::Vector3d(-contact.normal);
+      const double speed = -velocity.dot(n);
+      if (speed > approach)
+      {
+        approach = speed;
+        normal = n;
+      }
+
+      const auto *other = (first ? contact.collisionObject2 :
+          contact.collisionObject1)->getShapeFrame()->asShapeNode();
+      if (other && !other->getSkeleton()->isMobile())
+      {
+        hitSkeletons.push_back(std::const_pointer_cast<
+            dart::dynamics::Skeleton>(other->getSkeleton()));
+      }
+    }
+
+    if (approach > 0.0)
+    {
+      joint->setLinearVelocity(
+          velocity + (1.0 - hit) * approach * normal);
+    }
+  }
+
+  // The contact is resolved by the solver during the next step, which needs
+  // the models that were hit to be dynamic
+  for (const auto &hitSkeleton : hitSkeletons)
+  {
+    this->WakeSkeleton(hitSkeleton);
+    this->PromoteSkeleton(hitSkeleton);
+  }
+}
+
+void SimulationFeatures::WakeTouchedModels(
+    DartWorld *_world, WorldSleepInfo &_sleep)
+{
+  GZ_PROFILE("SimulationFeatures::WakeTouchedModels");
+  const dart::collision::CollisionOption option(
+      true, 10000u, std::make_shared<WakeUpCollisionFilter>());
+  dart::collision::CollisionResult result;
+
+  // Islands of touching models wake up as a whole, so the models that were
+  // woken up wake the sleeping models that they touch in turn
+  bool woken = true;
+  while (woken && _sleep.sleepingCount > 0)
+  {
+    woken = false;
+    result.clear();
+    _world->getConstraintSolver()->getCollisionGroup()->collide(
+        _sleep.sleepingGroup.get(), option, &result);
+
+    for (const auto *bn : result.getCollidingBodyNodes())
+    {
+      const auto skel = bn->getSkeleton();
+      if (skel->isMobile())
+        continue;
+      this->WakeSkeleton(skel);
+      woken = woken || skel->isMobile();
+    }
+  }
+}
+
+void SimulationFeatures::UpdateSleep(
+    const std::size_t _worldID, DartWorld *_world, WorldSleepInfo &_sleep)
+{
+  GZ_PROFILE("SimulationFeatures::UpdateSleep");
+  const double dt = _world->getTimeStep();
+  std::vector<ModelInfo *> awake;
+  std::unordered_map<const dart::dynamics::Skeleton *, std::size_t> indices;
+  for (std::size_t i = 0; i < _world->getNumSkeletons(); ++i)
+  {
+    const auto &skel = _world->getSkeleton(i);
+    if (!skel->isMobile())
+      continue;
+
+    const auto it = this->models.objectToID.find(skel);
+    if (it == this->models.objectToID.end())
+      continue;
+
+    ModelInfo &modelInfo = *this->models.idToObject.at(it->second);
+    if (IsAtRest(*skel, _sleep.parameters.linearVelocityThreshold,
+                 _sleep.parameters.angularVelocityThreshold))
+    {
+      modelInfo.restTime += dt;
+    }
+    else
+    {
+      modelInfo.restTime = 0.0;
+    }
+
+    indices[skel.get()] = awake.size();
+    awake.push_back(&modelInfo);
+  }
+
+  // Models that touch each other form an island, which only goes to sleep
+  // as a whole once all of its models rested long enough. Otherwise a model
+  // that goes to sleep would be woken up again by a neighbour that is still
+  // awake.
+  std::vector<std::size_t> islands(awake.size());
+  std::iota(islands.begin(), islands.end(), 0u);
+  const auto islandOf = [&islands](std::size_t _index)
+  {
+    while (islands[_index] != _index)
+    {
+      islands[_index] = islands[islands[_index]];
+      _index = islands[_index];
+    }
+    return _index;
+  };
+
+  for (const auto &contact : _world->getLastCollisionResult().getContacts())
+  {
+    const auto it1 = indices.find(SkeletonOf(contact.collisionObject1));
+    const auto it2 = indices.find(SkeletonOf(contact.collisionObject2));
+    if (it1 != indices.end() && it2 != indices.end())
+      islands[islandOf(it1->second)] = islandOf(it2->second);
+  }
+
+  std::vector<bool> restless(awake.size(), false);
+  for (std::size_t i = 0; i < awake.size(); ++i)
+  {
+    if (awake[i]->restTime < _sleep.parameters.timeThreshold ||
+        !CanSleep(*awake[i]))
+    {
+      restless[islandOf(i)] = true;
+    }
+  }
+
+  for (std::size_t i = 0; i < awake.size(); ++i)
+  {
+    if (!restless[islandOf(i)])
+      this->SleepModel(_worldID, *awake[i]);
+  }
+}
+
+void SimulationFeatures::PromoteTouchedModels(
+    DartWorld *_world, WorldLevelOfDetailInfo &_lod)
+{
+  GZ_PROFILE("SimulationFeatures::PromoteTouchedModels");
+  const dart::collision::CollisionOption option(
+      true, 10000u, std::make_shared<WakeUpCollisionFilter>());
+  dart::collision::CollisionResult result;
+  _world->getConstraintSolver()->getCollisionGroup()->collide(
+      _lod.proxyGroup.get(), option, &result);
+
+  for (const auto *bn : result.getCollidingBodyNodes())
+    this->PromoteSkeleton(bn->getSkeleton());
+}
+
+void SimulationFeatures::UpdateLevelOfDetail(
+    const std::size_t _worldID, DartWorld *_world,
+    WorldLevelOfDetailInfo &_lod)
+{
+  GZ_PROFILE("SimulationFeatures::UpdateLevelOfDetail");
+  const LevelOfDetailParameters &parameters = _lod.parameters;
+  const double dt = _world->getTimeStep();
+  const double promotion2 =
+      parameters.promotionDistance * parameters.promotionDistance;
+  const double demotion2 =
+      parameters.demotionDistance * parameters.demotionDistance;
+
+  // Models are placed by the origin of their root link
+  const auto positionOf = [](const dart::dynamics::Skeleton &_skel)
+  {
+    return _skel.getRootBodyNode()->getWorldTransform().translation();
+  };
+
+  std::vector<Eigen::Vector3d> focusPositions;
+  for (std::size_t i = 0; i < _world->getNumSkeletons(); ++i)
+  {
+    const auto &skel = _world->getSkeleton(i);
+    const auto it = this->models.objectToID.find(skel);
+    if (it != this->models.objectToID.end() && skel->getNumBodyNodes() > 0 &&
+        this->models.idToObject.at(it->second)->levelOfDetailFocus)
+    {
+      focusPositions.push_back(positionOf(*skel));
+    }
+  }
+
+  // Models are demoted after every model was checked, see below
+  std::vector<ModelInfo *> demoted;
+  for (std::size_t i = 0; i < _world->getNumSkeletons(); ++i)
+  {
+    const auto &skel = _world->getSkeleton(i);
+    const auto it = this->models.objectToID.find(skel);
+    if (it == this->models.objectToID.end() || skel->getNumBodyNodes() == 0)
+      continue;
+
+    ModelInfo &modelInfo = *this->models.idToObject.at(it->second);
+    if (modelInfo.levelOfDetailFocus)
+      continue;
+
+    const Eigen::Vector3d position = positionOf(*skel);
+    double distance2 = std::numeric_limits<double>::infinity();
+    for (const auto &focus : focusPositions)
+      distance2 = std::min(distance2, (position - focus).squaredNorm());
+    const bool near = distance2 < promotion2;
+
+    if (modelInfo.proxy)
+    {
+      if (near)
+        this->PromoteModel(_worldID, modelInfo);
+      continue;
+    }
+
+    // Static models are immobile without being asleep
+    if (!skel->isMobile() && !modelInfo.sleeping)
+      continue;
+
+    if (!focusPositions.empty() && distance2 > demotion2)
+    {
+      demoted.push_back(&modelInfo);
+      continue;
+    }
+
+    if (parameters.idleTime <= 0.0 || near)
+    {
+      modelInfo.idleTime = 0.0;
+      continue;
+    }
+
+    if (!modelInfo.sleeping &&
+        !IsAtRest(*skel, parameters.linearVelocityThreshold,
+                  parameters.angularVelocityThreshold))
+    {
+      modelInfo.idleTime = 0.0;
+      continue;
+    }
+
+    modelInfo.idleTime += dt;
+    if (modelInfo.idleTime >= parameters.idleTime)
+      demoted.push_back(&modelInfo);
+  }
+
+  if (demoted.empty())
+    return;
+
+  // A model that touches a mobile model which stays dynamic, for example one
+  // that is tied to others by joints, would be promoted again by that
+  // contact before the next step. Such models are kept until the contact
+  // ends, so that they do not switch back and forth every step.
+  std::unordered_set<const dart::dynamics::Skeleton *> candidates;
+  for (const ModelInfo *modelInfo : demoted)
+  {
+    if (modelInfo->sleeping || CanSleep(*modelInfo))
+      candidates.insert(modelInfo->model.get());
+  }
+
+  const auto staysDynamic = [&](const dart::dynamics::Skeleton *_skel)
+  {
+    return _skel && _skel->isMobile() && candidates.count(_skel) == 0;
+  };
+
+  const auto &contacts = _world->getLastCollisionResult().getContacts();
+  bool kept = true;
+  while (kept && !candidates.empty())
+  {
+    kept = false;
+    for (const auto &contact : contacts)
+    {
+      const auto *skel1 = SkeletonOf(contact.collisionObject1);
+      const auto *skel2 = SkeletonOf(contact.collisionObject2);
+      if (staysDynamic(skel1) && candidates.erase(skel2) > 0)
+        kept = true;
+      else if (staysDynamic(skel2) && candidates.erase(skel1) > 0)
+        kept = true;
+    }
+  }
+
+  for (ModelInfo *modelInfo : demoted)
+  {
+    if (candidates.count(modelInfo->model.get()) > 0)
+      this->DemoteModel(_worldID, *modelInfo);
+  }
+}
+
+void SimulationFeatures::WriteStepOutput(ForwardStep::Output &_h)
+{
   this->WriteRequiredData(_h);
   this->Write(_h.Get<ChangedWorldPoses>());
-  // TODO(MXG): Fill in state
+
+  // The pose stream is only encoded when the caller asked for it
+  if (_h.Has<ChangedWorldPosesStream>())
+    this->Write(_h.Get<ChangedWorldPosesStream>());
+}
+
+bool SimulationFeatures::WorldStartStateRecording(
+    const Identity &_worldID, const std::string &_path,
+    const StateLogOptions &_options)
+{
+  auto log = std::make_unique<StateLogWriter>();
+  if (!log->Open(_path, _options))
+  {
+    gzerr << "Unable to create state log [" << _path << "].\n";
+    return false;
+  }
+
+  // Replacing a recording in progress closes its log
+  this->stateRecorders[_worldID.id] = std::move(log);
+  return true;
+}
+
+bool SimulationFeatures::WorldStopStateRecording(const Identity &_worldID)
+{
+  const auto it = this->stateRecorders.find(_worldID.id);
+  if (it == this->stateRecorders.end())
+    return false;
+
+  const bool written = it->second->Close();
+  this->stateRecorders.erase(it);
+  return written;
+}
+
+bool SimulationFeatures::WorldLoadStateLog(
+    const Identity &_worldID, const std::string &_path)
+{
+  auto log = std::make_unique<StateLogReader>();
+  if (!log->Open(_path))
+  {
+    gzerr << "Unable to read state log [" << _path << "].\n";
+    return false;
+  }
+
+  this->stateReplays[_worldID.id] = StateReplay{std::move(log), 0};
+  return true;
+}
+
+void SimulationFeatures::WorldUnloadStateLog(const Identity &_worldID)
+{
+  this->stateReplays.erase(_worldID.id);
+}
+
+std::size_t SimulationFeatures::GetWorldStateLogStepCount(
+    const Identity &_worldID) const
+{
+  const auto it = this->stateReplays.find(_worldID.id);
+  if (it == this->stateReplays.end())
+    return 0;
+  return it->second.log->StepCount();
+}
+
+bool SimulationFeatures::WorldSeekStateLog(
+    const Identity &_worldID, const std::size_t _index)
+{
+  const auto it = this->stateReplays.find(_worldID.id);
+  if (it == this->stateReplays.end() ||
+      _index >= it->second.log->StepCount())
+  {
+    return false;
+  }
+
+  // Steps only hold what changed since the previous step, so the state of
+  // _index is rebuilt from its key frame, unless we are already on the way.
+  auto &replay = it->second;
+  const std::size_t keyFrame = replay.log->KeyFrameOf(_index);
+  const std::size_t first =
+      (keyFrame <= replay.next && replay.next <= _index) ?
+      replay.next : keyFrame;
+
+  StateLogStep step;
+  for (std::size_t i = first; i <= _index; ++i)
+  {
+    replay.log->Step(i, step);
+    this->ApplyLoggedStep(step);
+  }
+
+  this->ReferenceInterface<DartWorld>(_worldID)->setTime(step.time);
+  replay.next = _index + 1;
+  return true;
+}
+
+void SimulationFeatures::RecordState(
+    const Identity &_worldID, const DartWorld &_world,
+    StateLogWriter &_log) const
+{
+  _log.BeginStep(_world.getSimFrames(), _world.getTime());
+
+  for (std::size_t s = 0; s < _world.getNumSkeletons(); ++s)
+  {
+    const auto skeleton = _world.getSkeleton(s);
+    for (std::size_t b = 0; b < skeleton->getNumBodyNodes(); ++b)
+    {
+      const dart::dynamics::BodyNode *bn = skeleton->getBodyNode(b);
+      const auto linkIt = this->links.objectToID.find(bn);
+      if (linkIt != this->links.objectToID.end())
+      {
+        const Eigen::Isometry3d &tf = bn->getWorldTransform();
+        const Eigen::Quaterniond rot(tf.linear());
+        const Eigen::Vector3d v = bn->getLinearVelocity();
+        const Eigen::Vector3d w = bn->getAngularVelocity();
+        _log.AddLink(StateLogLink{
+            linkIt->second,
+            {tf.translation().x(), tf.translation().y(), tf.translation().z(),
+             rot.w(), rot.x(), rot.y(), rot.z()},
+            {v.x(), v.y(), v.z()},
+            {w.x(), w.y(), w.z()}});
+      }
+
+      // Free joints are recorded through the pose of their child link
+      const dart::dynamics::Joint *joint = bn->getParentJoint();
+      const auto jointIt = this->joints.objectToID.find(joint);
+      if (jointIt != this->joints.objectToID.end() &&
+          !dynamic_cast<const dart::dynamics::FreeJoint*>(joint))
+      {
+        for (std::size_t dof = 0; dof < joint->getNumDofs(); ++dof)
+        {
+          _log.AddJoint(StateLogJoint{
+              jointIt->second, dof,
+              joint->getPosition(dof), joint->getVelocity(dof)});
+        }
+      }
+    }
+  }
+
+  for (const auto &contact : this->GetContactsFromLastStep(_worldID))
+  {
+    StateLogContact record{};
+    record.collision1 = contact.collision1.id;
+    record.collision2 = contact.collision2.id;
+    record.point[0] = contact.point.x();
+    record.point[1] = contact.point.y();
+    record.point[2] = contact.point.z();
+
+    const auto *extra = contact.extraData.Query<
+        SimulationFeatures::ExtraContactData>();
+    if (extra)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        record.normal[i] = extra->normal[i];
+        record.force[i] = extra->force[i];
+      }
+      record.depth = extra->depth;
+    }
+    _log.AddContact(record);
+  }
+
+  _log.EndStep();
+}
+
+void SimulationFeatures::ApplyLoggedStep(const StateLogStep &_step)
+{
+  for (std::size_t i = 0; i < _step.linkCount; ++i)
+  {
+    const StateLogLink &record = _step.links[i];
+    const auto info = this->links.MaybeAt(record.entity);
+    if (!info || !(*info)->link)
+      continue;
+
+    // Links that are not free follow from the joint positions
+    auto *freeJoint = dynamic_cast<dart::dynamics::FreeJoint*>(
+        (*info)->link->getParentJoint());
+    if (!freeJoint)
+      continue;
+
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.translation() =
+        Eigen::Vector3d(record.pose[0], record.pose[1], record.pose[2]);
+    tf.linear() = Eigen::Quaterniond(
+        record.pose[3], record.pose[4], record.pose[5], record.pose[6])
+        .normalized().toRotationMatrix();
+    freeJoint->setTransform(tf);
+    freeJoint->setLinearVelocity(Eigen::Vector3d(
+        record.linearVelocity[0], record.linearVelocity[1],
+        record.linearVelocity[2]));
+    freeJoint->setAngularVelocity(Eigen::Vector3d(
+        record.angularVelocity[0], record.angularVelocity[1],
+        record.angularVelocity[2]));
+  }
+
+  for (std::size_t i = 0; i < _step.jointCount; ++i)
+  {
+    const StateLogJoint &record = _step.joints[i];
+    const auto info = this->joints.MaybeAt(record.entity);
+    if (!info || !(*info)->joint || record.dof >= (*info)->joint->getNumDofs())
+      continue;
+
+    dart::dynamics::Joint *joint = (*info)->joint.get();
+    joint->setPosition(record.dof, record.position);
+    joint->setVelocity(record.dof, record.velocity);
+  }
+}
+
+void SimulationFeatures::ApplyServoCommands(
+    DartWorld *_world, const JointServoCommands &_servos)
+{
+  const std::size_t count = _servos.joints.size();
+  if (_servos.dofs.size() != count || _servos.positions.size() != count ||
+      _servos.gains.size() != count)
+  {
+    gzerr << "Ignoring servo commands: expected [" << count << "] dofs, "
+          << "positions and gains, got [" << _servos.dofs.size() << "], ["
+          << _servos.positions.size() << "] and [" << _servos.gains.size()
+          << "].\n";
+    return;
+  }
+
+  // DART integrates joint springs and dampers implicitly, so a PD servo is
+  // expressed as a spring towards the target combined with any spring that
+  // is already set on the joint.
+  this->servoAxes.clear();
+  this->servoAxes.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const auto jointInfo = this->joints.MaybeAt(_servos.joints[i]);
+    if (!jointInfo || !(*jointInfo)->joint ||
+        !_world->hasSkeleton((*jointInfo)->joint->getSkeleton()))
+    {
+      gzerr << "Ignoring servo command for joint [" << _servos.joints[i]
+            << "], which is not a joint of this world.\n";
+      continue;
+    }
+
+    dart::dynamics::Joint *joint = (*jointInfo)->joint.get();
+    this->WakeSkeleton(joint->getSkeleton());
+    const std::size_t dof = _servos.dofs[i];
+    const double target = _servos.positions[i];
+    const double kp = _servos.gains[i].P;
+    const double kd = _servos.gains[i].D;
+    if (dof >= joint->getNumDofs() || !std::isfinite(target) ||
+        !std::isfinite(kp) || !std::isfinite(kd) || kp < 0.0 || kd < 0.0)
+    {
+      gzerr << "Ignoring invalid servo command for axis [" << dof
+            << "] of joint [" << joint->getName() << "].\n";
+      continue;
+    }
+
+    const double stiffness = joint->getSpringStiffness(dof);
+    const double damping = joint->getDampingCoefficient(dof);
+    const double restPosition = joint->getRestPosition(dof);
+    this->servoAxes.push_back({joint, dof, stiffness, damping, restPosition});
+
+    const double totalStiffness = stiffness + kp;
+    if (totalStiffness > 0.0)
+    {
+      joint->setRestPosition(dof,
+          (stiffness * restPosition + kp * target) / totalStiffness);
+    }
+    joint->setSpringStiffness(dof, totalStiffness);
+    joint->setDampingCoefficient(dof, damping + kd);
+  }
+}
+
+void SimulationFeatures::RestoreServoAxes()
+{
+  // Restore in reverse order so that an axis that was commanded more than
+  // once ends up with its original parameters.
+  for (auto it = this->servoAxes.rbegin(); it != this->servoAxes.rend(); ++it)
+  {
+    it->joint->setSpringStiffness(it->dof, it->stiffness);
+    it->joint->setDampingCoefficient(it->dof, it->damping);
+    it->joint->setRestPosition(it->dof, it->restPosition);
+  }
+  this->servoAxes.clear();
 }
 
 void SimulationFeatures::Write(WorldPoses &_worldPoses) const
@@ -132,8 +1015,6 @@ void SimulationFeatures::Write(ChangedWorldPoses &_changedPoses) const
   _changedPoses.entries.clear();
   _changedPoses.entries.reserve(this->links.size());
 
-  std::unordered_map<std::size_t, math::Pose3d> newPoses;
-
   for (const auto &[id, info] : this->links.idToObject)
   {
     // make sure the link exists
@@ -152,17 +1033,41 @@ void SimulationFeatures::Write(ChangedWorldPoses &_changedPoses) const
           !iter->second.Rot().Equal(wp.pose.Rot(), 1e-6))
       {
         _changedPoses.entries.push_back(wp);
-        newPoses[id] = wp.pose;
+        this->prevLinkPoses[id] = wp.pose;
       }
-      else
-        newPoses[id] = iter->second;
     }
   }
 
-  // Save the new poses so that they can be used to check for updates in the
-  // next iteration. Re-setting this->prevLinkPoses with the contents of
-  // newPoses ensures that we aren't caching data for links that were removed
-  this->prevLinkPoses = std::move(newPoses);
+  // The poses are updated in place so that they can be used to check for
+  // updates in the next iteration. Drop the links that were removed so that
+  // we aren't caching data for them.
+  for (auto iter = this->prevLinkPoses.begin();
+       iter != this->prevLinkPoses.end();)
+  {
+    const auto linkIt = this->links.idToObject.find(iter->first);
+    if (linkIt != this->links.idToObject.end() &&
+        linkIt->second && linkIt->second->link)
+      ++iter;
+    else
+      iter = this->prevLinkPoses.erase(iter);
+  }
+}
+
+void SimulationFeatures::Write(ChangedWorldPosesStream &_stream) const
+{
+  this->poseStreamEncoder.BeginFrame(_stream.frame);
+  for (const auto &[id, info] : this->links.idToObject)
+  {
+    if (info && info->link)
+    {
+      const Eigen::Isometry3d &tf = info->link->getWorldTransform();
+      const Eigen::Quaterniond rot(tf.linear());
+      this->poseStreamEncoder.Add(
+          id, tf.translation().x(), tf.translation().y(),
+          tf.translation().z(), rot.w(), rot.x(), rot.y(), rot.z());
+    }
+  }
+  this->poseStreamEncoder.EndFrame();
 }
 
 std::vector<SimulationFeatures::ContactInternal>
@@ -170,7 +1075,8 @@ SimulationFeatures::GetContactsFromLastStep(const Identity &_worldID) const
 {
   std::vector<SimulationFeatures::ContactInternal> outContacts;
   auto *const world = this->ReferenceInterface<DartWorld>(_worldID);
-  const auto colResult = world->getLastCollisionResult();
+  const auto &colResult = world->getLastCollisionResult();
+  outContacts.reserve(colResult.getNumContacts());
 
   for (const auto &dtContact : colResult.getContacts())
   {
@@ -229,6 +1135,10 @@ void SimulationFeatures::AddContactPropertiesCallback(
 
   auto handler = std::make_shared<GzContactSurfaceHandler>();
   handler->surfaceParamsCallback = _callback;
+  // The handler that was added last creates the contact constraints, so it
+  // warm starts them too
+  handler->impulseCache = this->ContactImpulseCacheOf(_worldID.id);
+  handler->impulseCache->handlerInstalled = true;
   handler->convertContact = [this](const dart::collision::Contact& _contact) {
     return this->convertContact(_contact);
   };
@@ -247,7 +1157,13 @@ bool SimulationFeatures::RemoveContactPropertiesCallback(
   {
     const auto handler = this->contactSurfaceHandlers[_callbackID];
     this->contactSurfaceHandlers.erase(_callbackID);
-    return world->getConstraintSolver()->removeContactSurfaceHandler(handler);
+    if (!world->getConstraintSolver()->removeContactSurfaceHandler(handler))
+      return false;
+
+    // The removed handler may have been the one that warm started the
+    // contacts, so make sure that the last handler still does
+    this->InstallWarmStartHandler(_worldID.id);
+    return true;
   }
   else
   {
@@ -365,34 +1281,26 @@ dart::constraint::ContactSurfaceParams GzContactSurfaceHandler::createParams(
   return pDart;
 }
 
-dart::constraint::ContactConstraintPtr
-GzContactSurfaceHandler::createConstraint(
-  dart::collision::Contact& _contact,
-  const size_t _numContactsOnCollisionObject,
-  const double _timeStep) const
+void GzContactSurfaceHandler::ConfigureConstraint(
+  dart::constraint::ContactConstraint &_constraint) const
 {
-  // this call sets this->lastGzParams
-  auto constraint = dart::constraint::ContactSurfaceHandler::createConstraint(
-    _contact, _numContactsOnCollisionObject, _timeStep);
-
+  // createParams, which was called for this constraint, set lastGzParams
   typedef SetContactPropertiesCallbackFeature F;
   typedef FeaturePolicy3d P;
   typename F::ContactSurfaceParams<P>& p = this->lastGzParams;
 
   if (this->lastGzParams.errorReductionParameter)
-    constraint->setErrorReductionParameter(p.errorReductionParameter.value());
+    _constraint.setErrorReductionParameter(p.errorReductionParameter.value());
 
   if (this->lastGzParams.maxErrorAllowance)
-    constraint->setErrorAllowance(p.maxErrorAllowance.value());
+    _constraint.setErrorAllowance(p.maxErrorAllowance.value());
 
   if (this->lastGzParams.maxErrorReductionVelocity)
-    constraint->setMaxErrorReductionVelocity(
+    _constraint.setMaxErrorReductionVelocity(
       p.maxErrorReductionVelocity.value());
 
   if (this->lastGzParams.constraintForceMixing)
-    constraint->setConstraintForceMixing(p.constraintForceMixing.value());
-
-  return constraint;
+    _constraint.setConstraintForceMixing(p.constraintForceMixing.value());
 }
 #endif
 
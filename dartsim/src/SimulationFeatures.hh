@@ -35,9 +35,13 @@
 #include <gz/physics/ForwardStep.hh>
 #include <gz/physics/GetContacts.hh>
 #include <gz/physics/ContactProperties.hh>
+#include <gz/physics/PoseStream.hh>
 #include <gz/physics/SpecifyData.hh>
+#include <gz/physics/StateLog.hh>
+#include <gz/physics/StateRecording.hh>
 
 #include "Base.hh"
+#include "ContactWarmStart.hh"
 
 namespace dart
 {
@@ -56,20 +60,20 @@ struct SimulationFeatureList : FeatureList<
 #ifdef DART_HAS_CONTACT_SURFACE
   SetContactPropertiesCallbackFeature,
 #endif
-  GetContactsFromLastStepFeature
+  GetContactsFromLastStepFeature,
+  RecordWorldState,
+  ReplayWorldState
 > { };
 
 #ifdef DART_HAS_CONTACT_SURFACE
-class GzContactSurfaceHandler : public dart::constraint::ContactSurfaceHandler
+class GzContactSurfaceHandler : public WarmStartContactSurfaceHandler
 {
   public: dart::constraint::ContactSurfaceParams createParams(
     const dart::collision::Contact& _contact,
     size_t _numContactsOnCollisionObject) const override;
 
-  public: dart::constraint::ContactConstraintPtr createConstraint(
-    dart::collision::Contact& _contact,
-    size_t _numContactsOnCollisionObject,
-    double _timeStep) const override;
+  public: void ConfigureConstraint(
+    dart::constraint::ContactConstraint &_constraint) const override;
 
   public: typedef SetContactPropertiesCallbackFeature Feature;
   public: typedef Feature::Implementation<FeaturePolicy3d> Impl;
@@ -110,13 +114,146 @@ class SimulationFeatures :
 
   public: void Write(ChangedWorldPoses &_changedPoses) const;
 
+  /// \brief Encode the link poses straight from the DART body nodes.
+  /// \param[out] _stream Stream frame of this step
+  public: void Write(ChangedWorldPosesStream &_stream) const;
+
   public: std::vector<ContactInternal> GetContactsFromLastStep(
       const Identity &_worldID) const override;
 
+  // Documentation inherited
+  public: bool WorldStartStateRecording(
+      const Identity &_worldID, const std::string &_path,
+      const StateLogOptions &_options) override;
+
+  // Documentation inherited
+  public: bool WorldStopStateRecording(const Identity &_worldID) override;
+
+  // Documentation inherited
+  public: bool WorldLoadStateLog(
+      const Identity &_worldID, const std::string &_path) override;
+
+  // Documentation inherited
+  public: void WorldUnloadStateLog(const Identity &_worldID) override;
+
+  // Documentation inherited
+  public: std::size_t GetWorldStateLogStepCount(
+      const Identity &_worldID) const override;
+
+  // Documentation inherited
+  public: bool WorldSeekStateLog(
+      const Identity &_worldID, std::size_t _index) override;
+
+  /// \brief Write the output of a step.
+  /// \param[out] _h Step output
+  private: void WriteStepOutput(ForwardStep::Output &_h);
+
+  /// \brief Append the current state of a world to its state log.
+  /// \param[in] _worldID World to record
+  /// \param[in] _world The DART world
+  /// \param[in] _log Log to append to
+  private: void RecordState(const Identity &_worldID, const DartWorld &_world,
+                            StateLogWriter &_log) const;
+
+  /// \brief Set the state of the links and joints of a logged step
+  /// kinematically. Links are placed through the free joints of their
+  /// skeletons, and every other link follows from the joint positions.
+  /// \param[in] _step Logged step
+  private: void ApplyLoggedStep(const StateLogStep &_step);
+
+  /// \brief Turn the servo commands into implicit joint springs and dampers
+  /// for the next step. The overridden parameters are saved in servoAxes.
+  /// \param[in] _world World that is about to be stepped
+  /// \param[in] _servos Servo commands of this step
+  private: void ApplyServoCommands(
+      DartWorld *_world, const JointServoCommands &_servos);
+
+  /// \brief Restore the joint spring and damper parameters that were
+  /// overridden by ApplyServoCommands.
+  private: void RestoreServoAxes();
+
+  /// \brief Wake the sleeping models of a world up that are touched by
+  /// moving models, together with the sleeping models that touch them.
+  /// \param[in] _world World that is about to be stepped
+  /// \param[in] _sleep Sleep state of the world
+  private: void WakeTouchedModels(DartWorld *_world, WorldSleepInfo &_sleep);
+
+  /// \brief Update the rest time of the awake models of a world after a
+  /// step, and put the islands of touching models to sleep whose models all
+  /// rested long enough.
+  /// \param[in] _worldID ID of the world
+  /// \param[in] _world World that was stepped
+  /// \param[in] _sleep Sleep state of the world
+  private: void UpdateSleep(std::size_t _worldID, DartWorld *_world,
+                            WorldSleepInfo &_sleep);
+
+  /// \brief Promote the kinematic proxies of a world that are touched by
+  /// moving models.
+  /// \param[in] _world World that is about to be stepped
+  /// \param[in] _lod Level of detail state of the world
+  private: void PromoteTouchedModels(
+      DartWorld *_world, WorldLevelOfDetailInfo &_lod);
+
+  /// \brief Promote the kinematic proxies of a world that came close to a
+  /// focus model after a step, and demote the models that are far from all
+  /// of them or that stayed idle long enough. Models that touch a mobile
+  /// model which stays dynamic are not demoted.
+  /// \param[in] _worldID ID of the world
+  /// \param[in] _world World that was stepped
+  /// \param[in] _lod Level of detail state of the world
+  private: void UpdateLevelOfDetail(std::size_t _worldID, DartWorld *_world,
+                                    WorldLevelOfDetailInfo &_lod);
+
+  /// \brief Sweep the motion of the links of a world that use continuous
+  /// collision detection, and slow the links down that would otherwise pass
+  /// through a collision during the step. Sleeping models and kinematic
+  /// proxies are swept against too, and the ones that are hit are woken up
+  /// and promoted.
+  /// \param[in] _world World that is about to be stepped
+  /// \param[in] _sleep Sleep state of the world, or nullptr
+  /// \param[in] _lod Level of detail state of the world, or nullptr
+  private: void SweepContinuousCollisionLinks(DartWorld *_world,
+      const WorldSleepInfo *_sleep, const WorldLevelOfDetailInfo *_lod);
+
+  /// \brief Spring and damper parameters of a joint axis that are
+  /// overridden by a servo command during a step.
+  private: struct ServoAxis
+  {
+    dart::dynamics::Joint *joint;
+    std::size_t dof;
+    double stiffness;
+    double damping;
+    double restPosition;
+  };
+
+  /// \brief Joint axes that are servoed during the current step. The buffer
+  /// is kept between steps to avoid reallocating it every step.
+  private: std::vector<ServoAxis> servoAxes;
+
   /// \brief link poses from the most recent pose change/update.
   /// The key is the link's ID, and the value is the link's pose
   private: mutable std::unordered_map<std::size_t, math::Pose3d> prevLinkPoses;
 
+  /// \brief Encoder of ChangedWorldPosesStream. It keeps the poses that were
+  /// last sent so that each frame only carries deltas.
+  private: mutable PoseStreamEncoder poseStreamEncoder;
+
+  /// \brief State logs of the worlds that are being recorded, by world ID
+  private: std::unordered_map<std::size_t, std::unique_ptr<StateLogWriter>>
+      stateRecorders;
+
+  /// \brief A state log that is being played back
+  private: struct StateReplay
+  {
+    std::unique_ptr<StateLogReader> log;
+
+    /// \brief Index of the next step to play back
+    std::size_t next = 0;
+  };
+
+  /// \brief State logs of the worlds that are being played back, by world ID
+  private: std::unordered_map<std::size_t, StateReplay> stateReplays;
+
   private: std::optional<ContactInternal> convertContact(
     const dart::collision::Contact& _contact) const;
 
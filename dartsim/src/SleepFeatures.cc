@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+
+#include <gz/common/Console.hh>
+
+#include "SleepFeatures.hh"
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+/////////////////////////////////////////////////
+void SleepFeatures::SetWorldSleepParameters(
+    const Identity &_worldID, const SleepParameters &_parameters)
+{
+  if (!(_parameters.linearVelocityThreshold >= 0.0) ||
+      !(_parameters.angularVelocityThreshold >= 0.0) ||
+      !(_parameters.timeThreshold >= 0.0) ||
+      !std::isfinite(_parameters.timeThreshold))
+  {
+    gzerr << "Ignoring sleep parameters with negative or invalid "
+          << "thresholds.\n";
+    return;
+  }
+
+  this->worldSleep[_worldID.id].parameters = _parameters;
+  if (!_parameters.enabled)
+    this->WakeWorld(_worldID.id);
+}
+
+/////////////////////////////////////////////////
+SleepParameters SleepFeatures::GetWorldSleepParameters(
+    const Identity &_worldID) const
+{
+  const auto it = this->worldSleep.find(_worldID.id);
+  if (it == this->worldSleep.end())
+    return SleepParameters();
+  return it->second.parameters;
+}
+
+/////////////////////////////////////////////////
+std::size_t SleepFeatures::GetWorldSleepingModelCount(
+    const Identity &_worldID) const
+{
+  const auto it = this->worldSleep.find(_worldID.id);
+  if (it == this->worldSleep.end())
+    return 0u;
+  return it->second.sleepingCount;
+}
+
+/////////////////////////////////////////////////
+bool SleepFeatures::GetModelSleeping(const Identity &_modelID) const
+{
+  const auto modelInfo = this->models.MaybeAt(_modelID.id);
+  return modelInfo && (*modelInfo)->sleeping;
+}
+
+/////////////////////////////////////////////////
+bool SleepFeatures::SetModelSleeping(
+    const Identity &_modelID, bool _sleeping)
+{
+  const auto modelInfo = this->models.MaybeAt(_modelID.id);
+  if (!modelInfo)
+    return false;
+
+  const std::size_t worldID = this->GetWorldOfModelImpl(_modelID.id);
+  if (!_sleeping)
+  {
+    this->WakeModel(worldID, **modelInfo);
+    return true;
+  }
+
+  const auto sleepIt = this->worldSleep.find(worldID);
+  if (sleepIt == this->worldSleep.end() || !sleepIt->second.parameters.enabled)
+  {
+    gzerr << "Unable to put model [" << (*modelInfo)->localName << "] to "
+          << "sleep: sleep is not enabled in its world.\n";
+    return false;
+  }
+  return this->SleepModel(worldID, **modelInfo);
+}
+
+}
+}
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_DARTSIM_SRC_SLEEPFEATURES_HH_
+#define GZ_PHYSICS_DARTSIM_SRC_SLEEPFEATURES_HH_
+
+#include <gz/physics/Sleep.hh>
+
+#include "Base.hh"
+
+namespace gz {
+namespace physics {
+namespace dartsim {
+
+struct SleepFeatureList : FeatureList<
+  SleepFeature
+> { };
+
+class SleepFeatures :
+    public virtual Base,
+    public virtual Implements3d<SleepFeatureList>
+{
+  // Documentation inherited
+  public: void SetWorldSleepParameters(
+      const Identity &_worldID, const SleepParameters &_parameters) override;
+
+  // Documentation inherited
+  public: SleepParameters GetWorldSleepParameters(
+      const Identity &_worldID) const override;
+
+  // Documentation inherited
+  public: std::size_t GetWorldSleepingModelCount(
+      const Identity &_worldID) const override;
+
+  // Documentation inherited
+  public: bool GetModelSleeping(const Identity &_modelID) const override;
+
+  // Documentation inherited
+  public: bool SetModelSleeping(
+      const Identity &_modelID, bool _sleeping) override;
+};
+
+}
+}
+}
+
+#endif
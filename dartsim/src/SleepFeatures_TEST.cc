@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include <gz/plugin/Loader.hh>
+#include <gz/physics/RequestEngine.hh>
+
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/FreeGroup.hh>
+#include <gz/physics/FrameSemantics.hh>
+#include <gz/physics/GetEntities.hh>
+#include <gz/physics/Link.hh>
+#include <gz/physics/Sleep.hh>
+#include <gz/physics/sdf/ConstructWorld.hh>
+
+#include <sdf/Root.hh>
+#include <sdf/World.hh>
+
+struct TestFeatureList : gz::physics::FeatureList<
+    gz::physics::ForwardStep,
+    gz::physics::sdf::ConstructSdfWorld,
+    gz::physics::GetEntities,
+    gz::physics::LinkFrameSemantics,
+    gz::physics::AddLinkExternalForceTorque,
+    gz::physics::FindFreeGroupFeature,
+    gz::physics::SetFreeGroupWorldPose,
+    gz::physics::SleepFeature
+> { };
+
+using namespace gz;
+
+using TestEnginePtr = physics::Engine3dPtr<TestFeatureList>;
+using TestWorldPtr = physics::World3dPtr<TestFeatureList>;
+
+/// \brief Number of boxes that rest on the ground
+constexpr std::size_t kNumBoxes = 3;
+
+//////////////////////////////////////////////////
+/// \brief A world with a ground plane and boxes that rest on it, 2 m apart
+std::string BoxesWorld()
+{
+  std::stringstream sdf;
+  sdf << R"(
+  <sdf version="1.9">
+    <world name="default">
+      <model name="ground">
+        <static>true</static>
+        <link name="link">
+          <collision name="collision">
+            <geometry><plane><normal>0 0 1</normal></plane></geometry>
+          </collision>
+        </link>
+      </model>)";
+  for (std::size_t i = 0; i < kNumBoxes; ++i)
+  {
+    sdf << R"(
+      <model name="box)" << i << R"(">
+        <pose>)" << 2.0 * static_cast<double>(i) << R"( 0 0.5 0 0 0</pose>
+        <link name="link">
+          <collision name="collision">
+            <geometry><box><size>1 1 1</size></box></geometry>
+          </collision>
+        </link>
+      </model>)";
+  }
+  sdf << R"(
+    </world>
+  </sdf>)";
+  return sdf.str();
+}
+
+//////////////////////////////////////////////////
+class SleepFeaturesFixture : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    gz::plugin::Loader loader;
+    loader.LoadLib(dartsim_plugin_LIB);
+
+    gz::plugin::PluginPtr dartsim =
+        loader.Instantiate("gz::physics::dartsim::Plugin");
+
+    this->engine =
+        gz::physics::RequestEngine3d<TestFeatureList>::From(dartsim);
+    ASSERT_NE(nullptr, this->engine);
+
+    sdf::Root root;
+    const sdf::Errors errors = root.LoadSdfString(BoxesWorld());
+    ASSERT_TRUE(errors.empty()) << errors;
+    this->world = this->engine->ConstructWorld(*root.WorldByIndex(0));
+    ASSERT_NE(nullptr, this->world);
+  }
+
+  /// \brief Step the world until the given number of models sleep
+  /// \param[in] _count Number of sleeping models to wait for
+  /// \return True if the models went to sleep within 5 s
+  protected: bool StepUntilSleeping(std::size_t _count)
+  {
+    physics::ForwardStep::Output output;
+    physics::ForwardStep::State state;
+    physics::ForwardStep::Input input;
+    for (std::size_t i = 0; i < 5000; ++i)
+    {
+      this->world->Step(output, state, input);
+      if (this->world->GetSleepingModelCount() == _count)
+        return true;
+    }
+    return false;
+  }
+
+  protected: TestEnginePtr engine;
+  protected: TestWorldPtr world;
+};
+
+//////////////////////////////////////////////////
+TEST_F(SleepFeaturesFixture, Parameters)
+{
+  // Sleep is disabled by default
+  EXPECT_FALSE(this->world->GetSleepParameters().enabled);
+  EXPECT_FALSE(this->world->GetModel("box0")->SetSleeping(true));
+  EXPECT_FALSE(this->world->GetModel("box0")->IsSleeping());
+
+  physics::SleepParameters parameters;
+  parameters.enabled = true;
+  parameters.timeThreshold = 0.2;
+  this->world->SetSleepParameters(parameters);
+  EXPECT_TRUE(this->world->GetSleepParameters().enabled);
+  EXPECT_DOUBLE_EQ(0.2, this->world->GetSleepParameters().timeThreshold);
+
+  // Invalid parameters are ignored
+  parameters.linearVelocityThreshold = -1.0;
+  this->world->SetSleepParameters(parameters);
+  EXPECT_DOUBLE_EQ(0.01,
+      this->world->GetSleepParameters().linearVelocityThreshold);
+
+  // Static models never sleep
+  EXPECT_FALSE(this->world->GetModel("ground")->SetSleeping(true));
+  EXPECT_TRUE(this->world->GetModel("box0")->SetSleeping(true));
+  EXPECT_TRUE(this->world->GetModel("box0")->IsSleeping());
+  EXPECT_EQ(1u, this->world->GetSleepingModelCount());
+}
+
+//////////////////////////////////////////////////
+TEST_F(SleepFeaturesFixture, RestingModelsSleep)
+{
+  physics::SleepParameters parameters;
+  parameters.enabled = true;
+  parameters.timeThreshold = 0.2;
+  this->world->SetSleepParameters(parameters);
+
+  ASSERT_TRUE(this->StepUntilSleeping(kNumBoxes));
+  auto link = this->world->GetModel("box0")->GetLink(0);
+  const auto pose = link->FrameDataRelativeToWorld().pose;
+
+  // Sleeping models do not move
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+  for (std::size_t i = 0; i < 100; ++i)
+    this->world->Step(output, state, input);
+  EXPECT_EQ(kNumBoxes, this->world->GetSleepingModelCount());
+  EXPECT_TRUE(pose.isApprox(link->FrameDataRelativeToWorld().pose));
+
+  // An external force wakes a model up
+  link->AddExternalForce(Eigen::Vector3d(0, 0, 1000));
+  EXPECT_FALSE(this->world->GetModel("box0")->IsSleeping());
+  this->world->Step(output, state, input);
+  EXPECT_LT(pose.translation().z(),
+            link->FrameDataRelativeToWorld().pose.translation().z());
+  EXPECT_EQ(kNumBoxes - 1, this->world->GetSleepingModelCount());
+
+  // So does writing its pose
+  ASSERT_TRUE(this->StepUntilSleeping(kNumBoxes));
+  auto freeGroup = this->world->GetModel("box1")->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  freeGroup->SetWorldPose(physics::Pose3d(
+      Eigen::Translation3d(4, 0, 2.0)));
+  EXPECT_FALSE(this->world->GetModel("box1")->IsSleeping());
+
+  // The box falls onto box2, which wakes it up
+  for (std::size_t i = 0; i < 1000 &&
+       this->world->GetModel("box2")->IsSleeping(); ++i)
+  {
+    this->world->Step(output, state, input);
+  }
+  EXPECT_FALSE(this->world->GetModel("box2")->IsSleeping());
+  EXPECT_TRUE(this->world->GetModel("box0")->IsSleeping());
+
+  // Disabling sleep wakes every model up
+  parameters.enabled = false;
+  this->world->SetSleepParameters(parameters);
+  EXPECT_EQ(0u, this->world->GetSleepingModelCount());
+  for (std::size_t i = 0; i < kNumBoxes; ++i)
+  {
+    EXPECT_FALSE(this->world->GetModel(
+        "box" + std::to_string(i))->IsSleeping());
+  }
+}
+
+//////////////////////////////////////////////////
+TEST_F(SleepFeaturesFixture, StackedModelsSleepTogether)
+{
+  // Stack two boxes on the ground, away from the others
+  auto freeGroup = this->world->GetModel("box0")->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  freeGroup->SetWorldPose(physics::Pose3d(Eigen::Translation3d(-4, 0, 0.5)));
+  freeGroup = this->world->GetModel("box1")->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  freeGroup->SetWorldPose(physics::Pose3d(Eigen::Translation3d(-4, 0, 1.5)));
+  freeGroup = this->world->GetModel("box2")->FindFreeGroup();
+  ASSERT_NE(nullptr, freeGroup);
+  freeGroup->SetWorldPose(physics::Pose3d(Eigen::Translation3d(4, 0, 10.0)));
+
+  physics::SleepParameters parameters;
+  parameters.enabled = true;
+  parameters.timeThreshold = 0.2;
+  this->world->SetSleepParameters(parameters);
+
+  // The stack goes to sleep as a whole and stays asleep, while the third box
+  // is still falling
+  ASSERT_TRUE(this->StepUntilSleeping(2));
+  EXPECT_TRUE(this->world->GetModel("box0")->IsSleeping());
+  EXPECT_TRUE(this->world->GetModel("box1")->IsSleeping());
+
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    this->world->Step(output, state, input);
+    EXPECT_EQ(2u, this->world->GetSleepingModelCount());
+  }
+  EXPECT_TRUE(this->world->GetModel("box0")->IsSleeping());
+  EXPECT_TRUE(this->world->GetModel("box1")->IsSleeping());
+
+  // Waking the bottom box up wakes the box that rests on it as well
+  this->world->GetModel("box0")->GetLink(0)->AddExternalForce(
+      Eigen::Vector3d(1000, 0, 0));
+  this->world->Step(output, state, input);
+  EXPECT_FALSE(this->world->GetModel("box0")->IsSleeping());
+  EXPECT_FALSE(this->world->GetModel("box1")->IsSleeping());
+}
+
+//////////////////////////////////////////////////
+TEST_F(SleepFeaturesFixture, ModelsWithoutSleepDoNotSleep)
+{
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+  for (std::size_t i = 0; i < 1000; ++i)
+    this->world->Step(output, state, input);
+  EXPECT_EQ(0u, this->world->GetSleepingModelCount());
+}
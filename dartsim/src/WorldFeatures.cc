@@ -15,6 +15,7 @@
  *
  */
 
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -23,8 +24,12 @@
 #include <dart/collision/fcl/FCLCollisionDetector.hpp>
 #include <dart/constraint/BoxedLcpConstraintSolver.hpp>
 #include <dart/constraint/ConstraintSolver.hpp>
+#include <dart/constraint/ContactConstraint.hpp>
 #include <dart/constraint/DantzigBoxedLcpSolver.hpp>
 #include <dart/constraint/PgsBoxedLcpSolver.hpp>
+#include <dart/dynamics/DegreeOfFreedom.hpp>
+#include <dart/dynamics/HeightmapShape.hpp>
+#include <dart/dynamics/MeshShape.hpp>
 #include <dart/simulation/World.hpp>
 
 #include <gz/common/Console.hh>
@@ -37,6 +42,69 @@ namespace gz {
 namespace physics {
 namespace dartsim {
 
+namespace {
+/////////////////////////////////////////////////
+/// \brief Estimate of the memory held by one element of a std::unordered_map:
+/// the node with its value, next pointer and cached hash, and one bucket.
+template <typename MapT>
+constexpr std::size_t HashMapEntrySize()
+{
+  return sizeof(typename MapT::value_type) + 3 * sizeof(void *);
+}
+
+/////////////////////////////////////////////////
+/// \brief Estimate of the memory held by one entity of an EntityStorage,
+/// including the info structure and the control block of its shared_ptr.
+template <typename StorageT, typename InfoT>
+constexpr std::size_t EntityStorageEntrySize()
+{
+  return HashMapEntrySize<decltype(StorageT::idToObject)>() +
+         HashMapEntrySize<decltype(StorageT::objectToID)>() +
+         HashMapEntrySize<decltype(StorageT::idToIndexInContainer)>() +
+         HashMapEntrySize<decltype(StorageT::idToContainerID)>() +
+         sizeof(std::size_t) + sizeof(InfoT) + 2 * sizeof(void *);
+}
+
+/////////////////////////////////////////////////
+/// \brief Estimate of the memory held by the geometry of a shape.
+std::size_t ShapeGeometrySize(const dart::dynamics::Shape &_shape)
+{
+  if (const auto *mesh =
+      dynamic_cast<const dart::dynamics::MeshShape *>(&_shape))
+  {
+    std::size_t size = sizeof(dart::dynamics::MeshShape);
+    const aiScene *scene = mesh->getMesh();
+    if (!scene)
+      return size;
+
+    // Meshes are triangulated when they are loaded. The collision detector
+    // builds its own copy of the vertices and triangles, which is about as
+    // large as the assimp scene.
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+    {
+      const aiMesh *subMesh = scene->mMeshes[i];
+      const std::size_t vertices = subMesh->mNumVertices *
+          sizeof(aiVector3D) * (subMesh->HasNormals() ? 2 : 1);
+      const std::size_t faces = subMesh->mNumFaces *
+          (sizeof(aiFace) + 3 * sizeof(unsigned int));
+      size += sizeof(aiMesh) + 2 * (vertices + faces);
+    }
+    return size;
+  }
+
+  if (const auto *heightmap =
+      dynamic_cast<const dart::dynamics::HeightmapShape<float> *>(&_shape))
+  {
+    return sizeof(*heightmap) +
+        static_cast<std::size_t>(heightmap->getHeightField().size()) *
+        sizeof(float);
+  }
+
+  // Primitive shapes only hold a few parameters
+  return sizeof(dart::dynamics::Shape);
+}
+}  // namespace
+
 /////////////////////////////////////////////////
 void WorldFeatures::SetWorldCollisionDetector(
     const Identity &_id, const std::string &_collisionDetector)
@@ -67,6 +135,10 @@ void WorldFeatures::SetWorldCollisionDetector(
            << collisionDetector->getType() << "]." << std::endl;
   }
 
+  // The sleeping and proxy collision groups were created by the previous
+  // detector
+  this->WakeWorld(_id.id);
+  this->PromoteWorld(_id.id);
   world->getConstraintSolver()->setCollisionDetector(collisionDetector);
 
   gzmsg << "Using [" << world->getConstraintSolver()->getCollisionDetector()
@@ -162,7 +234,13 @@ void WorldFeatures::SetWorldSolver(const Identity &_id,
   }
   else if (_solver == "pgs" || _solver == "PgsBoxedLcpSolver")
   {
-    boxedSolver = std::make_shared<dart::constraint::PgsBoxedLcpSolver>();
+    // DART's own solver and its stopping test are kept until the iterations
+    // of the world are set
+    const auto it = this->solverIterations.find(_id.id);
+    if (it != this->solverIterations.end())
+      boxedSolver = std::make_shared<AdaptivePgsBoxedLcpSolver>(it->second);
+    else
+      boxedSolver = std::make_shared<dart::constraint::PgsBoxedLcpSolver>();
   }
   else
   {
@@ -196,6 +274,195 @@ const std::string &WorldFeatures::GetWorldSolver(const Identity &_id) const
   return solver->getBoxedLcpSolver()->getType();
 }
 
+/////////////////////////////////////////////////
+bool WorldFeatures::SetWorldSolverIterations(const Identity &_id,
+    const SolverIterationParameters &_parameters)
+{
+  if (!(_parameters.residualTolerance >= 0.0) ||
+      !std::isfinite(_parameters.residualTolerance) ||
+      _parameters.maxIterations == 0u ||
+      _parameters.minIterations > _parameters.maxIterations)
+  {
+    gzerr << "Ignoring solver iteration parameters with an invalid residual "
+          << "tolerance or iteration range.\n";
+    return false;
+  }
+
+  // Only the PGS solver iterates. The parameters are kept for when the world
+  // switches to it.
+  const auto &state = this->SolverIterationStateOf(_id.id);
+  state->parameters = _parameters;
+
+  // A world that already uses DART's PGS solver switches to the adaptive
+  // one, which keeps the options of the solver that it replaces
+  auto world = this->ReferenceInterface<dart::simulation::World>(_id);
+  auto *solver = dynamic_cast<dart::constraint::BoxedLcpConstraintSolver *>(
+      world->getConstraintSolver());
+  if (solver)
+  {
+    auto pgs = std::dynamic_pointer_cast<dart::constraint::PgsBoxedLcpSolver>(
+        solver->getBoxedLcpSolver());
+    if (pgs && !std::dynamic_pointer_cast<AdaptivePgsBoxedLcpSolver>(pgs))
+    {
+      auto adaptive = std::make_shared<AdaptivePgsBoxedLcpSolver>(state);
+      adaptive->setOption(pgs->getOption());
+      solver->setBoxedLcpSolver(adaptive);
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+SolverIterationParameters WorldFeatures::GetWorldSolverIterations(
+    const Identity &_id) const
+{
+  const auto it = this->solverIterations.find(_id.id);
+  if (it == this->solverIterations.end())
+    return SolverIterationState().parameters;
+  return it->second->parameters;
+}
+
+/////////////////////////////////////////////////
+bool WorldFeatures::SetWorldSolverWarmStart(const Identity &_id,
+    const SolverWarmStartParameters &_parameters)
+{
+#ifdef DART_HAS_CONTACT_SURFACE
+  if (!(_parameters.factor >= 0.0 && _parameters.factor <= 1.0) ||
+      !(_parameters.matchingDistance >= 0.0) ||
+      !std::isfinite(_parameters.matchingDistance))
+  {
+    gzerr << "Ignoring solver warm start parameters with a factor outside of "
+          << "[0, 1] or an invalid matching distance.\n";
+    return false;
+  }
+
+  const auto &cache = this->ContactImpulseCacheOf(_id.id);
+  cache->parameters = _parameters;
+  if (!cache->handlerInstalled)
+    this->InstallWarmStartHandler(_id.id);
+
+  if (_parameters.enabled)
+  {
+    auto world = this->ReferenceInterface<dart::simulation::World>(_id);
+    auto solver = dynamic_cast<dart::constraint::BoxedLcpConstraintSolver *>(
+        world->getConstraintSolver());
+    if (solver && solver->getBoxedLcpSolver()->getType() !=
+        dart::constraint::PgsBoxedLcpSolver::getStaticType())
+    {
+      gzwarn << "Warm starting only speeds up iterative solvers, but the "
+             << "world uses [" << solver->getBoxedLcpSolver()->getType()
+             << "]. Use the [pgs] solver to benefit from it.\n";
+    }
+  }
+  return true;
+#else
+  (void)_id;
+  if (_parameters.enabled)
+  {
+    gzwarn << "Solver warm starting requires a version of DART that supports "
+           << "contact surface customizations.\n";
+    return false;
+  }
+  return true;
+#endif
+}
+
+/////////////////////////////////////////////////
+SolverWarmStartParameters WorldFeatures::GetWorldSolverWarmStart(
+    const Identity &_id) const
+{
+  const auto it = this->contactImpulseCaches.find(_id.id);
+  if (it == this->contactImpulseCaches.end())
+    return SolverWarmStartParameters();
+  return it->second->parameters;
+}
+
+/////////////////////////////////////////////////
+std::size_t WorldFeatures::GetWorldWarmStartedContactCount(
+    const Identity &_id) const
+{
+  const auto it = this->contactImpulseCaches.find(_id.id);
+  if (it == this->contactImpulseCaches.end())
+    return 0u;
+  return it->second->warmStartedCount;
+}
+
+/////////////////////////////////////////////////
+WorldMemoryUsage WorldFeatures::GetWorldMemoryUsage(const Identity &_id) const
+{
+  WorldMemoryUsage usage;
+  auto world = this->ReferenceInterface<dart::simulation::World>(_id);
+
+  using LinkStorage = decltype(this->links);
+  using JointStorage = decltype(this->joints);
+  using ShapeStorage = decltype(this->shapes);
+  using ModelStorage = decltype(this->models);
+  constexpr std::size_t linkEntrySize =
+      EntityStorageEntrySize<LinkStorage, LinkInfo>() +
+      HashMapEntrySize<decltype(this->linksByName)>() +
+      HashMapEntrySize<decltype(this->frames)>();
+  constexpr std::size_t jointEntrySize =
+      EntityStorageEntrySize<JointStorage, JointInfo>() +
+      HashMapEntrySize<decltype(this->jointsByName)>();
+  constexpr std::size_t shapeEntrySize =
+      EntityStorageEntrySize<ShapeStorage, ShapeInfo>();
+  constexpr std::size_t modelEntrySize =
+      EntityStorageEntrySize<ModelStorage, ModelInfo>() +
+      HashMapEntrySize<decltype(this->frames)>();
+
+  for (std::size_t i = 0; i < world->getNumSkeletons(); ++i)
+  {
+    const auto skeleton = world->getSkeleton(i);
+    const std::size_t dofs = skeleton->getNumDofs();
+
+    // A skeleton caches its mass matrix, augmented mass matrix and their
+    // inverses, each of which is dofs x dofs.
+    usage.articulatedBodies += sizeof(DartSkeleton) +
+        4 * dofs * dofs * sizeof(double) +
+        skeleton->getNumBodyNodes() * sizeof(DartBodyNode) +
+        skeleton->getNumJoints() * sizeof(DartJoint) +
+        dofs * sizeof(dart::dynamics::DegreeOfFreedom) +
+        skeleton->getNumShapeNodes() * sizeof(DartShapeNode);
+
+    if (this->models.HasEntity(DartConstSkeletonPtr(skeleton)))
+      usage.entityBookkeeping += modelEntrySize;
+
+    for (std::size_t b = 0; b < skeleton->getNumBodyNodes(); ++b)
+    {
+      const DartBodyNode *bn = skeleton->getBodyNode(b);
+      if (this->links.HasEntity(bn))
+        usage.entityBookkeeping += linkEntrySize;
+      if (this->joints.HasEntity(bn->getParentJoint()))
+        usage.entityBookkeeping += jointEntrySize;
+    }
+
+    for (std::size_t s = 0; s < skeleton->getNumShapeNodes(); ++s)
+    {
+      const DartShapeNode *shapeNode = skeleton->getShapeNode(s);
+      if (this->shapes.HasEntity(shapeNode))
+        usage.entityBookkeeping += shapeEntrySize;
+
+      if (const auto shape = shapeNode->getShape())
+        usage.collisionGeometry += ShapeGeometrySize(*shape);
+    }
+  }
+
+  // Contact constraints are rebuilt from the contacts of every step, so they
+  // are counted along with the contacts.
+  const auto &result = world->getLastCollisionResult();
+  usage.contactCaches += result.getNumContacts() *
+      (sizeof(dart::collision::Contact) +
+       sizeof(dart::constraint::ContactConstraint));
+  usage.contactCaches += world->getConstraintSolver()->getNumConstraints() *
+      sizeof(dart::constraint::ConstraintBase);
+
+  const auto cacheIt = this->contactImpulseCaches.find(_id.id);
+  if (cacheIt != this->contactImpulseCaches.end())
+    usage.contactCaches += cacheIt->second->MemoryUsage();
+
+  return usage;
+}
+
 }
 }
 }
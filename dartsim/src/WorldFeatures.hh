@@ -31,8 +31,11 @@ namespace dartsim {
 struct WorldFeatureList : FeatureList<
   CollisionDetector,
   CollisionPairMaxContacts,
+  GetWorldMemoryUsage,
   Gravity,
-  Solver
+  Solver,
+  SolverIterations,
+  SolverWarmStart
 > { };
 
 class WorldFeatures :
@@ -68,6 +71,30 @@ class WorldFeatures :
 
   // Documentation inherited
   public: const std::string &GetWorldSolver(const Identity &_id) const override;
+
+  // Documentation inherited
+  public: bool SetWorldSolverIterations(const Identity &_id,
+      const SolverIterationParameters &_parameters) override;
+
+  // Documentation inherited
+  public: SolverIterationParameters GetWorldSolverIterations(
+      const Identity &_id) const override;
+
+  // Documentation inherited
+  public: bool SetWorldSolverWarmStart(const Identity &_id,
+      const SolverWarmStartParameters &_parameters) override;
+
+  // Documentation inherited
+  public: SolverWarmStartParameters GetWorldSolverWarmStart(
+      const Identity &_id) const override;
+
+  // Documentation inherited
+  public: std::size_t GetWorldWarmStartedContactCount(
+      const Identity &_id) const override;
+
+  // Documentation inherited
+  public: WorldMemoryUsage GetWorldMemoryUsage(const Identity &_id)
+      const override;
 };
 
 }
@@ -18,19 +18,25 @@
 #include <gtest/gtest.h>
 
 #include <gz/common/Console.hh>
+#include <gz/common/geospatial/ImageHeightmap.hh>
+#include <gz/physics/ConstructEmpty.hh>
 #include <gz/physics/FindFeatures.hh>
 #include <gz/plugin/Loader.hh>
 #include <gz/physics/RequestEngine.hh>
 
+#include <gz/physics/ContactProperties.hh>
 #include <gz/physics/ForwardStep.hh>
 #include <gz/physics/FrameSemantics.hh>
+#include <gz/physics/GetContacts.hh>
 #include <gz/physics/GetBoundingBox.hh>
 #include <gz/physics/World.hh>
+#include <gz/physics/heightmap/HeightmapShape.hh>
 #include <gz/physics/sdf/ConstructWorld.hh>
 
 #include <sdf/Root.hh>
 #include <sdf/World.hh>
 
+#include "test/Resources.hh"
 #include "test/Utils.hh"
 #include "test/common_test/Worlds.hh"
 
@@ -39,9 +45,15 @@ struct TestFeatureList : gz::physics::FeatureList<
     gz::physics::Gravity,
     gz::physics::LinkFrameSemantics,
     gz::physics::Solver,
+    gz::physics::SolverIterations,
+    gz::physics::SolverWarmStart,
     gz::physics::ForwardStep,
     gz::physics::sdf::ConstructSdfWorld,
-    gz::physics::GetEntities
+    gz::physics::GetEntities,
+    gz::physics::GetWorldMemoryUsage,
+    gz::physics::ConstructEmptyModelFeature,
+    gz::physics::ConstructEmptyLinkFeature,
+    gz::physics::heightmap::AttachHeightmapShapeFeature
 > { };
 
 using namespace gz;
@@ -118,3 +130,206 @@ TEST_F(WorldFeaturesFixture, Solver)
   world->SetSolver("pgs");
   EXPECT_EQ("PgsBoxedLcpSolver", world->GetSolver());
 }
+
+//////////////////////////////////////////////////
+TEST_F(WorldFeaturesFixture, MemoryUsage)
+{
+  const auto world = LoadWorld(this->engine, common_test::worlds::kShapesWorld);
+  const auto shapes = world->GetMemoryUsage();
+  EXPECT_LT(0u, shapes.collisionGeometry);
+  EXPECT_LT(0u, shapes.articulatedBodies);
+  EXPECT_LT(0u, shapes.entityBookkeeping);
+  EXPECT_EQ(shapes.collisionGeometry + shapes.articulatedBodies +
+            shapes.entityBookkeeping + shapes.contactCaches, shapes.Total());
+
+  // The heightfield holds a float per sample, which dominates the geometry
+  common::ImageHeightmap data;
+  ASSERT_EQ(0, data.Load(gz::physics::test::resources::kHeightmapBowlPng));
+  auto model = world->ConstructEmptyModel("heightmap_model");
+  ASSERT_NE(nullptr, model);
+  auto link = model->ConstructEmptyLink("heightmap_link");
+  ASSERT_NE(nullptr, link);
+  ASSERT_NE(nullptr, link->AttachHeightmapShape("heightmap", data,
+      Eigen::Isometry3d::Identity(), Eigen::Vector3d(129, 129, 10)));
+
+  const auto heightmap = world->GetMemoryUsage();
+  const std::size_t samples = data.Width() * data.Height();
+  EXPECT_LE(shapes.collisionGeometry + samples * sizeof(float),
+            heightmap.collisionGeometry);
+  EXPECT_LT(shapes.articulatedBodies, heightmap.articulatedBodies);
+  EXPECT_LT(shapes.entityBookkeeping, heightmap.entityBookkeeping);
+
+  // A handful of shapes and a small heightmap use well under a megabyte
+  EXPECT_GT(1024u * 1024u, heightmap.Total());
+
+  // Worlds are accounted separately
+  const auto empty = LoadWorld(this->engine, common_test::worlds::kEmptySdf);
+  const auto emptyUsage = empty->GetMemoryUsage();
+  EXPECT_EQ(0u, emptyUsage.collisionGeometry);
+  EXPECT_EQ(0u, emptyUsage.articulatedBodies);
+  EXPECT_GT(shapes.Total(), emptyUsage.Total());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldFeaturesFixture, SolverWarmStart)
+{
+  const auto world = LoadWorld(this->engine, common_test::worlds::kContactSdf);
+  EXPECT_FALSE(world->GetSolverWarmStart().enabled);
+  EXPECT_EQ(0u, world->GetWarmStartedContactCount());
+
+  physics::SolverWarmStartParameters parameters;
+  parameters.enabled = true;
+  parameters.factor = 2.0;
+  EXPECT_FALSE(world->SetSolverWarmStart(parameters));
+  EXPECT_FALSE(world->GetSolverWarmStart().enabled);
+
+  parameters.factor = 0.9;
+  world->SetSolver("pgs");
+
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+#ifdef DART_HAS_CONTACT_SURFACE
+  ASSERT_TRUE(world->SetSolverWarmStart(parameters));
+  EXPECT_TRUE(world->GetSolverWarmStart().enabled);
+  EXPECT_DOUBLE_EQ(0.9, world->GetSolverWarmStart().factor);
+
+  // The spheres rest on the ground, so their contacts persist from one step
+  // to the next
+  for (std::size_t i = 0; i < 100; ++i)
+    world->Step(output, state, input);
+  EXPECT_LT(0u, world->GetWarmStartedContactCount());
+
+  parameters.enabled = false;
+  EXPECT_TRUE(world->SetSolverWarmStart(parameters));
+  world->Step(output, state, input);
+  EXPECT_EQ(0u, world->GetWarmStartedContactCount());
+#else
+  EXPECT_FALSE(world->SetSolverWarmStart(parameters));
+  world->Step(output, state, input);
+  EXPECT_EQ(0u, world->GetWarmStartedContactCount());
+#endif
+}
+
+#ifdef DART_HAS_CONTACT_SURFACE
+//////////////////////////////////////////////////
+struct ContactCallbackFeatureList : gz::physics::FeatureList<
+    TestFeatureList,
+    gz::physics::GetContactsFromLastStepFeature,
+    gz::physics::SetContactPropertiesCallbackFeature
+> { };
+
+//////////////////////////////////////////////////
+TEST(WorldFeatures_TEST, SolverWarmStartAfterContactCallback)
+{
+  gz::plugin::Loader loader;
+  loader.LoadLib(dartsim_plugin_LIB);
+  gz::plugin::PluginPtr dartsim =
+      loader.Instantiate("gz::physics::dartsim::Plugin");
+  auto engine =
+      gz::physics::RequestEngine3d<ContactCallbackFeatureList>::From(dartsim);
+  ASSERT_NE(nullptr, engine);
+
+  sdf::Root root;
+  ASSERT_TRUE(root.Load(common_test::worlds::kContactSdf).empty());
+  auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+  ASSERT_NE(nullptr, world);
+  world->SetSolver("pgs");
+
+  // The contact properties handler warm starts the contacts while it is the
+  // last handler of the solver
+  world->AddContactPropertiesCallback("callback",
+      [](const auto &, std::size_t, auto &) {});
+
+  physics::SolverWarmStartParameters parameters;
+  parameters.enabled = true;
+  ASSERT_TRUE(world->SetSolverWarmStart(parameters));
+
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+  for (std::size_t i = 0; i < 100; ++i)
+    world->Step(output, state, input);
+  EXPECT_LT(0u, world->GetWarmStartedContactCount());
+
+  // Contacts are still warm started once it is removed
+  EXPECT_TRUE(world->RemoveContactPropertiesCallback("callback"));
+  for (std::size_t i = 0; i < 10; ++i)
+    world->Step(output, state, input);
+  EXPECT_LT(0u, world->GetWarmStartedContactCount());
+}
+#endif
+
+//////////////////////////////////////////////////
+TEST_F(WorldFeaturesFixture, SolverIterations)
+{
+  const auto world = LoadWorld(this->engine, common_test::worlds::kContactSdf);
+
+  physics::SolverIterationParameters parameters;
+  parameters.minIterations = 5;
+  parameters.maxIterations = 4;
+  EXPECT_FALSE(world->SetSolverIterations(parameters));
+  EXPECT_EQ(30u, world->GetSolverIterations().maxIterations);
+
+  parameters.minIterations = 2;
+  parameters.maxIterations = 20;
+  parameters.residualTolerance = 1e-4;
+  ASSERT_TRUE(world->SetSolverIterations(parameters));
+  EXPECT_EQ(2u, world->GetSolverIterations().minIterations);
+  EXPECT_EQ(20u, world->GetSolverIterations().maxIterations);
+  EXPECT_DOUBLE_EQ(1e-4, world->GetSolverIterations().residualTolerance);
+
+  // Statistics are written when the output asks for them
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+  output.Get<physics::SolverStatistics>();
+
+  // The Dantzig solver does not iterate
+  world->Step(output, state, input);
+  EXPECT_EQ(0u, output.Get<physics::SolverStatistics>().iterations);
+
+  // The spheres fall onto the ground and come to rest, after which the PGS
+  // solver converges before its iteration limit
+  world->SetSolver("pgs");
+  for (std::size_t i = 0; i < 500; ++i)
+    world->Step(output, state, input);
+  const auto statistics = output.Get<physics::SolverStatistics>();
+  EXPECT_LT(0u, statistics.solves);
+  EXPECT_LE(2u, statistics.iterations);
+  EXPECT_GT(20u, statistics.iterations);
+
+  // Without a tolerance, the solver always runs its iteration limit
+  parameters.residualTolerance = 0.0;
+  ASSERT_TRUE(world->SetSolverIterations(parameters));
+  world->Step(output, state, input);
+  EXPECT_EQ(20u, output.Get<physics::SolverStatistics>().iterations);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldFeaturesFixture, PgsSolverWithoutIterations)
+{
+  const auto world = LoadWorld(this->engine, common_test::worlds::kContactSdf);
+
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+  output.Get<physics::SolverStatistics>();
+
+  // Worlds that never set their iterations keep DART's own PGS solver, which
+  // does not report statistics
+  world->SetSolver("pgs");
+  EXPECT_EQ("PgsBoxedLcpSolver", world->GetSolver());
+  for (std::size_t i = 0; i < 10; ++i)
+    world->Step(output, state, input);
+  EXPECT_EQ(0u, output.Get<physics::SolverStatistics>().solves);
+
+  // Setting the iterations switches the world to the adaptive solver
+  physics::SolverIterationParameters parameters;
+  parameters.maxIterations = 7;
+  ASSERT_TRUE(world->SetSolverIterations(parameters));
+  EXPECT_EQ("PgsBoxedLcpSolver", world->GetSolver());
+  world->Step(output, state, input);
+  EXPECT_LT(0u, output.Get<physics::SolverStatistics>().solves);
+  EXPECT_EQ(7u, output.Get<physics::SolverStatistics>().iterations);
+}
@@ -19,13 +19,16 @@
 
 #include "Base.hh"
 #include "AddedMassFeatures.hh"
+#include "ContinuousCollisionFeatures.hh"
 #include "CustomFeatures.hh"
 #include "JointFeatures.hh"
 #include "KinematicsFeatures.hh"
+#include "LevelOfDetailFeatures.hh"
 #include "LinkFeatures.hh"
 #include "SDFFeatures.hh"
 #include "ShapeFeatures.hh"
 #include "SimulationFeatures.hh"
+#include "SleepFeatures.hh"
 #include "EntityManagementFeatures.hh"
 #include "FreeGroupFeatures.hh"
 #include "WorldFeatures.hh"
@@ -36,30 +39,37 @@ namespace dartsim {
 
 struct DartsimFeatures : FeatureList<
   AddedMassFeatureList,
+  ContinuousCollisionFeatureList,
   CustomFeatureList,
+  EngineMemoryResourceFeature,
   EntityManagementFeatureList,
   FreeGroupFeatureList,
   JointFeatureList,
   KinematicsFeatureList,
+  LevelOfDetailFeatureList,
   LinkFeatureList,
   SDFFeatureList,
   ShapeFeatureList,
   SimulationFeatureList,
+  SleepFeatureList,
   WorldFeatureList
 > { };
 
 class Plugin :
     public virtual Base,
     public virtual AddedMassFeatures,
+    public virtual ContinuousCollisionFeatures,
     public virtual CustomFeatures,
     public virtual EntityManagementFeatures,
     public virtual FreeGroupFeatures,
     public virtual JointFeatures,
     public virtual KinematicsFeatures,
+    public virtual LevelOfDetailFeatures,
     public virtual LinkFeatures,
     public virtual SDFFeatures,
     public virtual ShapeFeatures,
     public virtual SimulationFeatures,
+    public virtual SleepFeatures,
     public virtual WorldFeatures { };
 
 namespace {
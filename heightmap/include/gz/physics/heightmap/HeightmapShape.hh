@@ -19,6 +19,7 @@
 #define GZ_PHYSICS_HEIGHTMAP_HEIGHTMAPSHAPE_HH_
 
 #include <string>
+#include <vector>
 
 #include <gz/common/geospatial/HeightmapData.hh>
 
@@ -107,6 +108,57 @@ namespace heightmap
           int _subSampling) = 0;
     };
   };
+
+  /////////////////////////////////////////////////
+  /// \brief Query the surface of a heightmap at many points at once, for
+  /// example to keep a large number of agents on the ground.
+  class GetHeightmapShapeHeightsFeature
+      : public virtual FeatureWithRequirements<HeightmapShapeCast>
+  {
+    public: template <typename PolicyT, typename FeaturesT>
+    class HeightmapShape : public virtual Entity<PolicyT, FeaturesT>
+    {
+      public: using Scalar = typename PolicyT::Scalar;
+
+      public: using Point = Vector<Scalar, 2>;
+
+      public: using Normal =
+          typename FromPolicy<PolicyT>::template Use<LinearVector>;
+
+      /// \brief Get the height and normal of the heightmap surface at
+      /// points given by their x and y coordinates in the world frame. The
+      /// heights are interpolated between the samples of the heightmap. The
+      /// heightmap is expected to be upright, i.e. only rotated about the
+      /// world z axis.
+      /// \param[in] _points X and Y coordinates in the world frame.
+      /// \param[out] _heights World z coordinates of the surface, NaN for
+      /// the points that are not above the heightmap.
+      /// \param[out] _normals Unit normals of the surface in the world frame,
+      /// the world z axis for the points that are not above the heightmap.
+      /// \return The number of points that are above the heightmap.
+      public: std::size_t GetHeightsAndNormals(
+          const std::vector<Point> &_points,
+          std::vector<Scalar> &_heights,
+          std::vector<Normal> &_normals) const;
+    };
+
+    public: template <typename PolicyT>
+    class Implementation : public virtual Feature::Implementation<PolicyT>
+    {
+      public: using Scalar = typename PolicyT::Scalar;
+
+      public: using Point = Vector<Scalar, 2>;
+
+      public: using Normal =
+          typename FromPolicy<PolicyT>::template Use<LinearVector>;
+
+      public: virtual std::size_t GetHeightmapShapeHeightsAndNormals(
+          const Identity &_heightmapID,
+          const std::vector<Point> &_points,
+          std::vector<Scalar> &_heights,
+          std::vector<Normal> &_normals) const = 0;
+    };
+  };
 }
 }
 }
@@ -19,6 +19,7 @@
 #define GZ_PHYSICS_HEIGHTMAP_DETAIL_HEIGHTMAPSHAPE_HH_
 
 #include <string>
+#include <vector>
 
 #include <gz/physics/heightmap/HeightmapShape.hh>
 
@@ -52,6 +53,19 @@ namespace heightmap
               ->AttachHeightmapShape(this->identity, _name, _heightmapData,
               _pose, _size, _subSampling));
   }
+
+  /////////////////////////////////////////////////
+  template <typename PolicyT, typename FeaturesT>
+  std::size_t GetHeightmapShapeHeightsFeature::HeightmapShape<
+      PolicyT, FeaturesT>::GetHeightsAndNormals(
+      const std::vector<Point> &_points,
+      std::vector<Scalar> &_heights,
+      std::vector<Normal> &_normals) const
+  {
+    return this->template Interface<GetHeightmapShapeHeightsFeature>()
+        ->GetHeightmapShapeHeightsAndNormals(
+            this->identity, _points, _heights, _normals);
+  }
 }
 }
 }
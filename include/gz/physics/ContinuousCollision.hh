@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_CONTINUOUSCOLLISION_HH_
+#define GZ_PHYSICS_CONTINUOUSCOLLISION_HH_
+
+#include <gz/physics/FeatureList.hh>
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+/// \brief Parameters of the continuous collision detection of a link.
+struct ContinuousCollisionParameters
+{
+  /// \brief Whether the motion of the link is swept.
+  bool enabled = false;
+
+  /// \brief Distance that the link must travel during a step for its
+  /// motion to be swept, in m. Slower links only use the discrete contacts
+  /// of the world.
+  double motionThreshold = 0.0;
+
+  /// \brief Radius of the sphere that is swept along the motion of the
+  /// link, in m. It should fit inside the collisions of the link.
+  double sweptSphereRadius = 0.0;
+};
+
+/////////////////////////////////////////////////
+/// \brief Continuous collision detection keeps small and fast links from
+/// tunnelling through other collisions, without shortening the step of the
+/// whole world. Before each step, the motion of a flagged link is swept from
+/// its current pose. If it would hit a collision that it does not touch yet,
+/// its velocity towards that collision is reduced so that the link reaches
+/// it at the end of the step, and the contact is then resolved by the
+/// solver. Only flagged links pay the cost of the sweep.
+///
+/// The sweep is sampled rather than conservative: the link is collided at
+/// poses along its motion that are at most a swept sphere radius apart, so
+/// the swept sphere should fit inside the collisions of the link. Engines may
+/// cap the number of samples per step to bound its cost. dartsim collides
+/// at most 64 poses per step, so a link that travels more than 64 swept
+/// sphere radii in a step is sampled more sparsely and may pass through
+/// collisions that are thinner than the sample spacing. A warning is
+/// printed when that happens.
+///
+/// Only the canonical link of a free-floating model can be flagged, since
+/// the velocity of other links is set by their joints.
+class GZ_PHYSICS_VISIBLE ContinuousCollisionFeature : public virtual Feature
+{
+  /// \brief The Link API for continuous collision detection.
+  public: template <typename PolicyT, typename FeaturesT>
+  class Link : public virtual Feature::Link<PolicyT, FeaturesT>
+  {
+    /// \brief Set the continuous collision parameters of the link.
+    /// \param[in] _parameters Continuous collision parameters.
+    /// \return True if the parameters were applied, false if they are
+    /// invalid or if the link cannot be flagged.
+    public: bool SetContinuousCollision(
+        const ContinuousCollisionParameters &_parameters);
+
+    /// \brief Get the continuous collision parameters of the link.
+    /// \return Continuous collision parameters.
+    public: ContinuousCollisionParameters GetContinuousCollision() const;
+  };
+
+  /// \private The implementation API for continuous collision detection.
+  public: template <typename PolicyT>
+  class Implementation : public virtual Feature::Implementation<PolicyT>
+  {
+    /// \brief Implementation API for setting the continuous collision
+    /// parameters of a link.
+    /// \param[in] _linkID Identity of the link.
+    /// \param[in] _parameters Continuous collision parameters.
+    /// \return True if the parameters were applied.
+    public: virtual bool SetLinkContinuousCollision(
+        const Identity &_linkID,
+        const ContinuousCollisionParameters &_parameters) = 0;
+
+    /// \brief Implementation API for getting the continuous collision
+    /// parameters of a link.
+    /// \param[in] _linkID Identity of the link.
+    /// \return Continuous collision parameters.
+    public: virtual ContinuousCollisionParameters GetLinkContinuousCollision(
+        const Identity &_linkID) const = 0;
+  };
+};
+}
+}
+
+#include "gz/physics/detail/ContinuousCollision.hh"
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_ENGINEMEMORYRESOURCE_HH_
+#define GZ_PHYSICS_ENGINEMEMORYRESOURCE_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include <gz/utils/SuppressWarning.hh>
+
+#include "gz/physics/Export.hh"
+#include "gz/physics/Feature.hh"
+
+namespace gz
+{
+  namespace physics
+  {
+    /// \brief EngineMemoryResource is the memory resource that a physics
+    /// plugin uses for its own allocations, such as its entity info structs
+    /// and entity maps.
+    ///
+    /// Plugins construct their containers with this resource before they know
+    /// which memory resource the user wants, so it forwards every allocation
+    /// to an upstream resource that can be chosen later, when the engine is
+    /// initiated. See RequestEngine::From. The upstream resource is the
+    /// default memory resource until then.
+    ///
+    /// Containers may allocate when they are constructed, e.g. the sentinel
+    /// node of std::unordered_map on MSVC, so memory can already be in use
+    /// when the upstream resource is chosen. Those blocks are returned to the
+    /// resource they came from. Once the plugin calls MarkInUse, the upstream
+    /// resource can no longer change.
+    class GZ_PHYSICS_VISIBLE EngineMemoryResource
+      : public std::pmr::memory_resource
+    {
+      /// \brief Constructor. Uses std::pmr::get_default_resource() upstream.
+      public: EngineMemoryResource();
+
+      /// \brief Destructor
+      public: ~EngineMemoryResource() override;
+
+      /// \brief Choose the resource that allocations are forwarded to. This
+      /// is only possible before MarkInUse is called.
+      /// \param[in] _upstream The new upstream resource. It must outlive this
+      /// resource.
+      /// \return False if _upstream is null, or if the resource is already in
+      /// use with another upstream resource, in which case the upstream
+      /// resource does not change.
+      public: bool SetUpstream(std::pmr::memory_resource *_upstream);
+
+      /// \brief Mark the resource as in use, after which the upstream resource
+      /// can no longer change. Plugins call this once their engine is
+      /// initiated.
+      public: void MarkInUse();
+
+      /// \brief Check whether MarkInUse has been called.
+      /// \return True if the upstream resource can no longer change.
+      public: bool InUse() const;
+
+      /// \brief Get the resource that allocations are forwarded to.
+      /// \return The upstream resource.
+      public: std::pmr::memory_resource *Upstream() const;
+
+      /// \brief Get the number of bytes that are currently allocated through
+      /// this resource.
+      /// \return Bytes in use.
+      public: std::size_t BytesInUse() const;
+
+      /// \brief Create an object that shares its allocation with its
+      /// std::shared_ptr control block, like std::make_shared, with memory
+      /// from this resource.
+      /// \param[in] _args Arguments of the constructor of T.
+      /// \tparam T Type of the object.
+      /// \return The new object.
+      public: template <typename T, typename... Args>
+      std::shared_ptr<T> MakeShared(Args &&... _args)
+      {
+        return std::allocate_shared<T>(
+            std::pmr::polymorphic_allocator<T>(this),
+            std::forward<Args>(_args)...);
+      }
+
+      // Documentation inherited
+      private: void *do_allocate(
+          std::size_t _bytes, std::size_t _alignment) override;
+
+      // Documentation inherited
+      private: void do_deallocate(
+          void *_p, std::size_t _bytes, std::size_t _alignment) override;
+
+      // Documentation inherited
+      private: bool do_is_equal(
+          const std::pmr::memory_resource &_other) const noexcept override;
+
+      /// \brief Resource that allocations are forwarded to
+      private: std::pmr::memory_resource *upstream;
+
+      /// \brief Whether the upstream resource can no longer change
+      private: bool inUse = false;
+
+      /// \brief A block that was allocated before the resource was in use
+      private: struct EarlyBlock
+      {
+        /// \brief Address of the block
+        void *pointer;
+
+        /// \brief Resource that the block came from
+        std::pmr::memory_resource *upstream;
+      };
+
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Number of bytes currently allocated
+      private: std::atomic<std::size_t> bytesInUse{0};
+
+      /// \brief Live blocks that were allocated from a different resource
+      /// than the current upstream resource. Only blocks allocated before
+      /// MarkInUse are tracked.
+      private: std::vector<EarlyBlock> earlyBlocks;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief Plugins that can allocate their own data from a memory resource
+    /// chosen by the user provide this feature. RequestEngine::From queries
+    /// for it when a memory resource is given, and falls back to
+    /// Feature::Implementation::InitiateEngine for plugins that do not
+    /// provide it. It has no API of its own, so users do not need to request
+    /// it.
+    class GZ_PHYSICS_VISIBLE EngineMemoryResourceFeature
+      : public virtual Feature
+    {
+      public: template <typename PolicyT>
+      class Implementation : public virtual Feature::Implementation<PolicyT>
+      {
+        /// \brief Tell the physics plugin to initiate a physics engine whose
+        /// own allocations, such as its entity info structs and entity maps,
+        /// come from _memoryResource. The memory resource must outlive the
+        /// plugin.
+        /// \param[in] _engineID The ID of the engine, see InitiateEngine.
+        /// \param[in] _memoryResource The memory resource of the engine.
+        /// \return The Identity of the physics engine, see InitiateEngine.
+        public: virtual Identity InitiateEngineWithMemoryResource(
+            std::size_t _engineID,
+            std::pmr::memory_resource &_memoryResource) = 0;
+      };
+    };
+  }
+}
+
+#endif
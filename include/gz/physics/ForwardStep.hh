@@ -18,6 +18,7 @@
 #ifndef GZ_PHYSICS_FORWARDSTEP_HH_
 #define GZ_PHYSICS_FORWARDSTEP_HH_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -58,6 +59,34 @@ namespace gz
       std::string annotation;
     };
 
+    /// \brief ChangedWorldPosesStream holds the link poses of a simulation
+    /// step encoded as one frame of a compact binary pose stream. Physics
+    /// engines only write it when it is present in the output of a step. See
+    /// gz/physics/PoseStream.hh for the encoding and the matching decoder.
+    struct ChangedWorldPosesStream
+    {
+      std::vector<uint8_t> frame;
+    };
+
+    /// \brief SolverStatistics describes how hard the constraint solver
+    /// worked during a simulation step. Physics engines only write it when it
+    /// is present in the output of a step. See SolverIterations for
+    /// controlling the number of iterations.
+    struct SolverStatistics
+    {
+      /// \brief Number of constraint problems that were solved, for example
+      /// one per island of interacting bodies.
+      std::size_t solves = 0;
+
+      /// \brief Largest number of iterations used by one of the solves.
+      /// Direct solvers do not iterate and report zero.
+      std::size_t iterations = 0;
+
+      /// \brief Largest residual left by one of the solves after its last
+      /// iteration, as defined by the solver of the physics engine.
+      double residual = 0.0;
+    };
+
     struct Point
     {
       gz::math::Vector3d point;
@@ -146,6 +175,35 @@ namespace gz
       std::string annotation;
     };
 
+    /// \brief Joint-space PD servo commands that are applied by the physics
+    /// engine inside the step, so they are integrated implicitly together
+    /// with the rest of the dynamics. The vectors are parallel arrays with
+    /// one entry per servoed joint axis: joints, dofs, positions and gains.
+    /// Servo commands only act during the step that they are passed to.
+    ///
+    /// This is not one of the expected types of ForwardStep::Input, so that
+    /// the input keeps its layout, but it can be passed with
+    /// Input::Get<JointServoCommands>() like any other data.
+    struct JointServoCommands
+    {
+      /// \brief Entity IDs of the servoed joints, see Entity::EntityID().
+      std::vector<std::size_t> joints;
+
+      /// \brief Servoed degree of freedom of each joint.
+      std::vector<std::size_t> dofs;
+
+      /// \brief Target position of each joint axis.
+      std::vector<double> positions;
+
+      /// \brief Gains of each joint axis. The proportional term is used as
+      /// the stiffness and the derivative term as the damping of the servo.
+      /// The integral term is ignored, since it cannot be integrated
+      /// implicitly.
+      std::vector<PIDValues> gains;
+
+      std::string annotation;
+    };
+
     /////////////////////////////////////////////////
     /// \brief ForwardStep is a feature that allows a simulation of a world to
     /// take one step forward in time.
@@ -160,7 +218,8 @@ namespace gz
 
       public: using Output = SpecifyData<
           RequireData<WorldPoses>,
-          ExpectData<ChangedWorldPoses, Contacts, JointPositions> >;
+          ExpectData<ChangedWorldPoses, Contacts, JointPositions,
+                     ChangedWorldPosesStream, SolverStatistics> >;
 
       public: using State = CompositeData;
 
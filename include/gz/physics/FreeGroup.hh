@@ -18,6 +18,8 @@
 #ifndef GZ_PHYSICS_FREEGROUP_HH_
 #define GZ_PHYSICS_FREEGROUP_HH_
 
+#include <vector>
+
 #include <gz/physics/FeatureList.hh>
 #include <gz/physics/FrameSemantics.hh>
 #include <gz/physics/Geometry.hh>
@@ -208,6 +210,83 @@ namespace gz
             const AngularVelocity &_angularVelocity) = 0;
       };
     };
+
+    /////////////////////////////////////////////////
+    /// \brief This feature sets the world poses and velocities of many
+    /// FreeGroups of a World in one call. The FreeGroups are declared once,
+    /// so the engine can resolve and cache their root links up front instead
+    /// of once per FreeGroup per call. The results are the same as calling
+    /// SetFreeGroupWorldPose::FreeGroup::SetWorldPose and
+    /// SetFreeGroupWorldVelocity on each FreeGroup, including which trees of
+    /// nested models are moved. Removing a model from the World invalidates
+    /// the declared FreeGroups, so declare them again afterwards.
+    class GZ_PHYSICS_VISIBLE SetFreeGroupWorldStateBatch
+        : public virtual FeatureWithRequirements<FindFreeGroupFeature>
+    {
+      /// \brief The World API for setting FreeGroup states in bulk.
+      public: template <typename PolicyT, typename FeaturesT>
+      class World : public virtual Feature::World<PolicyT, FeaturesT>
+      {
+        public: using PoseType =
+            typename FromPolicy<PolicyT>::template Use<Pose>;
+        public: using LinearVelocity =
+            typename FromPolicy<PolicyT>::template Use<LinearVector>;
+        public: using AngularVelocity =
+            typename FromPolicy<PolicyT>::template Use<AngularVector>;
+
+        /// \brief Declare the FreeGroups whose states are set by
+        /// SetFreeGroupWorldPoses and SetFreeGroupWorldVelocities. This
+        /// replaces any previously declared FreeGroups.
+        /// \param[in] _groups FreeGroups of this world.
+        /// \return True if all FreeGroups are valid, false otherwise. On
+        /// failure, no FreeGroups are declared.
+        public: bool SetFreeGroupBatch(
+            const std::vector<BaseFreeGroupPtr<PolicyT>> &_groups);
+
+        /// \brief Set the world pose of every declared FreeGroup.
+        /// \param[in] _poses Poses in the order of the declared FreeGroups.
+        /// \return True if the number of poses matches the number of
+        /// declared FreeGroups, false otherwise.
+        public: bool SetFreeGroupWorldPoses(
+            const std::vector<PoseType> &_poses);
+
+        /// \brief Set the world linear and angular velocity of every
+        /// declared FreeGroup.
+        /// \param[in] _linearVelocities Linear velocities in the order of the
+        /// declared FreeGroups.
+        /// \param[in] _angularVelocities Angular velocities in the order of
+        /// the declared FreeGroups.
+        /// \return True if the number of velocities matches the number of
+        /// declared FreeGroups, false otherwise.
+        public: bool SetFreeGroupWorldVelocities(
+            const std::vector<LinearVelocity> &_linearVelocities,
+            const std::vector<AngularVelocity> &_angularVelocities);
+      };
+
+      public: template <typename PolicyT>
+      class Implementation : public virtual Feature::Implementation<PolicyT>
+      {
+        public: using PoseType =
+            typename FromPolicy<PolicyT>::template Use<Pose>;
+        public: using LinearVelocity =
+            typename FromPolicy<PolicyT>::template Use<LinearVector>;
+        public: using AngularVelocity =
+            typename FromPolicy<PolicyT>::template Use<AngularVector>;
+
+        public: virtual bool SetWorldFreeGroupBatch(
+            const Identity &_worldID,
+            const std::vector<BaseFreeGroupPtr<PolicyT>> &_groups) = 0;
+
+        public: virtual bool SetWorldFreeGroupPoses(
+            const Identity &_worldID,
+            const std::vector<PoseType> &_poses) = 0;
+
+        public: virtual bool SetWorldFreeGroupVelocities(
+            const Identity &_worldID,
+            const std::vector<LinearVelocity> &_linearVelocities,
+            const std::vector<AngularVelocity> &_angularVelocities) = 0;
+      };
+    };
   }
 }
 
@@ -18,6 +18,8 @@
 #ifndef GZ_PHYSICS_GETBOUNDINGBOX_HH_
 #define GZ_PHYSICS_GETBOUNDINGBOX_HH_
 
+#include <vector>
+
 #include <gz/physics/FeatureList.hh>
 #include <gz/physics/FrameSemantics.hh>
 #include <gz/physics/GetEntities.hh>
@@ -96,6 +98,62 @@ namespace gz
       };
     };
 
+    /////////////////////////////////////////////////
+    /// \brief This feature retrieves the world axis aligned bounding boxes of
+    /// all models or all links of a world in a single call. The boxes are
+    /// taken from the engine's collision data, without creating an entity
+    /// handle or making a frame query per link or per shape.
+    class GZ_PHYSICS_VISIBLE GetWorldEntityBoundingBoxes
+        : public virtual Feature
+    {
+      public: template <typename PolicyT, typename FeaturesT>
+      class World : public virtual Feature::World<PolicyT, FeaturesT>
+      {
+        public: using AlignedBoxType =
+            typename FromPolicy<PolicyT>::template Use<AlignedBox>;
+
+        /// \brief Get the world axis aligned bounding box of every model that
+        /// is a direct child of this world. Each box covers the collision
+        /// shapes of the model and of its nested models. Models without any
+        /// collision shapes are skipped.
+        /// \param[out] _modelIds Entity IDs of the models, see
+        /// Entity::EntityID(). The contents are replaced.
+        /// \param[out] _boxes Bounding boxes in the world frame, in the same
+        /// order as _modelIds. The contents are replaced.
+        public: void GetModelAxisAlignedBoundingBoxes(
+            std::vector<std::size_t> &_modelIds,
+            std::vector<AlignedBoxType> &_boxes) const;
+
+        /// \brief Get the world axis aligned bounding box of every link in
+        /// this world, including the links of nested models. Links without
+        /// any collision shapes are skipped.
+        /// \param[out] _linkIds Entity IDs of the links, see
+        /// Entity::EntityID(). The contents are replaced.
+        /// \param[out] _boxes Bounding boxes in the world frame, in the same
+        /// order as _linkIds. The contents are replaced.
+        public: void GetLinkAxisAlignedBoundingBoxes(
+            std::vector<std::size_t> &_linkIds,
+            std::vector<AlignedBoxType> &_boxes) const;
+      };
+
+      public: template <typename PolicyT>
+      class Implementation : public virtual Feature::Implementation<PolicyT>
+      {
+        public: using AlignedBoxType =
+            typename FromPolicy<PolicyT>::template Use<AlignedBox>;
+
+        public: virtual void GetWorldModelAxisAlignedBoundingBoxes(
+            const Identity &_worldID,
+            std::vector<std::size_t> &_modelIds,
+            std::vector<AlignedBoxType> &_boxes) const = 0;
+
+        public: virtual void GetWorldLinkAxisAlignedBoundingBoxes(
+            const Identity &_worldID,
+            std::vector<std::size_t> &_linkIds,
+            std::vector<AlignedBoxType> &_boxes) const = 0;
+      };
+    };
+
     // see Shape.hh for GetShapeBoundingBox
   }
 }
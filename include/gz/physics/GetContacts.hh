@@ -100,6 +100,35 @@ class GZ_PHYSICS_VISIBLE GetContactsFromLastStepFeature
         const Identity &_worldID) const = 0;
   };
 };
+
+/// \brief GetLinkContactWrenchFromLastStepFeature is a feature for retrieving
+/// the total wrench that the contacts of the previous simulation step applied
+/// on a link, without going through the individual contacts.
+class GZ_PHYSICS_VISIBLE GetLinkContactWrenchFromLastStepFeature
+    : public virtual FeatureWithRequirements<GetContactsFromLastStepFeature>
+{
+  public: template <typename PolicyT, typename FeaturesT>
+  class Link : public virtual Feature::Link<PolicyT, FeaturesT>
+  {
+    public: using Wrench = typename FromPolicy<PolicyT>::template Use<Wrench>;
+
+    /// \brief Get the sum of the contact forces that acted on this link
+    /// during the previous simulation step, and the sum of their torques
+    /// about the origin of the link frame. Both are expressed in the world
+    /// frame.
+    /// \return The contact wrench. It is zero if the link had no contacts.
+    public: Wrench GetContactWrenchFromLastStep() const;
+  };
+
+  public: template <typename PolicyT>
+  class Implementation : public virtual Feature::Implementation<PolicyT>
+  {
+    public: using Wrench = typename FromPolicy<PolicyT>::template Use<Wrench>;
+
+    public: virtual Wrench GetLinkContactWrenchFromLastStep(
+        const Identity &_linkID) const = 0;
+  };
+};
 }
 }
 
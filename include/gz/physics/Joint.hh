@@ -23,6 +23,7 @@
 #include <gz/physics/Geometry.hh>
 
 #include <string>
+#include <vector>
 
 namespace gz
 {
@@ -369,6 +370,62 @@ namespace gz
       };
     };
 
+    /////////////////////////////////////////////////
+    /// \brief This feature sets the commanded generalized velocities of a
+    /// declared set of joints of a World in one call. The engine prepares
+    /// the velocity command of every declared joint up front, so commanding
+    /// thousands of joints per step avoids per-joint lookups.
+    class GZ_PHYSICS_VISIBLE SetJointVelocityCommandBatchFeature
+        : public virtual Feature
+    {
+      /// \brief The World API for setting velocity commands in bulk.
+      public: template <typename PolicyT, typename FeaturesT>
+      class World : public virtual Feature::World<PolicyT, FeaturesT>
+      {
+        public: using Scalar = typename PolicyT::Scalar;
+
+        /// \brief Declare the joints whose velocities are commanded by
+        /// SetJointVelocityCommands. This replaces any previously declared
+        /// joints.
+        /// \param[in] _joints
+        ///   Joints of this world with a single degree of freedom.
+        /// \return True if all joints are supported, false otherwise. On
+        /// failure, no joints are declared.
+        public: bool SetVelocityCommandJoints(
+            const std::vector<BaseJointPtr<PolicyT>> &_joints);
+
+        /// \brief Set the commanded generalized velocity of every declared
+        /// joint. This has the same effect as calling
+        /// SetJointVelocityCommandFeature::Joint::SetVelocityCommand on each
+        /// of them.
+        /// \param[in] _velocities
+        ///   The desired generalized velocities, in the same order as the
+        ///   joints passed to SetVelocityCommandJoints.
+        /// \return True if the number of velocities matches the number of
+        /// declared joints, false otherwise.
+        public: bool SetJointVelocityCommands(
+            const std::vector<Scalar> &_velocities);
+      };
+
+      /// \private The implementation API for setting velocity commands in
+      /// bulk
+      public: template <typename PolicyT>
+      class Implementation : public virtual Feature::Implementation<PolicyT>
+      {
+        public: using Scalar = typename PolicyT::Scalar;
+
+        // See World::SetVelocityCommandJoints above
+        public: virtual bool SetWorldVelocityCommandJoints(
+            const Identity &_worldID,
+            const std::vector<BaseJointPtr<PolicyT>> &_joints) = 0;
+
+        // See World::SetJointVelocityCommands above
+        public: virtual bool SetWorldJointVelocityCommands(
+            const Identity &_worldID,
+            const std::vector<Scalar> &_velocities) = 0;
+      };
+    };
+
     /////////////////////////////////////////////////
     /// \brief This feature sets the min and max generalized position of this
     /// Joint.
@@ -520,6 +577,52 @@ namespace gz
       };
     };
 
+    /////////////////////////////////////////////////
+    /// \brief This feature sets the spring and damper of a Joint. Unlike
+    /// spring and damping forces applied with SetBasicJointState::SetForce,
+    /// the engine integrates them implicitly, which keeps stiff springs
+    /// stable at large time steps.
+    class GZ_PHYSICS_VISIBLE SetJointSpringDamperFeature
+        : public virtual Feature
+    {
+      /// \brief The Joint API for setting the spring and damper of a joint.
+      public: template <typename PolicyT, typename FeaturesT>
+      class Joint : public virtual Feature::Joint<PolicyT, FeaturesT>
+      {
+        public: using Scalar = typename PolicyT::Scalar;
+
+        /// \brief Set the spring and damper of a specific generalized
+        /// coordinate within this joint. The joint effort they produce is
+        /// -stiffness * (position - restPosition) - damping * velocity.
+        /// \param[in] _dof
+        ///   The desired generalized coordinate within this joint. Values start
+        ///   from 0 and stop before Joint::GetDegreesOfFreedom().
+        /// \param[in] _stiffness
+        ///   The spring stiffness. Units depend on the underlying joint type.
+        /// \param[in] _damping
+        ///   The damping coefficient. Units depend on the underlying joint
+        ///   type.
+        /// \param[in] _restPosition
+        ///   The position at which the spring exerts no effort.
+        public: void SetSpringDamper(const std::size_t _dof,
+                                     const Scalar _stiffness,
+                                     const Scalar _damping,
+                                     const Scalar _restPosition);
+      };
+
+      /// \private The implementation API for setting the spring and damper
+      public: template <typename PolicyT>
+      class Implementation : public virtual Feature::Implementation<PolicyT>
+      {
+        public: using Scalar = typename PolicyT::Scalar;
+
+        // See Joint::SetSpringDamper above
+        public: virtual void SetJointSpringDamper(
+            const Identity &_id, std::size_t _dof, Scalar _stiffness,
+            Scalar _damping, Scalar _restPosition) = 0;
+      };
+    };
+
     class GZ_PHYSICS_VISIBLE DetachJointFeature
         : public virtual Feature
     {
@@ -652,6 +755,101 @@ namespace gz
             Scalar _reference) = 0;
       };
     };
+
+    /////////////////////////////////////////////////
+    /// \brief This feature applies a linear coupling between a set of
+    /// *leader* joint axes and a set of *follower* joint axes of a Model.
+    /// It generalizes SetMimicConstraintFeature to many axes at once,
+    /// including axes of multi-DOF joints, according to:
+    ///
+    /// follower_positions = A * leader_positions + b
+    ///
+    /// where A is a sparse matrix of multipliers and b is a vector of offsets.
+    /// The physics engine enforces every row of the coupling as a single
+    /// constraint block for the model instead of one constraint per follower.
+    /// An engine that cannot couple the positions of a joint, for example
+    /// because it stores them as a quaternion, rejects the coupling.
+    class GZ_PHYSICS_VISIBLE SetJointCouplingFeature
+        : public virtual Feature
+    {
+      /// \brief A single axis (generalized coordinate) of a joint.
+      public: template <typename PolicyT>
+      struct JointAxis
+      {
+        /// \brief The joint containing the axis.
+        BaseJointPtr<PolicyT> joint;
+
+        /// \brief The generalized coordinate within the joint. Values start
+        /// from 0 and stop before Joint::GetDegreesOfFreedom().
+        std::size_t dof = 0;
+      };
+
+      /// \brief A single nonzero entry of the coupling matrix A.
+      public: template <typename PolicyT>
+      struct CouplingTerm
+      {
+        /// \brief Row of A, i.e. index into JointCoupling::followers.
+        std::size_t follower = 0;
+
+        /// \brief Column of A, i.e. index into JointCoupling::leaders.
+        std::size_t leader = 0;
+
+        /// \brief Multiplier applied to the leader position.
+        typename PolicyT::Scalar multiplier = 1;
+      };
+
+      /// \brief Sparse description of a linear coupling between joint axes.
+      public: template <typename PolicyT>
+      struct JointCoupling
+      {
+        /// \brief Follower axes. Each follower is one row of the coupling.
+        /// An axis may appear as a follower at most once.
+        std::vector<JointAxis<PolicyT>> followers;
+
+        /// \brief Leader axes. Each leader is one column of the coupling.
+        std::vector<JointAxis<PolicyT>> leaders;
+
+        /// \brief Nonzero entries of A.
+        std::vector<CouplingTerm<PolicyT>> terms;
+
+        /// \brief Offsets b, one per follower. If empty, all offsets are
+        /// zero.
+        std::vector<typename PolicyT::Scalar> offsets;
+      };
+
+      public: template <typename PolicyT, typename FeaturesT>
+      class Model : public virtual Feature::Model<PolicyT, FeaturesT>
+      {
+        public: using JointCouplingType = JointCoupling<PolicyT>;
+
+        /// \brief Set the joint coupling of this model. This replaces any
+        /// joint coupling that was previously set on the model.
+        /// \param[in] _coupling
+        ///   The coupling to apply. All joints must belong to this model.
+        /// \return True if the coupling was set successfully, false
+        /// otherwise.
+        public: bool SetJointCoupling(const JointCouplingType &_coupling);
+
+        /// \brief Remove the joint coupling of this model, if any.
+        public: void RemoveJointCoupling();
+      };
+
+      /// \private The implementation API for setting the joint coupling.
+      public: template <typename PolicyT>
+      class Implementation : public virtual Feature::Implementation<PolicyT>
+      {
+        public: using JointCouplingType = JointCoupling<PolicyT>;
+
+        // See Model::SetJointCoupling above
+        public: virtual bool SetModelJointCoupling(
+            const Identity &_modelID,
+            const JointCouplingType &_coupling) = 0;
+
+        // See Model::RemoveJointCoupling above
+        public: virtual void RemoveModelJointCoupling(
+            const Identity &_modelID) = 0;
+      };
+    };
   }
 }
 
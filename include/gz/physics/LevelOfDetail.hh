@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_LEVELOFDETAIL_HH_
+#define GZ_PHYSICS_LEVELOFDETAIL_HH_
+
+#include <cstddef>
+
+#include <gz/physics/FeatureList.hh>
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+/// \brief Parameters that decide when the models of a world are demoted to
+/// kinematic proxies and promoted back to full dynamics.
+struct LevelOfDetailParameters
+{
+  /// \brief Whether models are promoted and demoted automatically.
+  bool enabled = false;
+
+  /// \brief Kinematic proxies closer than this to a focus model are
+  /// promoted, in m.
+  double promotionDistance = 20.0;
+
+  /// \brief Models farther than this from every focus model are demoted,
+  /// in m. It must not be smaller than the promotion distance, so that
+  /// models do not switch back and forth at the boundary.
+  double demotionDistance = 30.0;
+
+  /// \brief Models outside the promotion distance that stay at rest for
+  /// this long are demoted, in s. Zero only demotes models by distance.
+  double idleTime = 0.0;
+
+  /// \brief Linear velocity below which a model is at rest, in m/s.
+  double linearVelocityThreshold = 0.01;
+
+  /// \brief Angular velocity below which a model is at rest, in rad/s.
+  double angularVelocityThreshold = 0.05;
+};
+
+/////////////////////////////////////////////////
+/// \brief Level of detail lets large worlds only pay for the dynamics of
+/// the models that matter. A model either has full dynamics, or it is a
+/// kinematic proxy: a proxy is not integrated or solved, and it keeps its
+/// pose unless the pose is written through the API, so that it can be
+/// scripted. Proxies only take part in collision detection, and a proxy
+/// that a dynamic model touches is promoted right away. The velocities of a
+/// model are kept while it is a proxy and restored when it is promoted,
+/// and writing a velocity of a proxy promotes it first. Forces applied to a
+/// proxy are discarded.
+///
+/// When automatic level of detail is enabled, models are promoted and
+/// demoted every step by their distance to the focus models of the world,
+/// for example the robots, and by their activity. Without focus models,
+/// models are only demoted by activity. Focus models, static models and
+/// models that are tied to other models by joints are never demoted. A model
+/// that touches a dynamic model which is not demoted in the same step is
+/// kept until the contact ends, since the contact would promote it again.
+class GZ_PHYSICS_VISIBLE LevelOfDetailFeature : public virtual Feature
+{
+  /// \brief The World API for level of detail.
+  public: template <typename PolicyT, typename FeaturesT>
+  class World : public virtual Feature::World<PolicyT, FeaturesT>
+  {
+    /// \brief Set the level of detail parameters of the world. Disabling
+    /// automatic level of detail promotes every proxy.
+    /// \param[in] _parameters Level of detail parameters.
+    /// \return True if the parameters were applied, false if they are
+    /// invalid.
+    public: bool SetLevelOfDetailParameters(
+        const LevelOfDetailParameters &_parameters);
+
+    /// \brief Get the level of detail parameters of the world.
+    /// \return Level of detail parameters.
+    public: LevelOfDetailParameters GetLevelOfDetailParameters() const;
+
+    /// \brief Get the number of models of the world that are kinematic
+    /// proxies.
+    /// \return Number of kinematic proxies.
+    public: std::size_t GetKinematicProxyCount() const;
+  };
+
+  /// \brief The Model API for level of detail.
+  public: template <typename PolicyT, typename FeaturesT>
+  class Model : public virtual Feature::Model<PolicyT, FeaturesT>
+  {
+    /// \brief Check whether the model is a kinematic proxy.
+    /// \return True if the model is a kinematic proxy.
+    public: bool IsKinematicProxy() const;
+
+    /// \brief Demote the model to a kinematic proxy or promote it to full
+    /// dynamics. With automatic level of detail, the model may be promoted
+    /// or demoted again during the next step.
+    /// \param[in] _proxy True to demote the model.
+    /// \return True if the model is in the requested state.
+    public: bool SetKinematicProxy(bool _proxy);
+
+    /// \brief Check whether the model is a focus of the level of detail.
+    /// \return True if the model is a focus.
+    public: bool IsLevelOfDetailFocus() const;
+
+    /// \brief Make the model a focus of the level of detail of its world.
+    /// Focus models are promoted and never demoted.
+    /// \param[in] _focus True to make the model a focus.
+    public: void SetLevelOfDetailFocus(bool _focus);
+  };
+
+  /// \private The implementation API for level of detail.
+  public: template <typename PolicyT>
+  class Implementation : public virtual Feature::Implementation<PolicyT>
+  {
+    /// \brief Implementation API for setting the level of detail
+    /// parameters.
+    /// \param[in] _worldID Identity of the world.
+    /// \param[in] _parameters Level of detail parameters.
+    /// \return True if the parameters were applied.
+    public: virtual bool SetWorldLevelOfDetailParameters(
+        const Identity &_worldID,
+        const LevelOfDetailParameters &_parameters) = 0;
+
+    /// \brief Implementation API for getting the level of detail
+    /// parameters.
+    /// \param[in] _worldID Identity of the world.
+    /// \return Level of detail parameters.
+    public: virtual LevelOfDetailParameters GetWorldLevelOfDetailParameters(
+        const Identity &_worldID) const = 0;
+
+    /// \brief Implementation API for getting the number of proxies.
+    /// \param[in] _worldID Identity of the world.
+    /// \return Number of kinematic proxies.
+    public: virtual std::size_t GetWorldKinematicProxyCount(
+        const Identity &_worldID) const = 0;
+
+    /// \brief Implementation API for checking whether a model is a proxy.
+    /// \param[in] _modelID Identity of the model.
+    /// \return True if the model is a kinematic proxy.
+    public: virtual bool GetModelKinematicProxy(
+        const Identity &_modelID) const = 0;
+
+    /// \brief Implementation API for demoting or promoting a model.
+    /// \param[in] _modelID Identity of the model.
+    /// \param[in] _proxy True to demote the model.
+    /// \return True if the model is in the requested state.
+    public: virtual bool SetModelKinematicProxy(
+        const Identity &_modelID, bool _proxy) = 0;
+
+    /// \brief Implementation API for checking whether a model is a focus.
+    /// \param[in] _modelID Identity of the model.
+    /// \return True if the model is a focus.
+    public: virtual bool GetModelLevelOfDetailFocus(
+        const Identity &_modelID) const = 0;
+
+    /// \brief Implementation API for making a model a focus.
+    /// \param[in] _modelID Identity of the model.
+    /// \param[in] _focus True to make the model a focus.
+    public: virtual void SetModelLevelOfDetailFocus(
+        const Identity &_modelID, bool _focus) = 0;
+  };
+};
+}
+}
+
+#include "gz/physics/detail/LevelOfDetail.hh"
+
+#endif
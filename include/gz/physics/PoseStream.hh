@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_POSESTREAM_HH_
+#define GZ_PHYSICS_POSESTREAM_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+#include <gz/utils/SuppressWarning.hh>
+
+#include "gz/physics/Export.hh"
+#include "gz/physics/ForwardStep.hh"
+
+namespace gz
+{
+  namespace physics
+  {
+    /// \brief Options of a pose stream. The options are stored in the header
+    /// of every frame, so a decoder does not need to be told about them.
+    struct GZ_PHYSICS_VISIBLE PoseStreamOptions
+    {
+      /// \brief Resolution of the quantized positions, in meters.
+      public: double positionResolution = 1e-5;
+
+      /// \brief Number of bits used for each of the three quaternion
+      /// components that are sent. Must be in the range [2, 20].
+      public: unsigned int rotationBits = 16;
+
+      /// \brief When true, entities whose quantized pose did not change since
+      /// the previous frame are left out of the stream.
+      public: bool skipUnchanged = true;
+    };
+
+    class PoseStreamEncoderPrivate;
+    class PoseStreamDecoderPrivate;
+
+    /// \brief PoseStreamEncoder writes entity poses into a compact binary
+    /// stream of frames. Each frame contains:
+    ///
+    /// * The entity ID of each pose, as a varint delta to the previous ID in
+    ///   the frame.
+    /// * The position of each pose, quantized with
+    ///   PoseStreamOptions::positionResolution and sent as varint deltas to
+    ///   the position that was last sent for the same entity.
+    /// * The orientation of each pose, compressed with the smallest-three
+    ///   encoding: the largest quaternion component is dropped and the other
+    ///   three are quantized with PoseStreamOptions::rotationBits.
+    ///
+    /// Since positions are sent relative to previous frames, a
+    /// PoseStreamDecoder must receive every frame since the last key frame.
+    /// The first frame of an encoder is always a key frame, and
+    /// RequestKeyFrame() can be used to start a new one, e.g. when a new
+    /// client connects.
+    ///
+    /// Frames can be produced from a list of WorldPose, or pose by pose with
+    /// BeginFrame(), Add() and EndFrame() so that physics engines can write
+    /// straight from their own pose buffers.
+    class GZ_PHYSICS_VISIBLE PoseStreamEncoder
+    {
+      /// \brief Constructor
+      /// \param[in] _options Options of the stream.
+      public: explicit PoseStreamEncoder(
+          const PoseStreamOptions &_options = PoseStreamOptions());
+
+      /// \brief Move constructor
+      public: PoseStreamEncoder(PoseStreamEncoder &&_other) noexcept;
+
+      /// \brief Move assignment operator
+      public: PoseStreamEncoder &operator=(
+          PoseStreamEncoder &&_other) noexcept;
+
+      /// \brief Destructor
+      public: ~PoseStreamEncoder();
+
+      /// \brief Get the options of the stream.
+      /// \return The options of the stream.
+      public: const PoseStreamOptions &Options() const;
+
+      /// \brief Make the next frame a key frame. A key frame does not depend
+      /// on any previous frame.
+      public: void RequestKeyFrame();
+
+      /// \brief Start writing a new frame. Any content of _frame is replaced.
+      /// The frame must stay alive until EndFrame() is called.
+      /// \param[out] _frame Buffer that the frame will be written to.
+      public: void BeginFrame(std::vector<uint8_t> &_frame);
+
+      /// \brief Add the pose of an entity to the current frame.
+      /// \param[in] _entity Entity ID.
+      /// \param[in] _x X position.
+      /// \param[in] _y Y position.
+      /// \param[in] _z Z position.
+      /// \param[in] _qw W component of the orientation.
+      /// \param[in] _qx X component of the orientation.
+      /// \param[in] _qy Y component of the orientation.
+      /// \param[in] _qz Z component of the orientation.
+      /// \return False if no frame was begun or the pose is not finite, in
+      /// which case nothing is written.
+      public: bool Add(std::size_t _entity,
+                       double _x, double _y, double _z,
+                       double _qw, double _qx, double _qy, double _qz);
+
+      /// \brief Add the pose of an entity to the current frame.
+      /// \param[in] _entity Entity ID.
+      /// \param[in] _pose Pose of the entity.
+      /// \return False if no frame was begun or the pose is not finite, in
+      /// which case nothing is written.
+      public: bool Add(std::size_t _entity, const math::Pose3d &_pose);
+
+      /// \brief Finish the current frame.
+      /// \return The number of poses written to the frame.
+      public: std::size_t EndFrame();
+
+      /// \brief Encode a list of poses as one frame.
+      /// \param[in] _poses Poses to encode.
+      /// \param[out] _frame Buffer that the frame will be written to.
+      /// \return The number of poses written to the frame.
+      public: std::size_t Encode(const std::vector<WorldPose> &_poses,
+                                 std::vector<uint8_t> &_frame);
+
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Private data pointer
+      private: std::unique_ptr<PoseStreamEncoderPrivate> dataPtr;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+
+    /// \brief PoseStreamDecoder reads the frames written by a
+    /// PoseStreamEncoder. Frames must be decoded in the order they were
+    /// encoded, starting from a key frame.
+    class GZ_PHYSICS_VISIBLE PoseStreamDecoder
+    {
+      /// \brief Constructor
+      public: PoseStreamDecoder();
+
+      /// \brief Move constructor
+      public: PoseStreamDecoder(PoseStreamDecoder &&_other) noexcept;
+
+      /// \brief Move assignment operator
+      public: PoseStreamDecoder &operator=(
+          PoseStreamDecoder &&_other) noexcept;
+
+      /// \brief Destructor
+      public: ~PoseStreamDecoder();
+
+      /// \brief Decode one frame.
+      /// \param[in] _data Start of the frame.
+      /// \param[in] _size Size of the frame in bytes.
+      /// \param[out] _poses The poses of the frame. Any previous content is
+      /// replaced.
+      /// \return False if the frame is malformed, or if it is not a key frame
+      /// and no key frame was decoded before. In that case _poses is empty
+      /// and the decoder waits for the next key frame.
+      public: bool Decode(const uint8_t *_data, std::size_t _size,
+                          std::vector<WorldPose> &_poses);
+
+      /// \brief Decode one frame.
+      /// \param[in] _frame The frame.
+      /// \param[out] _poses The poses of the frame.
+      /// \return False if the frame is malformed, see the other overload.
+      public: bool Decode(const std::vector<uint8_t> &_frame,
+                          std::vector<WorldPose> &_poses);
+
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Private data pointer
+      private: std::unique_ptr<PoseStreamDecoderPrivate> dataPtr;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+  }
+}
+
+#endif
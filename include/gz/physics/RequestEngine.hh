@@ -19,6 +19,7 @@
 #define GZ_PHYSICS_REQUESTENGINE_HH_
 
 #include <memory>
+#include <memory_resource>
 #include <set>
 #include <string>
 
@@ -60,6 +61,30 @@ namespace gz
           const PtrT &_pimpl,
           const std::size_t _engineID = 0);
 
+      /// \brief Get an Engine from the given physics plugin, and have the
+      /// plugin allocate its own data from the given memory resource, e.g. an
+      /// arena or pool resource. Plugins that do not provide
+      /// EngineMemoryResourceFeature keep using the global heap.
+      ///
+      /// \param[in] _pimpl
+      ///   PluginPtr to the physics plugin
+      /// \param[in] _memoryResource
+      ///   The memory resource of the engine. It must outlive the plugin. It
+      ///   can only be chosen the first time an engine is requested from the
+      ///   plugin.
+      /// \param[in] _engineID
+      ///   The ID of the engine that you want to receive from the plugin.
+      /// \tparam PtrT
+      ///   The type of PluginPtr that you are providing.
+      ///
+      /// \return A pointer to a physics engine with the requested features, or
+      /// a nullptr if any of the requested features aren't available.
+      template <typename PtrT>
+      static EnginePtrType From(
+          const PtrT &_pimpl,
+          std::pmr::memory_resource &_memoryResource,
+          const std::size_t _engineID = 0);
+
       /// \brief Check that a physics plugin has all the requested features.
       ///
       /// \param[in] _pimpl
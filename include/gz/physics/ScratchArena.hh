@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_SCRATCHARENA_HH_
+#define GZ_PHYSICS_SCRATCHARENA_HH_
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "gz/physics/Export.hh"
+
+namespace gz
+{
+  namespace physics
+  {
+    /// \brief ScratchArena is a memory resource for the transient containers
+    /// that a physics engine builds during a simulation step, such as contact
+    /// lists and bookkeeping maps.
+    ///
+    /// Allocations are carved out of one block of memory and deallocations
+    /// do nothing. Reset() makes the whole block available again, so it must
+    /// only be called once every container that uses the arena is gone,
+    /// typically at the start of a step.
+    ///
+    /// When a cycle needs more memory than the block holds, the rest is
+    /// allocated from the upstream resource, and the next Reset() replaces
+    /// the block with one that is large enough. Once the amount of scratch
+    /// memory per step stops growing, the arena no longer allocates from the
+    /// upstream resource at all.
+    ///
+    /// The arena only serves the containers that the physics plugins create
+    /// themselves. A step is not free of heap allocations: the engines'
+    /// internals, such as the DART and Bullet solvers or the AABB tree
+    /// queries of TPE, keep allocating from the global heap.
+    class GZ_PHYSICS_VISIBLE ScratchArena : public std::pmr::memory_resource
+    {
+      /// \brief Constructor
+      /// \param[in] _upstream Resource that the block of memory comes from.
+      /// It must outlive the arena.
+      /// \param[in] _initialCapacity Initial size of the block, in bytes.
+      public: explicit ScratchArena(
+          std::pmr::memory_resource *_upstream =
+              std::pmr::get_default_resource(),
+          std::size_t _initialCapacity = 0);
+
+      /// \brief Destructor
+      public: ~ScratchArena() override;
+
+      /// \brief Copying an arena is not allowed
+      public: ScratchArena(const ScratchArena &) = delete;
+
+      /// \brief Copying an arena is not allowed
+      public: ScratchArena &operator=(const ScratchArena &) = delete;
+
+      /// \brief Make all the memory of the arena available again. Memory that
+      /// was allocated from the arena before must not be used anymore.
+      public: void Reset();
+
+      /// \brief Get the size of the block of memory of the arena.
+      /// \return Capacity in bytes.
+      public: std::size_t Capacity() const;
+
+      /// \brief Get the amount of memory that was allocated from the arena
+      /// since the last Reset(), including alignment padding.
+      /// \return Bytes used.
+      public: std::size_t BytesUsed() const;
+
+      // Documentation inherited
+      private: void *do_allocate(
+          std::size_t _bytes, std::size_t _alignment) override;
+
+      // Documentation inherited
+      private: void do_deallocate(
+          void *_p, std::size_t _bytes, std::size_t _alignment) override;
+
+      // Documentation inherited
+      private: bool do_is_equal(
+          const std::pmr::memory_resource &_other) const noexcept override;
+
+      /// \brief Return the overflow blocks to the upstream resource
+      private: void ReleaseOverflow();
+
+      /// \brief Header of a block allocated from the upstream resource
+      /// because the arena was full
+      private: struct Overflow;
+
+      /// \brief Resource that the memory comes from
+      private: std::pmr::memory_resource *upstream;
+
+      /// \brief Block of memory of the arena
+      private: std::byte *block = nullptr;
+
+      /// \brief Size of the block of memory
+      private: std::size_t capacity = 0;
+
+      /// \brief Offset of the first free byte of the block
+      private: std::size_t offset = 0;
+
+      /// \brief Memory requested since the last Reset(), including what
+      /// did not fit in the block
+      private: std::size_t used = 0;
+
+      /// \brief Most recent overflow block
+      private: Overflow *overflow = nullptr;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_SLEEP_HH_
+#define GZ_PHYSICS_SLEEP_HH_
+
+#include <cstddef>
+
+#include <gz/physics/FeatureList.hh>
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+/// \brief Parameters that decide when the models of a world go to sleep.
+/// A model goes to sleep once the linear and angular velocities of all of
+/// its links stay below the thresholds for the given time.
+struct SleepParameters
+{
+  /// \brief Whether models may go to sleep.
+  bool enabled = false;
+
+  /// \brief Linear velocity threshold, in m/s.
+  double linearVelocityThreshold = 0.01;
+
+  /// \brief Angular velocity threshold, in rad/s.
+  double angularVelocityThreshold = 0.05;
+
+  /// \brief Time the velocities must stay below the thresholds, in s.
+  double timeThreshold = 0.5;
+};
+
+/////////////////////////////////////////////////
+/// \brief Sleeping models are not integrated, collided or solved, so that
+/// the cost of a step only depends on the models that are awake. A sleeping
+/// model keeps its pose and has zero velocity. It wakes up when an awake
+/// model touches it, when a force or a command is applied to it, or when its
+/// state is written through the API.
+///
+/// Models that touch each other, such as stacked boxes, form an island. An
+/// island only goes to sleep once all of its models are at rest, and the
+/// sleeping models that touch a model that wakes up wake up with it.
+///
+/// Contacts of sleeping models with other sleeping or static models are not
+/// reported by GetContactsFromLastStepFeature.
+class GZ_PHYSICS_VISIBLE SleepFeature : public virtual Feature
+{
+  /// \brief The World API for sleeping.
+  public: template <typename PolicyT, typename FeaturesT>
+  class World : public virtual Feature::World<PolicyT, FeaturesT>
+  {
+    /// \brief Set the sleep parameters of the world. Disabling sleep wakes
+    /// every sleeping model.
+    /// \param[in] _parameters Sleep parameters.
+    public: void SetSleepParameters(const SleepParameters &_parameters);
+
+    /// \brief Get the sleep parameters of the world.
+    /// \return Sleep parameters.
+    public: SleepParameters GetSleepParameters() const;
+
+    /// \brief Get the number of models of the world that are sleeping.
+    /// \return Number of sleeping models.
+    public: std::size_t GetSleepingModelCount() const;
+  };
+
+  /// \brief The Model API for sleeping.
+  public: template <typename PolicyT, typename FeaturesT>
+  class Model : public virtual Feature::Model<PolicyT, FeaturesT>
+  {
+    /// \brief Check whether the model is sleeping.
+    /// \return True if the model is sleeping.
+    public: bool IsSleeping() const;
+
+    /// \brief Put the model to sleep or wake it up. A model only goes to
+    /// sleep if sleep is enabled in its world and if it can move.
+    /// \param[in] _sleeping True to put the model to sleep.
+    /// \return True if the model is in the requested state.
+    public: bool SetSleeping(bool _sleeping);
+  };
+
+  /// \private The implementation API for sleeping.
+  public: template <typename PolicyT>
+  class Implementation : public virtual Feature::Implementation<PolicyT>
+  {
+    /// \brief Implementation API for setting the sleep parameters.
+    /// \param[in] _worldID Identity of the world.
+    /// \param[in] _parameters Sleep parameters.
+    public: virtual void SetWorldSleepParameters(
+        const Identity &_worldID, const SleepParameters &_parameters) = 0;
+
+    /// \brief Implementation API for getting the sleep parameters.
+    /// \param[in] _worldID Identity of the world.
+    /// \return Sleep parameters.
+    public: virtual SleepParameters GetWorldSleepParameters(
+        const Identity &_worldID) const = 0;
+
+    /// \brief Implementation API for getting the number of sleeping models.
+    /// \param[in] _worldID Identity of the world.
+    /// \return Number of sleeping models.
+    public: virtual std::size_t GetWorldSleepingModelCount(
+        const Identity &_worldID) const = 0;
+
+    /// \brief Implementation API for checking whether a model is sleeping.
+    /// \param[in] _modelID Identity of the model.
+    /// \return True if the model is sleeping.
+    public: virtual bool GetModelSleeping(const Identity &_modelID) const = 0;
+
+    /// \brief Implementation API for putting a model to sleep or waking it.
+    /// \param[in] _modelID Identity of the model.
+    /// \param[in] _sleeping True to put the model to sleep.
+    /// \return True if the model is in the requested state.
+    public: virtual bool SetModelSleeping(
+        const Identity &_modelID, bool _sleeping) = 0;
+  };
+};
+}
+}
+
+#include "gz/physics/detail/Sleep.hh"
+
+#endif
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_STATELOG_HH_
+#define GZ_PHYSICS_STATELOG_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <gz/utils/SuppressWarning.hh>
+
+#include "gz/physics/Export.hh"
+
+namespace gz
+{
+  namespace physics
+  {
+    /// \brief State of a link in one step of a state log. Poses and
+    /// velocities are expressed in the world frame, and velocities are the
+    /// ones reported by the physics engine for the link frame.
+    struct StateLogLink
+    {
+      /// \brief Entity ID of the link
+      uint64_t entity;
+
+      /// \brief Position followed by the orientation quaternion, in the order
+      /// x, y, z, qw, qx, qy, qz.
+      double pose[7];
+
+      /// \brief Linear velocity
+      double linearVelocity[3];
+
+      /// \brief Angular velocity
+      double angularVelocity[3];
+    };
+
+    /// \brief State of one degree of freedom of a joint in one step of a
+    /// state log.
+    struct StateLogJoint
+    {
+      /// \brief Entity ID of the joint
+      uint64_t entity;
+
+      /// \brief Index of the degree of freedom
+      uint64_t dof;
+
+      /// \brief Position of the degree of freedom
+      double position;
+
+      /// \brief Velocity of the degree of freedom
+      double velocity;
+    };
+
+    /// \brief A contact point in one step of a state log, see
+    /// GetContactsFromLastStepFeature.
+    struct StateLogContact
+    {
+      /// \brief Entity ID of the first collision shape
+      uint64_t collision1;
+
+      /// \brief Entity ID of the second collision shape
+      uint64_t collision2;
+
+      /// \brief Contact point in the world frame
+      double point[3];
+
+      /// \brief Contact normal in the world frame
+      double normal[3];
+
+      /// \brief Force acting on the first shape in the world frame
+      double force[3];
+
+      /// \brief Penetration depth
+      double depth;
+    };
+
+    /// \brief One step of a state log. The arrays point into memory owned by
+    /// the StateLogReader, and stay valid until the reader is closed.
+    ///
+    /// A key frame step holds every link and joint of the world. Other steps
+    /// only hold the links and joints whose state changed since the previous
+    /// step, so the full state of a step is obtained by applying every step
+    /// from its key frame onwards. Contacts are always complete.
+    struct StateLogStep
+    {
+      /// \brief Index of the simulation step that was recorded
+      uint64_t step = 0;
+
+      /// \brief Simulation time of the step, in seconds
+      double time = 0.0;
+
+      /// \brief Whether this step is a key frame
+      bool keyFrame = false;
+
+      /// \brief Links of the step
+      const StateLogLink *links = nullptr;
+
+      /// \brief Number of links of the step
+      std::size_t linkCount = 0;
+
+      /// \brief Joints of the step
+      const StateLogJoint *joints = nullptr;
+
+      /// \brief Number of joint degrees of freedom of the step
+      std::size_t jointCount = 0;
+
+      /// \brief Contacts of the step
+      const StateLogContact *contacts = nullptr;
+
+      /// \brief Number of contacts of the step
+      std::size_t contactCount = 0;
+    };
+
+    /// \brief Options of a StateLogWriter.
+    struct GZ_PHYSICS_VISIBLE StateLogOptions
+    {
+      /// \brief Number of steps between two key frames. Each key frame starts
+      /// a new chunk of the log file, and seeking in the log costs at most
+      /// this many steps.
+      public: std::size_t keyFrameInterval = 100;
+    };
+
+    class StateLogWriterPrivate;
+    class StateLogReaderPrivate;
+
+    /// \brief StateLogWriter appends the state of a world at each step to a
+    /// binary log file.
+    ///
+    /// The file is a header followed by chunks, each starting with a key
+    /// frame. A chunk is written once it is complete, so a log that was not
+    /// closed properly can still be read up to its last complete chunk. When
+    /// the log is closed, an index of the chunks is appended so readers do not
+    /// need to scan the file. All records are stored in native byte order
+    /// and are 8-byte aligned, so a reader can use them directly from a
+    /// memory mapping of the file.
+    class GZ_PHYSICS_VISIBLE StateLogWriter
+    {
+      /// \brief Constructor
+      public: StateLogWriter();
+
+      /// \brief Destructor. Closes the log.
+      public: ~StateLogWriter();
+
+      /// \brief Create a new log file, replacing any existing file. Closes the
+      /// log that was open before, if any.
+      /// \param[in] _path Path of the log file.
+      /// \param[in] _options Options of the log.
+      /// \return False if the file could not be created.
+      public: bool Open(const std::string &_path,
+                        const StateLogOptions &_options = StateLogOptions());
+
+      /// \brief Check whether a log is open.
+      /// \return True if a log is open.
+      public: bool IsOpen() const;
+
+      /// \brief Start recording a new step.
+      /// \param[in] _step Index of the simulation step.
+      /// \param[in] _time Simulation time of the step, in seconds.
+      public: void BeginStep(uint64_t _step, double _time);
+
+      /// \brief Add the state of a link to the current step.
+      /// \param[in] _link State of the link.
+      public: void AddLink(const StateLogLink &_link);
+
+      /// \brief Add the state of a joint degree of freedom to the current
+      /// step.
+      /// \param[in] _joint State of the joint degree of freedom.
+      public: void AddJoint(const StateLogJoint &_joint);
+
+      /// \brief Add a contact to the current step.
+      /// \param[in] _contact The contact.
+      public: void AddContact(const StateLogContact &_contact);
+
+      /// \brief Finish the current step.
+      /// \return False if the log is not open or could not be written to.
+      public: bool EndStep();
+
+      /// \brief Write the pending chunk and the index, and close the file.
+      /// \return False if the log could not be written to.
+      public: bool Close();
+
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Private data pointer
+      private: std::unique_ptr<StateLogWriterPrivate> dataPtr;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+
+    /// \brief StateLogReader gives random access to the steps of a log
+    /// written by StateLogWriter. The file is memory mapped where the platform
+    /// supports it, so steps are read without copying them.
+    class GZ_PHYSICS_VISIBLE StateLogReader
+    {
+      /// \brief Constructor
+      public: StateLogReader();
+
+      /// \brief Destructor. Closes the log.
+      public: ~StateLogReader();
+
+      /// \brief Open a log file. If the log has no index, e.g. because it was
+      /// not closed properly, the chunks are scanned instead and any
+      /// incomplete chunk at the end of the file is ignored.
+      /// \param[in] _path Path of the log file.
+      /// \return False if the file could not be read or is not a state log.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Check whether a log is open.
+      /// \return True if a log is open.
+      public: bool IsOpen() const;
+
+      /// \brief Close the log. Steps that were read become invalid.
+      public: void Close();
+
+      /// \brief Get the number of steps in the log.
+      /// \return Number of steps.
+      public: std::size_t StepCount() const;
+
+      /// \brief Read a step of the log.
+      /// \param[in] _index Index of the step in the log, starting from 0.
+      /// \param[out] _step The step.
+      /// \return False if _index is out of range.
+      public: bool Step(std::size_t _index, StateLogStep &_step) const;
+
+      /// \brief Get the key frame that a step depends on.
+      /// \param[in] _index Index of the step in the log.
+      /// \return Index of the last key frame at or before _index.
+      public: std::size_t KeyFrameOf(std::size_t _index) const;
+
+      GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Private data pointer
+      private: std::unique_ptr<StateLogReaderPrivate> dataPtr;
+      GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+  }
+}
+
+#endif
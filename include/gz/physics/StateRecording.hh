@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_STATERECORDING_HH_
+#define GZ_PHYSICS_STATERECORDING_HH_
+
+#include <string>
+
+#include <gz/physics/FeatureList.hh>
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/StateLog.hh>
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+/// \brief RecordWorldState records the state of a world after every step
+/// into a state log file, see StateLogWriter. Each step records the pose and
+/// velocity of every link, the position and velocity of every joint degree
+/// of freedom and the contacts of the step.
+class GZ_PHYSICS_VISIBLE RecordWorldState
+    : public virtual FeatureWithRequirements<ForwardStep>
+{
+  public: template <typename PolicyT, typename FeaturesT>
+  class World : public virtual Feature::World<PolicyT, FeaturesT>
+  {
+    /// \brief Start recording the state of this world to a new log file.
+    /// A recording that is in progress is finished first.
+    /// \param[in] _path Path of the log file.
+    /// \param[in] _options Options of the log.
+    /// \return False if the log file could not be created.
+    public: bool StartStateRecording(
+        const std::string &_path,
+        const StateLogOptions &_options = StateLogOptions());
+
+    /// \brief Finish the recording in progress, if any.
+    /// \return False if there was no recording in progress or the log file
+    /// could not be written.
+    public: bool StopStateRecording();
+  };
+
+  /// \private The implementation API for state recording
+  public: template <typename PolicyT>
+  class Implementation : public virtual Feature::Implementation<PolicyT>
+  {
+    /// \brief Implementation API for starting a recording
+    /// \param[in] _worldID Identity of the world
+    /// \param[in] _path Path of the log file
+    /// \param[in] _options Options of the log
+    /// \return False if the log file could not be created
+    public: virtual bool WorldStartStateRecording(
+        const Identity &_worldID, const std::string &_path,
+        const StateLogOptions &_options) = 0;
+
+    /// \brief Implementation API for finishing a recording
+    /// \param[in] _worldID Identity of the world
+    /// \return False if there was no recording or it could not be written
+    public: virtual bool WorldStopStateRecording(const Identity &_worldID) = 0;
+  };
+};
+
+/////////////////////////////////////////////////
+/// \brief ReplayWorldState plays back a state log recorded with
+/// RecordWorldState. While a log is loaded, stepping the world sets the
+/// state of the next logged step kinematically instead of running the
+/// dynamics, so a recording can be played back much faster than it was
+/// simulated. The step output is written as usual. The log must have been
+/// recorded from the same world description, with the same physics engine.
+class GZ_PHYSICS_VISIBLE ReplayWorldState
+    : public virtual FeatureWithRequirements<ForwardStep>
+{
+  public: template <typename PolicyT, typename FeaturesT>
+  class World : public virtual Feature::World<PolicyT, FeaturesT>
+  {
+    /// \brief Load a state log and switch this world to playback. The first
+    /// step of the world plays back the first step of the log.
+    /// \param[in] _path Path of the log file.
+    /// \return False if the log could not be read, in which case the world
+    /// keeps simulating.
+    public: bool LoadStateLog(const std::string &_path);
+
+    /// \brief Unload the state log and resume simulating from the state
+    /// that was played back last.
+    public: void UnloadStateLog();
+
+    /// \brief Get the number of steps of the loaded state log.
+    /// \return Number of steps, or 0 if no log is loaded.
+    public: std::size_t GetStateLogStepCount() const;
+
+    /// \brief Set the world to the state of a step of the loaded log. The
+    /// next step of the world continues from the step after _index.
+    /// \param[in] _index Index of the step in the log.
+    /// \return False if no log is loaded or _index is out of range.
+    public: bool SeekStateLog(std::size_t _index);
+  };
+
+  /// \private The implementation API for state replay
+  public: template <typename PolicyT>
+  class Implementation : public virtual Feature::Implementation<PolicyT>
+  {
+    /// \brief Implementation API for loading a state log
+    /// \param[in] _worldID Identity of the world
+    /// \param[in] _path Path of the log file
+    /// \return False if the log could not be read
+    public: virtual bool WorldLoadStateLog(
+        const Identity &_worldID, const std::string &_path) = 0;
+
+    /// \brief Implementation API for unloading the state log
+    /// \param[in] _worldID Identity of the world
+    public: virtual void WorldUnloadStateLog(const Identity &_worldID) = 0;
+
+    /// \brief Implementation API for getting the number of logged steps
+    /// \param[in] _worldID Identity of the world
+    /// \return Number of steps of the loaded log
+    public: virtual std::size_t GetWorldStateLogStepCount(
+        const Identity &_worldID) const = 0;
+
+    /// \brief Implementation API for seeking in the state log
+    /// \param[in] _worldID Identity of the world
+    /// \param[in] _index Index of the step in the log
+    /// \return False if no log is loaded or _index is out of range
+    public: virtual bool WorldSeekStateLog(
+        const Identity &_worldID, std::size_t _index) = 0;
+  };
+};
+}
+}
+
+#include "gz/physics/detail/StateRecording.hh"
+
+#endif
@@ -18,6 +18,7 @@
 #ifndef GZ_PHYSICS_WORLD_HH_
 #define GZ_PHYSICS_WORLD_HH_
 
+#include <cstddef>
 #include <string>
 
 #include <gz/physics/FeatureList.hh>
@@ -203,6 +204,200 @@ namespace gz
             const Identity &_id) const = 0;
       };
     };
+
+    /////////////////////////////////////////////////
+    /// \brief Parameters that control the number of iterations of an
+    /// iterative constraint solver. The solver stops as soon as its residual
+    /// is below the tolerance, once it ran the minimum number of iterations,
+    /// and never runs more than the maximum number.
+    struct SolverIterationParameters
+    {
+      /// \brief Residual at which the solver stops, as defined by the solver
+      /// of the physics engine. Zero always runs the maximum number of
+      /// iterations.
+      double residualTolerance = 0.0;
+
+      /// \brief Minimum number of iterations.
+      std::size_t minIterations = 1;
+
+      /// \brief Maximum number of iterations.
+      std::size_t maxIterations = 50;
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief Control the number of iterations of the constraint solver of a
+    /// world. The iterations and the residual of each step are reported in
+    /// the SolverStatistics output of ForwardStep.
+    class GZ_PHYSICS_VISIBLE SolverIterations : public virtual Feature
+    {
+      /// \brief The World API for the solver iterations.
+      public: template <typename PolicyT, typename FeaturesT>
+      class World : public virtual Feature::World<PolicyT, FeaturesT>
+      {
+        /// \brief Set the iteration parameters of the solver.
+        /// \param[in] _parameters Iteration parameters.
+        /// \return True if the parameters were applied, false if they are
+        /// invalid.
+        public: bool SetSolverIterations(
+            const SolverIterationParameters &_parameters);
+
+        /// \brief Get the iteration parameters of the solver.
+        /// \return Iteration parameters.
+        public: SolverIterationParameters GetSolverIterations() const;
+      };
+
+      /// \private The implementation API for the solver iterations.
+      public: template <typename PolicyT>
+      class Implementation : public virtual Feature::Implementation<PolicyT>
+      {
+        /// \brief Implementation API for setting the iteration parameters.
+        /// \param[in] _id Identity of the world.
+        /// \param[in] _parameters Iteration parameters.
+        /// \return True if the parameters were applied.
+        public: virtual bool SetWorldSolverIterations(
+            const Identity &_id,
+            const SolverIterationParameters &_parameters) = 0;
+
+        /// \brief Implementation API for getting the iteration parameters.
+        /// \param[in] _id Identity of the world.
+        /// \return Iteration parameters.
+        public: virtual SolverIterationParameters GetWorldSolverIterations(
+            const Identity &_id) const = 0;
+      };
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief Parameters of solver warm starting. With warm starting, the
+    /// impulse of a contact that persists from the previous step is used as
+    /// the initial guess of the solver, so that iterative solvers converge in
+    /// fewer iterations on resting contacts. Contacts of consecutive steps
+    /// are matched by the pair of shapes they touch and by the position of
+    /// the contact point on the first shape.
+    struct SolverWarmStartParameters
+    {
+      /// \brief Whether the solver is warm started.
+      bool enabled = false;
+
+      /// \brief Fraction of the impulse of the previous step that is used as
+      /// the initial guess, in [0, 1].
+      double factor = 1.0;
+
+      /// \brief Maximum distance, in m, between the contact points of two
+      /// steps, in the frame of the first shape, for the contacts to match.
+      double matchingDistance = 0.01;
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief Warm start the constraint solver of a world from the contact
+    /// impulses of the previous step.
+    class GZ_PHYSICS_VISIBLE SolverWarmStart : public virtual Feature
+    {
+      /// \brief The World API for solver warm starting.
+      public: template <typename PolicyT, typename FeaturesT>
+      class World : public virtual Feature::World<PolicyT, FeaturesT>
+      {
+        /// \brief Set the warm starting parameters of the solver.
+        /// \param[in] _parameters Warm starting parameters.
+        /// \return True if the parameters were applied, false if they are
+        /// invalid or if the engine cannot warm start its solver.
+        public: bool SetSolverWarmStart(
+            const SolverWarmStartParameters &_parameters);
+
+        /// \brief Get the warm starting parameters of the solver.
+        /// \return Warm starting parameters.
+        public: SolverWarmStartParameters GetSolverWarmStart() const;
+
+        /// \brief Get the number of contacts of the last step whose impulses
+        /// were initialized from a matching contact of the step before.
+        /// \return Number of warm started contacts.
+        public: std::size_t GetWarmStartedContactCount() const;
+      };
+
+      /// \private The implementation API for solver warm starting.
+      public: template <typename PolicyT>
+      class Implementation : public virtual Feature::Implementation<PolicyT>
+      {
+        /// \brief Implementation API for setting the warm starting
+        /// parameters.
+        /// \param[in] _id Identity of the world.
+        /// \param[in] _parameters Warm starting parameters.
+        /// \return True if the parameters were applied.
+        public: virtual bool SetWorldSolverWarmStart(
+            const Identity &_id,
+            const SolverWarmStartParameters &_parameters) = 0;
+
+        /// \brief Implementation API for getting the warm starting
+        /// parameters.
+        /// \param[in] _id Identity of the world.
+        /// \return Warm starting parameters.
+        public: virtual SolverWarmStartParameters GetWorldSolverWarmStart(
+            const Identity &_id) const = 0;
+
+        /// \brief Implementation API for getting the number of warm started
+        /// contacts of the last step.
+        /// \param[in] _id Identity of the world.
+        /// \return Number of warm started contacts.
+        public: virtual std::size_t GetWorldWarmStartedContactCount(
+            const Identity &_id) const = 0;
+      };
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief Memory used by a world, in bytes, by category. The numbers are
+    /// estimates computed from the sizes of the engine data structures, not
+    /// measurements of the heap, so they are meant for finding out which part
+    /// of a world uses the most memory rather than for exact accounting.
+    struct WorldMemoryUsage
+    {
+      /// \brief Collision geometry: meshes, their bounding volume
+      /// hierarchies, heightfields and primitive shapes.
+      std::size_t collisionGeometry = 0;
+
+      /// \brief Articulated bodies: skeletons or multibodies, with their
+      /// links, joints and degrees of freedom.
+      std::size_t articulatedBodies = 0;
+
+      /// \brief Entity bookkeeping of the plugin: the maps from entity IDs to
+      /// engine objects and the info structures they hold.
+      std::size_t entityBookkeeping = 0;
+
+      /// \brief Contact and constraint caches: contact points and manifolds
+      /// of the last step, and the constraints of the world.
+      std::size_t contactCaches = 0;
+
+      /// \brief Get the sum of every category.
+      /// \return Total memory used by the world, in bytes.
+      std::size_t Total() const
+      {
+        return this->collisionGeometry + this->articulatedBodies +
+               this->entityBookkeeping + this->contactCaches;
+      }
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief Get an estimate of the memory used by a world.
+    class GZ_PHYSICS_VISIBLE GetWorldMemoryUsage : public virtual Feature
+    {
+      /// \brief The World API for getting the memory usage.
+      public: template <typename PolicyT, typename FeaturesT>
+      class World : public virtual Feature::World<PolicyT, FeaturesT>
+      {
+        /// \brief Get an estimate of the memory used by this world.
+        /// \return Memory used by this world, by category.
+        public: WorldMemoryUsage GetMemoryUsage() const;
+      };
+
+      /// \private The implementation API for getting the memory usage.
+      public: template <typename PolicyT>
+      class Implementation : public virtual Feature::Implementation<PolicyT>
+      {
+        /// \brief Implementation API for getting the memory usage.
+        /// \param[in] _id Identity of the world.
+        /// \return Memory used by the world, by category.
+        public: virtual WorldMemoryUsage GetWorldMemoryUsage(
+            const Identity &_id) const = 0;
+      };
+    };
   }
 }
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_WORLDPARTITION_HH_
+#define GZ_PHYSICS_WORLDPARTITION_HH_
+
+#include <cstddef>
+
+#include <Eigen/Geometry>
+
+#include "gz/physics/Export.hh"
+
+namespace gz
+{
+  namespace physics
+  {
+    /// \brief WorldPartition splits the horizontal plane of a world into a
+    /// grid of regions, each of which can be simulated by its own world, see
+    /// sdf::PartitionedWorld.
+    ///
+    /// The grid covers a rectangle of the xy plane. The regions along the
+    /// border of the grid extend to infinity, so that every position belongs
+    /// to exactly one region. Neighbouring regions share an overlap zone on
+    /// each side of their boundary: a body in the overlap zone of a region
+    /// that does not own it is mirrored in that region, so that the bodies
+    /// of both regions collide with it.
+    ///
+    /// A body is handed off to another region once it is farther than half
+    /// the overlap from the region that owns it, so that a body that moves
+    /// along a boundary does not change owner at every step.
+    class GZ_PHYSICS_VISIBLE WorldPartition
+    {
+      /// \brief Constructor
+      /// \param[in] _min Lower corner of the grid in the xy plane.
+      /// \param[in] _max Upper corner of the grid in the xy plane.
+      /// \param[in] _columns Number of regions along x, at least 1.
+      /// \param[in] _rows Number of regions along y, at least 1.
+      /// \param[in] _overlap Width of the overlap zone on each side of the
+      /// boundaries between regions, in meters. Negative values are
+      /// clamped to 0.
+      public: WorldPartition(const Eigen::Vector3d &_min,
+                             const Eigen::Vector3d &_max,
+                             std::size_t _columns,
+                             std::size_t _rows,
+                             double _overlap);
+
+      /// \brief Get the number of regions.
+      /// \return Number of regions of the grid.
+      public: std::size_t RegionCount() const;
+
+      /// \brief Get the width of the overlap zone.
+      /// \return Width of the overlap zone, in meters.
+      public: double Overlap() const;
+
+      /// \brief Get the region that contains a position.
+      /// \param[in] _position Position in the world frame.
+      /// \return Index of the region, in row-major order.
+      public: std::size_t RegionOf(const Eigen::Vector3d &_position) const;
+
+      /// \brief Check whether a position is inside a region grown by a
+      /// margin.
+      /// \param[in] _region Index of the region.
+      /// \param[in] _position Position in the world frame.
+      /// \param[in] _margin Distance by which the region is grown on each
+      /// side, in meters.
+      /// \return True if the position is inside the grown region, false if
+      /// it is not or if the region does not exist.
+      public: bool Contains(std::size_t _region,
+                            const Eigen::Vector3d &_position,
+                            double _margin = 0.0) const;
+
+      /// \brief Get the region that owns a body after it moved.
+      /// \param[in] _region Region that owned the body so far.
+      /// \param[in] _position New position of the body.
+      /// \return _region while the body is within half the overlap of it,
+      /// the region that contains the body otherwise.
+      public: std::size_t HandOff(std::size_t _region,
+                                  const Eigen::Vector3d &_position) const;
+
+      /// \brief Check whether a region mirrors a body that another region
+      /// owns.
+      /// \param[in] _region Region to check.
+      /// \param[in] _owner Region that owns the body.
+      /// \param[in] _position Position of the body.
+      /// \return True if _region is not _owner and the body is in its
+      /// overlap zone.
+      public: bool Mirrors(std::size_t _region, std::size_t _owner,
+                           const Eigen::Vector3d &_position) const;
+
+      /// \brief Lower x coordinate of the grid
+      private: double minX;
+
+      /// \brief Lower y coordinate of the grid
+      private: double minY;
+
+      /// \brief Width of a region along x
+      private: double width;
+
+      /// \brief Width of a region along y
+      private: double height;
+
+      /// \brief Number of regions along x
+      private: std::size_t columns;
+
+      /// \brief Number of regions along y
+      private: std::size_t rows;
+
+      /// \brief Width of the overlap zone
+      private: double overlap;
+    };
+  }
+}
+
+#endif
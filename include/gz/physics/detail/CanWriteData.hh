@@ -18,6 +18,8 @@
 #ifndef GZ_PHYSICS_DETAIL_CANWRITEDATA_HH_
 #define GZ_PHYSICS_DETAIL_CANWRITEDATA_HH_
 
+#include <type_traits>
+
 #include "gz/physics/CanWriteData.hh"
 
 namespace gz
@@ -70,6 +72,146 @@ namespace gz
           yourClass->Write(data.template Get<Data>());
         }
       };
+
+      /// \brief A compile-time list of data types.
+      template <typename... Data>
+      struct DataList { };
+
+      /// \brief Append Data to the type list unless the list already
+      /// contains it.
+      template <typename List, typename Data>
+      struct AppendUniqueData;
+
+      template <typename... Listed, typename Data>
+      struct AppendUniqueData<DataList<Listed...>, Data>
+      {
+        using Type = std::conditional_t<
+            (std::is_same_v<Listed, Data> || ...),
+            DataList<Listed...>, DataList<Listed..., Data>>;
+      };
+
+      /// \brief Append each type of the second list to the first list,
+      /// skipping the types that are already present.
+      template <typename List, typename Other>
+      struct MergeUniqueData;
+
+      template <typename List>
+      struct MergeUniqueData<List, DataList<>>
+      {
+        using Type = List;
+      };
+
+      template <typename List, typename First, typename... Rest>
+      struct MergeUniqueData<List, DataList<First, Rest...>>
+      {
+        using Type = typename MergeUniqueData<
+            typename AppendUniqueData<List, First>::Type,
+            DataList<Rest...>>::Type;
+      };
+
+      /// \brief Flatten a specification tree into a list of the data types
+      /// that it specifies. Each type appears once, in the same order that
+      /// OperateOnSpecifiedData would first visit it. The recursion mirrors
+      /// SpecificationDataCounterImpl.
+      template <typename Data, typename SubSpec1, typename SubSpec2,
+                template <typename> class SpecFinder>
+      struct SpecifiedDataList
+      {
+        using Type = typename MergeUniqueData<
+            typename MergeUniqueData<
+                DataList<Data>,
+                typename SpecifiedDataList<
+                    typename SpecFinder<SubSpec1>::Data,
+                    typename SubSpec1::SubSpecification1,
+                    typename SubSpec1::SubSpecification2,
+                    SpecFinder>::Type>::Type,
+            typename SpecifiedDataList<
+                typename SpecFinder<SubSpec2>::Data,
+                typename SubSpec2::SubSpecification1,
+                typename SubSpec2::SubSpecification2,
+                SpecFinder>::Type>::Type;
+      };
+
+      template <typename SubSpec1, typename SubSpec2,
+                template <typename> class SpecFinder>
+      struct SpecifiedDataList<void, SubSpec1, SubSpec2, SpecFinder>
+      {
+        using Type = typename MergeUniqueData<
+            typename SpecifiedDataList<
+                typename SpecFinder<SubSpec1>::Data,
+                typename SubSpec1::SubSpecification1,
+                typename SubSpec1::SubSpecification2,
+                SpecFinder>::Type,
+            typename SpecifiedDataList<
+                typename SpecFinder<SubSpec2>::Data,
+                typename SubSpec2::SubSpecification1,
+                typename SubSpec2::SubSpecification2,
+                SpecFinder>::Type>::Type;
+      };
+
+      template <typename Data, template <typename> class SpecFinder>
+      struct SpecifiedDataList<Data, void, void, SpecFinder>
+      {
+        using Type = DataList<Data>;
+      };
+
+      template <template <typename> class SpecFinder>
+      struct SpecifiedDataList<void, void, void, SpecFinder>
+      {
+        using Type = DataList<>;
+      };
+
+      /// \brief A write plan is the flat list of data types that a
+      /// Specification asks us to write. It is resolved entirely at compile
+      /// time, so writing the output of each step is a straight sequence of
+      /// status checks and Write(~) calls, without walking the specification
+      /// tree or keeping a runtime history of the visited types.
+      template <typename List>
+      struct WritePlanImpl;
+
+      template <typename... Data>
+      struct WritePlanImpl<DataList<Data...>>
+      {
+        /// \brief The number of distinct data types in this plan.
+        public: static constexpr std::size_t Size = sizeof...(Data);
+
+        /// \brief Invoke _performer->Write(~) on each data type of the plan
+        /// whose status in _data satisfies _mask.
+        /// \param[in] _performer
+        ///   The object which will perform the Write operations.
+        /// \param[in,out] _data
+        ///   The object which will be written to.
+        /// \param[in] _mask
+        ///   Criteria that the status of each data type must satisfy.
+        public: template <typename Derived, typename CompositeType>
+        static void Write(const Derived *_performer, CompositeType &_data,
+                          const DataStatusMask &_mask)
+        {
+          (WriteIfSatisfied<Data>(_performer, _data, _mask), ...);
+        }
+
+        private: template <typename D, typename Derived,
+                           typename CompositeType>
+        static void WriteIfSatisfied(
+            const Derived *_performer, CompositeType &_data,
+            const DataStatusMask &_mask)
+        {
+          if (_mask.Satisfied(_data.template StatusOf<D>()))
+          {
+            WriteDataOperation<D, const Derived, CompositeType>::Operate(
+                  _performer, _data);
+          }
+        }
+      };
+
+      /// \brief The write plan of the data that SpecFinder picks out of
+      /// Specification.
+      template <typename Specification, template <typename> class SpecFinder>
+      using WritePlan = WritePlanImpl<typename SpecifiedDataList<
+          typename SpecFinder<Specification>::Data,
+          typename Specification::SubSpecification1,
+          typename Specification::SubSpecification2,
+          SpecFinder>::Type>;
     }
 
     template <typename Derived, typename Specification>
@@ -100,10 +242,8 @@ namespace gz
       if (_options.onlyWriteUnqueriedData)
         mask.queried = DataStatusMask::MUST_NOT;
 
-      OperateOnSpecifiedData<
-          Specification, FindRequired, detail::WriteDataOperation,
-          const Derived>::Operate(static_cast<const Derived*>(this),
-                                  _data, mask);
+      detail::WritePlan<Specification, FindRequired>::Write(
+            static_cast<const Derived*>(this), _data, mask);
     }
 
     template <typename Derived, typename Specification>
@@ -134,10 +274,8 @@ namespace gz
       if (_options.onlyWriteUnqueriedData)
         mask.queried = DataStatusMask::MUST_NOT;
 
-      OperateOnSpecifiedData<
-          Specification, FindExpected, detail::WriteDataOperation,
-          const Derived>::Operate(static_cast<const Derived*>(this),
-                                  _data, mask);
+      detail::WritePlan<Specification, FindExpected>::Write(
+            static_cast<const Derived*>(this), _data, mask);
     }
   }
 }
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_DETAIL_CONTINUOUSCOLLISION_HH_
+#define GZ_PHYSICS_DETAIL_CONTINUOUSCOLLISION_HH_
+
+#include <gz/physics/ContinuousCollision.hh>
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool ContinuousCollisionFeature::Link<PolicyT, FeaturesT>::
+    SetContinuousCollision(const ContinuousCollisionParameters &_parameters)
+{
+  return this->template Interface<ContinuousCollisionFeature>()
+      ->SetLinkContinuousCollision(this->identity, _parameters);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+ContinuousCollisionParameters ContinuousCollisionFeature::
+    Link<PolicyT, FeaturesT>::GetContinuousCollision() const
+{
+  return this->template Interface<ContinuousCollisionFeature>()
+      ->GetLinkContinuousCollision(this->identity);
+}
+}
+}
+
+#endif
@@ -253,14 +253,15 @@ namespace gz
         return *this;
       }
 
-      if (this->entity)
+      // The pimpl may be shared with other entities, e.g. through the cache of
+      // RequestFeatures::From, so it can only be reused when it is not.
+      if (this->entity && this->entity->pimpl.use_count() == 1)
       {
-        // Emplace to set the identity because assigment is not possible. Use
-        // the entity's own pimpl temporarily for the construction and copy
-        // assign the pimpl afterward
-        this->entity.emplace(this->entity->pimpl, _other.entity->identity);
-        // Avoid reallocating the pimpl
-        *this->entity->pimpl = *_other.entity->pimpl;
+        // Avoid reallocating the pimpl. Hold on to it while emplacing, which
+        // is needed to set the identity because assigment is not possible.
+        std::shared_ptr<typename EntityT::Pimpl> pimpl = this->entity->pimpl;
+        *pimpl = *_other.entity->pimpl;
+        this->entity.emplace(std::move(pimpl), _other.entity->identity);
       }
       else
       {
@@ -126,6 +126,36 @@ namespace gz
       this->template Interface<SetFreeGroupWorldVelocity>()
         ->SetFreeGroupWorldAngularVelocity(this->identity, _angularVelocity);
     }
+
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    bool SetFreeGroupWorldStateBatch::World<PolicyT, FeaturesT>::
+    SetFreeGroupBatch(const std::vector<BaseFreeGroupPtr<PolicyT>> &_groups)
+    {
+      return this->template Interface<SetFreeGroupWorldStateBatch>()
+        ->SetWorldFreeGroupBatch(this->identity, _groups);
+    }
+
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    bool SetFreeGroupWorldStateBatch::World<PolicyT, FeaturesT>::
+    SetFreeGroupWorldPoses(const std::vector<PoseType> &_poses)
+    {
+      return this->template Interface<SetFreeGroupWorldStateBatch>()
+        ->SetWorldFreeGroupPoses(this->identity, _poses);
+    }
+
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    bool SetFreeGroupWorldStateBatch::World<PolicyT, FeaturesT>::
+    SetFreeGroupWorldVelocities(
+        const std::vector<LinearVelocity> &_linearVelocities,
+        const std::vector<AngularVelocity> &_angularVelocities)
+    {
+      return this->template Interface<SetFreeGroupWorldStateBatch>()
+        ->SetWorldFreeGroupVelocities(
+            this->identity, _linearVelocities, _angularVelocities);
+    }
   }
 }
 
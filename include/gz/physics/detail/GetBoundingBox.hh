@@ -18,6 +18,8 @@
 #ifndef GZ_PHYSICS_DETAIL_GETBOUNDINGBOX_HH_
 #define GZ_PHYSICS_DETAIL_GETBOUNDINGBOX_HH_
 
+#include <vector>
+
 #include <gz/physics/GetBoundingBox.hh>
 
 namespace gz
@@ -57,6 +59,30 @@ namespace gz
       }
       return result;
     }
+
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    void GetWorldEntityBoundingBoxes::World<PolicyT, FeaturesT>
+    ::GetModelAxisAlignedBoundingBoxes(
+        std::vector<std::size_t> &_modelIds,
+        std::vector<AlignedBoxType> &_boxes) const
+    {
+      this->template Interface<GetWorldEntityBoundingBoxes>()
+        ->GetWorldModelAxisAlignedBoundingBoxes(
+            this->identity, _modelIds, _boxes);
+    }
+
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    void GetWorldEntityBoundingBoxes::World<PolicyT, FeaturesT>
+    ::GetLinkAxisAlignedBoundingBoxes(
+        std::vector<std::size_t> &_linkIds,
+        std::vector<AlignedBoxType> &_boxes) const
+    {
+      this->template Interface<GetWorldEntityBoundingBoxes>()
+        ->GetWorldLinkAxisAlignedBoundingBoxes(
+            this->identity, _linkIds, _boxes);
+    }
   }
 }
 
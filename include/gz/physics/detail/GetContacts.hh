@@ -67,6 +67,15 @@ auto GetContactsFromLastStepFeature::World<
   return output;
 }
 
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+auto GetLinkContactWrenchFromLastStepFeature::Link<
+    PolicyT, FeaturesT>::GetContactWrenchFromLastStep() const -> Wrench
+{
+  return this->template Interface<GetLinkContactWrenchFromLastStepFeature>()
+      ->GetLinkContactWrenchFromLastStep(this->identity);
+}
+
 }  // namespace physics
 }  // namespace gz
 
@@ -162,6 +162,25 @@ namespace gz
           ->SetJointVelocityCommand(this->identity, _dof, _value);
     }
 
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    bool SetJointVelocityCommandBatchFeature::World<PolicyT, FeaturesT>::
+    SetVelocityCommandJoints(
+        const std::vector<BaseJointPtr<PolicyT>> &_joints)
+    {
+      return this->template Interface<SetJointVelocityCommandBatchFeature>()
+          ->SetWorldVelocityCommandJoints(this->identity, _joints);
+    }
+
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    bool SetJointVelocityCommandBatchFeature::World<PolicyT, FeaturesT>::
+    SetJointVelocityCommands(const std::vector<Scalar> &_velocities)
+    {
+      return this->template Interface<SetJointVelocityCommandBatchFeature>()
+          ->SetWorldJointVelocityCommands(this->identity, _velocities);
+    }
+
     /////////////////////////////////////////////////
     template <typename PolicyT, typename FeaturesT>
     void SetJointPositionLimitsFeature::Joint<PolicyT, FeaturesT>::
@@ -216,6 +235,17 @@ namespace gz
         ->SetJointMaxEffort(this->identity, _dof, _value);
     }
 
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    void SetJointSpringDamperFeature::Joint<PolicyT, FeaturesT>::
+    SetSpringDamper(const std::size_t _dof, const Scalar _stiffness,
+                    const Scalar _damping, const Scalar _restPosition)
+    {
+      this->template Interface<SetJointSpringDamperFeature>()
+        ->SetJointSpringDamper(
+            this->identity, _dof, _stiffness, _damping, _restPosition);
+    }
+
     /////////////////////////////////////////////////
     template <typename PolicyT, typename FeaturesT>
     bool SetMimicConstraintFeature::Joint<PolicyT, FeaturesT>::
@@ -232,6 +262,24 @@ namespace gz
           _leaderAxisDof, _multiplier, _offset, _reference);
     }
 
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    bool SetJointCouplingFeature::Model<PolicyT, FeaturesT>::
+    SetJointCoupling(const JointCouplingType &_coupling)
+    {
+      return this->template Interface<SetJointCouplingFeature>()
+        ->SetModelJointCoupling(this->identity, _coupling);
+    }
+
+    /////////////////////////////////////////////////
+    template <typename PolicyT, typename FeaturesT>
+    void SetJointCouplingFeature::Model<PolicyT, FeaturesT>::
+    RemoveJointCoupling()
+    {
+      this->template Interface<SetJointCouplingFeature>()
+        ->RemoveModelJointCoupling(this->identity);
+    }
+
     /////////////////////////////////////////////////
     template <typename PolicyT, typename FeaturesT>
     void DetachJointFeature::Joint<PolicyT, FeaturesT>::Detach()
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_DETAIL_LEVELOFDETAIL_HH_
+#define GZ_PHYSICS_DETAIL_LEVELOFDETAIL_HH_
+
+#include <gz/physics/LevelOfDetail.hh>
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool LevelOfDetailFeature::World<PolicyT, FeaturesT>::
+    SetLevelOfDetailParameters(const LevelOfDetailParameters &_parameters)
+{
+  return this->template Interface<LevelOfDetailFeature>()
+      ->SetWorldLevelOfDetailParameters(this->identity, _parameters);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+LevelOfDetailParameters LevelOfDetailFeature::World<PolicyT, FeaturesT>::
+    GetLevelOfDetailParameters() const
+{
+  return this->template Interface<LevelOfDetailFeature>()
+      ->GetWorldLevelOfDetailParameters(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+std::size_t LevelOfDetailFeature::World<PolicyT, FeaturesT>::
+    GetKinematicProxyCount() const
+{
+  return this->template Interface<LevelOfDetailFeature>()
+      ->GetWorldKinematicProxyCount(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool LevelOfDetailFeature::Model<PolicyT, FeaturesT>::IsKinematicProxy() const
+{
+  return this->template Interface<LevelOfDetailFeature>()
+      ->GetModelKinematicProxy(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool LevelOfDetailFeature::Model<PolicyT, FeaturesT>::SetKinematicProxy(
+    const bool _proxy)
+{
+  return this->template Interface<LevelOfDetailFeature>()
+      ->SetModelKinematicProxy(this->identity, _proxy);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool LevelOfDetailFeature::Model<PolicyT, FeaturesT>::IsLevelOfDetailFocus()
+    const
+{
+  return this->template Interface<LevelOfDetailFeature>()
+      ->GetModelLevelOfDetailFocus(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+void LevelOfDetailFeature::Model<PolicyT, FeaturesT>::SetLevelOfDetailFocus(
+    const bool _focus)
+{
+  this->template Interface<LevelOfDetailFeature>()
+      ->SetModelLevelOfDetailFocus(this->identity, _focus);
+}
+}
+}
+
+#endif
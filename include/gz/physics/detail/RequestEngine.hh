@@ -19,9 +19,11 @@
 #define GZ_PHYSICS_DETAIL_REQUESTENGINE_HH_
 
 #include <memory>
+#include <memory_resource>
 #include <set>
 #include <string>
 
+#include <gz/physics/EngineMemoryResource.hh>
 #include <gz/physics/RequestEngine.hh>
 #include <gz/physics/detail/InspectFeatures.hh>
 
@@ -69,6 +71,40 @@ namespace gz
 
       return EnginePtrType(pimpl, implBase->InitiateEngine(_engineID));
     }
+
+    /////////////////////////////////////////////////
+    template <typename FeaturePolicyT, typename FeatureListT>
+    template <typename PtrT>
+    auto RequestEngine<FeaturePolicyT, FeatureListT>::From(
+        const PtrT &_pimpl,
+        std::pmr::memory_resource &_memoryResource,
+        const std::size_t _engineID) -> EnginePtrType
+    {
+      using Pimpl = typename Engine<FeaturePolicyT, FeatureListT>::Pimpl;
+
+      if (!detail::InspectFeatures<FeaturePolicyT, Features>::Verify(_pimpl))
+        return nullptr;
+
+      std::shared_ptr<Pimpl> pimpl = std::make_shared<Pimpl>(_pimpl);
+
+      // Plugins that cannot use a custom memory resource keep using the
+      // global heap.
+      EngineMemoryResourceFeature::Implementation<FeaturePolicyT> *implMemory =
+          (*pimpl)->template QueryInterface<
+              EngineMemoryResourceFeature::Implementation<FeaturePolicyT>>();
+      if (implMemory)
+      {
+        return EnginePtrType(
+            pimpl, implMemory->InitiateEngineWithMemoryResource(
+                _engineID, _memoryResource));
+      }
+
+      Feature::Implementation<FeaturePolicyT> *implBase =
+          (*pimpl)->template QueryInterface<
+              Feature::Implementation<FeaturePolicyT>>();
+
+      return EnginePtrType(pimpl, implBase->InitiateEngine(_engineID));
+    }
   }
 }
 
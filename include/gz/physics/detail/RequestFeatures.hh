@@ -19,8 +19,10 @@
 #define GZ_PHYSICS_DETAIL_REQUESTFEATURES_HH_
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include <gz/physics/RequestFeatures.hh>
@@ -30,6 +32,69 @@ namespace gz
 {
   namespace physics
   {
+    namespace detail
+    {
+      /////////////////////////////////////////////////
+      /// \private Cache of the specialized plugins that have been verified by
+      /// RequestFeatures::From, keyed by the plugin instance they refer to.
+      /// Only weak references are held, so the cache never extends the
+      /// lifetime of a plugin instance. An entry is reused for as long as any
+      /// entity still refers to the specialized plugin.
+      template <typename ToPluginType>
+      class SpecializedPluginCache
+      {
+        /// \brief Get the cached specialized plugin for the instance held by
+        /// _from, if there is one.
+        public: template <typename FromPluginType>
+        static std::shared_ptr<ToPluginType> Find(const FromPluginType &_from)
+        {
+          Storage &storage = Instance();
+          std::lock_guard<std::mutex> lock(storage.mutex);
+          const auto it = storage.plugins.find(_from.Hash());
+          if (it == storage.plugins.end())
+            return nullptr;
+
+          std::shared_ptr<ToPluginType> cached = it->second.lock();
+          // Check for hash collisions between plugin instances
+          if (cached && *cached == _from)
+            return cached;
+
+          return nullptr;
+        }
+
+        /// \brief Store a verified specialized plugin.
+        public: static void Insert(const std::shared_ptr<ToPluginType> &_to)
+        {
+          Storage &storage = Instance();
+          std::lock_guard<std::mutex> lock(storage.mutex);
+
+          // Insertions only happen on a cache miss, so this is a good time to
+          // drop entries whose specialized plugins are no longer in use.
+          for (auto it = storage.plugins.begin(); it != storage.plugins.end();)
+          {
+            if (it->second.expired())
+              it = storage.plugins.erase(it);
+            else
+              ++it;
+          }
+
+          storage.plugins[_to->Hash()] = _to;
+        }
+
+        private: struct Storage
+        {
+          std::mutex mutex;
+          std::unordered_map<std::size_t, std::weak_ptr<ToPluginType>> plugins;
+        };
+
+        private: static Storage &Instance()
+        {
+          static Storage storage;
+          return storage;
+        }
+      };
+    }
+
     /////////////////////////////////////////////////
     template <typename FeatureListT>
     template <
@@ -53,6 +118,17 @@ namespace gz
       if (!_from.entity->pimpl)
         return nullptr;
 
+      using Cache = detail::SpecializedPluginCache<ToPluginType>;
+
+      // Reuse the specialized plugin of an earlier cast of the same plugin
+      // instance, which skips constructing and verifying a new one.
+      std::shared_ptr<ToPluginType> cached = Cache::Find(*_from.entity->pimpl);
+      if (cached)
+      {
+        return EntityPtr<EntityT<PolicyT, FeatureListT>>(
+              std::move(cached), _from.entity->identity);
+      }
+
       ToPluginType toPlugin(*_from.entity->pimpl);
       if (!detail::InspectFeatures<
               PolicyT,
@@ -64,9 +140,11 @@ namespace gz
         return nullptr;
       }
 
+      auto toPluginPtr = std::make_shared<ToPluginType>(std::move(toPlugin));
+      Cache::Insert(toPluginPtr);
+
       return EntityPtr<EntityT<PolicyT, FeatureListT>>(
-            std::make_shared<ToPluginType>(std::move(toPlugin)),
-            _from.entity->identity);
+            std::move(toPluginPtr), _from.entity->identity);
     }
 
     /////////////////////////////////////////////////
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_DETAIL_SLEEP_HH_
+#define GZ_PHYSICS_DETAIL_SLEEP_HH_
+
+#include <gz/physics/Sleep.hh>
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+void SleepFeature::World<PolicyT, FeaturesT>::SetSleepParameters(
+    const SleepParameters &_parameters)
+{
+  this->template Interface<SleepFeature>()
+      ->SetWorldSleepParameters(this->identity, _parameters);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+SleepParameters SleepFeature::World<PolicyT, FeaturesT>::GetSleepParameters()
+    const
+{
+  return this->template Interface<SleepFeature>()
+      ->GetWorldSleepParameters(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+std::size_t SleepFeature::World<PolicyT, FeaturesT>::GetSleepingModelCount()
+    const
+{
+  return this->template Interface<SleepFeature>()
+      ->GetWorldSleepingModelCount(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool SleepFeature::Model<PolicyT, FeaturesT>::IsSleeping() const
+{
+  return this->template Interface<SleepFeature>()
+      ->GetModelSleeping(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool SleepFeature::Model<PolicyT, FeaturesT>::SetSleeping(
+    const bool _sleeping)
+{
+  return this->template Interface<SleepFeature>()
+      ->SetModelSleeping(this->identity, _sleeping);
+}
+}
+}
+
+#endif
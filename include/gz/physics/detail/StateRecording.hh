@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_DETAIL_STATERECORDING_HH_
+#define GZ_PHYSICS_DETAIL_STATERECORDING_HH_
+
+#include <string>
+
+#include <gz/physics/StateRecording.hh>
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool RecordWorldState::World<PolicyT, FeaturesT>::StartStateRecording(
+    const std::string &_path, const StateLogOptions &_options)
+{
+  return this->template Interface<RecordWorldState>()
+      ->WorldStartStateRecording(this->identity, _path, _options);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool RecordWorldState::World<PolicyT, FeaturesT>::StopStateRecording()
+{
+  return this->template Interface<RecordWorldState>()
+      ->WorldStopStateRecording(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool ReplayWorldState::World<PolicyT, FeaturesT>::LoadStateLog(
+    const std::string &_path)
+{
+  return this->template Interface<ReplayWorldState>()
+      ->WorldLoadStateLog(this->identity, _path);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+void ReplayWorldState::World<PolicyT, FeaturesT>::UnloadStateLog()
+{
+  this->template Interface<ReplayWorldState>()
+      ->WorldUnloadStateLog(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+std::size_t ReplayWorldState::World<PolicyT, FeaturesT>
+::GetStateLogStepCount() const
+{
+  return this->template Interface<ReplayWorldState>()
+      ->GetWorldStateLogStepCount(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool ReplayWorldState::World<PolicyT, FeaturesT>::SeekStateLog(
+    const std::size_t _index)
+{
+  return this->template Interface<ReplayWorldState>()
+      ->WorldSeekStateLog(this->identity, _index);
+}
+}
+}
+
+#endif
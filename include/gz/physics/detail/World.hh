@@ -135,6 +135,60 @@ const std::string &Solver::World<PolicyT, FeaturesT>::
       ->GetWorldSolver(this->identity);
 }
 
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool SolverIterations::World<PolicyT, FeaturesT>::SetSolverIterations(
+    const SolverIterationParameters &_parameters)
+{
+  return this->template Interface<SolverIterations>()
+      ->SetWorldSolverIterations(this->identity, _parameters);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+SolverIterationParameters SolverIterations::World<PolicyT, FeaturesT>::
+    GetSolverIterations() const
+{
+  return this->template Interface<SolverIterations>()
+      ->GetWorldSolverIterations(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+bool SolverWarmStart::World<PolicyT, FeaturesT>::SetSolverWarmStart(
+    const SolverWarmStartParameters &_parameters)
+{
+  return this->template Interface<SolverWarmStart>()
+      ->SetWorldSolverWarmStart(this->identity, _parameters);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+SolverWarmStartParameters SolverWarmStart::World<PolicyT, FeaturesT>::
+    GetSolverWarmStart() const
+{
+  return this->template Interface<SolverWarmStart>()
+      ->GetWorldSolverWarmStart(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+std::size_t SolverWarmStart::World<PolicyT, FeaturesT>::
+    GetWarmStartedContactCount() const
+{
+  return this->template Interface<SolverWarmStart>()
+      ->GetWorldWarmStartedContactCount(this->identity);
+}
+
+/////////////////////////////////////////////////
+template <typename PolicyT, typename FeaturesT>
+WorldMemoryUsage GetWorldMemoryUsage::World<PolicyT, FeaturesT>::
+    GetMemoryUsage() const
+{
+  return this->template Interface<GetWorldMemoryUsage>()
+      ->GetWorldMemoryUsage(this->identity);
+}
+
 }  // namespace physics
 }  // namespace gz
 
@@ -0,0 +1,613 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_SDF_PARTITIONEDWORLD_HH_
+#define GZ_PHYSICS_SDF_PARTITIONEDWORLD_HH_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sdf/Model.hh>
+#include <sdf/World.hh>
+
+#include <gz/physics/FeatureList.hh>
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/FrameSemantics.hh>
+#include <gz/physics/FreeGroup.hh>
+#include <gz/physics/GetContacts.hh>
+#include <gz/physics/GetEntities.hh>
+#include <gz/physics/RemoveEntities.hh>
+#include <gz/physics/RequestEngine.hh>
+#include <gz/physics/WorldPartition.hh>
+#include <gz/physics/sdf/ConstructModel.hh>
+#include <gz/physics/sdf/ConstructWorld.hh>
+
+namespace gz {
+namespace physics {
+namespace sdf {
+
+/// \brief The features that the engines of a PartitionedWorld must have.
+struct PartitionedWorldFeatureList : FeatureList<
+  ForwardStep,
+  ConstructSdfWorld,
+  ConstructSdfModel,
+  GetModelFromWorld,
+  GetLinkFromModel,
+  GetShapeFromLink,
+  RemoveModelFromWorld,
+  FindFreeGroupFeature,
+  SetFreeGroupWorldPose,
+  SetFreeGroupWorldVelocity,
+  LinkFrameSemantics,
+  GetContactsFromLastStepFeature
+> { };
+
+/// \brief Pose of a model of a PartitionedWorld after a step.
+struct PartitionedModelPose
+{
+  /// \brief Name of the model
+  std::string name;
+
+  /// \brief Region that owns the model
+  std::size_t region;
+
+  /// \brief Pose of the root link of the model in the world frame
+  Pose3d pose;
+};
+
+/// \brief Contact of a PartitionedWorld during the last step.
+struct PartitionedContact
+{
+  /// \brief Name of the model of the first collision
+  std::string model1;
+
+  /// \brief Name of the model of the second collision
+  std::string model2;
+
+  /// \brief Region whose world reported the contact
+  std::size_t region;
+
+  /// \brief Contact point in the world frame
+  Eigen::Vector3d point;
+};
+
+/// \brief PartitionedWorld simulates a world that is too large for a single
+/// engine world by splitting it into the regions of a WorldPartition. Each
+/// region is simulated by a world of its own engine instance, and the
+/// regions are stepped in parallel, one thread each.
+///
+/// Static models are constructed in every region. Every other model is
+/// owned by the region that contains the origin of its root link, and
+/// regions whose overlap zone it is in hold a mirror of it: a copy whose
+/// pose and velocity are overwritten with the ones of the owner after every
+/// step, so that the bodies of that region collide with it. Mirrors are
+/// simulated like any other model during a step, so a contact across a
+/// boundary only acts on the body of the region that reports it.
+///
+/// Once a model leaves the region that owns it by more than half the
+/// overlap, it is handed off: the region that contains it becomes its owner,
+/// starting from the pose and velocity that the previous owner computed.
+///
+/// Models are placed by their raw pose, which must be relative to the
+/// world. Only models without nested models can be partitioned, and models
+/// that are not free, such as models fixed to the world, stay in the region
+/// they start in and are never mirrored. Since only the pose and velocity of
+/// the root link are carried over to mirrors and new owners, models with
+/// more than one link are pinned the same way, so that the state of their
+/// joints is never lost.
+///
+/// The engines must not share state between their instances, since they are
+/// stepped concurrently.
+template <typename FeaturesT>
+class PartitionedWorld
+{
+  public: using EnginePtrType = Engine3dPtr<FeaturesT>;
+  public: using WorldPtrType = World3dPtr<FeaturesT>;
+  public: using ModelPtrType = Model3dPtr<FeaturesT>;
+
+  /// \brief Construct a partitioned world.
+  /// \param[in] _engines Engine of each region of the partition. Each
+  /// region needs its own engine instance.
+  /// \param[in] _world World to partition.
+  /// \param[in] _partition Regions of the world.
+  /// \param[in] _threaded True to step the regions in parallel, false to
+  /// step them one after the other in the calling thread.
+  /// \return The partitioned world, or nullptr if the number of engines
+  /// does not match the number of regions, or if a region or a model could
+  /// not be constructed.
+  public: static std::unique_ptr<PartitionedWorld> Construct(
+      const std::vector<EnginePtrType> &_engines,
+      const ::sdf::World &_world,
+      const WorldPartition &_partition,
+      bool _threaded = true);
+
+  /// \brief Destructor. Stops the threads of the regions.
+  public: ~PartitionedWorld();
+
+  public: PartitionedWorld(const PartitionedWorld &) = delete;
+  public: PartitionedWorld &operator=(const PartitionedWorld &) = delete;
+
+  /// \brief Step every region, then hand the models off that left the
+  /// region that owns them, and update the mirrors.
+  /// \param[in] _input Input of the step, passed to every region.
+  public: void Step(const ForwardStep::Input &_input);
+
+  /// \brief Get the regions of the world.
+  /// \return Partition of the world.
+  public: const WorldPartition &Partition() const;
+
+  /// \brief Get the world that simulates a region.
+  /// \param[in] _region Index of the region.
+  /// \return World of the region, or nullptr if it does not exist.
+  public: WorldPtrType RegionWorld(std::size_t _region) const;
+
+  /// \brief Get the region that owns a model.
+  /// \param[in] _name Name of the model.
+  /// \return Index of the region, or the number of regions if the model is
+  /// static or does not exist.
+  public: std::size_t RegionOfModel(const std::string &_name) const;
+
+  /// \brief Get the number of mirrors of models in overlap zones.
+  /// \return Number of mirrors in all the regions.
+  public: std::size_t MirrorCount() const;
+
+  /// \brief Get the poses of the models that are not static, merged from
+  /// the regions that own them.
+  /// \return Poses of the models after the last step.
+  public: const std::vector<PartitionedModelPose> &ModelPoses() const;
+
+  /// \brief Get the contacts of the last step, merged from all the regions.
+  /// Contacts that only involve mirrors and static models are left out, and
+  /// a contact between models of two regions is only reported once.
+  /// \return Contacts of the last step.
+  public: const std::vector<PartitionedContact> &Contacts() const;
+
+  /// \brief State of a model that is not static
+  private: struct PartitionedModel
+  {
+    /// \brief Description of the model, used to construct its copies
+    ::sdf::Model description;
+
+    /// \brief Copy of the model in each region, or nullptr
+    std::vector<ModelPtrType> copies;
+
+    /// \brief Region that owns the model
+    std::size_t owner;
+
+    /// \brief Whether the model is free and has a single link, so that it
+    /// can be moved between regions
+    bool free;
+
+    /// \brief Frame data of the root link of the owner copy
+    FrameData3d state;
+  };
+
+  /// \brief World of a region and the data of its steps
+  private: struct Region
+  {
+    WorldPtrType world;
+    ForwardStep::Input input;
+    ForwardStep::Output output;
+    ForwardStep::State state;
+    std::thread thread;
+  };
+
+  /// \brief Constructor
+  /// \param[in] _partition Regions of the world.
+  private: explicit PartitionedWorld(const WorldPartition &_partition);
+
+  /// \brief Read the state of the owner copy of every model.
+  private: void ReadStates();
+
+  /// \brief Merge the contacts of the regions.
+  private: void MergeContacts();
+
+  /// \brief Hand the models off, and create, update or remove the mirrors.
+  /// \return False if a copy of a model could not be constructed.
+  private: bool UpdateMirrors();
+
+  /// \brief Construct a copy of a model in a region.
+  /// \param[in] _model Model to copy.
+  /// \param[in] _region Region of the copy.
+  /// \return False if the copy could not be constructed.
+  private: bool ConstructCopy(PartitionedModel &_model, std::size_t _region);
+
+  /// \brief Step a region whenever Step() asks for it.
+  /// \param[in] _region Region to step.
+  private: void RunRegion(Region &_region);
+
+  private: WorldPartition partition;
+  private: std::vector<std::unique_ptr<Region>> regions;
+  private: std::vector<PartitionedModel> models;
+  private: std::unordered_map<std::string, std::size_t> modelIndices;
+  private: std::vector<PartitionedModelPose> poses;
+  private: std::vector<PartitionedContact> contacts;
+  private: std::size_t mirrorCount = 0;
+
+  /// \brief Synchronization of the threads of the regions
+  private: std::mutex mutex;
+  private: std::condition_variable startCondition;
+  private: std::condition_variable doneCondition;
+  private: std::size_t generation = 0;
+  private: std::size_t pending = 0;
+  private: bool stopping = false;
+};
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+PartitionedWorld<FeaturesT>::PartitionedWorld(
+    const WorldPartition &_partition)
+  : partition(_partition)
+{
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+auto PartitionedWorld<FeaturesT>::Construct(
+    const std::vector<EnginePtrType> &_engines,
+    const ::sdf::World &_world,
+    const WorldPartition &_partition,
+    const bool _threaded) -> std::unique_ptr<PartitionedWorld>
+{
+  if (_engines.size() != _partition.RegionCount())
+    return nullptr;
+
+  std::unique_ptr<PartitionedWorld> world(new PartitionedWorld(_partition));
+
+  // Every region gets the static models, the other models are added to the
+  // region that owns them
+  ::sdf::World staticWorld = _world;
+  staticWorld.ClearModels();
+  for (std::size_t i = 0; i < _world.ModelCount(); ++i)
+  {
+    const ::sdf::Model *model = _world.ModelByIndex(i);
+    if (model->Static())
+    {
+      staticWorld.AddModel(*model);
+      continue;
+    }
+
+    PartitionedModel partitioned;
+    partitioned.description = *model;
+    partitioned.copies.resize(_partition.RegionCount());
+    const auto &position = model->RawPose().Pos();
+    partitioned.owner = _partition.RegionOf(
+        Eigen::Vector3d(position.X(), position.Y(), position.Z()));
+    partitioned.free = false;
+    world->modelIndices[model->Name()] = world->models.size();
+    world->models.push_back(std::move(partitioned));
+  }
+
+  for (const auto &engine : _engines)
+  {
+    if (!engine)
+      return nullptr;
+
+    auto region = std::make_unique<Region>();
+    region->world = engine->ConstructWorld(staticWorld);
+    if (!region->world)
+      return nullptr;
+    world->regions.push_back(std::move(region));
+  }
+
+  for (auto &model : world->models)
+  {
+    auto &copy = model.copies[model.owner];
+    copy = world->regions[model.owner]->world->ConstructModel(
+        model.description);
+    if (!copy)
+      return nullptr;
+    model.free = model.description.LinkCount() == 1u &&
+        static_cast<bool>(copy->FindFreeGroup());
+  }
+
+  world->ReadStates();
+  if (!world->UpdateMirrors())
+    return nullptr;
+
+  if (_threaded)
+  {
+    for (auto &region : world->regions)
+    {
+      region->thread = std::thread(
+          &PartitionedWorld::RunRegion, world.get(), std::ref(*region));
+    }
+  }
+  return world;
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+PartitionedWorld<FeaturesT>::~PartitionedWorld()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->startCondition.notify_all();
+  for (auto &region : this->regions)
+  {
+    if (region->thread.joinable())
+      region->thread.join();
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+void PartitionedWorld<FeaturesT>::Step(const ForwardStep::Input &_input)
+{
+  // Each region queries its own copy of the input, since queries keep track
+  // of what was queried
+  for (auto &region : this->regions)
+    region->input = _input;
+
+  if (this->regions.front()->thread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->pending = this->regions.size();
+      ++this->generation;
+    }
+    this->startCondition.notify_all();
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->doneCondition.wait(lock, [this]() { return this->pending == 0; });
+  }
+  else
+  {
+    for (auto &region : this->regions)
+      region->world->Step(region->output, region->state, region->input);
+  }
+
+  this->ReadStates();
+  this->MergeContacts();
+  this->UpdateMirrors();
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+const WorldPartition &PartitionedWorld<FeaturesT>::Partition() const
+{
+  return this->partition;
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+auto PartitionedWorld<FeaturesT>::RegionWorld(const std::size_t _region) const
+    -> WorldPtrType
+{
+  if (_region >= this->regions.size())
+    return nullptr;
+  return this->regions[_region]->world;
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+std::size_t PartitionedWorld<FeaturesT>::RegionOfModel(
+    const std::string &_name) const
+{
+  const auto it = this->modelIndices.find(_name);
+  if (it == this->modelIndices.end())
+    return this->regions.size();
+  return this->models[it->second].owner;
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+std::size_t PartitionedWorld<FeaturesT>::MirrorCount() const
+{
+  return this->mirrorCount;
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+const std::vector<PartitionedModelPose> &
+PartitionedWorld<FeaturesT>::ModelPoses() const
+{
+  return this->poses;
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+const std::vector<PartitionedContact> &
+PartitionedWorld<FeaturesT>::Contacts() const
+{
+  return this->contacts;
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+void PartitionedWorld<FeaturesT>::ReadStates()
+{
+  this->poses.clear();
+  for (auto &model : this->models)
+  {
+    const auto &copy = model.copies[model.owner];
+    if (model.free)
+    {
+      model.state = copy->FindFreeGroup()->RootLink()
+          ->FrameDataRelativeToWorld();
+    }
+    else if (const auto link = copy->GetLink(0))
+    {
+      model.state = link->FrameDataRelativeToWorld();
+    }
+
+    this->poses.push_back(PartitionedModelPose{
+        model.description.Name(), model.owner, model.state.pose});
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+void PartitionedWorld<FeaturesT>::MergeContacts()
+{
+  this->contacts.clear();
+  for (std::size_t r = 0; r < this->regions.size(); ++r)
+  {
+    // Regions that do not own a model, and thus mirror the models of
+    // another region, map to the number of regions
+    const auto ownerOf = [&](const auto &_shape)
+    {
+      const auto it = this->modelIndices.find(
+          _shape->GetLink()->GetModel()->GetName());
+      return it == this->modelIndices.end() ?
+          this->regions.size() : this->models[it->second].owner;
+    };
+
+    for (const auto &contact :
+         this->regions[r]->world->GetContactsFromLastStep())
+    {
+      const auto &point = contact.template Get<
+          typename World3d<FeaturesT>::ContactPoint>();
+      if (!point.collision1 || !point.collision2)
+        continue;
+
+      const std::size_t owner1 = ownerOf(point.collision1);
+      const std::size_t owner2 = ownerOf(point.collision2);
+      if (owner1 != r && owner2 != r)
+        continue;
+
+      // A contact between models of two regions is reported by both, once
+      // with each model as a mirror
+      if (owner1 < this->regions.size() && owner2 < this->regions.size() &&
+          std::min(owner1, owner2) != r)
+      {
+        continue;
+      }
+
+      this->contacts.push_back(PartitionedContact{
+          point.collision1->GetLink()->GetModel()->GetName(),
+          point.collision2->GetLink()->GetModel()->GetName(),
+          r, point.point});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+bool PartitionedWorld<FeaturesT>::UpdateMirrors()
+{
+  bool constructed = true;
+  this->mirrorCount = 0;
+  for (std::size_t i = 0; i < this->models.size(); ++i)
+  {
+    PartitionedModel &model = this->models[i];
+    if (!model.free)
+      continue;
+
+    const Eigen::Vector3d position = model.state.pose.translation();
+    std::size_t owner = this->partition.HandOff(model.owner, position);
+
+    // A model that cannot be copied to its new region stays where it is
+    if (!model.copies[owner] && !this->ConstructCopy(model, owner))
+    {
+      constructed = false;
+      owner = model.owner;
+    }
+
+    for (std::size_t r = 0; r < this->regions.size(); ++r)
+    {
+      auto &copy = model.copies[r];
+      if (r == model.owner && r == owner)
+        continue;
+
+      if (r != owner && !this->partition.Mirrors(r, owner, position))
+      {
+        if (copy)
+        {
+          copy->Remove();
+          copy = nullptr;
+        }
+        continue;
+      }
+
+      if (!copy && !this->ConstructCopy(model, r))
+      {
+        constructed = false;
+        continue;
+      }
+
+      auto freeGroup = copy->FindFreeGroup();
+      freeGroup->SetWorldPose(model.state.pose);
+      freeGroup->SetWorldLinearVelocity(model.state.linearVelocity);
+      freeGroup->SetWorldAngularVelocity(model.state.angularVelocity);
+      if (r != owner)
+        ++this->mirrorCount;
+    }
+
+    model.owner = owner;
+    this->poses[i].region = owner;
+  }
+  return constructed;
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+bool PartitionedWorld<FeaturesT>::ConstructCopy(
+    PartitionedModel &_model, const std::size_t _region)
+{
+  auto copy = this->regions[_region]->world->ConstructModel(
+      _model.description);
+  if (!copy || !copy->FindFreeGroup())
+  {
+    if (copy)
+      copy->Remove();
+    return false;
+  }
+  _model.copies[_region] = copy;
+  return true;
+}
+
+/////////////////////////////////////////////////
+template <typename FeaturesT>
+void PartitionedWorld<FeaturesT>::RunRegion(Region &_region)
+{
+  std::size_t stepped = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->startCondition.wait(lock, [&]()
+          { return this->stopping || this->generation != stepped; });
+      if (this->stopping)
+        return;
+      stepped = this->generation;
+    }
+
+    _region.world->Step(_region.output, _region.state, _region.input);
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (--this->pending == 0)
+        this->doneCondition.notify_one();
+    }
+  }
+}
+}
+}
+}
+
+#endif
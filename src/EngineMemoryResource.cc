@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include "gz/physics/EngineMemoryResource.hh"
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+EngineMemoryResource::EngineMemoryResource()
+  : upstream(std::pmr::get_default_resource())
+{
+  // Do nothing
+}
+
+/////////////////////////////////////////////////
+EngineMemoryResource::~EngineMemoryResource() = default;
+
+/////////////////////////////////////////////////
+bool EngineMemoryResource::SetUpstream(std::pmr::memory_resource *_upstream)
+{
+  if (!_upstream)
+    return false;
+
+  if (_upstream == this->upstream)
+    return true;
+
+  if (this->inUse)
+    return false;
+
+  this->upstream = _upstream;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void EngineMemoryResource::MarkInUse()
+{
+  this->inUse = true;
+
+  // Blocks from the final upstream resource no longer need to be told apart
+  this->earlyBlocks.erase(std::remove_if(
+      this->earlyBlocks.begin(), this->earlyBlocks.end(),
+      [this](const EarlyBlock &_block)
+      {
+        return _block.upstream == this->upstream;
+      }), this->earlyBlocks.end());
+}
+
+/////////////////////////////////////////////////
+bool EngineMemoryResource::InUse() const
+{
+  return this->inUse;
+}
+
+/////////////////////////////////////////////////
+std::pmr::memory_resource *EngineMemoryResource::Upstream() const
+{
+  return this->upstream;
+}
+
+/////////////////////////////////////////////////
+std::size_t EngineMemoryResource::BytesInUse() const
+{
+  return this->bytesInUse.load();
+}
+
+/////////////////////////////////////////////////
+void *EngineMemoryResource::do_allocate(
+    const std::size_t _bytes, const std::size_t _alignment)
+{
+  void *p = this->upstream->allocate(_bytes, _alignment);
+  this->bytesInUse += _bytes;
+  if (!this->inUse)
+    this->earlyBlocks.push_back({p, this->upstream});
+  return p;
+}
+
+/////////////////////////////////////////////////
+void EngineMemoryResource::do_deallocate(
+    void *_p, const std::size_t _bytes, const std::size_t _alignment)
+{
+  std::pmr::memory_resource *resource = this->upstream;
+  if (!this->earlyBlocks.empty())
+  {
+    auto blockIt = std::find_if(
+        this->earlyBlocks.begin(), this->earlyBlocks.end(),
+        [_p](const EarlyBlock &_block) { return _block.pointer == _p; });
+    if (blockIt != this->earlyBlocks.end())
+    {
+      resource = blockIt->upstream;
+      this->earlyBlocks.erase(blockIt);
+    }
+  }
+
+  resource->deallocate(_p, _bytes, _alignment);
+  this->bytesInUse -= _bytes;
+}
+
+/////////////////////////////////////////////////
+bool EngineMemoryResource::do_is_equal(
+    const std::pmr::memory_resource &_other) const noexcept
+{
+  return this == &_other;
+}
+}
+}
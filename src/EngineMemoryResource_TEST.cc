@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+
+#include "gz/physics/EngineMemoryResource.hh"
+
+using gz::physics::EngineMemoryResource;
+
+/////////////////////////////////////////////////
+/// Memory resource that counts the allocations it receives
+class CountingResource : public std::pmr::memory_resource
+{
+  public: std::size_t allocations = 0;
+  public: std::size_t deallocations = 0;
+
+  private: void *do_allocate(
+      std::size_t _bytes, std::size_t _alignment) override
+  {
+    ++this->allocations;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+  }
+
+  private: void do_deallocate(
+      void *_p, std::size_t _bytes, std::size_t _alignment) override
+  {
+    ++this->deallocations;
+    std::pmr::new_delete_resource()->deallocate(_p, _bytes, _alignment);
+  }
+
+  private: bool do_is_equal(
+      const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST(EngineMemoryResource_TEST, Forwarding)
+{
+  EngineMemoryResource resource;
+  EXPECT_EQ(std::pmr::get_default_resource(), resource.Upstream());
+  EXPECT_EQ(0u, resource.BytesInUse());
+
+  CountingResource counting;
+  EXPECT_FALSE(resource.SetUpstream(nullptr));
+  ASSERT_TRUE(resource.SetUpstream(&counting));
+  EXPECT_EQ(&counting, resource.Upstream());
+
+  {
+    std::pmr::unordered_map<std::size_t, std::string> map(&resource);
+    for (std::size_t i = 0; i < 10; ++i)
+      map[i] = "entity";
+
+    EXPECT_LT(0u, counting.allocations);
+    EXPECT_LT(0u, resource.BytesInUse());
+
+    // The upstream resource cannot change once the resource is in use, but
+    // setting the same one again is harmless
+    resource.MarkInUse();
+    EXPECT_TRUE(resource.InUse());
+    CountingResource other;
+    EXPECT_FALSE(resource.SetUpstream(&other));
+    EXPECT_TRUE(resource.SetUpstream(&counting));
+    EXPECT_EQ(&counting, resource.Upstream());
+  }
+
+  EXPECT_EQ(counting.allocations, counting.deallocations);
+  EXPECT_EQ(0u, resource.BytesInUse());
+  EXPECT_FALSE(resource.SetUpstream(std::pmr::new_delete_resource()));
+}
+
+/////////////////////////////////////////////////
+TEST(EngineMemoryResource_TEST, SwitchBeforeUse)
+{
+  CountingResource first;
+  CountingResource second;
+  EngineMemoryResource resource;
+  ASSERT_TRUE(resource.SetUpstream(&first));
+  EXPECT_FALSE(resource.InUse());
+
+  // Memory allocated before the resource is in use, like the sentinel node
+  // of a container, does not keep the upstream resource from changing
+  void *early = resource.allocate(16, alignof(std::max_align_t));
+  EXPECT_EQ(1u, first.allocations);
+  ASSERT_TRUE(resource.SetUpstream(&second));
+  resource.MarkInUse();
+
+  void *late = resource.allocate(32, alignof(std::max_align_t));
+  EXPECT_EQ(1u, first.allocations);
+  EXPECT_EQ(1u, second.allocations);
+
+  // Each block goes back to the resource it came from
+  resource.deallocate(early, 16, alignof(std::max_align_t));
+  EXPECT_EQ(1u, first.deallocations);
+  EXPECT_EQ(0u, second.deallocations);
+  resource.deallocate(late, 32, alignof(std::max_align_t));
+  EXPECT_EQ(1u, first.deallocations);
+  EXPECT_EQ(1u, second.deallocations);
+  EXPECT_EQ(0u, resource.BytesInUse());
+}
+
+/////////////////////////////////////////////////
+TEST(EngineMemoryResource_TEST, MakeShared)
+{
+  CountingResource counting;
+  EngineMemoryResource resource;
+  ASSERT_TRUE(resource.SetUpstream(&counting));
+
+  struct Info
+  {
+    std::size_t id;
+    double value;
+  };
+
+  auto info = resource.MakeShared<Info>(Info{5u, 2.0});
+  ASSERT_NE(nullptr, info);
+  EXPECT_EQ(5u, info->id);
+  EXPECT_DOUBLE_EQ(2.0, info->value);
+
+  // The object and its control block share one allocation
+  EXPECT_EQ(1u, counting.allocations);
+  EXPECT_LE(sizeof(Info), resource.BytesInUse());
+
+  auto copy = info;
+  info.reset();
+  EXPECT_EQ(0u, counting.deallocations);
+  copy.reset();
+  EXPECT_EQ(1u, counting.deallocations);
+  EXPECT_EQ(0u, resource.BytesInUse());
+}
@@ -0,0 +1,587 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#include "gz/physics/PoseStream.hh"
+
+namespace gz
+{
+namespace physics
+{
+namespace
+{
+/////////////////////////////////////////////////
+// Layout of the frame header:
+//   [0]      format version
+//   [1]      flags
+//   [2]      bits per quaternion component
+//   [3, 11)  position resolution, IEEE 754 double, little endian
+//   [11, 15) number of poses, little endian
+constexpr uint8_t kVersion = 1;
+constexpr uint8_t kKeyFrameFlag = 0x01;
+constexpr std::size_t kResolutionOffset = 3;
+constexpr std::size_t kCountOffset = 11;
+constexpr std::size_t kHeaderSize = 15;
+
+constexpr unsigned int kMinRotationBits = 2;
+constexpr unsigned int kMaxRotationBits = 20;
+
+// Quantized positions beyond this magnitude are rejected so that deltas
+// between them can never overflow.
+constexpr double kMaxQuantizedPosition = 1e18;
+
+constexpr double kSqrt2 = 1.41421356237309504880;
+
+constexpr std::size_t kMaxVarintBytes = 10;
+
+/////////////////////////////////////////////////
+std::size_t RotationBytes(const unsigned int _bits)
+{
+  return (2 + 3 * _bits + 7) / 8;
+}
+
+/////////////////////////////////////////////////
+void WriteLittleEndian(uint64_t _value, const std::size_t _bytes,
+                       uint8_t *_out)
+{
+  for (std::size_t i = 0; i < _bytes; ++i)
+  {
+    _out[i] = static_cast<uint8_t>(_value & 0xFF);
+    _value >>= 8;
+  }
+}
+
+/////////////////////////////////////////////////
+uint64_t ReadLittleEndian(const uint8_t *_in, const std::size_t _bytes)
+{
+  uint64_t value = 0;
+  for (std::size_t i = _bytes; i > 0; --i)
+    value = (value << 8) | _in[i - 1];
+  return value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a varint to _out, which must have room for kMaxVarintBytes.
+/// \return Pointer past the last byte that was written.
+uint8_t *WriteVarint(uint64_t _value, uint8_t *_out)
+{
+  while (_value >= 0x80)
+  {
+    *_out++ = static_cast<uint8_t>(_value | 0x80);
+    _value >>= 7;
+  }
+  *_out++ = static_cast<uint8_t>(_value);
+  return _out;
+}
+
+/////////////////////////////////////////////////
+bool ReadVarint(const uint8_t *_data, const std::size_t _size,
+                std::size_t &_pos, uint64_t &_value)
+{
+  _value = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7)
+  {
+    if (_pos >= _size)
+      return false;
+
+    const uint8_t byte = _data[_pos++];
+    _value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+uint64_t ZigZag(const int64_t _value)
+{
+  return (static_cast<uint64_t>(_value) << 1) ^
+         static_cast<uint64_t>(_value >> 63);
+}
+
+/////////////////////////////////////////////////
+int64_t UnZigZag(const uint64_t _value)
+{
+  return static_cast<int64_t>((_value >> 1) ^ (~(_value & 1) + 1));
+}
+
+/////////////////////////////////////////////////
+/// \brief Pack a quaternion with the smallest-three encoding. The two lowest
+/// bits hold the index of the dropped component.
+uint64_t PackRotation(double _q[4], const unsigned int _bits)
+{
+  const double norm = std::sqrt(
+      _q[0]*_q[0] + _q[1]*_q[1] + _q[2]*_q[2] + _q[3]*_q[3]);
+  if (norm < 1e-12)
+  {
+    _q[0] = 1.0;
+    _q[1] = _q[2] = _q[3] = 0.0;
+  }
+  else
+  {
+    const double inverseNorm = 1.0 / norm;
+    for (int i = 0; i < 4; ++i)
+      _q[i] *= inverseNorm;
+  }
+
+  unsigned int largest = 0;
+  for (unsigned int i = 1; i < 4; ++i)
+  {
+    if (std::abs(_q[i]) > std::abs(_q[largest]))
+      largest = i;
+  }
+
+  // q and -q are the same rotation, so we can always make the dropped
+  // component positive and recover it from the other three.
+  const double sign = _q[largest] < 0.0 ? -1.0 : 1.0;
+  const uint64_t maxValue = (uint64_t{1} << _bits) - 1;
+
+  uint64_t packed = largest;
+  unsigned int shift = 2;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+
+    // The components that are kept lie in [-1/sqrt(2), 1/sqrt(2)]
+    const double unit = (sign * _q[i] * kSqrt2 + 1.0) * 0.5;
+    const double scaled = std::clamp(
+        unit * static_cast<double>(maxValue),
+        0.0, static_cast<double>(maxValue));
+    packed |= static_cast<uint64_t>(std::llrint(scaled)) << shift;
+    shift += _bits;
+  }
+
+  return packed;
+}
+
+/////////////////////////////////////////////////
+math::Quaterniond UnpackRotation(uint64_t _packed, const unsigned int _bits)
+{
+  const uint64_t maxValue = (uint64_t{1} << _bits) - 1;
+  const unsigned int largest = static_cast<unsigned int>(_packed & 0x3);
+  _packed >>= 2;
+
+  double q[4];
+  double sumSquared = 0.0;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+
+    const double unit =
+        static_cast<double>(_packed & maxValue) / static_cast<double>(maxValue);
+    q[i] = (unit * 2.0 - 1.0) / kSqrt2;
+    sumSquared += q[i] * q[i];
+    _packed >>= _bits;
+  }
+  q[largest] = std::sqrt(std::max(0.0, 1.0 - sumSquared));
+
+  return math::Quaterniond(q[0], q[1], q[2], q[3]);
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+class PoseStreamEncoderPrivate
+{
+  /// \brief What was last sent for an entity
+  public: struct EntityState
+  {
+    std::size_t entity;
+    int64_t position[3];
+    uint64_t rotation;
+  };
+
+  /// \brief Find the state of an entity, creating it if needed.
+  /// \param[in] _entity Entity ID
+  /// \param[out] _inserted Whether the state was created
+  /// \return Index of the state in this->states
+  public: std::size_t FindState(const std::size_t _entity, bool &_inserted)
+  {
+    // Engines add their poses in the same order every step, so the entity
+    // that was added in the same slot of the previous frame is almost always
+    // the one we are looking for, which saves hashing its ID.
+    const std::size_t slot = this->currentOrder.size();
+    if (slot < this->previousOrder.size())
+    {
+      const std::size_t index = this->previousOrder[slot];
+      if (this->states[index].entity == _entity)
+      {
+        _inserted = false;
+        this->currentOrder.push_back(index);
+        return index;
+      }
+    }
+
+    auto [it, inserted] =
+        this->stateIndex.try_emplace(_entity, this->states.size());
+    if (inserted)
+      this->states.push_back(EntityState{_entity, {0, 0, 0}, 0});
+
+    _inserted = inserted;
+    this->currentOrder.push_back(it->second);
+    return it->second;
+  }
+
+  public: PoseStreamOptions options;
+
+  public: double inverseResolution = 0.0;
+
+  public: std::size_t rotationBytes = 0;
+
+  /// \brief What was last sent for each entity since the last key frame
+  public: std::vector<EntityState> states;
+
+  /// \brief Map from entity ID to its index in states
+  public: std::unordered_map<std::size_t, std::size_t> stateIndex;
+
+  /// \brief Indices of the states in the order their entities were added to
+  /// the previous frame
+  public: std::vector<std::size_t> previousOrder;
+
+  /// \brief Indices of the states in the order their entities were added to
+  /// the current frame
+  public: std::vector<std::size_t> currentOrder;
+
+  /// \brief Whether the next frame is a key frame
+  public: bool keyFrame = true;
+
+  /// \brief Whether the frame being written is a key frame
+  public: bool writingKeyFrame = false;
+
+  /// \brief The frame being written, or nullptr if no frame was begun
+  public: std::vector<uint8_t> *frame = nullptr;
+
+  public: std::size_t previousEntity = 0;
+
+  public: std::size_t count = 0;
+};
+
+/////////////////////////////////////////////////
+PoseStreamEncoder::PoseStreamEncoder(const PoseStreamOptions &_options)
+  : dataPtr(std::make_unique<PoseStreamEncoderPrivate>())
+{
+  this->dataPtr->options = _options;
+  if (!std::isfinite(_options.positionResolution) ||
+      _options.positionResolution <= 0.0)
+  {
+    this->dataPtr->options.positionResolution =
+        PoseStreamOptions().positionResolution;
+  }
+  this->dataPtr->options.rotationBits = std::clamp(
+      _options.rotationBits, kMinRotationBits, kMaxRotationBits);
+
+  this->dataPtr->inverseResolution =
+      1.0 / this->dataPtr->options.positionResolution;
+  this->dataPtr->rotationBytes =
+      RotationBytes(this->dataPtr->options.rotationBits);
+}
+
+/////////////////////////////////////////////////
+PoseStreamEncoder::PoseStreamEncoder(PoseStreamEncoder &&) noexcept = default;
+
+/////////////////////////////////////////////////
+PoseStreamEncoder &PoseStreamEncoder::operator=(
+    PoseStreamEncoder &&) noexcept = default;
+
+/////////////////////////////////////////////////
+PoseStreamEncoder::~PoseStreamEncoder() = default;
+
+/////////////////////////////////////////////////
+const PoseStreamOptions &PoseStreamEncoder::Options() const
+{
+  return this->dataPtr->options;
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::RequestKeyFrame()
+{
+  this->dataPtr->keyFrame = true;
+}
+
+/////////////////////////////////////////////////
+void PoseStreamEncoder::BeginFrame(std::vector<uint8_t> &_frame)
+{
+  auto &d = *this->dataPtr;
+  d.frame = &_frame;
+  d.previousEntity = 0;
+  d.count = 0;
+  d.writingKeyFrame = d.keyFrame;
+  if (d.writingKeyFrame)
+  {
+    d.states.clear();
+    d.stateIndex.clear();
+    d.previousOrder.clear();
+  }
+  d.currentOrder.clear();
+
+  _frame.resize(kHeaderSize);
+  _frame[0] = kVersion;
+  _frame[1] = d.writingKeyFrame ? kKeyFrameFlag : 0;
+  _frame[2] = static_cast<uint8_t>(d.options.rotationBits);
+
+  uint64_t resolution;
+  std::memcpy(&resolution, &d.options.positionResolution, sizeof(resolution));
+  WriteLittleEndian(resolution, 8, _frame.data() + kResolutionOffset);
+  WriteLittleEndian(0, 4, _frame.data() + kCountOffset);
+}
+
+/////////////////////////////////////////////////
+bool PoseStreamEncoder::Add(
+    const std::size_t _entity,
+    const double _x, const double _y, const double _z,
+    const double _qw, const double _qx, const double _qy, const double _qz)
+{
+  auto &d = *this->dataPtr;
+  if (!d.frame)
+    return false;
+
+  const double position[3] = {_x, _y, _z};
+  int64_t quantized[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    const double scaled = position[i] * d.inverseResolution;
+    if (!std::isfinite(scaled) || std::abs(scaled) > kMaxQuantizedPosition)
+      return false;
+    quantized[i] = std::llrint(scaled);
+  }
+
+  double q[4] = {_qw, _qx, _qy, _qz};
+  if (!std::isfinite(q[0]) || !std::isfinite(q[1]) ||
+      !std::isfinite(q[2]) || !std::isfinite(q[3]))
+  {
+    return false;
+  }
+  const uint64_t rotation = PackRotation(q, d.options.rotationBits);
+
+  bool inserted;
+  auto &state = d.states[d.FindState(_entity, inserted)];
+  if (!inserted && !d.writingKeyFrame && d.options.skipUnchanged &&
+      state.rotation == rotation &&
+      state.position[0] == quantized[0] &&
+      state.position[1] == quantized[1] &&
+      state.position[2] == quantized[2])
+  {
+    return true;
+  }
+
+  // Make room for the largest possible entry and trim the frame afterwards,
+  // which is much cheaper than growing it byte by byte.
+  std::vector<uint8_t> &out = *d.frame;
+  const std::size_t offset = out.size();
+  out.resize(offset + 4 * kMaxVarintBytes + d.rotationBytes);
+  uint8_t *cursor = out.data() + offset;
+  cursor = WriteVarint(
+      ZigZag(static_cast<int64_t>(_entity - d.previousEntity)), cursor);
+  for (int i = 0; i < 3; ++i)
+    cursor = WriteVarint(ZigZag(quantized[i] - state.position[i]), cursor);
+  WriteLittleEndian(rotation, d.rotationBytes, cursor);
+  cursor += d.rotationBytes;
+  out.resize(static_cast<std::size_t>(cursor - out.data()));
+
+  state.position[0] = quantized[0];
+  state.position[1] = quantized[1];
+  state.position[2] = quantized[2];
+  state.rotation = rotation;
+  d.previousEntity = _entity;
+  ++d.count;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool PoseStreamEncoder::Add(const std::size_t _entity,
+                            const math::Pose3d &_pose)
+{
+  return this->Add(_entity, _pose.Pos().X(), _pose.Pos().Y(), _pose.Pos().Z(),
+                   _pose.Rot().W(), _pose.Rot().X(), _pose.Rot().Y(),
+                   _pose.Rot().Z());
+}
+
+/////////////////////////////////////////////////
+std::size_t PoseStreamEncoder::EndFrame()
+{
+  auto &d = *this->dataPtr;
+  if (!d.frame)
+    return 0;
+
+  WriteLittleEndian(d.count, 4, d.frame->data() + kCountOffset);
+  std::swap(d.previousOrder, d.currentOrder);
+  if (d.writingKeyFrame)
+    d.keyFrame = false;
+  d.frame = nullptr;
+  return d.count;
+}
+
+/////////////////////////////////////////////////
+std::size_t PoseStreamEncoder::Encode(const std::vector<WorldPose> &_poses,
+                                      std::vector<uint8_t> &_frame)
+{
+  this->BeginFrame(_frame);
+  _frame.reserve(
+      kHeaderSize + _poses.size() * (4 + this->dataPtr->rotationBytes));
+  for (const auto &wp : _poses)
+    this->Add(wp.body, wp.pose);
+  return this->EndFrame();
+}
+
+/////////////////////////////////////////////////
+class PoseStreamDecoderPrivate
+{
+  /// \brief Reset the decoder so that it waits for the next key frame
+  public: void Reset()
+  {
+    this->received.clear();
+    this->hasKeyFrame = false;
+  }
+
+  /// \brief Last quantized position received for each entity since the last
+  /// key frame
+  public: std::unordered_map<std::size_t, std::array<int64_t, 3>> received;
+
+  public: bool hasKeyFrame = false;
+};
+
+/////////////////////////////////////////////////
+PoseStreamDecoder::PoseStreamDecoder()
+  : dataPtr(std::make_unique<PoseStreamDecoderPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+PoseStreamDecoder::PoseStreamDecoder(PoseStreamDecoder &&) noexcept = default;
+
+/////////////////////////////////////////////////
+PoseStreamDecoder &PoseStreamDecoder::operator=(
+    PoseStreamDecoder &&) noexcept = default;
+
+/////////////////////////////////////////////////
+PoseStreamDecoder::~PoseStreamDecoder() = default;
+
+/////////////////////////////////////////////////
+bool PoseStreamDecoder::Decode(const uint8_t *_data, const std::size_t _size,
+                               std::vector<WorldPose> &_poses)
+{
+  auto &d = *this->dataPtr;
+  _poses.clear();
+
+  if (!_data || _size < kHeaderSize || _data[0] != kVersion)
+  {
+    d.Reset();
+    return false;
+  }
+
+  const bool keyFrame = (_data[1] & kKeyFrameFlag) != 0;
+  const unsigned int bits = _data[2];
+
+  double resolution;
+  const uint64_t resolutionBits =
+      ReadLittleEndian(_data + kResolutionOffset, 8);
+  std::memcpy(&resolution, &resolutionBits, sizeof(resolution));
+
+  if (bits < kMinRotationBits || bits > kMaxRotationBits ||
+      !std::isfinite(resolution) || resolution <= 0.0)
+  {
+    d.Reset();
+    return false;
+  }
+
+  if (keyFrame)
+  {
+    d.received.clear();
+    d.hasKeyFrame = true;
+  }
+  else if (!d.hasKeyFrame)
+  {
+    return false;
+  }
+
+  const std::size_t rotationBytes = RotationBytes(bits);
+  const std::size_t count =
+      static_cast<std::size_t>(ReadLittleEndian(_data + kCountOffset, 4));
+
+  // Every entry takes at least one byte for each varint plus the rotation,
+  // which bounds how many entries a frame of this size can hold.
+  if (count > (_size - kHeaderSize) / (4 + rotationBytes))
+  {
+    d.Reset();
+    return false;
+  }
+  _poses.reserve(count);
+
+  std::size_t pos = kHeaderSize;
+  std::size_t entity = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    uint64_t value;
+    if (!ReadVarint(_data, _size, pos, value))
+      break;
+    entity += static_cast<std::size_t>(UnZigZag(value));
+
+    auto &position = d.received.try_emplace(
+        entity, std::array<int64_t, 3>{0, 0, 0}).first->second;
+
+    // A hostile frame can hold any delta, so positions wrap around instead
+    // of overflowing
+    bool ok = true;
+    for (std::size_t k = 0; k < 3 && ok; ++k)
+    {
+      ok = ReadVarint(_data, _size, pos, value);
+      position[k] = static_cast<int64_t>(
+          static_cast<uint64_t>(position[k]) +
+          static_cast<uint64_t>(UnZigZag(value)));
+    }
+
+    if (!ok || pos + rotationBytes > _size)
+      break;
+
+    WorldPose wp;
+    wp.body = entity;
+    wp.pose.Pos().Set(
+        static_cast<double>(position[0]) * resolution,
+        static_cast<double>(position[1]) * resolution,
+        static_cast<double>(position[2]) * resolution);
+    wp.pose.Rot() = UnpackRotation(
+        ReadLittleEndian(_data + pos, rotationBytes), bits);
+    pos += rotationBytes;
+
+    _poses.push_back(wp);
+  }
+
+  if (_poses.size() != count || pos != _size)
+  {
+    _poses.clear();
+    d.Reset();
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool PoseStreamDecoder::Decode(const std::vector<uint8_t> &_frame,
+                               std::vector<WorldPose> &_poses)
+{
+  return this->Decode(_frame.data(), _frame.size(), _poses);
+}
+}  // namespace physics
+}  // namespace gz
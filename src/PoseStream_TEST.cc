@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "gz/physics/PoseStream.hh"
+
+using namespace gz;
+
+using physics::PoseStreamDecoder;
+using physics::PoseStreamEncoder;
+using physics::PoseStreamOptions;
+using physics::WorldPose;
+
+/////////////////////////////////////////////////
+std::vector<WorldPose> MakePoses(const std::size_t _count)
+{
+  std::vector<WorldPose> poses;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double t = static_cast<double>(i);
+    WorldPose wp;
+    wp.body = 100 + 7 * i;
+    wp.pose = math::Pose3d(
+        0.37 * t - 20.0, std::sin(t) * 5.0, 0.01 * t,
+        0.3 * t, std::cos(t), -0.7 * t);
+    poses.push_back(wp);
+  }
+  return poses;
+}
+
+/////////////////////////////////////////////////
+void ExpectPosesNear(const std::vector<WorldPose> &_expected,
+                     const std::vector<WorldPose> &_actual,
+                     const double _positionTol)
+{
+  ASSERT_EQ(_expected.size(), _actual.size());
+  for (std::size_t i = 0; i < _expected.size(); ++i)
+  {
+    EXPECT_EQ(_expected[i].body, _actual[i].body);
+    EXPECT_NEAR(0.0,
+        _expected[i].pose.Pos().Distance(_actual[i].pose.Pos()), _positionTol);
+
+    // q and -q are the same rotation
+    const auto &q1 = _expected[i].pose.Rot();
+    const auto &q2 = _actual[i].pose.Rot();
+    const double dot = q1.W() * q2.W() + q1.X() * q2.X() +
+                       q1.Y() * q2.Y() + q1.Z() * q2.Z();
+    EXPECT_NEAR(1.0, std::abs(dot), 1e-6);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PoseStream_TEST, RoundTrip)
+{
+  PoseStreamEncoder encoder;
+  PoseStreamDecoder decoder;
+
+  auto poses = MakePoses(500);
+  std::vector<uint8_t> frame;
+  std::vector<WorldPose> decoded;
+
+  EXPECT_EQ(poses.size(), encoder.Encode(poses, frame));
+  EXPECT_TRUE(decoder.Decode(frame, decoded));
+  ExpectPosesNear(poses, decoded, 1e-5);
+
+  // The stream is much smaller than the poses themselves
+  EXPECT_LT(frame.size(), poses.size() * sizeof(WorldPose) / 2);
+
+  // Move the poses a little, which only sends small deltas
+  for (auto &wp : poses)
+    wp.pose.Pos() += math::Vector3d(0.001, -0.002, 0.0005);
+
+  const std::size_t keyFrameSize = frame.size();
+  EXPECT_EQ(poses.size(), encoder.Encode(poses, frame));
+  EXPECT_LT(frame.size(), keyFrameSize);
+  EXPECT_TRUE(decoder.Decode(frame, decoded));
+  ExpectPosesNear(poses, decoded, 1e-5);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseStream_TEST, SkipUnchanged)
+{
+  PoseStreamEncoder encoder;
+  PoseStreamDecoder decoder;
+
+  auto poses = MakePoses(20);
+  std::vector<uint8_t> frame;
+  std::vector<WorldPose> decoded;
+
+  EXPECT_EQ(poses.size(), encoder.Encode(poses, frame));
+  EXPECT_TRUE(decoder.Decode(frame, decoded));
+
+  // Nothing moved
+  EXPECT_EQ(0u, encoder.Encode(poses, frame));
+  EXPECT_TRUE(decoder.Decode(frame, decoded));
+  EXPECT_TRUE(decoded.empty());
+
+  // Only one pose moved
+  poses[3].pose.Pos().Z(poses[3].pose.Pos().Z() + 1.0);
+  EXPECT_EQ(1u, encoder.Encode(poses, frame));
+  EXPECT_TRUE(decoder.Decode(frame, decoded));
+  ExpectPosesNear({poses[3]}, decoded, 1e-5);
+
+  // A key frame sends everything again
+  encoder.RequestKeyFrame();
+  EXPECT_EQ(poses.size(), encoder.Encode(poses, frame));
+  EXPECT_TRUE(decoder.Decode(frame, decoded));
+  ExpectPosesNear(poses, decoded, 1e-5);
+
+  // Unchanged poses are kept when asked to
+  PoseStreamOptions options;
+  options.skipUnchanged = false;
+  PoseStreamEncoder everyPoseEncoder(options);
+  EXPECT_EQ(poses.size(), everyPoseEncoder.Encode(poses, frame));
+  EXPECT_EQ(poses.size(), everyPoseEncoder.Encode(poses, frame));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseStream_TEST, Options)
+{
+  PoseStreamOptions options;
+  options.positionResolution = 1e-3;
+  options.rotationBits = 10;
+  PoseStreamEncoder encoder(options);
+  PoseStreamDecoder decoder;
+
+  EXPECT_DOUBLE_EQ(1e-3, encoder.Options().positionResolution);
+  EXPECT_EQ(10u, encoder.Options().rotationBits);
+
+  // The decoder reads the options from the frame
+  const auto poses = MakePoses(50);
+  std::vector<uint8_t> frame;
+  std::vector<WorldPose> decoded;
+  encoder.Encode(poses, frame);
+  EXPECT_TRUE(decoder.Decode(frame, decoded));
+  ASSERT_EQ(poses.size(), decoded.size());
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    EXPECT_NEAR(0.0,
+        poses[i].pose.Pos().Distance(decoded[i].pose.Pos()), 1e-3);
+    EXPECT_TRUE(poses[i].pose.Rot().Equal(decoded[i].pose.Rot(), 5e-3) ||
+        poses[i].pose.Rot().Equal(-decoded[i].pose.Rot(), 5e-3));
+  }
+
+  // Invalid options fall back to valid values
+  options.positionResolution = -1.0;
+  options.rotationBits = 64;
+  PoseStreamEncoder clampedEncoder(options);
+  EXPECT_DOUBLE_EQ(PoseStreamOptions().positionResolution,
+                   clampedEncoder.Options().positionResolution);
+  EXPECT_EQ(20u, clampedEncoder.Options().rotationBits);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseStream_TEST, IncrementalFrame)
+{
+  PoseStreamEncoder encoder;
+  PoseStreamDecoder decoder;
+  std::vector<uint8_t> frame;
+  std::vector<WorldPose> decoded;
+
+  // Poses cannot be added before a frame is begun
+  EXPECT_FALSE(encoder.Add(1, 0, 0, 0, 1, 0, 0, 0));
+
+  encoder.BeginFrame(frame);
+  EXPECT_TRUE(encoder.Add(5, 1.0, 2.0, 3.0, 1.0, 0.0, 0.0, 0.0));
+  EXPECT_TRUE(encoder.Add(2, math::Pose3d(-1, -2, -3, 0, 0, GZ_PI)));
+
+  // Non-finite poses are rejected
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(encoder.Add(3, nan, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0));
+  EXPECT_FALSE(encoder.Add(3, 0.0, 0.0, 0.0, nan, 0.0, 0.0, 0.0));
+  EXPECT_EQ(2u, encoder.EndFrame());
+
+  EXPECT_TRUE(decoder.Decode(frame, decoded));
+  ASSERT_EQ(2u, decoded.size());
+  EXPECT_EQ(5u, decoded[0].body);
+  EXPECT_EQ(2u, decoded[1].body);
+  EXPECT_TRUE(decoded[0].pose.Pos().Equal(math::Vector3d(1, 2, 3), 1e-5));
+  EXPECT_TRUE(decoded[1].pose.Pos().Equal(math::Vector3d(-1, -2, -3), 1e-5));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseStream_TEST, MalformedFrames)
+{
+  PoseStreamEncoder encoder;
+  PoseStreamDecoder decoder;
+
+  const auto poses = MakePoses(10);
+  std::vector<uint8_t> keyFrame;
+  std::vector<WorldPose> decoded;
+  encoder.Encode(poses, keyFrame);
+
+  // Truncated frames are rejected
+  std::vector<uint8_t> truncated(keyFrame.begin(), keyFrame.end() - 1);
+  EXPECT_FALSE(decoder.Decode(truncated, decoded));
+  EXPECT_TRUE(decoded.empty());
+  EXPECT_FALSE(decoder.Decode(nullptr, 0, decoded));
+
+  // Unknown versions are rejected
+  std::vector<uint8_t> badVersion = keyFrame;
+  badVersion[0] = 0xFF;
+  EXPECT_FALSE(decoder.Decode(badVersion, decoded));
+
+  // A delta frame cannot be decoded without its key frame
+  auto moved = poses;
+  moved[0].pose.Pos().X(moved[0].pose.Pos().X() + 1.0);
+  std::vector<uint8_t> deltaFrame;
+  encoder.Encode(moved, deltaFrame);
+  EXPECT_FALSE(decoder.Decode(deltaFrame, decoded));
+
+  EXPECT_TRUE(decoder.Decode(keyFrame, decoded));
+  EXPECT_TRUE(decoder.Decode(deltaFrame, decoded));
+  ExpectPosesNear({moved[0]}, decoded, 1e-5);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseStream_TEST, OverflowingDeltas)
+{
+  // A key frame with two entries for the same entity, each of which moves it
+  // by the largest delta along x
+  std::vector<uint8_t> frame = {1, 0x01, 8};
+  const double resolution = 1.0;
+  uint64_t resolutionBits;
+  std::memcpy(&resolutionBits, &resolution, sizeof(resolution));
+  for (std::size_t i = 0; i < 8; ++i)
+    frame.push_back(static_cast<uint8_t>(resolutionBits >> (8 * i)));
+  for (const uint8_t byte : {2, 0, 0, 0})
+    frame.push_back(byte);
+
+  for (std::size_t entry = 0; entry < 2; ++entry)
+  {
+    frame.push_back(entry == 0 ? 2 : 0);
+
+    // Zigzag encoding of the largest int64_t, as a varint
+    for (std::size_t i = 0; i < 9; ++i)
+      frame.push_back(i == 0 ? 0xFE : 0xFF);
+    frame.push_back(0x01);
+    frame.push_back(0);
+    frame.push_back(0);
+
+    for (std::size_t i = 0; i < 4; ++i)
+      frame.push_back(0);
+  }
+
+  PoseStreamDecoder decoder;
+  std::vector<WorldPose> decoded;
+  ASSERT_TRUE(decoder.Decode(frame, decoded));
+  ASSERT_EQ(2u, decoded.size());
+  EXPECT_EQ(1u, decoded[1].body);
+  EXPECT_DOUBLE_EQ(-2.0, decoded[1].pose.Pos().X());
+}
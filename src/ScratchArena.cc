@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+
+#include "gz/physics/ScratchArena.hh"
+
+namespace gz
+{
+namespace physics
+{
+/////////////////////////////////////////////////
+struct ScratchArena::Overflow
+{
+  /// \brief Previous overflow block
+  Overflow *previous;
+
+  /// \brief Size of the allocation, including this header
+  std::size_t size;
+
+  /// \brief Alignment of the allocation
+  std::size_t alignment;
+};
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Alignment of the block of memory of an arena
+constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+/////////////////////////////////////////////////
+std::size_t RoundUp(const std::size_t _value, const std::size_t _alignment)
+{
+  return (_value + _alignment - 1) / _alignment * _alignment;
+}
+}
+
+/////////////////////////////////////////////////
+ScratchArena::ScratchArena(
+    std::pmr::memory_resource *_upstream,
+    const std::size_t _initialCapacity)
+  : upstream(_upstream)
+{
+  if (_initialCapacity > 0)
+  {
+    this->capacity = RoundUp(_initialCapacity, kBlockAlignment);
+    this->block = static_cast<std::byte *>(
+        this->upstream->allocate(this->capacity, kBlockAlignment));
+  }
+}
+
+/////////////////////////////////////////////////
+ScratchArena::~ScratchArena()
+{
+  this->ReleaseOverflow();
+  if (this->block)
+    this->upstream->deallocate(this->block, this->capacity, kBlockAlignment);
+}
+
+/////////////////////////////////////////////////
+void ScratchArena::Reset()
+{
+  this->ReleaseOverflow();
+
+  // Grow the block so that the next cycle fits in it if it needs as much
+  // memory as this one did
+  if (this->used > this->capacity)
+  {
+    const std::size_t newCapacity = RoundUp(
+        std::max(this->used, 2 * this->capacity), kBlockAlignment);
+    if (this->block)
+      this->upstream->deallocate(this->block, this->capacity, kBlockAlignment);
+    this->block = nullptr;
+    this->capacity = 0;
+
+    this->block = static_cast<std::byte *>(
+        this->upstream->allocate(newCapacity, kBlockAlignment));
+    this->capacity = newCapacity;
+  }
+
+  this->offset = 0;
+  this->used = 0;
+}
+
+/////////////////////////////////////////////////
+std::size_t ScratchArena::Capacity() const
+{
+  return this->capacity;
+}
+
+/////////////////////////////////////////////////
+std::size_t ScratchArena::BytesUsed() const
+{
+  return this->used;
+}
+
+/////////////////////////////////////////////////
+void *ScratchArena::do_allocate(
+    const std::size_t _bytes, const std::size_t _alignment)
+{
+  if (this->block)
+  {
+    const auto address =
+        reinterpret_cast<std::uintptr_t>(this->block + this->offset);
+    const std::size_t padding =
+        RoundUp(address, _alignment) - address;
+    if (this->offset + padding + _bytes <= this->capacity)
+    {
+      void *p = this->block + this->offset + padding;
+      this->offset += padding + _bytes;
+      this->used += padding + _bytes;
+      return p;
+    }
+  }
+
+  // The block is full, so this allocation comes from the upstream resource
+  // until the next Reset() makes the block larger
+  const std::size_t alignment = std::max(_alignment, alignof(Overflow));
+  const std::size_t headerSize = RoundUp(sizeof(Overflow), alignment);
+  const std::size_t size = headerSize + _bytes;
+
+  auto *header = static_cast<Overflow *>(
+      this->upstream->allocate(size, alignment));
+  header->previous = this->overflow;
+  header->size = size;
+  header->alignment = alignment;
+  this->overflow = header;
+
+  this->used += RoundUp(_bytes, _alignment) + _alignment;
+  return reinterpret_cast<std::byte *>(header) + headerSize;
+}
+
+/////////////////////////////////////////////////
+void ScratchArena::do_deallocate(
+    void * /*_p*/, const std::size_t /*_bytes*/,
+    const std::size_t /*_alignment*/)
+{
+  // Memory is only given back by Reset()
+}
+
+/////////////////////////////////////////////////
+bool ScratchArena::do_is_equal(
+    const std::pmr::memory_resource &_other) const noexcept
+{
+  return this == &_other;
+}
+
+/////////////////////////////////////////////////
+void ScratchArena::ReleaseOverflow()
+{
+  while (this->overflow)
+  {
+    Overflow *previous = this->overflow->previous;
+    this->upstream->deallocate(
+        this->overflow, this->overflow->size, this->overflow->alignment);
+    this->overflow = previous;
+  }
+}
+}
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+#include "gz/physics/ScratchArena.hh"
+
+using gz::physics::ScratchArena;
+
+/////////////////////////////////////////////////
+/// Memory resource that counts the allocations it receives
+class CountingResource : public std::pmr::memory_resource
+{
+  public: std::size_t allocations = 0;
+  public: std::size_t deallocations = 0;
+
+  private: void *do_allocate(
+      std::size_t _bytes, std::size_t _alignment) override
+  {
+    ++this->allocations;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+  }
+
+  private: void do_deallocate(
+      void *_p, std::size_t _bytes, std::size_t _alignment) override
+  {
+    ++this->deallocations;
+    std::pmr::new_delete_resource()->deallocate(_p, _bytes, _alignment);
+  }
+
+  private: bool do_is_equal(
+      const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+};
+
+/////////////////////////////////////////////////
+/// Build the kind of containers that a step creates
+void FakeStep(ScratchArena &_arena, const std::size_t _contacts)
+{
+  std::pmr::vector<double> points(&_arena);
+  std::pmr::unordered_map<std::size_t, std::size_t> pairs(&_arena);
+  for (std::size_t i = 0; i < _contacts; ++i)
+  {
+    points.push_back(static_cast<double>(i));
+    ++pairs[i % 7];
+  }
+  EXPECT_EQ(_contacts, points.size());
+}
+
+/////////////////////////////////////////////////
+TEST(ScratchArena_TEST, SteadyState)
+{
+  CountingResource counting;
+  ScratchArena arena(&counting);
+  EXPECT_EQ(0u, arena.Capacity());
+  EXPECT_EQ(0u, counting.allocations);
+
+  // The first step does not fit, so its memory comes from upstream
+  arena.Reset();
+  FakeStep(arena, 100);
+  EXPECT_LT(0u, counting.allocations);
+  EXPECT_LT(0u, arena.BytesUsed());
+
+  // Reset gives the overflow back and grows the block once
+  const std::size_t warmUpAllocations = counting.allocations;
+  arena.Reset();
+  EXPECT_EQ(warmUpAllocations + 1, counting.allocations);
+  EXPECT_EQ(warmUpAllocations, counting.deallocations);
+  EXPECT_EQ(0u, arena.BytesUsed());
+  EXPECT_LT(0u, arena.Capacity());
+
+  // Steps that need the same amount of memory do not allocate from
+  // upstream anymore
+  const std::size_t settledAllocations = counting.allocations;
+  for (int i = 0; i < 10; ++i)
+  {
+    arena.Reset();
+    FakeStep(arena, 100);
+  }
+  EXPECT_EQ(settledAllocations, counting.allocations);
+
+  // A larger step overflows, and the arena grows to fit it
+  arena.Reset();
+  FakeStep(arena, 1000);
+  EXPECT_LT(settledAllocations, counting.allocations);
+  arena.Reset();
+  const std::size_t grownAllocations = counting.allocations;
+  FakeStep(arena, 1000);
+  EXPECT_EQ(grownAllocations, counting.allocations);
+}
+
+/////////////////////////////////////////////////
+TEST(ScratchArena_TEST, Alignment)
+{
+  ScratchArena arena(std::pmr::new_delete_resource(), 256);
+  EXPECT_LE(256u, arena.Capacity());
+
+  void *p1 = arena.allocate(1, 1);
+  void *p2 = arena.allocate(8, 8);
+  void *p3 = arena.allocate(16, 64);
+  EXPECT_NE(p1, p2);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(p2) % 8);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(p3) % 64);
+
+  // Overflow allocations are aligned too
+  void *p4 = arena.allocate(1024, 32);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(p4) % 32);
+  arena.deallocate(p4, 1024, 32);
+
+  EXPECT_TRUE(arena.is_equal(arena));
+  ScratchArena other;
+  EXPECT_FALSE(arena.is_equal(other));
+}
@@ -0,0 +1,668 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "gz/physics/StateLog.hh"
+
+namespace gz
+{
+namespace physics
+{
+namespace
+{
+/////////////////////////////////////////////////
+// Layout of a state log file:
+//
+//   FileHeader
+//   Chunk 0: ChunkHeader, then for each step: StepHeader, StateLogLink[],
+//            StateLogJoint[], StateLogContact[]
+//   Chunk 1: ...
+//   IndexEntry[] (one per chunk, only if the log was closed)
+//   Footer       (only if the log was closed)
+//
+// Every record is a multiple of 8 bytes, so all of them are 8-byte aligned.
+constexpr char kFileMagic[8] = {'G', 'Z', 'S', 'T', 'A', 'T', 'E', 'L'};
+constexpr char kChunkMagic[4] = {'C', 'H', 'N', 'K'};
+constexpr char kIndexMagic[8] = {'G', 'Z', 'S', 'T', 'I', 'N', 'D', 'X'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint32_t kKeyFrameFlag = 0x1;
+
+struct FileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  uint64_t keyFrameInterval;
+  uint64_t reserved;
+};
+
+struct ChunkHeader
+{
+  char magic[4];
+  uint32_t stepCount;
+  /// \brief Size of the chunk, not counting this header
+  uint64_t size;
+  uint64_t firstStep;
+  double firstTime;
+};
+
+struct StepHeader
+{
+  uint64_t step;
+  double time;
+  uint32_t linkCount;
+  uint32_t jointCount;
+  uint32_t contactCount;
+  uint32_t flags;
+};
+
+struct IndexEntry
+{
+  uint64_t offset;
+  uint64_t stepCount;
+  uint64_t firstStep;
+  double firstTime;
+};
+
+struct Footer
+{
+  uint64_t indexOffset;
+  uint64_t chunkCount;
+  char magic[8];
+};
+
+template <typename T>
+constexpr bool IsLogRecord()
+{
+  return std::is_trivially_copyable_v<T> && sizeof(T) % 8 == 0;
+}
+
+static_assert(IsLogRecord<FileHeader>());
+static_assert(IsLogRecord<ChunkHeader>());
+static_assert(IsLogRecord<StepHeader>());
+static_assert(IsLogRecord<IndexEntry>());
+static_assert(IsLogRecord<Footer>());
+static_assert(IsLogRecord<StateLogLink>());
+static_assert(IsLogRecord<StateLogJoint>());
+static_assert(IsLogRecord<StateLogContact>());
+
+/////////////////////////////////////////////////
+template <typename T>
+void Append(const T *_records, const std::size_t _count,
+            std::vector<uint8_t> &_out)
+{
+  const auto *bytes = reinterpret_cast<const uint8_t*>(_records);
+  _out.insert(_out.end(), bytes, bytes + _count * sizeof(T));
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void Append(const T &_record, std::vector<uint8_t> &_out)
+{
+  Append(&_record, 1, _out);
+}
+
+/////////////////////////////////////////////////
+struct JointKeyHash
+{
+  std::size_t operator()(const std::pair<uint64_t, uint64_t> &_key) const
+  {
+    return std::hash<uint64_t>()(_key.first * 31 + _key.second);
+  }
+};
+}  // namespace
+
+/////////////////////////////////////////////////
+class StateLogWriterPrivate
+{
+  /// \brief Write the pending chunk to the file
+  public: void FlushChunk();
+
+  public: std::ofstream file;
+
+  public: StateLogOptions options;
+
+  /// \brief Whether every write succeeded since the log was opened
+  public: bool good = false;
+
+  /// \brief Offset in the file where the next chunk will be written
+  public: uint64_t offset = 0;
+
+  /// \brief Index of the chunks that were written
+  public: std::vector<IndexEntry> index;
+
+  /// \brief Steps of the chunk that is not written yet
+  public: std::vector<uint8_t> chunk;
+
+  public: uint32_t chunkStepCount = 0;
+
+  public: uint64_t chunkFirstStep = 0;
+
+  public: double chunkFirstTime = 0.0;
+
+  /// \brief Whether a step was begun and not ended yet
+  public: bool inStep = false;
+
+  public: bool keyFrame = false;
+
+  public: StepHeader step;
+
+  public: std::vector<StateLogLink> links;
+
+  public: std::vector<StateLogJoint> joints;
+
+  public: std::vector<StateLogContact> contacts;
+
+  /// \brief Last state written for each link since the last key frame
+  public: std::unordered_map<uint64_t, StateLogLink> lastLinks;
+
+  /// \brief Last state written for each joint degree of freedom since the
+  /// last key frame
+  public: std::unordered_map<std::pair<uint64_t, uint64_t>, StateLogJoint,
+                             JointKeyHash> lastJoints;
+};
+
+/////////////////////////////////////////////////
+void StateLogWriterPrivate::FlushChunk()
+{
+  if (this->chunkStepCount == 0)
+    return;
+
+  ChunkHeader header;
+  std::memcpy(header.magic, kChunkMagic, sizeof(header.magic));
+  header.stepCount = this->chunkStepCount;
+  header.size = this->chunk.size();
+  header.firstStep = this->chunkFirstStep;
+  header.firstTime = this->chunkFirstTime;
+
+  this->file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  this->file.write(reinterpret_cast<const char*>(this->chunk.data()),
+                   static_cast<std::streamsize>(this->chunk.size()));
+  this->file.flush();
+  this->good = this->good && this->file.good();
+
+  this->index.push_back(IndexEntry{
+      this->offset, this->chunkStepCount,
+      this->chunkFirstStep, this->chunkFirstTime});
+  this->offset += sizeof(header) + this->chunk.size();
+
+  this->chunk.clear();
+  this->chunkStepCount = 0;
+}
+
+/////////////////////////////////////////////////
+StateLogWriter::StateLogWriter()
+  : dataPtr(std::make_unique<StateLogWriterPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+StateLogWriter::~StateLogWriter()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool StateLogWriter::Open(const std::string &_path,
+                          const StateLogOptions &_options)
+{
+  this->Close();
+
+  auto &d = *this->dataPtr;
+  d.file.open(_path, std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!d.file.is_open())
+    return false;
+
+  d.options = _options;
+  if (d.options.keyFrameInterval == 0)
+    d.options.keyFrameInterval = 1;
+
+  FileHeader header;
+  std::memcpy(header.magic, kFileMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.byteOrder = kByteOrderMark;
+  header.keyFrameInterval = d.options.keyFrameInterval;
+  header.reserved = 0;
+  d.file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  d.good = d.file.good();
+  d.offset = sizeof(header);
+  d.index.clear();
+  d.chunk.clear();
+  d.chunkStepCount = 0;
+  d.inStep = false;
+  return d.good;
+}
+
+/////////////////////////////////////////////////
+bool StateLogWriter::IsOpen() const
+{
+  return this->dataPtr->file.is_open();
+}
+
+/////////////////////////////////////////////////
+void StateLogWriter::BeginStep(const uint64_t _step, const double _time)
+{
+  auto &d = *this->dataPtr;
+  d.inStep = d.file.is_open();
+  if (!d.inStep)
+    return;
+
+  d.keyFrame = d.chunkStepCount == 0 ||
+      d.chunkStepCount >= d.options.keyFrameInterval;
+  if (d.keyFrame)
+  {
+    d.FlushChunk();
+    d.lastLinks.clear();
+    d.lastJoints.clear();
+  }
+
+  d.step = StepHeader{_step, _time, 0, 0, 0, d.keyFrame ? kKeyFrameFlag : 0};
+  d.links.clear();
+  d.joints.clear();
+  d.contacts.clear();
+}
+
+/////////////////////////////////////////////////
+void StateLogWriter::AddLink(const StateLogLink &_link)
+{
+  auto &d = *this->dataPtr;
+  if (!d.inStep)
+    return;
+
+  auto [it, inserted] = d.lastLinks.try_emplace(_link.entity, _link);
+  if (!inserted)
+  {
+    if (std::memcmp(&it->second, &_link, sizeof(_link)) == 0)
+      return;
+    it->second = _link;
+  }
+  d.links.push_back(_link);
+}
+
+/////////////////////////////////////////////////
+void StateLogWriter::AddJoint(const StateLogJoint &_joint)
+{
+  auto &d = *this->dataPtr;
+  if (!d.inStep)
+    return;
+
+  auto [it, inserted] = d.lastJoints.try_emplace(
+      std::make_pair(_joint.entity, _joint.dof), _joint);
+  if (!inserted)
+  {
+    if (std::memcmp(&it->second, &_joint, sizeof(_joint)) == 0)
+      return;
+    it->second = _joint;
+  }
+  d.joints.push_back(_joint);
+}
+
+/////////////////////////////////////////////////
+void StateLogWriter::AddContact(const StateLogContact &_contact)
+{
+  auto &d = *this->dataPtr;
+  if (d.inStep)
+    d.contacts.push_back(_contact);
+}
+
+/////////////////////////////////////////////////
+bool StateLogWriter::EndStep()
+{
+  auto &d = *this->dataPtr;
+  if (!d.inStep)
+    return false;
+  d.inStep = false;
+
+  if (d.chunkStepCount == 0)
+  {
+    d.chunkFirstStep = d.step.step;
+    d.chunkFirstTime = d.step.time;
+  }
+
+  d.step.linkCount = static_cast<uint32_t>(d.links.size());
+  d.step.jointCount = static_cast<uint32_t>(d.joints.size());
+  d.step.contactCount = static_cast<uint32_t>(d.contacts.size());
+  Append(d.step, d.chunk);
+  Append(d.links.data(), d.links.size(), d.chunk);
+  Append(d.joints.data(), d.joints.size(), d.chunk);
+  Append(d.contacts.data(), d.contacts.size(), d.chunk);
+  ++d.chunkStepCount;
+
+  return d.good;
+}
+
+/////////////////////////////////////////////////
+bool StateLogWriter::Close()
+{
+  auto &d = *this->dataPtr;
+  if (!d.file.is_open())
+    return false;
+
+  d.inStep = false;
+  d.FlushChunk();
+
+  Footer footer;
+  footer.indexOffset = d.offset;
+  footer.chunkCount = d.index.size();
+  std::memcpy(footer.magic, kIndexMagic, sizeof(footer.magic));
+
+  d.file.write(reinterpret_cast<const char*>(d.index.data()),
+               static_cast<std::streamsize>(
+                   d.index.size() * sizeof(IndexEntry)));
+  d.file.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+  d.good = d.good && d.file.good();
+  d.file.close();
+
+  d.index.clear();
+  d.lastLinks.clear();
+  d.lastJoints.clear();
+  return d.good;
+}
+
+/////////////////////////////////////////////////
+class StateLogReaderPrivate
+{
+  /// \brief Read the chunk index from the footer of the log
+  /// \param[out] _chunks Offsets of the chunks
+  /// \return False if the log has no valid footer
+  public: bool ReadIndex(std::vector<uint64_t> &_chunks) const;
+
+  /// \brief Find the chunks by walking through the log
+  /// \param[out] _chunks Offsets of the complete chunks
+  public: void ScanChunks(std::vector<uint64_t> &_chunks) const;
+
+  /// \brief Add the steps of a chunk to the step table
+  /// \param[in] _offset Offset of the chunk
+  /// \return False if the chunk is malformed
+  public: bool AddChunk(uint64_t _offset);
+
+  /// \brief Start of the log contents
+  public: const uint8_t *data = nullptr;
+
+  /// \brief Size of the log contents
+  public: std::size_t size = 0;
+
+#ifndef _WIN32
+  /// \brief Memory mapping of the log file
+  public: void *mapping = nullptr;
+#endif
+
+  /// \brief Contents of the log file where it cannot be mapped
+  public: std::vector<uint8_t> buffer;
+
+  /// \brief Offset of each step in the log
+  public: std::vector<uint64_t> stepOffsets;
+
+  /// \brief Key frame of each step
+  public: std::vector<std::size_t> keyFrames;
+};
+
+/////////////////////////////////////////////////
+bool StateLogReaderPrivate::ReadIndex(std::vector<uint64_t> &_chunks) const
+{
+  if (this->size < sizeof(FileHeader) + sizeof(Footer))
+    return false;
+
+  Footer footer;
+  std::memcpy(&footer, this->data + this->size - sizeof(Footer),
+              sizeof(footer));
+  if (std::memcmp(footer.magic, kIndexMagic, sizeof(footer.magic)) != 0)
+    return false;
+
+  const uint64_t indexEnd = this->size - sizeof(Footer);
+  if (footer.indexOffset < sizeof(FileHeader) ||
+      footer.indexOffset > indexEnd ||
+      (indexEnd - footer.indexOffset) / sizeof(IndexEntry) !=
+          footer.chunkCount)
+  {
+    return false;
+  }
+
+  const auto *entries = reinterpret_cast<const IndexEntry*>(
+      this->data + footer.indexOffset);
+  _chunks.reserve(footer.chunkCount);
+  for (uint64_t i = 0; i < footer.chunkCount; ++i)
+    _chunks.push_back(entries[i].offset);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void StateLogReaderPrivate::ScanChunks(std::vector<uint64_t> &_chunks) const
+{
+  uint64_t offset = sizeof(FileHeader);
+  while (offset + sizeof(ChunkHeader) <= this->size)
+  {
+    const auto *header =
+        reinterpret_cast<const ChunkHeader*>(this->data + offset);
+    if (std::memcmp(header->magic, kChunkMagic, sizeof(header->magic)) != 0 ||
+        header->size > this->size - offset - sizeof(ChunkHeader))
+    {
+      break;
+    }
+
+    _chunks.push_back(offset);
+    offset += sizeof(ChunkHeader) + header->size;
+  }
+}
+
+/////////////////////////////////////////////////
+bool StateLogReaderPrivate::AddChunk(const uint64_t _offset)
+{
+  if (_offset < sizeof(FileHeader) || _offset % 8 != 0 ||
+      _offset + sizeof(ChunkHeader) > this->size)
+  {
+    return false;
+  }
+
+  const auto *header =
+      reinterpret_cast<const ChunkHeader*>(this->data + _offset);
+  if (std::memcmp(header->magic, kChunkMagic, sizeof(header->magic)) != 0 ||
+      header->size > this->size - _offset - sizeof(ChunkHeader))
+  {
+    return false;
+  }
+
+  const std::size_t keyFrame = this->stepOffsets.size();
+  const uint64_t end = _offset + sizeof(ChunkHeader) + header->size;
+  uint64_t offset = _offset + sizeof(ChunkHeader);
+  for (uint32_t i = 0; i < header->stepCount; ++i)
+  {
+    if (offset + sizeof(StepHeader) > end)
+      return false;
+
+    const auto *step = reinterpret_cast<const StepHeader*>(this->data + offset);
+    const uint64_t stepSize = sizeof(StepHeader) +
+        step->linkCount * sizeof(StateLogLink) +
+        step->jointCount * sizeof(StateLogJoint) +
+        step->contactCount * sizeof(StateLogContact);
+    if (stepSize > end - offset)
+      return false;
+
+    this->stepOffsets.push_back(offset);
+    this->keyFrames.push_back(keyFrame);
+    offset += stepSize;
+  }
+
+  return offset == end;
+}
+
+/////////////////////////////////////////////////
+StateLogReader::StateLogReader()
+  : dataPtr(std::make_unique<StateLogReaderPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+StateLogReader::~StateLogReader()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool StateLogReader::Open(const std::string &_path)
+{
+  this->Close();
+  auto &d = *this->dataPtr;
+
+#ifndef _WIN32
+  const int fd = ::open(_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  d.size = static_cast<std::size_t>(fileStat.st_size);
+  void *mapping = ::mmap(nullptr, d.size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    d.size = 0;
+    return false;
+  }
+  d.mapping = mapping;
+  d.data = static_cast<const uint8_t*>(mapping);
+#else
+  std::ifstream file(_path, std::ios::binary);
+  if (!file.is_open())
+    return false;
+
+  d.buffer.assign(std::istreambuf_iterator<char>(file),
+                  std::istreambuf_iterator<char>());
+  d.data = d.buffer.data();
+  d.size = d.buffer.size();
+#endif
+
+  FileHeader header;
+  if (d.size < sizeof(header))
+  {
+    this->Close();
+    return false;
+  }
+  std::memcpy(&header, d.data, sizeof(header));
+  if (std::memcmp(header.magic, kFileMagic, sizeof(header.magic)) != 0 ||
+      header.version != kVersion || header.byteOrder != kByteOrderMark)
+  {
+    this->Close();
+    return false;
+  }
+
+  std::vector<uint64_t> chunks;
+  if (!d.ReadIndex(chunks))
+  {
+    chunks.clear();
+    d.ScanChunks(chunks);
+  }
+
+  for (const uint64_t chunk : chunks)
+  {
+    if (!d.AddChunk(chunk))
+    {
+      this->Close();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool StateLogReader::IsOpen() const
+{
+  return this->dataPtr->data != nullptr;
+}
+
+/////////////////////////////////////////////////
+void StateLogReader::Close()
+{
+  auto &d = *this->dataPtr;
+#ifndef _WIN32
+  if (d.mapping)
+    ::munmap(d.mapping, d.size);
+  d.mapping = nullptr;
+#endif
+  d.buffer.clear();
+  d.buffer.shrink_to_fit();
+  d.data = nullptr;
+  d.size = 0;
+  d.stepOffsets.clear();
+  d.keyFrames.clear();
+}
+
+/////////////////////////////////////////////////
+std::size_t StateLogReader::StepCount() const
+{
+  return this->dataPtr->stepOffsets.size();
+}
+
+/////////////////////////////////////////////////
+bool StateLogReader::Step(const std::size_t _index, StateLogStep &_step) const
+{
+  const auto &d = *this->dataPtr;
+  if (_index >= d.stepOffsets.size())
+    return false;
+
+  const uint8_t *record = d.data + d.stepOffsets[_index];
+  const auto *header = reinterpret_cast<const StepHeader*>(record);
+  record += sizeof(StepHeader);
+
+  _step.step = header->step;
+  _step.time = header->time;
+  _step.keyFrame = (header->flags & kKeyFrameFlag) != 0;
+
+  _step.links = reinterpret_cast<const StateLogLink*>(record);
+  _step.linkCount = header->linkCount;
+  record += _step.linkCount * sizeof(StateLogLink);
+
+  _step.joints = reinterpret_cast<const StateLogJoint*>(record);
+  _step.jointCount = header->jointCount;
+  record += _step.jointCount * sizeof(StateLogJoint);
+
+  _step.contacts = reinterpret_cast<const StateLogContact*>(record);
+  _step.contactCount = header->contactCount;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t StateLogReader::KeyFrameOf(const std::size_t _index) const
+{
+  const auto &d = *this->dataPtr;
+  if (_index >= d.keyFrames.size())
+    return d.keyFrames.empty() ? 0 : d.keyFrames.back();
+  return d.keyFrames[_index];
+}
+}  // namespace physics
+}  // namespace gz
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "gz/physics/StateLog.hh"
+
+using namespace gz;
+
+using physics::StateLogContact;
+using physics::StateLogJoint;
+using physics::StateLogLink;
+using physics::StateLogOptions;
+using physics::StateLogReader;
+using physics::StateLogStep;
+using physics::StateLogWriter;
+
+/////////////////////////////////////////////////
+/// Write a log of _steps steps where link 1 falls, links 2 and 3 stay still,
+/// joint 5 turns, and there is a contact every other step.
+void WriteLog(const std::string &_path, const uint64_t _steps,
+              const std::size_t _keyFrameInterval, const bool _close)
+{
+  StateLogOptions options;
+  options.keyFrameInterval = _keyFrameInterval;
+
+  StateLogWriter writer;
+  ASSERT_TRUE(writer.Open(_path, options));
+  EXPECT_TRUE(writer.IsOpen());
+  for (uint64_t s = 0; s < _steps; ++s)
+  {
+    writer.BeginStep(s, 0.001 * static_cast<double>(s));
+    for (uint64_t l = 1; l <= 3; ++l)
+    {
+      StateLogLink link{};
+      link.entity = l;
+      link.pose[2] = (l == 1) ? -0.1 * static_cast<double>(s) : 1.0;
+      link.pose[3] = 1.0;
+      link.linearVelocity[2] = (l == 1) ? -1.0 : 0.0;
+      writer.AddLink(link);
+    }
+    writer.AddJoint(StateLogJoint{5, 0, 0.5 * static_cast<double>(s), 1.0});
+
+    if (s % 2 == 1)
+    {
+      StateLogContact contact{};
+      contact.collision1 = 10;
+      contact.collision2 = 11;
+      contact.depth = 0.01;
+      writer.AddContact(contact);
+    }
+    EXPECT_TRUE(writer.EndStep());
+  }
+
+  if (_close)
+  {
+    EXPECT_TRUE(writer.Close());
+    EXPECT_FALSE(writer.IsOpen());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(StateLog_TEST, RoundTrip)
+{
+  const std::string path = testing::TempDir() + "StateLog_TEST_RoundTrip.log";
+  WriteLog(path, 25, 10, true);
+
+  StateLogReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_TRUE(reader.IsOpen());
+  ASSERT_EQ(25u, reader.StepCount());
+
+  StateLogStep step;
+  for (std::size_t i = 0; i < reader.StepCount(); ++i)
+  {
+    ASSERT_TRUE(reader.Step(i, step));
+    EXPECT_EQ(i, step.step);
+    EXPECT_DOUBLE_EQ(0.001 * static_cast<double>(i), step.time);
+    EXPECT_EQ(i / 10 * 10, reader.KeyFrameOf(i));
+    EXPECT_EQ(i % 10 == 0, step.keyFrame);
+
+    // Key frames hold every link, other steps only the one that moved
+    if (step.keyFrame)
+    {
+      ASSERT_EQ(3u, step.linkCount);
+    }
+    else
+    {
+      ASSERT_EQ(1u, step.linkCount);
+      EXPECT_EQ(1u, step.links[0].entity);
+    }
+    EXPECT_DOUBLE_EQ(-0.1 * static_cast<double>(i), step.links[0].pose[2]);
+    EXPECT_DOUBLE_EQ(-1.0, step.links[0].linearVelocity[2]);
+
+    ASSERT_EQ(1u, step.jointCount);
+    EXPECT_EQ(5u, step.joints[0].entity);
+    EXPECT_DOUBLE_EQ(0.5 * static_cast<double>(i), step.joints[0].position);
+
+    ASSERT_EQ(i % 2, step.contactCount);
+    if (step.contactCount > 0)
+    {
+      EXPECT_EQ(10u, step.contacts[0].collision1);
+      EXPECT_EQ(11u, step.contacts[0].collision2);
+      EXPECT_DOUBLE_EQ(0.01, step.contacts[0].depth);
+    }
+  }
+
+  EXPECT_FALSE(reader.Step(25, step));
+
+  reader.Close();
+  EXPECT_FALSE(reader.IsOpen());
+  EXPECT_EQ(0u, reader.StepCount());
+}
+
+/////////////////////////////////////////////////
+TEST(StateLog_TEST, UnclosedLog)
+{
+  const std::string path = testing::TempDir() + "StateLog_TEST_Full.log";
+  WriteLog(path, 25, 10, true);
+
+  // Drop the index and part of the last chunk, as if the writer had crashed
+  std::ifstream in(path, std::ios::binary);
+  const std::vector<char> bytes(
+      (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  ASSERT_GT(bytes.size(), 200u);
+
+  const std::string truncatedPath =
+      testing::TempDir() + "StateLog_TEST_Truncated.log";
+  std::ofstream out(truncatedPath, std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 200));
+  out.close();
+
+  // Only the complete chunks are read
+  StateLogReader reader;
+  ASSERT_TRUE(reader.Open(truncatedPath));
+  EXPECT_EQ(20u, reader.StepCount());
+
+  StateLogStep step;
+  ASSERT_TRUE(reader.Step(19, step));
+  EXPECT_EQ(19u, step.step);
+  EXPECT_EQ(10u, reader.KeyFrameOf(19));
+}
+
+/////////////////////////////////////////////////
+TEST(StateLog_TEST, InvalidFiles)
+{
+  StateLogReader reader;
+  EXPECT_FALSE(reader.Open(testing::TempDir() + "StateLog_TEST_Missing.log"));
+  EXPECT_FALSE(reader.IsOpen());
+
+  const std::string path = testing::TempDir() + "StateLog_TEST_Invalid.log";
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << "this is not a state log";
+  out.close();
+  EXPECT_FALSE(reader.Open(path));
+
+  // Steps cannot be written to a log that is not open
+  StateLogWriter writer;
+  EXPECT_FALSE(writer.IsOpen());
+  writer.BeginStep(0, 0.0);
+  EXPECT_FALSE(writer.EndStep());
+}
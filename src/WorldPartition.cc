@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "gz/physics/WorldPartition.hh"
+
+namespace gz
+{
+namespace physics
+{
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Get the cell of a coordinate along one axis of the grid.
+std::size_t CellOf(const double _coordinate, const double _min,
+                   const double _width, const std::size_t _count)
+{
+  const double cell = std::floor((_coordinate - _min) / _width);
+  if (!(cell > 0.0))
+    return 0u;
+  return std::min(static_cast<std::size_t>(
+      std::min(cell, static_cast<double>(_count))), _count - 1);
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a coordinate is within a cell of one axis of the
+/// grid grown by a margin. The first and last cells extend to infinity.
+bool InCell(const double _coordinate, const std::size_t _cell,
+            const double _min, const double _width, const std::size_t _count,
+            const double _margin)
+{
+  const double infinity = std::numeric_limits<double>::infinity();
+  const double lower = _cell == 0 ?
+      -infinity : _min + _width * static_cast<double>(_cell);
+  const double upper = _cell + 1 == _count ?
+      infinity : _min + _width * static_cast<double>(_cell + 1);
+  return _coordinate >= lower - _margin && _coordinate < upper + _margin;
+}
+}
+
+/////////////////////////////////////////////////
+WorldPartition::WorldPartition(const Eigen::Vector3d &_min,
+                               const Eigen::Vector3d &_max,
+                               const std::size_t _columns,
+                               const std::size_t _rows,
+                               const double _overlap)
+  : minX(_min.x()),
+    minY(_min.y()),
+    columns(std::max<std::size_t>(_columns, 1u)),
+    rows(std::max<std::size_t>(_rows, 1u)),
+    overlap(_overlap > 0.0 ? _overlap : 0.0)
+{
+  // A grid without extent along an axis has a single region along it
+  if (!(_max.x() > _min.x()))
+    this->columns = 1;
+  if (!(_max.y() > _min.y()))
+    this->rows = 1;
+  this->width = this->columns > 1 ?
+      (_max.x() - _min.x()) / static_cast<double>(this->columns) : 1.0;
+  this->height = this->rows > 1 ?
+      (_max.y() - _min.y()) / static_cast<double>(this->rows) : 1.0;
+}
+
+/////////////////////////////////////////////////
+std::size_t WorldPartition::RegionCount() const
+{
+  return this->columns * this->rows;
+}
+
+/////////////////////////////////////////////////
+double WorldPartition::Overlap() const
+{
+  return this->overlap;
+}
+
+/////////////////////////////////////////////////
+std::size_t WorldPartition::RegionOf(const Eigen::Vector3d &_position) const
+{
+  const std::size_t column =
+      CellOf(_position.x(), this->minX, this->width, this->columns);
+  const std::size_t row =
+      CellOf(_position.y(), this->minY, this->height, this->rows);
+  return row * this->columns + column;
+}
+
+/////////////////////////////////////////////////
+bool WorldPartition::Contains(const std::size_t _region,
+                              const Eigen::Vector3d &_position,
+                              const double _margin) const
+{
+  if (_region >= this->RegionCount())
+    return false;
+
+  return InCell(_position.x(), _region % this->columns, this->minX,
+                this->width, this->columns, _margin) &&
+         InCell(_position.y(), _region / this->columns, this->minY,
+                this->height, this->rows, _margin);
+}
+
+/////////////////////////////////////////////////
+std::size_t WorldPartition::HandOff(const std::size_t _region,
+                                    const Eigen::Vector3d &_position) const
+{
+  if (this->Contains(_region, _position, 0.5 * this->overlap))
+    return _region;
+  return this->RegionOf(_position);
+}
+
+/////////////////////////////////////////////////
+bool WorldPartition::Mirrors(const std::size_t _region,
+                             const std::size_t _owner,
+                             const Eigen::Vector3d &_position) const
+{
+  return _region != _owner &&
+      this->Contains(_region, _position, this->overlap);
+}
+}
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gz/physics/WorldPartition.hh"
+
+using namespace gz;
+using physics::WorldPartition;
+
+/////////////////////////////////////////////////
+TEST(WorldPartition, RegionOf)
+{
+  // Two columns and three rows of 10 m x 10 m regions
+  const WorldPartition partition(
+      Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(20, 30, 0), 2, 3, 2.0);
+  EXPECT_EQ(6u, partition.RegionCount());
+  EXPECT_DOUBLE_EQ(2.0, partition.Overlap());
+
+  EXPECT_EQ(0u, partition.RegionOf(Eigen::Vector3d(5, 5, 0)));
+  EXPECT_EQ(1u, partition.RegionOf(Eigen::Vector3d(15, 5, 0)));
+  EXPECT_EQ(2u, partition.RegionOf(Eigen::Vector3d(5, 15, 0)));
+  EXPECT_EQ(5u, partition.RegionOf(Eigen::Vector3d(15, 25, 100)));
+
+  // Boundaries belong to the upper region
+  EXPECT_EQ(1u, partition.RegionOf(Eigen::Vector3d(10, 5, 0)));
+
+  // The border regions extend to infinity
+  EXPECT_EQ(0u, partition.RegionOf(Eigen::Vector3d(-1e9, -1e9, 0)));
+  EXPECT_EQ(5u, partition.RegionOf(Eigen::Vector3d(1e9, 1e9, 0)));
+  EXPECT_TRUE(partition.Contains(5, Eigen::Vector3d(1e9, 1e9, 0)));
+  EXPECT_FALSE(partition.Contains(6, Eigen::Vector3d(1e9, 1e9, 0)));
+}
+
+/////////////////////////////////////////////////
+TEST(WorldPartition, Overlap)
+{
+  const WorldPartition partition(
+      Eigen::Vector3d(-10, 0, 0), Eigen::Vector3d(10, 0, 0), 2, 1, 2.0);
+  EXPECT_EQ(2u, partition.RegionCount());
+
+  // Region 1 mirrors the bodies of region 0 that are within 2 m of it
+  EXPECT_FALSE(partition.Mirrors(1, 0, Eigen::Vector3d(-2.5, 0, 0)));
+  EXPECT_TRUE(partition.Mirrors(1, 0, Eigen::Vector3d(-1.5, 0, 0)));
+  EXPECT_FALSE(partition.Mirrors(0, 0, Eigen::Vector3d(-1.5, 0, 0)));
+  EXPECT_TRUE(partition.Mirrors(0, 1, Eigen::Vector3d(1.5, 0, 0)));
+
+  // Bodies are handed off once they are 1 m past the boundary
+  EXPECT_EQ(0u, partition.HandOff(0, Eigen::Vector3d(0.5, 0, 0)));
+  EXPECT_EQ(1u, partition.HandOff(0, Eigen::Vector3d(1.5, 0, 0)));
+  EXPECT_EQ(1u, partition.HandOff(1, Eigen::Vector3d(-0.5, 0, 0)));
+  EXPECT_EQ(0u, partition.HandOff(1, Eigen::Vector3d(-1.5, 0, 0)));
+
+  // The region that a body is handed off to mirrored it already
+  EXPECT_TRUE(partition.Mirrors(0, 1, Eigen::Vector3d(1.5, 0, 0)));
+}
+
+/////////////////////////////////////////////////
+TEST(WorldPartition, Degenerate)
+{
+  // A grid without extent has a single region
+  const WorldPartition partition(
+      Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(0, 0, 0), 4, 4, -1.0);
+  EXPECT_EQ(1u, partition.RegionCount());
+  EXPECT_DOUBLE_EQ(0.0, partition.Overlap());
+  EXPECT_EQ(0u, partition.RegionOf(Eigen::Vector3d(3, -7, 0)));
+  EXPECT_EQ(0u, partition.HandOff(0, Eigen::Vector3d(3, -7, 0)));
+  EXPECT_FALSE(partition.Mirrors(0, 0, Eigen::Vector3d(3, -7, 0)));
+
+  const WorldPartition empty(
+      Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(1, 1, 0), 0, 0, 1.0);
+  EXPECT_EQ(1u, empty.RegionCount());
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "gz/physics/CanWriteData.hh"
+#include "test/TestDataTypes.hh"
+
+std::size_t gNumTests = 10000;
+
+// A specification shaped like the output of a physics step: a few required
+// types, plus expected types that overlap with the required ones.
+using StepOutputSpec = gz::physics::SpecifyData<
+    gz::physics::RequireData<StringData, DoubleData, IntData>,
+    gz::physics::SpecifyData<
+        gz::physics::ExpectData<IntData, FloatData, BoolData>,
+        gz::physics::ExpectData<DoubleData, CharData>>>;
+
+class StepOutputWriter
+    : public gz::physics::CanWriteRequiredData<
+          StepOutputWriter, StepOutputSpec>,
+      public gz::physics::CanWriteExpectedData<
+          StepOutputWriter, StepOutputSpec>
+{
+  public: void Write(StringData &_data) const { _data.myString = "written"; }
+  public: void Write(DoubleData &_data) const { _data.myDouble = 1.0; }
+  public: void Write(IntData &_data) const { _data.myInt = 1; }
+  public: void Write(FloatData &_data) const { _data.myFloat = 1.0f; }
+  public: void Write(BoolData &_data) const { _data.myBool = true; }
+  public: void Write(CharData &_data) const { _data.myChar = 'x'; }
+};
+
+using StepOutputExpect = gz::physics::ExpectData<
+    StringData, DoubleData, IntData, FloatData, BoolData, CharData>;
+
+/// \brief Write the expected data by traversing the specification at runtime,
+/// which is how CanWriteExpectedData used to operate. This is the reference
+/// for the precomputed write plan.
+template <class Q>
+// NOLINTNEXTLINE
+void BM_WriteTraversal(benchmark::State &_st)
+{
+  const std::size_t numTests = _st.range(0);
+  const StepOutputWriter writer;
+  const gz::physics::DataStatusMask mask;
+  Q data;
+
+  for (auto _ : _st)
+  {
+    for (std::size_t i = 0; i < numTests; ++i)
+    {
+      gz::physics::OperateOnSpecifiedData<
+          StepOutputSpec, gz::physics::FindExpected,
+          gz::physics::detail::WriteDataOperation,
+          const StepOutputWriter>::Operate(&writer, data, mask);
+    }
+  }
+
+  benchmark::DoNotOptimize(data);
+}
+
+/// \brief Write the expected data through the precomputed write plan.
+template <class Q>
+// NOLINTNEXTLINE
+void BM_WritePlan(benchmark::State &_st)
+{
+  const std::size_t numTests = _st.range(0);
+  const StepOutputWriter writer;
+  const gz::physics::WriteOptions options(false, false);
+  Q data;
+
+  for (auto _ : _st)
+  {
+    for (std::size_t i = 0; i < numTests; ++i)
+      writer.WriteExpectedData(data, options);
+  }
+
+  benchmark::DoNotOptimize(data);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_WriteTraversal, StepOutputExpect)->Arg(gNumTests);
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_WritePlan, StepOutputExpect)->Arg(gNumTests);
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_WriteTraversal, gz::physics::CompositeData)
+    ->Arg(gNumTests);
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_WritePlan, gz::physics::CompositeData)->Arg(gNumTests);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include <gz/plugin/Loader.hh>
+
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/GetEntities.hh>
+#include <gz/physics/LevelOfDetail.hh>
+#include <gz/physics/RequestEngine.hh>
+#include <gz/physics/sdf/ConstructWorld.hh>
+
+#include <sdf/Root.hh>
+
+using namespace gz;
+
+struct LevelOfDetailFeatureList : physics::FeatureList<
+    physics::ForwardStep,
+    physics::sdf::ConstructSdfWorld,
+    physics::GetEntities,
+    physics::LevelOfDetailFeature
+> { };
+
+using LevelOfDetailWorldPtr = physics::World3dPtr<LevelOfDetailFeatureList>;
+
+/////////////////////////////////////////////////
+/// \brief A world with boxes that rest on a ground plane, 4 m apart on a
+/// grid that starts at the origin.
+std::string LevelOfDetailWorld(const std::size_t _count)
+{
+  std::stringstream sdf;
+  sdf << R"(
+  <sdf version="1.9">
+    <world name="default">
+      <model name="ground">
+        <static>true</static>
+        <link name="link">
+          <collision name="collision">
+            <geometry><plane><normal>0 0 1</normal></plane></geometry>
+          </collision>
+        </link>
+      </model>)";
+
+  const std::size_t side = static_cast<std::size_t>(
+      std::ceil(std::sqrt(static_cast<double>(_count))));
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    sdf << R"(
+    <model name="box)" << i << R"(">
+      <pose>)" << 4.0 * static_cast<double>(i % side) << " "
+             << 4.0 * static_cast<double>(i / side) << R"( 0.5 0 0 0</pose>
+      <link name="link">
+        <inertial><mass>1</mass></inertial>
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>)";
+  }
+
+  sdf << R"(
+    </world>
+  </sdf>)";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Step a world with many boxes, the first of which is the focus.
+/// With level of detail, the cost of a step follows the number of boxes
+/// within the demotion distance of the focus only.
+template <bool LevelOfDetail>
+// NOLINTNEXTLINE
+void BM_DartsimLevelOfDetail(benchmark::State &_st)
+{
+  const std::size_t numBoxes = _st.range(0);
+
+  plugin::Loader loader;
+  loader.LoadLib(dartsim_plugin_LIB);
+  auto engine = physics::RequestEngine3d<LevelOfDetailFeatureList>::From(
+      loader.Instantiate("gz::physics::dartsim::Plugin"));
+
+  sdf::Root root;
+  root.LoadSdfString(LevelOfDetailWorld(numBoxes));
+  LevelOfDetailWorldPtr world = engine->ConstructWorld(*root.WorldByIndex(0));
+  world->GetModel("box0")->SetLevelOfDetailFocus(true);
+
+  physics::LevelOfDetailParameters parameters;
+  parameters.enabled = LevelOfDetail;
+  parameters.promotionDistance = 10.0;
+  parameters.demotionDistance = 15.0;
+  world->SetLevelOfDetailParameters(parameters);
+
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+  for (std::size_t i = 0; i < 100; ++i)
+    world->Step(output, state, input);
+
+  for (auto _ : _st)
+    world->Step(output, state, input);
+
+  _st.counters["proxies"] =
+      static_cast<double>(world->GetKinematicProxyCount());
+  _st.SetItemsProcessed(_st.iterations());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_DartsimLevelOfDetail, false)->Arg(100)->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_DartsimLevelOfDetail, true)->Arg(100)->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
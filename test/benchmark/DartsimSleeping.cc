@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gz/plugin/Loader.hh>
+
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/FrameSemantics.hh>
+#include <gz/physics/GetEntities.hh>
+#include <gz/physics/Link.hh>
+#include <gz/physics/RequestEngine.hh>
+#include <gz/physics/Sleep.hh>
+#include <gz/physics/sdf/ConstructWorld.hh>
+
+#include <sdf/Root.hh>
+
+using namespace gz;
+
+struct SleepFeatureList : physics::FeatureList<
+    physics::ForwardStep,
+    physics::sdf::ConstructSdfWorld,
+    physics::GetEntities,
+    physics::AddLinkExternalForceTorque,
+    physics::SleepFeature
+> { };
+
+using SleepWorldPtr = physics::World3dPtr<SleepFeatureList>;
+using SleepLinkPtr = physics::Link3dPtr<SleepFeatureList>;
+
+/// \brief Number of boxes that rest on the ground
+std::size_t gNumRestingBoxes = 1000;
+
+/////////////////////////////////////////////////
+/// \brief A world with boxes that rest on a ground plane and boxes that
+/// hover above it, each on its own grid so that none of them touch.
+std::string SleepWorld(const std::size_t _resting, const std::size_t _awake)
+{
+  std::stringstream sdf;
+  sdf << R"(
+  <sdf version="1.9">
+    <world name="default">
+      <model name="ground">
+        <static>true</static>
+        <link name="link">
+          <collision name="collision">
+            <geometry><plane><normal>0 0 1</normal></plane></geometry>
+          </collision>
+        </link>
+      </model>)";
+
+  const auto addBoxes = [&](const std::string &_prefix,
+      const std::size_t _count, const double _z)
+  {
+    const std::size_t side = static_cast<std::size_t>(
+        std::ceil(std::sqrt(static_cast<double>(_count))));
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      sdf << R"(
+      <model name=")" << _prefix << i << R"(">
+        <pose>)" << 2.0 * static_cast<double>(i % side) << " "
+               << 2.0 * static_cast<double>(i / side) << " " << _z
+               << R"( 0 0 0</pose>
+        <link name="link">
+          <inertial><mass>1</mass></inertial>
+          <collision name="collision">
+            <geometry><box><size>1 1 1</size></box></geometry>
+          </collision>
+        </link>
+      </model>)";
+    }
+  };
+  addBoxes("resting", _resting, 0.5);
+  addBoxes("awake", _awake, 5.0);
+
+  sdf << R"(
+    </world>
+  </sdf>)";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Step a world with many resting boxes and a few boxes that are
+/// kept awake by a force that balances gravity. With sleep, the cost of a
+/// step follows the number of awake boxes only.
+template <bool Sleep>
+// NOLINTNEXTLINE
+void BM_DartsimSleeping(benchmark::State &_st)
+{
+  const std::size_t numAwake = _st.range(0);
+
+  plugin::Loader loader;
+  loader.LoadLib(dartsim_plugin_LIB);
+  auto engine = physics::RequestEngine3d<SleepFeatureList>::From(
+      loader.Instantiate("gz::physics::dartsim::Plugin"));
+
+  sdf::Root root;
+  root.LoadSdfString(SleepWorld(gNumRestingBoxes, numAwake));
+  SleepWorldPtr world = engine->ConstructWorld(*root.WorldByIndex(0));
+
+  std::vector<SleepLinkPtr> awakeLinks;
+  for (std::size_t i = 0; i < numAwake; ++i)
+  {
+    awakeLinks.push_back(
+        world->GetModel("awake" + std::to_string(i))->GetLink(0));
+  }
+
+  physics::SleepParameters parameters;
+  parameters.enabled = Sleep;
+  parameters.timeThreshold = 0.1;
+  world->SetSleepParameters(parameters);
+
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+  const Eigen::Vector3d antiGravity(0, 0, 9.8);
+  const auto step = [&]()
+  {
+    for (auto &link : awakeLinks)
+      link->AddExternalForce(antiGravity);
+    world->Step(output, state, input);
+  };
+
+  // Let the resting boxes settle and, with sleep, go to sleep
+  for (std::size_t i = 0; i < 500; ++i)
+    step();
+
+  for (auto _ : _st)
+    step();
+
+  _st.counters["sleeping"] =
+      static_cast<double>(world->GetSleepingModelCount());
+  _st.SetItemsProcessed(_st.iterations());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_DartsimSleeping, false)->Arg(10)->Arg(100)
+    ->Unit(benchmark::kMicrosecond);
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_DartsimSleeping, true)->Arg(10)->Arg(100)->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+#include <gz/plugin/Loader.hh>
+
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/RequestEngine.hh>
+#include <gz/physics/World.hh>
+#include <gz/physics/sdf/ConstructWorld.hh>
+
+#include <sdf/Root.hh>
+
+using namespace gz;
+
+struct WarmStartFeatureList : physics::FeatureList<
+    physics::ForwardStep,
+    physics::sdf::ConstructSdfWorld,
+    physics::Solver,
+    physics::SolverWarmStart
+> { };
+
+/// \brief Number of boxes of each stack
+constexpr std::size_t kStackHeight = 5;
+
+/////////////////////////////////////////////////
+/// \brief A world with stacks of boxes on a ground plane
+std::string StacksWorld(const std::size_t _stacks)
+{
+  std::stringstream sdf;
+  sdf << R"(
+  <sdf version="1.9">
+    <world name="default">
+      <model name="ground">
+        <static>true</static>
+        <link name="link">
+          <collision name="collision">
+            <geometry><plane><normal>0 0 1</normal></plane></geometry>
+          </collision>
+        </link>
+      </model>)";
+  for (std::size_t s = 0; s < _stacks; ++s)
+  {
+    for (std::size_t i = 0; i < kStackHeight; ++i)
+    {
+      sdf << R"(
+      <model name="box_)" << s << "_" << i << R"(">
+        <pose>)" << 2.0 * static_cast<double>(s) << " 0 "
+               << 0.5 + static_cast<double>(i) << R"( 0 0 0</pose>
+        <link name="link">
+          <inertial><mass>1</mass></inertial>
+          <collision name="collision">
+            <geometry><box><size>1 1 1</size></box></geometry>
+          </collision>
+        </link>
+      </model>)";
+    }
+  }
+  sdf << R"(
+    </world>
+  </sdf>)";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Step stacks of resting boxes with the PGS solver, with and
+/// without warm starting.
+template <bool WarmStart>
+// NOLINTNEXTLINE
+void BM_DartsimWarmStart(benchmark::State &_st)
+{
+  plugin::Loader loader;
+  loader.LoadLib(dartsim_plugin_LIB);
+  auto engine = physics::RequestEngine3d<WarmStartFeatureList>::From(
+      loader.Instantiate("gz::physics::dartsim::Plugin"));
+
+  sdf::Root root;
+  root.LoadSdfString(StacksWorld(_st.range(0)));
+  auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+  world->SetSolver("pgs");
+
+  physics::SolverWarmStartParameters parameters;
+  parameters.enabled = WarmStart;
+  if (!world->SetSolverWarmStart(parameters))
+  {
+    _st.SkipWithError("Solver warm starting is not supported");
+    return;
+  }
+
+  physics::ForwardStep::Output output;
+  physics::ForwardStep::State state;
+  physics::ForwardStep::Input input;
+
+  // Let the stacks settle
+  for (std::size_t i = 0; i < 200; ++i)
+    world->Step(output, state, input);
+
+  for (auto _ : _st)
+    world->Step(output, state, input);
+
+  _st.counters["warm_started"] =
+      static_cast<double>(world->GetWarmStartedContactCount());
+  _st.SetItemsProcessed(_st.iterations());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_DartsimWarmStart, false)->Arg(10)->Arg(50)
+    ->Unit(benchmark::kMicrosecond);
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_DartsimWarmStart, true)->Arg(10)->Arg(50)
+    ->Unit(benchmark::kMicrosecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
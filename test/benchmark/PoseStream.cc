@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "gz/physics/PoseStream.hh"
+
+std::size_t gNumPoses = 30000;
+
+/// \brief Create the poses of one frame of a simulation where every link
+/// moves a little from frame to frame.
+std::vector<gz::physics::WorldPose> CreatePoses(
+    const std::size_t _count, const std::size_t _frame)
+{
+  std::vector<gz::physics::WorldPose> poses(_count);
+  const double t = 1e-3 * static_cast<double>(_frame);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double s = static_cast<double>(i);
+    poses[i].body = i + 1;
+    poses[i].pose = gz::math::Pose3d(
+        std::fmod(s, 100.0) + 0.1 * t, std::floor(s / 100.0), 1.0 - 0.5 * t,
+        0.01 * s + t, 0.2 * t, -0.3 * t);
+  }
+  return poses;
+}
+
+/// \brief Reference: copy the poses as they are, which is what serializing
+/// the raw doubles costs.
+// NOLINTNEXTLINE
+void BM_RawCopy(benchmark::State &_st)
+{
+  const std::size_t count = _st.range(0);
+  const auto poses = CreatePoses(count, 1);
+  std::vector<uint8_t> buffer;
+
+  for (auto _ : _st)
+  {
+    buffer.resize(poses.size() * sizeof(gz::physics::WorldPose));
+    std::memcpy(buffer.data(), poses.data(), buffer.size());
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  _st.SetItemsProcessed(_st.iterations() * count);
+  _st.counters["bytes/frame"] = static_cast<double>(buffer.size());
+}
+
+/// \brief Encode a frame where every pose moved since the previous frame.
+// NOLINTNEXTLINE
+void BM_Encode(benchmark::State &_st)
+{
+  const std::size_t count = _st.range(0);
+  const std::vector<std::vector<gz::physics::WorldPose>> frames =
+      {CreatePoses(count, 0), CreatePoses(count, 1)};
+
+  gz::physics::PoseStreamEncoder encoder;
+  std::vector<uint8_t> buffer;
+  std::size_t f = 0;
+
+  for (auto _ : _st)
+  {
+    encoder.Encode(frames[f], buffer);
+    f = 1 - f;
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  _st.SetItemsProcessed(_st.iterations() * count);
+  _st.counters["bytes/frame"] = static_cast<double>(buffer.size());
+}
+
+/// \brief Decode a stream of frames where every pose moved since the
+/// previous frame.
+// NOLINTNEXTLINE
+void BM_Decode(benchmark::State &_st)
+{
+  const std::size_t count = _st.range(0);
+  gz::physics::PoseStreamEncoder encoder;
+  std::vector<uint8_t> keyFrame;
+  std::vector<uint8_t> forward;
+  std::vector<uint8_t> backward;
+  encoder.Encode(CreatePoses(count, 0), keyFrame);
+  encoder.Encode(CreatePoses(count, 1), forward);
+  encoder.Encode(CreatePoses(count, 0), backward);
+
+  gz::physics::PoseStreamDecoder decoder;
+  std::vector<gz::physics::WorldPose> poses;
+  decoder.Decode(keyFrame, poses);
+  bool back = false;
+
+  for (auto _ : _st)
+  {
+    decoder.Decode(back ? backward : forward, poses);
+    back = !back;
+    benchmark::DoNotOptimize(poses.data());
+  }
+
+  _st.SetItemsProcessed(_st.iterations() * count);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_RawCopy)->Arg(gNumPoses);
+// NOLINTNEXTLINE
+BENCHMARK(BM_Encode)->Arg(gNumPoses);
+// NOLINTNEXTLINE
+BENCHMARK(BM_Decode)->Arg(gNumPoses);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "lib/src/Shape.hh"
+
+using namespace gz;
+using namespace physics;
+
+/// \brief Number of samples along each side of the heightmap
+constexpr std::size_t kHeightmapSamples = 513;
+
+/// \brief Size of the heightmap along x and y in meters
+constexpr double kHeightmapSize = 512.0;
+
+/////////////////////////////////////////////////
+tpelib::HeightmapShape CreateHeightmap()
+{
+  std::vector<float> heights(kHeightmapSamples * kHeightmapSamples);
+  for (std::size_t r = 0; r < kHeightmapSamples; ++r)
+  {
+    for (std::size_t c = 0; c < kHeightmapSamples; ++c)
+    {
+      heights[r * kHeightmapSamples + c] = static_cast<float>(
+          std::sin(0.05 * static_cast<double>(c)) *
+          std::cos(0.03 * static_cast<double>(r)) * 5.0);
+    }
+  }
+
+  tpelib::HeightmapShape heightmap;
+  heightmap.SetHeights(kHeightmapSamples, kHeightmapSamples,
+      std::move(heights), math::Vector2d(kHeightmapSize, kHeightmapSize));
+  return heightmap;
+}
+
+/////////////////////////////////////////////////
+/// \brief Clamp agents scattered over the heightmap to the ground, like a
+/// crowd simulation does every step.
+// NOLINTNEXTLINE
+void BM_HeightmapClampAgents(benchmark::State &_st)
+{
+  const tpelib::HeightmapShape heightmap = CreateHeightmap();
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(
+      -kHeightmapSize * 0.5, kHeightmapSize * 0.5);
+  std::vector<math::Vector2d> agents(_st.range(0));
+  for (auto &agent : agents)
+    agent.Set(distribution(generator), distribution(generator));
+
+  std::vector<double> heights;
+  std::vector<math::Vector3d> normals;
+  for (auto _ : _st)
+  {
+    benchmark::DoNotOptimize(heightmap.HeightsAt(agents, heights, normals));
+    benchmark::ClobberMemory();
+  }
+
+  _st.SetItemsProcessed(_st.iterations() * agents.size());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_HeightmapClampAgents)->Arg(1000)->Arg(10000);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include "lib/src/Collision.hh"
+#include "lib/src/Entity.hh"
+#include "lib/src/Link.hh"
+#include "lib/src/Model.hh"
+
+using namespace gz;
+using namespace physics;
+
+std::size_t gNumModels = 200;
+
+/// \brief Number of nested models between a top level model and its links
+constexpr std::size_t kNestingDepth = 5;
+
+/// \brief Number of links of the innermost models
+constexpr std::size_t kLinksPerModel = 4;
+
+/// \brief Models that are nested kNestingDepth levels deep, with a few links
+/// that each have a collision at the bottom.
+struct NestedModels
+{
+  std::vector<std::unique_ptr<tpelib::Model>> models;
+  std::vector<tpelib::Entity *> links;
+  std::vector<tpelib::Entity *> collisions;
+};
+
+/////////////////////////////////////////////////
+NestedModels CreateNestedModels(const std::size_t _count)
+{
+  NestedModels result;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    auto model = std::make_unique<tpelib::Model>();
+    model->SetPose(math::Pose3d(static_cast<double>(i), 0, 0, 0, 0, 0));
+
+    tpelib::Model *parent = model.get();
+    for (std::size_t d = 0; d < kNestingDepth; ++d)
+    {
+      auto &nested = parent->AddModel();
+      nested.SetPose(math::Pose3d(0, 0, 0.1, 0, 0, 0.2));
+      parent = static_cast<tpelib::Model *>(&nested);
+    }
+
+    for (std::size_t l = 0; l < kLinksPerModel; ++l)
+    {
+      auto &link = parent->AddLink();
+      link.SetPose(math::Pose3d(0.1 * static_cast<double>(l), 0, 0, 0, 0, 0));
+      result.links.push_back(&link);
+      result.collisions.push_back(
+          &static_cast<tpelib::Link *>(&link)->AddCollision());
+    }
+    result.models.push_back(std::move(model));
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Reference: multiply the poses of the whole parent chain, which is
+/// what every world pose query used to do.
+math::Pose3d ParentChainWorldPose(const tpelib::Entity &_entity)
+{
+  math::Pose3d pose = _entity.GetPose();
+  for (auto *parent = _entity.GetParent(); parent;
+       parent = parent->GetParent())
+  {
+    pose = parent->GetPose() * pose;
+  }
+  return pose;
+}
+
+/////////////////////////////////////////////////
+/// \brief Move every top level model, then read the world poses of all the
+/// links and collisions, like a step of the tpe plugin does.
+template <bool Cached>
+// NOLINTNEXTLINE
+void BM_NestedWorldPoses(benchmark::State &_st)
+{
+  const std::size_t count = _st.range(0);
+  NestedModels world = CreateNestedModels(count);
+  double t = 0.0;
+
+  for (auto _ : _st)
+  {
+    t += 1e-3;
+    for (auto &model : world.models)
+    {
+      math::Pose3d pose = model->GetPose();
+      pose.Pos().Z() = t;
+      model->SetPose(pose);
+    }
+
+    for (const auto *entities : {&world.links, &world.collisions})
+    {
+      for (const auto *entity : *entities)
+      {
+        math::Pose3d pose = Cached ?
+            entity->GetWorldPose() : ParentChainWorldPose(*entity);
+        benchmark::DoNotOptimize(pose);
+      }
+    }
+  }
+
+  _st.SetItemsProcessed(
+      _st.iterations() * (world.links.size() + world.collisions.size()));
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_NestedWorldPoses, false)->Arg(gNumModels);
+// NOLINTNEXTLINE
+BENCHMARK_TEMPLATE(BM_NestedWorldPoses, true)->Arg(gNumModels);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
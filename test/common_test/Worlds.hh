@@ -37,12 +37,16 @@ const auto kFallingAddedMassWorld = CommonTestWorld("falling_added_mass.world");
 const auto kGroundSdf = CommonTestWorld("ground.sdf");
 const auto kJointAcrossModelsSdf = CommonTestWorld("joint_across_models.sdf");
 const auto kJointConstraintSdf = CommonTestWorld("joint_constraint.sdf");
+const auto kMimicBallWorld = CommonTestWorld("mimic_ball_world.sdf");
 const auto kMimicFastSlowPendulumsWorld =
   CommonTestWorld("mimic_fast_slow_pendulums_world.sdf");
 const auto kMimicPendulumWorld = CommonTestWorld("mimic_pendulum_world.sdf");
 const auto kMimicPrismaticWorld = CommonTestWorld("mimic_prismatic_world.sdf");
 const auto kMimicUniversalWorld = CommonTestWorld("mimic_universal_world.sdf");
 const auto kMultipleCollisionsSdf = CommonTestWorld("multiple_collisions.sdf");
+const auto kPartitionedBoxesSdf = CommonTestWorld("partitioned_boxes.sdf");
+const auto kPartitionedContactsSdf =
+  CommonTestWorld("partitioned_contacts.sdf");
 const auto kPendulumJointWrenchSdf =
   CommonTestWorld("pendulum_joint_wrench.sdf");
 const auto kShapesWorld = CommonTestWorld("shapes.world");
@@ -51,6 +55,7 @@ const auto kSlipComplianceSdf = CommonTestWorld("slip_compliance.sdf");
 const auto kSphereSdf = CommonTestWorld("sphere.sdf");
 const auto kStringPendulumSdf = CommonTestWorld("string_pendulum.sdf");
 const auto kTestWorld = CommonTestWorld("test.world");
+const auto kThinWallSdf = CommonTestWorld("thin_wall.sdf");
 const auto kWorldJointTestSdf = CommonTestWorld("world_joint_test.sdf");
 const auto kWorldUnsortedLinksSdf = CommonTestWorld("world_unsorted_links.sdf");
 const auto kWorldSingleNestedModelSdf =
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/plugin/Loader.hh>
+
+#include "test/AllocationCounter.hh"
+#include "test/TestLibLoader.hh"
+#include "Worlds.hh"
+
+#include <gz/physics/FindFeatures.hh>
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/FrameSemantics.hh>
+#include <gz/physics/GetContacts.hh>
+#include <gz/physics/GetEntities.hh>
+#include <gz/physics/RequestEngine.hh>
+#include <gz/physics/sdf/ConstructWorld.hh>
+
+#include <sdf/Root.hh>
+
+using gz::physics::test::AllocationCounter;
+
+/// \brief Allocations that one step of the test worlds may make, for each
+/// engine. The budgets leave headroom above what the engines need today, so
+/// that they catch new per-entity or per-step containers rather than small
+/// changes inside the engines. The plugins keep their per-step containers in
+/// a ScratchArena, but the budgets are not zero because the engines'
+/// internals still allocate from the global heap.
+const std::unordered_map<std::string, std::size_t> kStepAllocationBudget
+{
+  {"bullet", 64},
+  {"bullet-featherstone", 64},
+  {"dartsim", 512},
+  {"tpe", 256},
+};
+
+/// \brief Allocations that GetContactsFromLastStep may make for each contact,
+/// mostly the shape pointers and the data of the returned contacts.
+constexpr std::size_t kContactAllocationBudget = 32;
+
+/// \brief Number of steps before allocations are counted
+constexpr std::size_t kWarmUpSteps = 20;
+
+/// \brief Number of steps during which allocations are counted
+constexpr std::size_t kCountedSteps = 200;
+
+template <class T>
+class AllocationsTest:
+  public testing::Test, public gz::physics::TestLibLoader
+{
+  // Documentation inherited
+  public: void SetUp() override
+  {
+    gz::common::Console::SetVerbosity(4);
+
+    loader.LoadLib(AllocationsTest::GetLibToTest());
+
+    // TODO(ahcorde): We should also run the 3f, 2d, and 2f variants of
+    // FindFeatures
+    pluginNames = gz::physics::FindFeatures3d<T>::From(loader);
+    if (pluginNames.empty())
+    {
+      std::cerr << "No plugins with required features found in "
+                << GetLibToTest() << std::endl;
+      GTEST_SKIP();
+    }
+  }
+
+  public: std::set<std::string> pluginNames;
+  public: gz::plugin::Loader loader;
+};
+
+/////////////////////////////////////////////////
+template <class T>
+gz::physics::World3dPtr<T> LoadWorld(
+    const gz::plugin::Loader &_loader,
+    const std::string &_pluginName,
+    const std::string &_world)
+{
+  gz::plugin::PluginPtr plugin = _loader.Instantiate(_pluginName);
+  auto engine = gz::physics::RequestEngine3d<T>::From(plugin);
+  EXPECT_NE(nullptr, engine);
+  if (!engine)
+    return nullptr;
+
+  sdf::Root root;
+  const sdf::Errors errors = root.Load(_world);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *sdfWorld = root.WorldByIndex(0);
+  if (!sdfWorld)
+    return nullptr;
+
+  return engine->ConstructWorld(*sdfWorld);
+}
+
+struct StepFeatures : gz::physics::FeatureList<
+  gz::physics::sdf::ConstructSdfWorld,
+  gz::physics::ForwardStep,
+  gz::physics::GetModelFromWorld,
+  gz::physics::GetLinkFromModel,
+  gz::physics::LinkFrameSemantics
+> {};
+
+using StepFeaturesTestTypes =
+  ::testing::Types<StepFeatures>;
+TYPED_TEST_SUITE(AllocationsTest, StepFeaturesTestTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(AllocationsTest, StepBudget)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+#ifdef _WIN32
+    // See https://github.com/gazebosim/gz-physics/issues/483
+    CHECK_UNSUPPORTED_ENGINE(name, "bullet", "bullet-featherstone")
+#endif
+    const std::string engineName = this->PhysicsEngineName(name);
+    const auto budgetIt = kStepAllocationBudget.find(engineName);
+    ASSERT_NE(kStepAllocationBudget.end(), budgetIt) << engineName;
+
+    for (const auto &worldPath : {common_test::worlds::kFallingWorld,
+                                  common_test::worlds::kContactSdf})
+    {
+      SCOPED_TRACE(engineName + " " + worldPath);
+      auto world = LoadWorld<StepFeatures>(this->loader, name, worldPath);
+      ASSERT_NE(nullptr, world);
+
+      // Entity handles allocate, so they are all created up front
+      std::vector<gz::physics::Link3dPtr<StepFeatures>> links;
+      for (std::size_t m = 0; m < world->GetModelCount(); ++m)
+      {
+        auto model = world->GetModel(m);
+        for (std::size_t l = 0; l < model->GetLinkCount(); ++l)
+          links.push_back(model->GetLink(l));
+      }
+      ASSERT_FALSE(links.empty());
+
+      gz::physics::ForwardStep::Input input;
+      gz::physics::ForwardStep::State state;
+      gz::physics::ForwardStep::Output output;
+      for (std::size_t i = 0; i < kWarmUpSteps; ++i)
+        world->Step(output, state, input);
+
+      std::size_t maxStepAllocations = 0;
+      std::size_t totalStepAllocations = 0;
+      std::size_t linkAllocations = 0;
+      for (std::size_t i = 0; i < kCountedSteps; ++i)
+      {
+        {
+          AllocationCounter counter;
+          world->Step(output, state, input);
+          maxStepAllocations = std::max(maxStepAllocations, counter.Count());
+          totalStepAllocations += counter.Count();
+        }
+
+        AllocationCounter counter;
+        for (const auto &link : links)
+        {
+          const auto frameData = link->FrameDataRelativeToWorld();
+          EXPECT_TRUE(frameData.pose.translation().allFinite());
+        }
+        linkAllocations += counter.Count();
+      }
+
+      EXPECT_LE(maxStepAllocations, budgetIt->second)
+          << "average: " << totalStepAllocations / kCountedSteps;
+
+      // Reading the state of a link never needs to allocate
+      EXPECT_EQ(0u, linkAllocations);
+    }
+  }
+}
+
+struct ContactFeatures : gz::physics::FeatureList<
+  gz::physics::sdf::ConstructSdfWorld,
+  gz::physics::ForwardStep,
+  gz::physics::GetContactsFromLastStepFeature
+> {};
+
+template <class T>
+class AllocationsContactTest : public AllocationsTest<T> {};
+using ContactFeaturesTestTypes =
+  ::testing::Types<ContactFeatures>;
+TYPED_TEST_SUITE(AllocationsContactTest, ContactFeaturesTestTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(AllocationsContactTest, ContactsBudget)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+#ifdef _WIN32
+    // See https://github.com/gazebosim/gz-physics/issues/483
+    CHECK_UNSUPPORTED_ENGINE(name, "bullet", "bullet-featherstone")
+#endif
+    for (const auto &worldPath : {common_test::worlds::kFallingWorld,
+                                  common_test::worlds::kContactSdf})
+    {
+      SCOPED_TRACE(this->PhysicsEngineName(name) + " " + worldPath);
+      auto world = LoadWorld<ContactFeatures>(this->loader, name, worldPath);
+      ASSERT_NE(nullptr, world);
+
+      gz::physics::ForwardStep::Input input;
+      gz::physics::ForwardStep::State state;
+      gz::physics::ForwardStep::Output output;
+      for (std::size_t i = 0; i < kWarmUpSteps; ++i)
+        world->Step(output, state, input);
+
+      for (std::size_t i = 0; i < kCountedSteps; ++i)
+      {
+        world->Step(output, state, input);
+
+        std::size_t contactCount = 0;
+        std::size_t allocations = 0;
+        {
+          AllocationCounter counter;
+          contactCount = world->GetContactsFromLastStep().size();
+          allocations = counter.Count();
+        }
+        EXPECT_LE(allocations, kContactAllocationBudget * (contactCount + 1))
+            << "contacts: " << contactCount;
+      }
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  if (!AllocationsTest<StepFeatures>::init(argc, argv))
+    return -1;
+  return RUN_ALL_TESTS();
+}
@@ -16,7 +16,9 @@
 */
 #include <gtest/gtest.h>
 
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include "test/TestLibLoader.hh"
 #include "Worlds.hh"
@@ -26,6 +28,7 @@
 #include <gz/math/Vector3.hh>
 #include <gz/math/eigen3/Conversions.hh>
 #include <gz/plugin/Loader.hh>
+#include <sdf/Model.hh>
 #include <sdf/Root.hh>
 #include <sdf/World.hh>
 
@@ -33,6 +36,7 @@
 #include "gz/physics/FrameSemantics.hh"
 #include "gz/physics/FreeGroup.hh"
 #include "gz/physics/GetEntities.hh"
+#include "gz/physics/RemoveEntities.hh"
 #include "gz/physics/RequestEngine.hh"
 #include "gz/physics/sdf/ConstructModel.hh"
 #include "gz/physics/sdf/ConstructNestedModel.hh"
@@ -316,6 +320,145 @@ TEST_F(FreeGroupFeaturesTest, FreeGroupSetWorldPosePrincipalAxesOffset)
   }
 }
 
+struct FreeGroupBatchFeatureList : gz::physics::FeatureList<
+    TestFeatureList,
+    gz::physics::RemoveModelFromWorld,
+    gz::physics::SetFreeGroupWorldStateBatch > { };
+
+class FreeGroupBatchFeaturesTest:
+  public testing::Test, public gz::physics::TestLibLoader
+{
+  // Documentation inherited
+  public: void SetUp() override
+  {
+    gz::common::Console::SetVerbosity(4);
+
+    loader.LoadLib(FreeGroupBatchFeaturesTest::GetLibToTest());
+
+    pluginNames =
+        gz::physics::FindFeatures3d<FreeGroupBatchFeatureList>::From(loader);
+    if (pluginNames.empty())
+    {
+      std::cerr << "No plugins with required features found in "
+                << GetLibToTest() << std::endl;
+      GTEST_SKIP();
+    }
+  }
+
+  public: std::set<std::string> pluginNames;
+  public: gz::plugin::Loader loader;
+};
+
+TEST_F(FreeGroupBatchFeaturesTest, SetWorldStateBatch)
+{
+  const std::string modelStr = R"(
+    <sdf version="1.11">
+      <model name="box">
+        <pose>0 0 3.0 0 0 0</pose>
+        <link name="link">
+          <collision name="coll_box">
+            <geometry>
+              <box>
+                <size>1 1 1</size>
+              </box>
+            </geometry>
+          </collision>
+        </link>
+      </model>
+    </sdf>)";
+
+  for (const std::string &name : pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = loader.Instantiate(name);
+
+    auto engine =
+        gz::physics::RequestEngine3d<FreeGroupBatchFeatureList>::From(plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    sdf::Errors errors = root.Load(common_test::worlds::kGroundSdf);
+    EXPECT_EQ(0u, errors.size()) << errors;
+    const sdf::World *sdfWorld = root.WorldByIndex(0);
+    ASSERT_NE(nullptr, sdfWorld);
+
+    auto world = engine->ConstructWorld(*sdfWorld);
+    ASSERT_NE(nullptr, world);
+
+    const std::size_t numModels = 3;
+    std::vector<gz::physics::BaseFreeGroup3dPtr> groups;
+    std::vector<gz::physics::Link3dPtr<FreeGroupBatchFeatureList>> links;
+    for (std::size_t i = 0; i < numModels; ++i)
+    {
+      errors = root.LoadSdfString(modelStr);
+      ASSERT_TRUE(errors.empty()) << errors;
+      sdf::Model sdfModel = *root.Model();
+      sdfModel.SetName("box" + std::to_string(i));
+      auto model = world->ConstructModel(sdfModel);
+      ASSERT_NE(nullptr, model);
+
+      auto freeGroup = model->FindFreeGroup();
+      ASSERT_NE(nullptr, freeGroup);
+      groups.push_back(freeGroup);
+      links.push_back(model->GetLink("link"));
+      ASSERT_NE(nullptr, links.back());
+    }
+
+    // Mismatched sizes are rejected before any groups are declared
+    EXPECT_FALSE(
+        world->SetFreeGroupWorldPoses({Eigen::Isometry3d::Identity()}));
+
+    EXPECT_TRUE(world->SetFreeGroupBatch(groups));
+
+    std::vector<Eigen::Isometry3d> poses;
+    for (std::size_t i = 0; i < numModels; ++i)
+    {
+      poses.push_back(gz::math::eigen3::convert(gz::math::Pose3d(
+          static_cast<double>(i), 2, 5, 0, 0, 0.5 * static_cast<double>(i))));
+    }
+    EXPECT_FALSE(world->SetFreeGroupWorldPoses(
+        std::vector<Eigen::Isometry3d>(numModels - 1)));
+    EXPECT_TRUE(world->SetFreeGroupWorldPoses(poses));
+
+    std::vector<Eigen::Vector3d> linearVelocities;
+    std::vector<Eigen::Vector3d> angularVelocities;
+    for (std::size_t i = 0; i < numModels; ++i)
+    {
+      linearVelocities.emplace_back(0.1 * static_cast<double>(i), -0.2, 0.3);
+      angularVelocities.emplace_back(0, 0, 0.4 * static_cast<double>(i));
+    }
+    EXPECT_TRUE(world->SetFreeGroupWorldVelocities(
+        linearVelocities, angularVelocities));
+
+    for (std::size_t i = 0; i < numModels; ++i)
+    {
+      const auto frameData = links[i]->FrameDataRelativeToWorld();
+      EXPECT_EQ(gz::math::eigen3::convert(poses[i]),
+                gz::math::eigen3::convert(frameData.pose));
+      EXPECT_EQ(gz::math::eigen3::convert(linearVelocities[i]),
+                gz::math::eigen3::convert(frameData.linearVelocity));
+      EXPECT_EQ(gz::math::eigen3::convert(angularVelocities[i]),
+                gz::math::eigen3::convert(frameData.angularVelocity));
+    }
+
+    // Removing a model invalidates the declared groups until they are
+    // declared again
+    EXPECT_TRUE(world->GetModel("box1")->Remove());
+    gz::common::Console::SetVerbosity(0);
+    EXPECT_FALSE(world->SetFreeGroupWorldPoses(poses));
+    gz::common::Console::SetVerbosity(4);
+
+    EXPECT_TRUE(world->SetFreeGroupBatch({groups[0], groups[2]}));
+    EXPECT_TRUE(world->SetFreeGroupWorldPoses({poses[2], poses[0]}));
+    EXPECT_EQ(gz::math::eigen3::convert(poses[2]),
+              gz::math::eigen3::convert(
+                  links[0]->FrameDataRelativeToWorld().pose));
+    EXPECT_EQ(gz::math::eigen3::convert(poses[0]),
+              gz::math::eigen3::convert(
+                  links[2]->FrameDataRelativeToWorld().pose));
+  }
+}
+
 int main(int argc, char *argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
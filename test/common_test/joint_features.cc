@@ -194,6 +194,262 @@ TYPED_TEST(JointFeaturesTest, JointSetCommand)
   }
 }
 
+TYPED_TEST(JointFeaturesTest, JointServoCommand)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    if(this->PhysicsEngineName(name) == "bullet")
+    {
+      GTEST_SKIP();
+    }
+
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = this->loader.Instantiate(name);
+
+    auto engine = gz::physics::RequestEngine3d<JointFeatureList>::From(plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    const sdf::Errors errors = root.Load(common_test::worlds::kTestWorld);
+    ASSERT_TRUE(errors.empty()) << errors.front();
+
+    auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+    auto model = world->GetModel("double_pendulum_with_base");
+    auto upperJoint = model->GetJoint("upper_joint");
+    auto lowerJoint = model->GetJoint("lower_joint");
+
+    gz::physics::ForwardStep::Output output;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Input input;
+
+    // Servo both joints of the pendulum with stiff gains. The servo is
+    // integrated implicitly, so the gains are stable at this step size.
+    auto &servos = input.Get<gz::physics::JointServoCommands>();
+    servos.joints = {upperJoint->EntityID(), lowerJoint->EntityID()};
+    servos.dofs = {0, 0};
+    servos.positions = {0.5, -0.25};
+    servos.gains = {{1e4, 0.0, 1e2}, {1e4, 0.0, 1e2}};
+
+    for (std::size_t i = 0; i < 2000; ++i)
+      world->Step(output, state, input);
+
+    EXPECT_NEAR(0.5, upperJoint->GetPosition(0), 1e-2);
+    EXPECT_NEAR(-0.25, lowerJoint->GetPosition(0), 1e-2);
+    EXPECT_NEAR(0.0, upperJoint->GetVelocity(0), 1e-2);
+    EXPECT_NEAR(0.0, lowerJoint->GetVelocity(0), 1e-2);
+
+    // Mismatched arrays are ignored
+    servos.positions.pop_back();
+    gz::common::Console::SetVerbosity(0);
+    for (std::size_t i = 0; i < 100; ++i)
+      world->Step(output, state, input);
+    gz::common::Console::SetVerbosity(4);
+    EXPECT_GT(std::abs(upperJoint->GetVelocity(0)), 1e-2);
+
+    // Servo commands only act during the step they are passed to
+    input.Get<gz::physics::JointServoCommands>() = {};
+    for (std::size_t i = 0; i < 100; ++i)
+      world->Step(output, state, input);
+    EXPECT_GT(std::abs(upperJoint->GetVelocity(0)), 1e-2);
+  }
+}
+
+struct JointFeatureSpringDamperList : gz::physics::FeatureList<
+    gz::physics::ForwardStep,
+    gz::physics::GetBasicJointState,
+    gz::physics::GetEngineInfo,
+    gz::physics::GetJointFromModel,
+    gz::physics::GetModelFromWorld,
+    gz::physics::SetJointSpringDamperFeature,
+    gz::physics::sdf::ConstructSdfWorld
+> { };
+
+template <class T>
+class JointFeaturesSpringDamperTest :
+  public JointFeaturesTest<T>{};
+using JointFeaturesSpringDamperTestTypes =
+  ::testing::Types<JointFeatureSpringDamperList>;
+TYPED_TEST_SUITE(JointFeaturesSpringDamperTest,
+                 JointFeaturesSpringDamperTestTypes);
+
+TYPED_TEST(JointFeaturesSpringDamperTest, StiffSpringLargeTimeStep)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = this->loader.Instantiate(name);
+
+    auto engine =
+        gz::physics::RequestEngine3d<JointFeatureSpringDamperList>::From(
+            plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    const sdf::Errors errors = root.Load(common_test::worlds::kTestWorld);
+    ASSERT_TRUE(errors.empty()) << errors.front();
+
+    auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+    auto model = world->GetModel("double_pendulum_with_base");
+    auto upperJoint = model->GetJoint("upper_joint");
+    auto lowerJoint = model->GetJoint("lower_joint");
+
+    // This spring would be unstable if it was integrated explicitly at a
+    // 10 ms time step.
+    upperJoint->SetSpringDamper(0, 1e5, 1e3, 0.3);
+    lowerJoint->SetSpringDamper(0, 1e5, 1e3, -0.2);
+
+    gz::physics::ForwardStep::Output output;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Input input;
+    input.Get<std::chrono::steady_clock::duration>() =
+        std::chrono::milliseconds(10);
+
+    for (std::size_t i = 0; i < 500; ++i)
+      world->Step(output, state, input);
+
+    EXPECT_NEAR(0.3, upperJoint->GetPosition(0), 1e-2);
+    EXPECT_NEAR(-0.2, lowerJoint->GetPosition(0), 1e-2);
+    EXPECT_NEAR(0.0, upperJoint->GetVelocity(0), 1e-2);
+    EXPECT_NEAR(0.0, lowerJoint->GetVelocity(0), 1e-2);
+
+    // Invalid values are ignored
+    gz::common::Console::SetVerbosity(0);
+    upperJoint->SetSpringDamper(
+        0, std::numeric_limits<double>::quiet_NaN(), 1e3, 0.3);
+    upperJoint->SetSpringDamper(0, -1.0, 1e3, 0.3);
+    gz::common::Console::SetVerbosity(4);
+    for (std::size_t i = 0; i < 10; ++i)
+      world->Step(output, state, input);
+    EXPECT_NEAR(0.3, upperJoint->GetPosition(0), 1e-2);
+
+    // Without the springs, the pendulum swings under gravity again
+    upperJoint->SetSpringDamper(0, 0.0, 0.0, 0.0);
+    lowerJoint->SetSpringDamper(0, 0.0, 0.0, 0.0);
+    for (std::size_t i = 0; i < 10; ++i)
+      world->Step(output, state, input);
+    EXPECT_GT(std::abs(upperJoint->GetVelocity(0)), 1e-2);
+  }
+}
+
+struct JointFeatureVelocityCommandBatchList : gz::physics::FeatureList<
+    gz::physics::ForwardStep,
+    gz::physics::GetBasicJointState,
+    gz::physics::GetEngineInfo,
+    gz::physics::GetJointFromModel,
+    gz::physics::GetModelFromWorld,
+    gz::physics::RemoveModelFromWorld,
+    gz::physics::SetJointVelocityCommandBatchFeature,
+    gz::physics::sdf::ConstructSdfWorld
+> { };
+
+template <class T>
+class JointFeaturesVelocityCommandBatchTest :
+  public JointFeaturesTest<T>{};
+using JointFeaturesVelocityCommandBatchTestTypes =
+  ::testing::Types<JointFeatureVelocityCommandBatchList>;
+TYPED_TEST_SUITE(JointFeaturesVelocityCommandBatchTest,
+                 JointFeaturesVelocityCommandBatchTestTypes);
+
+TYPED_TEST(JointFeaturesVelocityCommandBatchTest, JointSetCommands)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = this->loader.Instantiate(name);
+
+    auto engine =
+        gz::physics::RequestEngine3d<JointFeatureVelocityCommandBatchList>::
+            From(plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    const sdf::Errors errors = root.Load(common_test::worlds::kTestWorld);
+    ASSERT_TRUE(errors.empty()) << errors.front();
+
+    auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+    auto model = world->GetModel("double_pendulum_with_base");
+    auto upperJoint = model->GetJoint("upper_joint");
+    auto lowerJoint = model->GetJoint("lower_joint");
+
+    ASSERT_TRUE(world->SetVelocityCommandJoints({upperJoint, lowerJoint}));
+
+    // The number of commands must match the number of declared joints
+    gz::common::Console::SetVerbosity(0);
+    EXPECT_FALSE(world->SetJointVelocityCommands({1.0}));
+    gz::common::Console::SetVerbosity(4);
+
+    gz::physics::ForwardStep::Output output;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Input input;
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+      EXPECT_TRUE(world->SetJointVelocityCommands({1.0, -0.5}));
+      world->Step(output, state, input);
+      EXPECT_NEAR(1.0, upperJoint->GetVelocity(0), 1e-2);
+      EXPECT_NEAR(-0.5, lowerJoint->GetVelocity(0), 1e-2);
+    }
+
+    // Changing a single command updates only that joint
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+      EXPECT_TRUE(world->SetJointVelocityCommands({1.0, 0.5}));
+      world->Step(output, state, input);
+      EXPECT_NEAR(1.0, upperJoint->GetVelocity(0), 1e-2);
+      EXPECT_NEAR(0.5, lowerJoint->GetVelocity(0), 1e-2);
+    }
+  }
+}
+
+TYPED_TEST(JointFeaturesVelocityCommandBatchTest, RemoveCommandedModel)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = this->loader.Instantiate(name);
+
+    auto engine =
+        gz::physics::RequestEngine3d<JointFeatureVelocityCommandBatchList>::
+            From(plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    const sdf::Errors errors = root.Load(common_test::worlds::kTestWorld);
+    ASSERT_TRUE(errors.empty()) << errors.front();
+
+    auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+    auto pendulum = world->GetModel("double_pendulum_with_base");
+    auto upperJoint = pendulum->GetJoint("upper_joint");
+    auto lowerJoint = pendulum->GetJoint("lower_joint");
+    auto simpleJoint = world->GetModel("simple_joint_test")->GetJoint("j1");
+
+    ASSERT_TRUE(world->SetVelocityCommandJoints(
+        {upperJoint, simpleJoint, lowerJoint}));
+
+    gz::physics::ForwardStep::Output output;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Input input;
+
+    EXPECT_TRUE(world->SetJointVelocityCommands({1.0, 0.5, -0.5}));
+    world->Step(output, state, input);
+
+    // Removing a model drops its joints from the declared joints, while the
+    // remaining joints keep their order.
+    EXPECT_TRUE(pendulum->Remove());
+
+    gz::common::Console::SetVerbosity(0);
+    EXPECT_FALSE(world->SetJointVelocityCommands({1.0, 0.5, -0.5}));
+    gz::common::Console::SetVerbosity(4);
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+      EXPECT_TRUE(world->SetJointVelocityCommands({0.25}));
+      world->Step(output, state, input);
+      EXPECT_NEAR(0.25, simpleJoint->GetVelocity(0), 1e-2);
+    }
+  }
+}
+
 struct JointFeaturePositionLimitsList : gz::physics::FeatureList<
     gz::physics::ForwardStep,
     gz::physics::GetBasicJointProperties,
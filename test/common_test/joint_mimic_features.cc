@@ -16,7 +16,9 @@
 */
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 #include <gz/common/Console.hh>
 #include <gz/plugin/Loader.hh>
@@ -98,6 +100,20 @@ struct JointMimicFeatureList : gz::physics::FeatureList<
 using JointMimicFeatureTest =
     JointMimicFeaturesTest<JointMimicFeatureList>;
 
+struct JointCouplingFeatureList : gz::physics::FeatureList<
+    gz::physics::ForwardStep,
+    gz::physics::GetBasicJointProperties,
+    gz::physics::GetBasicJointState,
+    gz::physics::GetEngineInfo,
+    gz::physics::GetJointFromModel,
+    gz::physics::GetModelFromWorld,
+    gz::physics::SetBasicJointState,
+    gz::physics::SetJointCouplingFeature,
+    gz::physics::sdf::ConstructSdfWorld>{};
+
+using JointCouplingFeatureTest =
+    JointMimicFeaturesTest<JointCouplingFeatureList>;
+
 // Here, we test mimic constraints on various combinations of
 // prismatic and revolute joints using a chain of constraints.
 TEST_F(JointMimicFeatureTest, PrismaticRevoluteMimicTest)
@@ -519,6 +535,218 @@ TEST_F(JointMimicFeatureTest, PendulumsFastSlowMimicTest)
   }
 }
 
+// Here, the chain of mimic constraints of PrismaticRevoluteMimicTest is
+// expressed as a single joint coupling of the model.
+TEST_F(JointCouplingFeatureTest, PrismaticRevoluteCouplingTest)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = this->loader.Instantiate(name);
+
+    auto engine =
+        gz::physics::RequestEngine3d<JointCouplingFeatureList>::From(plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    const sdf::Errors errors =
+      root.Load(common_test::worlds::kMimicPrismaticWorld);
+    ASSERT_TRUE(errors.empty()) << errors.front();
+
+    auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+
+    auto model = world->GetModel("prismatic_model");
+
+    auto leaderJoint = model->GetJoint("prismatic_joint_1");
+    auto prismaticFollowerJoint1 = model->GetJoint("prismatic_joint_2");
+    auto revoluteFollowerJoint1 = model->GetJoint("revolute_joint_1");
+    auto revoluteFollowerJoint2 = model->GetJoint("revolute_joint_2");
+    auto prismaticFollowerJoint2 = model->GetJoint("prismatic_joint_3");
+
+    using JointCoupling = gz::physics::SetJointCouplingFeature::
+        JointCoupling<gz::physics::FeaturePolicy3d>;
+
+    // Invalid couplings are rejected
+    {
+      JointCoupling coupling;
+      coupling.followers = {{prismaticFollowerJoint1, 0}};
+      coupling.leaders = {{leaderJoint, 0}};
+      coupling.terms = {{0, 1, 1.0}};
+      EXPECT_FALSE(model->SetJointCoupling(coupling));
+
+      coupling.terms = {{0, 0, 1.0}};
+      coupling.offsets = {0.0, 0.0};
+      EXPECT_FALSE(model->SetJointCoupling(coupling));
+
+      coupling.offsets.clear();
+      coupling.followers = {{prismaticFollowerJoint1, 1}};
+      EXPECT_FALSE(model->SetJointCoupling(coupling));
+    }
+
+    gz::physics::ForwardStep::Output output;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Input input;
+
+    auto testCouplingFcn = [&](
+        double multiplier, double offset, double reference)
+      {
+        // Leaders (columns): prismatic_joint_1, revolute_joint_1
+        // Followers (rows):
+        // prismatic_joint_2 = multiplier * prismatic_joint_1 + b
+        // revolute_joint_1 = multiplier * prismatic_joint_1 + b
+        // revolute_joint_2 = multiplier * revolute_joint_1 + b
+        // prismatic_joint_3 = multiplier * revolute_joint_1 + b
+        const double b = offset - multiplier * reference;
+        JointCoupling coupling;
+        coupling.followers = {
+          {prismaticFollowerJoint1, 0},
+          {revoluteFollowerJoint1, 0},
+          {revoluteFollowerJoint2, 0},
+          {prismaticFollowerJoint2, 0}};
+        coupling.leaders = {
+          {leaderJoint, 0},
+          {revoluteFollowerJoint1, 0}};
+        coupling.terms = {
+          {0, 0, multiplier},
+          {1, 0, multiplier},
+          {2, 1, multiplier},
+          {3, 1, multiplier}};
+        coupling.offsets = {b, b, b, b};
+        ASSERT_TRUE(model->SetJointCoupling(coupling));
+
+        // Reset positions and run a few iterations so the positions reach
+        // nontrivial values.
+        leaderJoint->SetPosition(0, 0);
+        prismaticFollowerJoint1->SetPosition(0, 0);
+        prismaticFollowerJoint2->SetPosition(0, 0);
+        revoluteFollowerJoint1->SetPosition(0, 0);
+        revoluteFollowerJoint2->SetPosition(0, 0);
+        for (int _ = 0; _ < 200; _++)
+          world->Step(output, state, input);
+
+        const double positionTolerance = 0.1;
+        for (int _ = 0; _ < 10; _++)
+        {
+          world->Step(output, state, input);
+          const double leaderPos = leaderJoint->GetPosition(0);
+          const double revolutePos = revoluteFollowerJoint1->GetPosition(0);
+          EXPECT_NEAR(multiplier * leaderPos + b,
+              prismaticFollowerJoint1->GetPosition(0), positionTolerance)
+            << "multiplier [" << multiplier << "], offset [" << offset
+            << "], reference [" << reference << "]";
+          EXPECT_NEAR(multiplier * leaderPos + b,
+              revolutePos, positionTolerance)
+            << "multiplier [" << multiplier << "], offset [" << offset
+            << "], reference [" << reference << "]";
+          EXPECT_NEAR(multiplier * revolutePos + b,
+              revoluteFollowerJoint2->GetPosition(0), positionTolerance)
+            << "multiplier [" << multiplier << "], offset [" << offset
+            << "], reference [" << reference << "]";
+          EXPECT_NEAR(multiplier * revolutePos + b,
+              prismaticFollowerJoint2->GetPosition(0), positionTolerance)
+            << "multiplier [" << multiplier << "], offset [" << offset
+            << "], reference [" << reference << "]";
+        }
+      };
+
+    // Testing with different (multiplier, offset, reference) combinations.
+    testCouplingFcn(1, 0, 0);
+    testCouplingFcn(-1, 0, 0);
+    testCouplingFcn(1, 0.1, 0);
+    testCouplingFcn(1, 0.05, 0.05);
+    testCouplingFcn(-1, 0.2, 0);
+    testCouplingFcn(-2, 0, 0);
+
+    // Once the coupling is removed, the joints move independently again.
+    model->RemoveJointCoupling();
+    leaderJoint->SetPosition(0, 0);
+    prismaticFollowerJoint1->SetPosition(0, 0);
+    for (int _ = 0; _ < 10; _++)
+      world->Step(output, state, input);
+    EXPECT_NE(leaderJoint->GetPosition(0),
+              prismaticFollowerJoint1->GetPosition(0));
+
+    std::cout << "Finished testing plugin: " << name << std::endl;
+  }
+}
+
+// Here, every axis of a ball joint follows the same axis of another ball
+// joint, so both arms must keep the same orientation. bullet-featherstone
+// stores the positions of ball joints as a quaternion and rejects the
+// coupling.
+TEST_F(JointCouplingFeatureTest, BallCouplingTest)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = this->loader.Instantiate(name);
+
+    auto engine =
+        gz::physics::RequestEngine3d<JointCouplingFeatureList>::From(plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    const sdf::Errors errors =
+      root.Load(common_test::worlds::kMimicBallWorld);
+    ASSERT_TRUE(errors.empty()) << errors.front();
+
+    auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+
+    auto model = world->GetModel("ball_model");
+    ASSERT_NE(nullptr, model);
+
+    auto leaderJoint = model->GetJoint("ball_joint_1");
+    auto followerJoint = model->GetJoint("ball_joint_2");
+    ASSERT_NE(nullptr, leaderJoint);
+    ASSERT_NE(nullptr, followerJoint);
+    ASSERT_EQ(3u, leaderJoint->GetDegreesOfFreedom());
+    ASSERT_EQ(3u, followerJoint->GetDegreesOfFreedom());
+
+    using JointCoupling = gz::physics::SetJointCouplingFeature::
+        JointCoupling<gz::physics::FeaturePolicy3d>;
+
+    JointCoupling coupling;
+    for (std::size_t dof = 0; dof < 3; ++dof)
+    {
+      coupling.followers.push_back({followerJoint, dof});
+      coupling.leaders.push_back({leaderJoint, dof});
+      coupling.terms.push_back({dof, dof, 1.0});
+    }
+
+    if (this->PhysicsEngineName(name) == "bullet-featherstone")
+    {
+      EXPECT_FALSE(model->SetJointCoupling(coupling));
+      continue;
+    }
+    ASSERT_TRUE(model->SetJointCoupling(coupling));
+
+    gz::physics::ForwardStep::Output output;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Input input;
+
+    // The centers of mass of the arms are offset differently, so the arms
+    // would swing apart if they were not coupled.
+    const double positionTolerance = 0.05;
+    double maxLeaderPos = 0.0;
+    for (int i = 0; i < 1000; ++i)
+    {
+      world->Step(output, state, input);
+      for (std::size_t dof = 0; dof < 3; ++dof)
+      {
+        const double leaderPos = leaderJoint->GetPosition(dof);
+        maxLeaderPos = std::max(maxLeaderPos, std::abs(leaderPos));
+        EXPECT_NEAR(leaderPos, followerJoint->GetPosition(dof),
+            positionTolerance) << "step [" << i << "], axis [" << dof << "]";
+      }
+    }
+
+    // Make sure the arms actually swung
+    EXPECT_GT(maxLeaderPos, 0.05);
+
+    std::cout << "Finished testing plugin: " << name << std::endl;
+  }
+}
+
 int main(int argc, char *argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
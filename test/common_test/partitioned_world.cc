@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/plugin/Loader.hh>
+
+#include "test/TestLibLoader.hh"
+#include "Worlds.hh"
+
+#include <gz/physics/FindFeatures.hh>
+#include <gz/physics/ForwardStep.hh>
+#include <gz/physics/RequestEngine.hh>
+#include <gz/physics/WorldPartition.hh>
+#include <gz/physics/sdf/PartitionedWorld.hh>
+
+#include <sdf/Root.hh>
+#include <sdf/World.hh>
+
+using Features = gz::physics::sdf::PartitionedWorldFeatureList;
+
+class PartitionedWorldTest:
+  public testing::Test, public gz::physics::TestLibLoader
+{
+  // Documentation inherited
+  public: void SetUp() override
+  {
+    gz::common::Console::SetVerbosity(4);
+
+    loader.LoadLib(PartitionedWorldTest::GetLibToTest());
+
+    pluginNames = gz::physics::FindFeatures3d<Features>::From(loader);
+    if (pluginNames.empty())
+    {
+      std::cerr << "No plugins with required features found in "
+                << GetLibToTest() << std::endl;
+      GTEST_SKIP();
+    }
+
+    const sdf::Errors errors =
+        this->root.Load(common_test::worlds::kPartitionedBoxesSdf);
+    ASSERT_TRUE(errors.empty()) << errors;
+  }
+
+  /// \brief Instantiate an engine of a plugin
+  /// \param[in] _name Name of the plugin
+  /// \return A new instance of the engine
+  public: gz::physics::Engine3dPtr<Features> Engine(const std::string &_name)
+  {
+    return gz::physics::RequestEngine3d<Features>::From(
+        this->loader.Instantiate(_name));
+  }
+
+  public: std::set<std::string> pluginNames;
+  public: gz::plugin::Loader loader;
+  public: sdf::Root root;
+};
+
+/// \brief Two regions that split the world at x = 0, with a 2 m overlap
+const gz::physics::WorldPartition kPartition(
+    Eigen::Vector3d(-10, -10, 0), Eigen::Vector3d(10, 10, 0), 2, 1, 2.0);
+
+/// \brief Initial velocity of the flying box, which takes it across the
+/// boundary between the regions
+const Eigen::Vector3d kFlyingVelocity(6, 0, 0);
+
+/////////////////////////////////////////////////
+TEST_F(PartitionedWorldTest, Construct)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+
+    // Every region needs an engine
+    auto partitioned =
+        gz::physics::sdf::PartitionedWorld<Features>::Construct(
+            {this->Engine(name)}, *this->root.WorldByIndex(0), kPartition);
+    EXPECT_EQ(nullptr, partitioned);
+
+    partitioned = gz::physics::sdf::PartitionedWorld<Features>::Construct(
+        {this->Engine(name), this->Engine(name)},
+        *this->root.WorldByIndex(0), kPartition);
+    ASSERT_NE(nullptr, partitioned);
+
+    // Static models are in every region, the others in the region that owns
+    // them and in the regions whose overlap zone they are in
+    for (std::size_t r = 0; r < 2; ++r)
+      EXPECT_NE(nullptr, partitioned->RegionWorld(r)->GetModel("ground"));
+    EXPECT_EQ(2u, partitioned->RegionOfModel("ground"));
+    EXPECT_EQ(0u, partitioned->RegionOfModel("resting"));
+    EXPECT_EQ(0u, partitioned->RegionOfModel("flying"));
+    EXPECT_NE(nullptr, partitioned->RegionWorld(1)->GetModel("resting"));
+    EXPECT_EQ(nullptr, partitioned->RegionWorld(1)->GetModel("flying"));
+    EXPECT_EQ(1u, partitioned->MirrorCount());
+    EXPECT_EQ(2u, partitioned->ModelPoses().size());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PartitionedWorldTest, MatchesSingleWorld)
+{
+  constexpr std::size_t kSteps = 1000;
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+
+    // Reference simulation of the whole world by a single engine
+    auto reference = this->Engine(name)->ConstructWorld(
+        *this->root.WorldByIndex(0));
+    ASSERT_NE(nullptr, reference);
+    reference->GetModel("flying")->FindFreeGroup()->SetWorldLinearVelocity(
+        kFlyingVelocity);
+
+    gz::physics::ForwardStep::Input input;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Output output;
+    for (std::size_t i = 0; i < kSteps; ++i)
+      reference->Step(output, state, input);
+
+    const auto referencePose = [&](const std::string &_model)
+    {
+      return reference->GetModel(_model)->FindFreeGroup()->RootLink()
+          ->FrameDataRelativeToWorld().pose;
+    };
+    const std::size_t referenceContacts =
+        reference->GetContactsFromLastStep().size();
+
+    for (const bool threaded : {true, false})
+    {
+      auto partitioned =
+          gz::physics::sdf::PartitionedWorld<Features>::Construct(
+              {this->Engine(name), this->Engine(name)},
+              *this->root.WorldByIndex(0), kPartition, threaded);
+      ASSERT_NE(nullptr, partitioned);
+      partitioned->RegionWorld(0)->GetModel("flying")->FindFreeGroup()
+          ->SetWorldLinearVelocity(kFlyingVelocity);
+
+      for (std::size_t i = 0; i < kSteps; ++i)
+        partitioned->Step(input);
+
+      // The flying box was handed off to the second region
+      EXPECT_EQ(1u, partitioned->RegionOfModel("flying"));
+      EXPECT_EQ(nullptr, partitioned->RegionWorld(0)->GetModel("flying"));
+      EXPECT_EQ(0u, partitioned->RegionOfModel("resting"));
+      EXPECT_EQ(1u, partitioned->MirrorCount());
+
+      ASSERT_EQ(2u, partitioned->ModelPoses().size());
+      for (const auto &pose : partitioned->ModelPoses())
+      {
+        EXPECT_EQ(partitioned->RegionOfModel(pose.name), pose.region);
+        EXPECT_TRUE(referencePose(pose.name).isApprox(pose.pose, 1e-6))
+            << pose.name << ":\n" << referencePose(pose.name).matrix()
+            << "\n" << pose.pose.matrix();
+      }
+
+      // The contacts of the mirror of the resting box are left out
+      EXPECT_EQ(referenceContacts, partitioned->Contacts().size());
+      for (const auto &contact : partitioned->Contacts())
+      {
+        EXPECT_EQ(0u, contact.region);
+        EXPECT_TRUE(contact.model1 == "resting" || contact.model2 == "resting");
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PartitionedWorldTest, MatchesSingleWorldWithContacts)
+{
+  constexpr std::size_t kSteps = 1000;
+
+  sdf::Root contactRoot;
+  const sdf::Errors errors =
+      contactRoot.Load(common_test::worlds::kPartitionedContactsSdf);
+  ASSERT_TRUE(errors.empty()) << errors;
+  const sdf::World &sdfWorld = *contactRoot.WorldByIndex(0);
+
+  // The sliding box crosses the boundary on the ground, and the left and
+  // right boxes, which start in different regions, collide in the overlap
+  // zone
+  const std::vector<std::pair<std::string, Eigen::Vector3d>> velocities = {
+      {"sliding", Eigen::Vector3d(6, 0, 0)},
+      {"left", Eigen::Vector3d(3, 0, 0)},
+      {"right", Eigen::Vector3d(-3, 0, 0)}};
+
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+
+    // Reference simulation of the whole world by a single engine
+    auto reference = this->Engine(name)->ConstructWorld(sdfWorld);
+    ASSERT_NE(nullptr, reference);
+    for (const auto &[model, velocity] : velocities)
+    {
+      reference->GetModel(model)->FindFreeGroup()->SetWorldLinearVelocity(
+          velocity);
+    }
+
+    gz::physics::ForwardStep::Input input;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Output output;
+    for (std::size_t i = 0; i < kSteps; ++i)
+      reference->Step(output, state, input);
+
+    const auto referencePose = [&](const std::string &_model)
+    {
+      return reference->GetModel(_model)->FindFreeGroup()->RootLink()
+          ->FrameDataRelativeToWorld().pose;
+    };
+    const std::size_t referenceContacts =
+        reference->GetContactsFromLastStep().size();
+
+    // The sliding box ends beyond the overlap zone of the first region, and
+    // the colliding boxes stop against each other close to the boundary
+    ASSERT_LT(2.0, referencePose("sliding").translation().x());
+    const double left = referencePose("left").translation().x();
+    const double right = referencePose("right").translation().x();
+    ASSERT_LT(-1.0, left);
+    ASSERT_GT(1.0, right);
+    ASSERT_NEAR(0.5, right - left, 1e-2);
+
+    for (const bool threaded : {true, false})
+    {
+      auto partitioned =
+          gz::physics::sdf::PartitionedWorld<Features>::Construct(
+              {this->Engine(name), this->Engine(name)}, sdfWorld,
+              kPartition, threaded);
+      ASSERT_NE(nullptr, partitioned);
+      for (const auto &[model, velocity] : velocities)
+      {
+        const std::size_t region = partitioned->RegionOfModel(model);
+        partitioned->RegionWorld(region)->GetModel(model)->FindFreeGroup()
+            ->SetWorldLinearVelocity(velocity);
+      }
+
+      for (std::size_t i = 0; i < kSteps; ++i)
+        partitioned->Step(input);
+
+      EXPECT_EQ(1u, partitioned->RegionOfModel("sliding"));
+      EXPECT_EQ(0u, partitioned->RegionOfModel("left"));
+      EXPECT_EQ(1u, partitioned->RegionOfModel("right"));
+
+      // The colliding boxes are mirrored in each other's region
+      EXPECT_EQ(2u, partitioned->MirrorCount());
+
+      ASSERT_EQ(3u, partitioned->ModelPoses().size());
+      for (const auto &pose : partitioned->ModelPoses())
+      {
+        EXPECT_EQ(partitioned->RegionOfModel(pose.name), pose.region);
+        EXPECT_TRUE(referencePose(pose.name).isApprox(pose.pose, 1e-6))
+            << pose.name << ":\n" << referencePose(pose.name).matrix()
+            << "\n" << pose.pose.matrix();
+      }
+
+      // Contacts with mirrors are only reported by the region that owns the
+      // other model, and the contact between the colliding boxes only once
+      EXPECT_EQ(referenceContacts, partitioned->Contacts().size());
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  if (!PartitionedWorldTest::init(argc, argv))
+    return -1;
+  return RUN_ALL_TESTS();
+}
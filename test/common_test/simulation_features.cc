@@ -18,6 +18,7 @@
 
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <gz/common/Console.hh>
@@ -38,6 +39,7 @@
 #include "gz/physics/BoxShape.hh"
 #include <gz/physics/GetContacts.hh>
 #include "gz/physics/ContactProperties.hh"
+#include <gz/physics/ContinuousCollision.hh>
 #include "gz/physics/CylinderShape.hh"
 #include "gz/physics/CapsuleShape.hh"
 #include "gz/physics/EllipsoidShape.hh"
@@ -49,6 +51,8 @@
 #include <gz/physics/FindFeatures.hh>
 #include <gz/physics/ForwardStep.hh>
 #include <gz/physics/GetEntities.hh>
+#include <gz/physics/PoseStream.hh>
+#include <gz/physics/StateRecording.hh>
 #include <gz/physics/RequestEngine.hh>
 #include <gz/physics/World.hh>
 
@@ -309,6 +313,61 @@ TYPED_TEST(SimulationFeaturesStepTest, StepWorld)
   }
 }
 
+/////////////////////////////////////////////////
+TYPED_TEST(SimulationFeaturesStepTest, PoseStream)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    CHECK_UNSUPPORTED_ENGINE(name, "bullet", "tpe")
+
+    auto world = LoadPluginAndWorld<FeaturesStep>(
+      this->loader,
+      name,
+      common_test::worlds::kFallingWorld);
+
+    gz::physics::ForwardStep::Input input;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Output output;
+
+    // The engine only encodes the stream if it is part of the output
+    output.Get<gz::physics::ChangedWorldPosesStream>();
+
+    gz::physics::PoseStreamDecoder decoder;
+    std::vector<gz::physics::WorldPose> decoded;
+    std::unordered_map<std::size_t, gz::math::Pose3d> streamPoses;
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+      output.ResetQueries();
+      world->Step(output, state, input);
+
+      const auto &stream = output.Get<gz::physics::ChangedWorldPosesStream>();
+      ASSERT_TRUE(decoder.Decode(stream.frame, decoded));
+      if (i == 0)
+        EXPECT_FALSE(decoded.empty());
+
+      for (const auto &wp : decoded)
+        streamPoses[wp.body] = wp.pose;
+
+      // Every link pose reconstructed from the stream matches the pose that
+      // the engine reports, up to the quantization of the stream.
+      const auto &worldPoses = output.Get<gz::physics::WorldPoses>();
+      ASSERT_EQ(worldPoses.entries.size(), streamPoses.size());
+      for (const auto &wp : worldPoses.entries)
+      {
+        const auto it = streamPoses.find(wp.body);
+        ASSERT_NE(streamPoses.end(), it);
+        EXPECT_NEAR(0.0, wp.pose.Pos().Distance(it->second.Pos()), 1e-4);
+
+        const auto &q1 = wp.pose.Rot();
+        const auto &q2 = it->second.Rot();
+        const double dot = q1.W() * q2.W() + q1.X() * q2.X() +
+                           q1.Y() * q2.Y() + q1.Z() * q2.Z();
+        EXPECT_NEAR(1.0, std::abs(dot), 1e-6);
+      }
+    }
+  }
+}
+
 // The features that an engine must have to be loaded by this loader.
 struct FeaturesFalling : public  gz::physics::FeatureList<
   gz::physics::sdf::ConstructSdfWorld,
@@ -360,6 +419,168 @@ TYPED_TEST(SimulationFeaturesFallingTest, Falling)
   }
 }
 
+// The features that an engine must have to be loaded by this loader.
+struct FeaturesContactWrench : gz::physics::FeatureList<
+  gz::physics::sdf::ConstructSdfWorld,
+  gz::physics::ForwardStep,
+  gz::physics::GetModelFromWorld,
+  gz::physics::GetLinkFromModel,
+  gz::physics::GetShapeFromLink,
+  gz::physics::GetContactsFromLastStepFeature,
+  gz::physics::GetLinkContactWrenchFromLastStepFeature
+> {};
+
+template <class T>
+class SimulationFeaturesContactWrenchTest :
+  public SimulationFeaturesTest<T>{};
+using SimulationFeaturesContactWrenchTestTypes =
+  ::testing::Types<FeaturesContactWrench>;
+TYPED_TEST_SUITE(SimulationFeaturesContactWrenchTest,
+                 SimulationFeaturesContactWrenchTestTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(SimulationFeaturesContactWrenchTest, RestingSphere)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    auto world = LoadPluginAndWorld<FeaturesContactWrench>(
+        this->loader, name,
+        common_test::worlds::kFallingWorld);
+
+    // Let the sphere fall and come to rest on the box
+    StepWorld<FeaturesContactWrench>(world, true, 1000);
+
+    const auto link = world->GetModel("sphere")->GetLink("sphere_link");
+    ASSERT_NE(nullptr, link);
+    const auto collision = link->GetShape(0);
+    ASSERT_NE(nullptr, collision);
+
+    // The contacts hold the 1 kg sphere up against gravity
+    const auto wrench = link->GetContactWrenchFromLastStep();
+    EXPECT_NEAR(0.0, wrench.force.x(), 1e-1);
+    EXPECT_NEAR(0.0, wrench.force.y(), 1e-1);
+    EXPECT_NEAR(9.8, wrench.force.z(), 5e-1);
+
+    // The contact point is right below the center of the sphere
+    EXPECT_NEAR(0.0, wrench.torque.norm(), 1e-1);
+
+    // The individual contact forces add up to the same force
+    Eigen::Vector3d force = Eigen::Vector3d::Zero();
+    using World = gz::physics::World3d<FeaturesContactWrench>;
+    for (auto &contact : world->GetContactsFromLastStep())
+    {
+      const auto &contactPoint =
+          contact.template Get<World::ContactPoint>();
+      const auto *extra =
+          contact.template Query<World::ExtraContactData>();
+      ASSERT_NE(nullptr, extra);
+      if (contactPoint.collision1 == collision)
+        force += extra->force;
+      else if (contactPoint.collision2 == collision)
+        force -= extra->force;
+    }
+    EXPECT_TRUE(force.isApprox(wrench.force, 1e-6));
+
+    // The box pushes the sphere up, so it is pushed down
+    const auto box = world->GetModel("box")->GetLink("box_link");
+    ASSERT_NE(nullptr, box);
+    EXPECT_NEAR(-9.8, box->GetContactWrenchFromLastStep().force.z(), 5e-1);
+  }
+}
+
+// The features that an engine must have to be loaded by this loader.
+struct FeaturesStateRecording : gz::physics::FeatureList<
+  gz::physics::sdf::ConstructSdfWorld,
+  gz::physics::ForwardStep,
+  gz::physics::RecordWorldState,
+  gz::physics::ReplayWorldState
+> {};
+
+template <class T>
+class SimulationFeaturesStateRecordingTest :
+  public SimulationFeaturesTest<T>{};
+using SimulationFeaturesStateRecordingTestTypes =
+  ::testing::Types<FeaturesStateRecording>;
+TYPED_TEST_SUITE(SimulationFeaturesStateRecordingTest,
+                 SimulationFeaturesStateRecordingTestTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(SimulationFeaturesStateRecordingTest, RecordAndReplay)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    CHECK_UNSUPPORTED_ENGINE(name, "bullet", "tpe")
+
+    const std::string logPath =
+        testing::TempDir() + "simulation_features_state.log";
+    const std::size_t steps = 200;
+
+    // Each plugin instance numbers its entities from scratch, so both worlds
+    // get the same entity IDs.
+    auto world = LoadPluginAndWorld<FeaturesStateRecording>(
+        this->loader, name, common_test::worlds::kFallingWorld);
+    gz::physics::StateLogOptions options;
+    options.keyFrameInterval = 50;
+    ASSERT_TRUE(world->StartStateRecording(logPath, options));
+
+    gz::physics::ForwardStep::Input input;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Output output;
+    std::vector<std::vector<gz::physics::WorldPose>> recorded;
+    for (std::size_t i = 0; i < steps; ++i)
+    {
+      output.ResetQueries();
+      world->Step(output, state, input);
+      recorded.push_back(
+          output.Get<gz::physics::WorldPoses>().entries);
+    }
+    EXPECT_TRUE(world->StopStateRecording());
+    EXPECT_FALSE(world->StopStateRecording());
+
+    auto playback = LoadPluginAndWorld<FeaturesStateRecording>(
+        this->loader, name, common_test::worlds::kFallingWorld);
+    EXPECT_FALSE(playback->LoadStateLog(logPath + ".missing"));
+    EXPECT_EQ(0u, playback->GetStateLogStepCount());
+    ASSERT_TRUE(playback->LoadStateLog(logPath));
+    ASSERT_EQ(steps, playback->GetStateLogStepCount());
+
+    auto expectPosesEqual = [](
+        const std::vector<gz::physics::WorldPose> &_expected,
+        const std::vector<gz::physics::WorldPose> &_actual)
+    {
+      ASSERT_EQ(_expected.size(), _actual.size());
+      for (const auto &expected : _expected)
+      {
+        const auto it = std::find_if(_actual.begin(), _actual.end(),
+            [&](const auto &_wp) { return _wp.body == expected.body; });
+        ASSERT_NE(_actual.end(), it);
+        EXPECT_TRUE(expected.pose.Pos().Equal(it->pose.Pos(), 1e-6));
+        EXPECT_TRUE(expected.pose.Rot().Equal(it->pose.Rot(), 1e-6));
+      }
+    };
+
+    // Stepping the playback world plays the log back, one step at a time
+    for (std::size_t i = 0; i < steps; ++i)
+    {
+      output.ResetQueries();
+      playback->Step(output, state, input);
+      expectPosesEqual(recorded[i],
+                       output.Get<gz::physics::WorldPoses>().entries);
+    }
+
+    // Seeking backwards rebuilds the state from the previous key frame
+    EXPECT_FALSE(playback->SeekStateLog(steps));
+    ASSERT_TRUE(playback->SeekStateLog(119));
+    output.ResetQueries();
+    playback->Step(output, state, input);
+    expectPosesEqual(recorded[120],
+                     output.Get<gz::physics::WorldPoses>().entries);
+
+    playback->UnloadStateLog();
+    EXPECT_EQ(0u, playback->GetStateLogStepCount());
+  }
+}
+
 
 // The features that an engine must have to be loaded by this loader.
 struct FeaturesShapeFeatures : gz::physics::FeatureList<
@@ -1233,6 +1454,74 @@ TYPED_TEST(SimulationFeaturesTestBasic, MultipleCollisions)
   }
 }
 
+// The features that an engine must have to be loaded by this loader.
+struct FeaturesContinuousCollision : gz::physics::FeatureList<
+  gz::physics::sdf::ConstructSdfWorld,
+  gz::physics::ForwardStep,
+  gz::physics::GetModelFromWorld,
+  gz::physics::GetLinkFromModel,
+  gz::physics::LinkFrameSemantics,
+  gz::physics::FindFreeGroupFeature,
+  gz::physics::SetFreeGroupWorldVelocity,
+  gz::physics::ContinuousCollisionFeature
+> {};
+
+template <class T>
+class SimulationFeaturesContinuousCollisionTest :
+  public SimulationFeaturesTest<T>{};
+using SimulationFeaturesContinuousCollisionTestTypes =
+  ::testing::Types<FeaturesContinuousCollision>;
+TYPED_TEST_SUITE(SimulationFeaturesContinuousCollisionTest,
+                 SimulationFeaturesContinuousCollisionTestTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(SimulationFeaturesContinuousCollisionTest, ThinWall)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    // The ball moves 0.3 m per step, more than the wall and the ball are
+    // thick together
+    for (const bool sweep : {false, true})
+    {
+      auto world = LoadPluginAndWorld<FeaturesContinuousCollision>(
+        this->loader,
+        name,
+        common_test::worlds::kThinWallSdf);
+      auto ball = world->GetModel("ball");
+      auto link = ball->GetLink(0);
+
+      gz::physics::ContinuousCollisionParameters parameters;
+      parameters.enabled = sweep;
+      parameters.motionThreshold = 0.01;
+      parameters.sweptSphereRadius = 0.04;
+      ASSERT_TRUE(link->SetContinuousCollision(parameters));
+      EXPECT_EQ(sweep, link->GetContinuousCollision().enabled);
+
+      ball->FindFreeGroup()->SetWorldLinearVelocity(
+          Eigen::Vector3d(300, 0, 0));
+      StepWorld<FeaturesContinuousCollision>(world, false, 20);
+
+      const double x =
+          link->FrameDataRelativeToWorld().pose.translation().x();
+      if (sweep)
+        EXPECT_GT(1.0, x);
+      else
+        EXPECT_LT(1.0, x);
+    }
+
+    // Links that hang from a joint are moved by it
+    auto world = LoadPluginAndWorld<FeaturesContinuousCollision>(
+      this->loader,
+      name,
+      common_test::worlds::kThinWallSdf);
+    gz::physics::ContinuousCollisionParameters parameters;
+    parameters.enabled = true;
+    parameters.sweptSphereRadius = 0.04;
+    EXPECT_FALSE(world->GetModel("arm")->GetLink("tip_link")
+        ->SetContinuousCollision(parameters));
+  }
+}
+
 int main(int argc, char *argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
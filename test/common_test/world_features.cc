@@ -16,6 +16,10 @@
 */
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <gz/plugin/Loader.hh>
 
@@ -27,6 +31,7 @@
 #include <gz/physics/FindFeatures.hh>
 #include <gz/physics/ForwardStep.hh>
 #include <gz/physics/FrameSemantics.hh>
+#include <gz/physics/GetBoundingBox.hh>
 #include <gz/physics/GetEntities.hh>
 #include <gz/physics/RemoveEntities.hh>
 #include <gz/physics/RequestEngine.hh>
@@ -38,6 +43,7 @@
 #include <gz/physics/sdf/ConstructNestedModel.hh>
 #include <gz/physics/sdf/ConstructWorld.hh>
 
+#include <sdf/Model.hh>
 #include <sdf/Root.hh>
 
 using AssertVectorApprox = gz::physics::test::AssertVectorApprox;
@@ -457,6 +463,237 @@ TEST_F(WorldNestedModelTest, WorldConstructNestedModel)
   }
 }
 
+struct WorldBoundingBoxFeatureList : gz::physics::FeatureList<
+  gz::physics::sdf::ConstructSdfWorld,
+  gz::physics::sdf::ConstructSdfModel,
+  gz::physics::GetModelFromWorld,
+  gz::physics::GetLinkFromModel,
+  gz::physics::GetWorldEntityBoundingBoxes
+> { };
+
+using WorldFeaturesTestBoundingBoxes =
+  WorldFeaturesTest<WorldBoundingBoxFeatureList>;
+
+/////////////////////////////////////////////////
+TEST_F(WorldFeaturesTestBoundingBoxes, ModelAndLinkBoundingBoxes)
+{
+  const std::string modelStr = R"(
+    <sdf version="1.11">
+      <model name="box">
+        <link name="link">
+          <collision name="coll_box">
+            <geometry>
+              <box>
+                <size>2 1 1</size>
+              </box>
+            </geometry>
+          </collision>
+        </link>
+      </model>
+    </sdf>)";
+
+  // The second box is rotated by 90 degrees about z, which swaps the x and y
+  // extents of its world bounding box.
+  const std::vector<gz::math::Pose3d> poses = {
+    gz::math::Pose3d(0, 0, 3, 0, 0, 0),
+    gz::math::Pose3d(5, 1, 2, 0, 0, GZ_PI_2)};
+  const std::vector<Eigen::AlignedBox3d> expectedBoxes = {
+    Eigen::AlignedBox3d(
+        Eigen::Vector3d(-1, -0.5, 2.5), Eigen::Vector3d(1, 0.5, 3.5)),
+    Eigen::AlignedBox3d(
+        Eigen::Vector3d(4.5, 0, 1.5), Eigen::Vector3d(5.5, 2, 2.5))};
+
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = this->loader.Instantiate(name);
+
+    auto engine =
+      gz::physics::RequestEngine3d<WorldBoundingBoxFeatureList>::From(plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    sdf::Errors errors = root.Load(common_test::worlds::kEmptySdf);
+    ASSERT_TRUE(errors.empty()) << errors;
+    auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+    ASSERT_NE(nullptr, world);
+
+    std::vector<std::size_t> modelIds;
+    std::vector<std::size_t> linkIds;
+    for (std::size_t i = 0; i < poses.size(); ++i)
+    {
+      errors = root.LoadSdfString(modelStr);
+      ASSERT_TRUE(errors.empty()) << errors;
+      sdf::Model sdfModel = *root.Model();
+      sdfModel.SetName("box" + std::to_string(i));
+      sdfModel.SetRawPose(poses[i]);
+      auto model = world->ConstructModel(sdfModel);
+      ASSERT_NE(nullptr, model);
+      modelIds.push_back(model->EntityID());
+
+      auto link = model->GetLink("link");
+      ASSERT_NE(nullptr, link);
+      linkIds.push_back(link->EntityID());
+    }
+
+    // Engines may pad the boxes with a collision margin
+    const double tol = 0.1;
+    auto checkBoxes = [&](const std::vector<std::size_t> &_expectedIds,
+                          const std::vector<std::size_t> &_ids,
+                          const std::vector<Eigen::AlignedBox3d> &_boxes)
+    {
+      ASSERT_EQ(_ids.size(), _boxes.size());
+      for (std::size_t i = 0; i < _expectedIds.size(); ++i)
+      {
+        auto it = std::find(_ids.begin(), _ids.end(), _expectedIds[i]);
+        ASSERT_NE(_ids.end(), it);
+        const auto &box = _boxes[static_cast<std::size_t>(it - _ids.begin())];
+        EXPECT_TRUE(box.contains(expectedBoxes[i]));
+        EXPECT_GT(tol, (box.min() - expectedBoxes[i].min()).norm());
+        EXPECT_GT(tol, (box.max() - expectedBoxes[i].max()).norm());
+      }
+    };
+
+    std::vector<std::size_t> ids;
+    std::vector<Eigen::AlignedBox3d> boxes;
+    world->GetModelAxisAlignedBoundingBoxes(ids, boxes);
+    checkBoxes(modelIds, ids, boxes);
+
+    world->GetLinkAxisAlignedBoundingBoxes(ids, boxes);
+    checkBoxes(linkIds, ids, boxes);
+  }
+}
+
+struct WorldMemoryUsageFeatureList : gz::physics::FeatureList<
+  gz::physics::sdf::ConstructSdfWorld,
+  gz::physics::ForwardStep,
+  gz::physics::GetWorldMemoryUsage
+> { };
+
+using WorldFeaturesTestMemoryUsage =
+  WorldFeaturesTest<WorldMemoryUsageFeatureList>;
+
+/////////////////////////////////////////////////
+TEST_F(WorldFeaturesTestMemoryUsage, MemoryUsage)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = this->loader.Instantiate(name);
+
+    auto engine =
+      gz::physics::RequestEngine3d<WorldMemoryUsageFeatureList>::From(plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    sdf::Errors errors = root.Load(common_test::worlds::kEmptySdf);
+    ASSERT_TRUE(errors.empty()) << errors;
+    auto emptyWorld = engine->ConstructWorld(*root.WorldByIndex(0));
+    ASSERT_NE(nullptr, emptyWorld);
+
+    errors = root.Load(common_test::worlds::kShapesWorld);
+    ASSERT_TRUE(errors.empty()) << errors;
+    auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+    ASSERT_NE(nullptr, world);
+
+    const auto empty = emptyWorld->GetMemoryUsage();
+    EXPECT_EQ(0u, empty.collisionGeometry);
+    EXPECT_EQ(0u, empty.articulatedBodies);
+
+    const auto loaded = world->GetMemoryUsage();
+    EXPECT_LT(0u, loaded.collisionGeometry);
+    EXPECT_LT(0u, loaded.articulatedBodies);
+    EXPECT_LT(empty.entityBookkeeping, loaded.entityBookkeeping);
+    EXPECT_EQ(loaded.collisionGeometry + loaded.articulatedBodies +
+              loaded.entityBookkeeping + loaded.contactCaches,
+              loaded.Total());
+
+    // Stepping only changes the contact caches
+    gz::physics::ForwardStep::Output output;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Input input;
+    for (std::size_t i = 0; i < 10; ++i)
+      world->Step(output, state, input);
+
+    const auto stepped = world->GetMemoryUsage();
+    EXPECT_EQ(loaded.collisionGeometry, stepped.collisionGeometry);
+    EXPECT_EQ(loaded.articulatedBodies, stepped.articulatedBodies);
+    EXPECT_EQ(loaded.entityBookkeeping, stepped.entityBookkeeping);
+
+    // A handful of primitive shapes use well under a megabyte
+    EXPECT_GT(1024u * 1024u, stepped.Total());
+
+    // Stepping one world does not change the other
+    EXPECT_EQ(empty.Total(), emptyWorld->GetMemoryUsage().Total());
+  }
+}
+
+struct SolverIterationsFeatureList : gz::physics::FeatureList<
+  gz::physics::sdf::ConstructSdfWorld,
+  gz::physics::ForwardStep,
+  gz::physics::SolverIterations
+> { };
+
+using WorldFeaturesTestSolverIterations =
+  WorldFeaturesTest<SolverIterationsFeatureList>;
+
+/////////////////////////////////////////////////
+TEST_F(WorldFeaturesTestSolverIterations, SolverIterations)
+{
+  for (const std::string &name : this->pluginNames)
+  {
+    std::cout << "Testing plugin: " << name << std::endl;
+    gz::plugin::PluginPtr plugin = this->loader.Instantiate(name);
+
+    auto engine = gz::physics::RequestEngine3d<
+        SolverIterationsFeatureList>::From(plugin);
+    ASSERT_NE(nullptr, engine);
+
+    sdf::Root root;
+    const sdf::Errors errors = root.Load(common_test::worlds::kContactSdf);
+    ASSERT_TRUE(errors.empty()) << errors;
+    auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+    ASSERT_NE(nullptr, world);
+
+    gz::physics::SolverIterationParameters parameters;
+    parameters.minIterations = 3;
+    parameters.maxIterations = 2;
+    EXPECT_FALSE(world->SetSolverIterations(parameters));
+    parameters.maxIterations = 10;
+    parameters.residualTolerance = -1.0;
+    EXPECT_FALSE(world->SetSolverIterations(parameters));
+
+    parameters.residualTolerance = 0.0;
+    ASSERT_TRUE(world->SetSolverIterations(parameters));
+    const auto applied = world->GetSolverIterations();
+    EXPECT_EQ(3u, applied.minIterations);
+    EXPECT_EQ(10u, applied.maxIterations);
+    EXPECT_DOUBLE_EQ(0.0, applied.residualTolerance);
+
+    gz::physics::ForwardStep::Output output;
+    gz::physics::ForwardStep::State state;
+    gz::physics::ForwardStep::Input input;
+    output.Get<gz::physics::SolverStatistics>();
+    for (std::size_t i = 0; i < 100; ++i)
+      world->Step(output, state, input);
+
+    const auto statistics = output.Get<gz::physics::SolverStatistics>();
+    if (this->PhysicsEngineName(name) == "dartsim")
+    {
+      // The default Dantzig solver of dartsim does not iterate. The iterative
+      // PGS solver is covered by the dartsim unit tests.
+      EXPECT_EQ(0u, statistics.iterations);
+    }
+    else
+    {
+      // Without a tolerance, iterative solvers run their iteration limit
+      // while the overlapping spheres are in contact
+      EXPECT_LT(0u, statistics.solves);
+      EXPECT_EQ(10u, statistics.iterations);
+    }
+  }
+}
+
 int main(int argc, char *argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
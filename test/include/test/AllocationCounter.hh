@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_TEST_ALLOCATIONCOUNTER_HH_
+#define GZ_PHYSICS_TEST_ALLOCATIONCOUNTER_HH_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// This header replaces the global operator new and operator delete of the
+// executable that includes it, so it must be included by exactly one
+// translation unit of a test executable.
+//
+// Only the allocations of the thread that owns an AllocationCounter are
+// counted, so that background threads of the test framework or of the
+// physics engines do not make the counts flaky. Over-aligned allocations
+// and allocations that do not go through operator new, e.g. malloc or the
+// aligned allocators of Eigen and Bullet, are not counted.
+
+namespace gz::physics::test
+{
+class AllocationCounter;
+
+namespace detail
+{
+/// \brief Innermost active AllocationCounter of the current thread
+inline thread_local AllocationCounter *tlActiveCounter = nullptr;
+
+/// \brief Count an allocation in every active counter of this thread
+inline void RecordAllocation(std::size_t _bytes);
+}
+
+/////////////////////////////////////////////////
+/// \brief AllocationCounter counts the calls to operator new that the
+/// current thread makes while the counter is alive. Counters can be nested,
+/// in which case an allocation is counted by all of them.
+///
+/// Example:
+/// \code
+///   gz::physics::test::AllocationCounter counter;
+///   world->Step(output, state, input);
+///   EXPECT_EQ(0u, counter.Count());
+/// \endcode
+class AllocationCounter
+{
+  /// \brief Constructor. Starts counting.
+  public: AllocationCounter()
+    : previous(detail::tlActiveCounter)
+  {
+    detail::tlActiveCounter = this;
+  }
+
+  /// \brief Destructor. Stops counting.
+  public: ~AllocationCounter()
+  {
+    detail::tlActiveCounter = this->previous;
+  }
+
+  /// \brief Counters are bound to a scope
+  public: AllocationCounter(const AllocationCounter &) = delete;
+
+  /// \brief Counters are bound to a scope
+  public: AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+  /// \brief Get the number of allocations since the counter was created or
+  /// reset.
+  /// \return Number of allocations.
+  public: std::size_t Count() const
+  {
+    return this->count;
+  }
+
+  /// \brief Get the number of bytes allocated since the counter was created
+  /// or reset.
+  /// \return Number of bytes.
+  public: std::size_t Bytes() const
+  {
+    return this->bytes;
+  }
+
+  /// \brief Restart counting from zero
+  public: void Reset()
+  {
+    this->count = 0;
+    this->bytes = 0;
+  }
+
+  /// \brief Counter that was active when this one was created
+  private: AllocationCounter *previous;
+
+  /// \brief Number of allocations
+  private: std::size_t count = 0;
+
+  /// \brief Number of bytes allocated
+  private: std::size_t bytes = 0;
+
+  friend void detail::RecordAllocation(std::size_t _bytes);
+};
+
+/////////////////////////////////////////////////
+inline void detail::RecordAllocation(const std::size_t _bytes)
+{
+  for (AllocationCounter *counter = tlActiveCounter; counter;
+       counter = counter->previous)
+  {
+    ++counter->count;
+    counter->bytes += _bytes;
+  }
+}
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  gz::physics::test::detail::RecordAllocation(_size);
+  void *p = std::malloc(_size == 0 ? 1 : _size);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size)
+{
+  return ::operator new(_size);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_p) noexcept
+{
+  std::free(_p);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_p) noexcept
+{
+  std::free(_p);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_p, std::size_t) noexcept
+{
+  std::free(_p);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_p, std::size_t) noexcept
+{
+  std::free(_p);
+}
+
+#endif
@@ -110,3 +110,68 @@ TEST(RequestFeatures_TEST, Casting)
       unavailableFeatureModel);
   EXPECT_FALSE(invalidModel);
 }
+
+TEST(RequestFeatures_TEST, CachedCasting)
+{
+  using InitialFeatures =
+    gz::physics::FeatureList<
+      mock::MockGetByName>;
+
+  using ExtendFeatures =
+    gz::physics::FeatureList<
+      InitialFeatures,
+      mock::MockSetName>;
+
+  gz::plugin::Loader loader;
+  loader.LoadLib(MockEntities_LIB);
+
+  // Two instances of the same plugin must never share a cached cast
+  auto plugin1 = loader.Instantiate("mock::EntitiesPlugin3d");
+  auto plugin2 = loader.Instantiate("mock::EntitiesPlugin3d");
+  ASSERT_TRUE(plugin1);
+  ASSERT_TRUE(plugin2);
+
+  auto engine1 =
+      gz::physics::RequestEngine3d<InitialFeatures>::From(plugin1);
+  auto engine2 =
+      gz::physics::RequestEngine3d<InitialFeatures>::From(plugin2);
+  ASSERT_TRUE(engine1);
+  ASSERT_TRUE(engine2);
+
+  auto world1 = engine1->GetWorld("Some world");
+  auto world2 = engine2->GetWorld("Some world");
+  ASSERT_TRUE(world1);
+  ASSERT_TRUE(world2);
+
+  auto extendWorld1 =
+      gz::physics::RequestFeatures<ExtendFeatures>::From(world1);
+  auto extendWorld2 =
+      gz::physics::RequestFeatures<ExtendFeatures>::From(world2);
+  ASSERT_TRUE(extendWorld1);
+  ASSERT_TRUE(extendWorld2);
+
+  extendWorld1->SetName("World 1");
+  extendWorld2->SetName("World 2");
+  EXPECT_EQ("World 1", world1->Name());
+  EXPECT_EQ("World 2", world2->Name());
+
+  // Casting again reuses the cached cast of the same plugin instance
+  auto extendModel1 =
+      gz::physics::RequestFeatures<ExtendFeatures>::From(
+        world1->GetModel("First model"));
+  ASSERT_TRUE(extendModel1);
+  extendModel1->SetName("Model 1");
+  EXPECT_EQ("Model 1", extendModel1->Name());
+  EXPECT_NE("Model 1", world2->GetModel("First model")->Name());
+
+  // The cast still works after every earlier cast has been released
+  extendWorld1 = nullptr;
+  extendWorld2 = nullptr;
+  extendModel1 = nullptr;
+  auto extendWorld3 =
+      gz::physics::RequestFeatures<ExtendFeatures>::From(world2);
+  ASSERT_TRUE(extendWorld3);
+  extendWorld3->SetName("World 3");
+  EXPECT_EQ("World 3", world2->Name());
+  EXPECT_EQ("World 1", world1->Name());
+}
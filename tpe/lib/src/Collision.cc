@@ -103,6 +103,17 @@ void Collision::SetShape(const Shape &_shape)
     const MeshShape *typedShape = dynamic_cast<const MeshShape *>(&_shape);
     this->dataPtr->shape.reset(new MeshShape(*typedShape));
   }
+  else if (_shape.GetType() == ShapeType::HEIGHTMAP)
+  {
+    const HeightmapShape *typedShape =
+      dynamic_cast<const HeightmapShape *>(&_shape);
+    if (!typedShape)
+    {
+      gzwarn << "Failed to set shape." << std::endl;
+      return;
+    }
+    this->dataPtr->shape.reset(new HeightmapShape(*typedShape));
+  }
   else
   {
     gzwarn << "Failed to set shape." << std::endl;
@@ -15,8 +15,10 @@
  *
 */
 
+#include <memory_resource>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include <gz/common/Profiler.hh>
 
@@ -25,6 +27,12 @@
 
 #include "AABBTree.hh"
 
+/// \brief Pairs of node ids that collided during one collision detection
+/// iteration. The key and value are:
+///   std::unorderd_map<node_a_id, std::unordered_map<node_b_id, collided>
+using CollisionStateMap = std::pmr::unordered_map<std::size_t,
+    std::pmr::unordered_map<std::size_t, bool>>;
+
 /// \brief Private data class for CollisionDetector
 class gz::physics::tpelib::CollisionDetectorPrivate
 {
@@ -32,8 +40,10 @@ class gz::physics::tpelib::CollisionDetectorPrivate
   /// already been recorded or not
   /// \param[in] _a Node A Id
   /// \param[in] _b Node B Id
+  /// \param[in,out] _collisionStateMap Pairs of node ids that collided
   /// \return True if this is a duplicate collision
-  public: bool CheckDuplicateCollisionPair(std::size_t _a, std::size_t _b);
+  public: bool CheckDuplicateCollisionPair(std::size_t _a, std::size_t _b,
+      CollisionStateMap &_collisionStateMap);
 
   /// \brief AABB tree
   public: AABBTree aabbTree;
@@ -41,11 +51,13 @@ class gz::physics::tpelib::CollisionDetectorPrivate
   /// \brief Set of entity id
   public: std::set<std::size_t> nodeIds;
 
-  /// \brief Keep track of pairs of node ids that collided. The map is cleared
-  /// after each collision detection iteration. The key and value are:
-  ///   std::unorderd_map<node_a_id, std::unordered_map<node_b_id, collided>
-  public: std::unordered_map<std::size_t, std::unordered_map<std::size_t, bool>>
-    collisionStateMap;
+  /// \brief Memory resource of the temporary containers of CheckCollisions
+  public: std::pmr::memory_resource *scratch =
+      std::pmr::get_default_resource();
+
+  /// \brief Intersection points of a pair of nodes. It is kept between
+  /// calls so that its capacity is reused.
+  public: std::vector<math::Vector3d> points;
 };
 
 using namespace gz;
@@ -66,20 +78,35 @@ std::vector<Contact> CollisionDetector::CheckCollisions(
     const std::map<std::size_t, std::shared_ptr<Entity>> &_entities,
     bool _singleContact)
 {
-  GZ_PROFILE("tpelib::CollisionDetector::CheckCollisions");
-
   // contacts to be filled and returned
   std::vector<Contact> contacts;
+  this->CheckCollisions(_entities, contacts, _singleContact);
+  return contacts;
+}
+
+//////////////////////////////////////////////////
+void CollisionDetector::CheckCollisions(
+    const std::map<std::size_t, std::shared_ptr<Entity>> &_entities,
+    std::vector<Contact> &_contacts,
+    bool _singleContact)
+{
+  GZ_PROFILE("tpelib::CollisionDetector::CheckCollisions");
+
+  _contacts.clear();
 
   // update AABB tree
   // remove nodes that no longer exist
-  auto nodesToCheckForRemoval = this->dataPtr->nodeIds;
-  for (auto id : nodesToCheckForRemoval)
+  for (auto idIt = this->dataPtr->nodeIds.begin();
+       idIt != this->dataPtr->nodeIds.end();)
   {
-    if (_entities.find(id) == _entities.end())
+    if (_entities.find(*idIt) == _entities.end())
+    {
+      this->dataPtr->aabbTree.RemoveNode(*idIt);
+      idIt = this->dataPtr->nodeIds.erase(idIt);
+    }
+    else
     {
-      this->dataPtr->aabbTree.RemoveNode(id);
-      this->dataPtr->nodeIds.erase(id);
+      ++idIt;
     }
   }
 
@@ -119,6 +146,10 @@ std::vector<Contact> CollisionDetector::CheckCollisions(
     }
   }
 
+  // keep track of pairs of node ids that collided
+  CollisionStateMap collisionStateMap(this->dataPtr->scratch);
+  auto &points = this->dataPtr->points;
+
   // query AABB tree for collisions
   for (auto it = _entities.begin(); it != _entities.end(); ++it)
   {
@@ -145,7 +176,8 @@ std::vector<Contact> CollisionDetector::CheckCollisions(
     for (const auto &nId : result)
     {
       // skip if we have already checked collision for this pair of nodes
-      if (this->dataPtr->CheckDuplicateCollisionPair(e->GetId(), nId))
+      if (this->dataPtr->CheckDuplicateCollisionPair(
+              e->GetId(), nId, collisionStateMap))
         continue;
 
       // Get collide bitmask for entity 2
@@ -155,7 +187,7 @@ std::vector<Contact> CollisionDetector::CheckCollisions(
       if ((cb1 & cb2) == 0)
         continue;
 
-      std::vector<math::Vector3d> points;
+      points.clear();
       math::AxisAlignedBox wb2 = this->dataPtr->aabbTree.AABB(nId);
       if (this->GetIntersectionPoints(wb1, wb2, points, _singleContact))
       {
@@ -167,14 +199,19 @@ std::vector<Contact> CollisionDetector::CheckCollisions(
         for (const auto &p : points)
         {
           c.point = p;
-          contacts.push_back(c);
+          _contacts.push_back(c);
         }
       }
     }
   }
+}
 
-  this->dataPtr->collisionStateMap.clear();
-  return contacts;
+//////////////////////////////////////////////////
+void CollisionDetector::SetScratchMemoryResource(
+    std::pmr::memory_resource *_resource)
+{
+  this->dataPtr->scratch =
+      _resource ? _resource : std::pmr::get_default_resource();
 }
 
 //////////////////////////////////////////////////
@@ -244,14 +281,14 @@ bool CollisionDetector::GetIntersectionPoints(const math::AxisAlignedBox &_b1,
 
 //////////////////////////////////////////////////
 bool CollisionDetectorPrivate::CheckDuplicateCollisionPair(
-    std::size_t _a, std::size_t _b)
+    std::size_t _a, std::size_t _b, CollisionStateMap &_collisionStateMap)
 {
   // use a 2d map to keep track of pairs of collisions
   // mark the corresponding elements in the 2d map to true to indicate
   // the check is done
   bool duplicate = true;
-  auto aIt = this->collisionStateMap.find(_a);
-  if (aIt == this->collisionStateMap.end())
+  auto aIt = _collisionStateMap.find(_a);
+  if (aIt == _collisionStateMap.end())
   {
     duplicate = false;
   }
@@ -266,8 +303,8 @@ bool CollisionDetectorPrivate::CheckDuplicateCollisionPair(
 
   if (!duplicate)
   {
-    this->collisionStateMap[_a][_b] = true;
-    this->collisionStateMap[_b][_a] = true;
+    _collisionStateMap[_a][_b] = true;
+    _collisionStateMap[_b][_a] = true;
   }
   return duplicate;
 }
@@ -20,6 +20,7 @@
 
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -73,6 +74,27 @@ class GZ_PHYSICS_TPELIB_VISIBLE CollisionDetector
       const std::map<std::size_t, std::shared_ptr<Entity>> &_entities,
       bool _singleContact = false);
 
+  /// \brief Check collisions between a list entities and get all contact points
+  /// \param[in] _entities List of entities
+  /// \param[out] _contacts A list of contact points. It is cleared first, and
+  /// its capacity is reused.
+  /// \param[in] _singleContact Get only 1 contact point for each pair of
+  /// collisions.
+  /// The contact point will be at the center of all points
+  public: void CheckCollisions(
+      const std::map<std::size_t, std::shared_ptr<Entity>> &_entities,
+      std::vector<Contact> &_contacts,
+      bool _singleContact = false);
+
+  /// \brief Set the memory resource of the temporary containers that are
+  /// created while checking collisions. They are all released before
+  /// CheckCollisions returns, so the resource can be a scratch arena that is
+  /// reset between two calls. The queries of the AABB tree do not use this
+  /// resource and still allocate from the global heap.
+  /// \param[in] _resource The memory resource. It must outlive this
+  /// collision detector, or be replaced before it is destroyed.
+  public: void SetScratchMemoryResource(std::pmr::memory_resource *_resource);
+
   /// \brief Get a vector of intersection points between two axis aligned boxes
   /// \param[in] _b1 Axis aligned box 1
   /// \param[in] _b2 Axis aligned box 2
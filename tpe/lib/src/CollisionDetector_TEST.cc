@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <memory_resource>
+
 #include <gz/math/AxisAlignedBox.hh>
 
 #include "Collision.hh"
@@ -403,3 +406,79 @@ TEST(CollisionDetector, CheckStaticCollisionFiltering)
   std::vector<Contact> contacts = cd.CheckCollisions(entities);
   EXPECT_TRUE(contacts.empty());
 }
+
+/////////////////////////////////////////////////
+/// Memory resource that counts the allocations it receives
+class CountingResource : public std::pmr::memory_resource
+{
+  public: std::size_t allocations = 0;
+
+  private: void *do_allocate(
+      std::size_t _bytes, std::size_t _alignment) override
+  {
+    ++this->allocations;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+  }
+
+  private: void do_deallocate(
+      void *_p, std::size_t _bytes, std::size_t _alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(_p, _bytes, _alignment);
+  }
+
+  private: bool do_is_equal(
+      const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST(CollisionDetector, ScratchMemory)
+{
+  std::map<std::size_t, std::shared_ptr<Entity>> entities;
+  for (int i = 0; i < 2; ++i)
+  {
+    std::shared_ptr<Model> model(new Model);
+    Entity &linkEnt = model->AddLink();
+    Link *link = static_cast<Link *>(&linkEnt);
+    Entity &collisionEnt = link->AddCollision();
+    Collision *collision = static_cast<Collision *>(&collisionEnt);
+    BoxShape boxShape;
+    boxShape.SetSize(math::Vector3d(2, 2, 2));
+    collision->SetShape(boxShape);
+    model->SetPose(math::Pose3d(i, 0, 0, 0, 0, 0));
+    entities[model->GetId()] = model;
+  }
+
+  CountingResource scratch;
+  CollisionDetector cd;
+  cd.SetScratchMemoryResource(&scratch);
+
+  // The output vector keeps its capacity from one call to the next
+  std::vector<Contact> contacts;
+  cd.CheckCollisions(entities, contacts);
+  EXPECT_EQ(8u, contacts.size());
+  const Contact *data = contacts.data();
+  for (int i = 0; i < 5; ++i)
+  {
+    cd.CheckCollisions(entities, contacts);
+    EXPECT_EQ(8u, contacts.size());
+    EXPECT_EQ(data, contacts.data());
+  }
+
+  // Single contacts are cleared and written into the same vector
+  cd.CheckCollisions(entities, contacts, true);
+  EXPECT_EQ(1u, contacts.size());
+  EXPECT_EQ(data, contacts.data());
+
+  // The temporary containers were allocated from the scratch resource
+  EXPECT_LT(0u, scratch.allocations);
+
+  // Without a scratch resource, the default one is used again
+  const std::size_t allocations = scratch.allocations;
+  cd.SetScratchMemoryResource(nullptr);
+  cd.CheckCollisions(entities, contacts, true);
+  EXPECT_EQ(1u, contacts.size());
+  EXPECT_EQ(allocations, scratch.allocations);
+}
@@ -59,7 +59,7 @@ Entity &Engine::GetWorldById(std::size_t _worldId)
   {
     return *it->second;
   }
-  return Entity::kNullEntity;
+  return Entity::NullEntity();
 }
 
 /////////////////////////////////////////////////
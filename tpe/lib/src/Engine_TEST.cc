@@ -59,5 +59,5 @@ TEST(Engine, World)
   EXPECT_EQ(1u, engine.GetWorldCount());
 
   Entity nullWorld = engine.GetWorldById(worldId);
-  EXPECT_EQ(Entity::kNullEntity.GetId(), nullWorld.GetId());
+  EXPECT_EQ(kNullEntityId, nullWorld.GetId());
 }
@@ -15,6 +15,8 @@
  *
 */
 
+#include <atomic>
+
 #include "Entity.hh"
 #include "Utils.hh"
 
@@ -48,6 +50,14 @@ class gz::physics::tpelib::EntityPrivate
   /// \brief Flag to indicate if pose changed
   public: bool poseDirty = false;
 
+  /// \brief World pose of the entity, valid when worldPoseDirty is false
+  public: math::Pose3d worldPose;
+
+  /// \brief Flag to indicate that the pose of the entity or of one of its
+  /// ancestors changed since worldPose was computed. When an entity is dirty,
+  /// all of its descendants are dirty too.
+  public: bool worldPoseDirty = true;
+
   /// \brief Flag to indicate if collide bitmask changed
   public: bool collideBitmaskDirty = true;
 
@@ -59,8 +69,11 @@ using namespace gz;
 using namespace physics;
 using namespace tpelib;
 
-std::size_t Entity::nextId = 0;
-Entity Entity::kNullEntity = Entity(kNullEntityId);
+namespace
+{
+/// \brief Entity id counter, shared by all the worlds
+std::atomic<std::size_t> gNextEntityId{0u};
+}
 
 //////////////////////////////////////////////////
 Entity::Entity()
@@ -134,6 +147,7 @@ void Entity::SetPose(const math::Pose3d &_pose)
 {
   this->dataPtr->pose = _pose;
   this->dataPtr->poseDirty = true;
+  this->WorldPoseChanged();
 }
 
 //////////////////////////////////////////////////
@@ -145,10 +159,23 @@ math::Pose3d Entity::GetPose() const
 //////////////////////////////////////////////////
 math::Pose3d Entity::GetWorldPose() const
 {
-  if (this->dataPtr->parent)
-    return this->dataPtr->parent->GetWorldPose() * this->dataPtr->pose;
+  // The world pose of the parent is brought up to date first, so an ancestor
+  // is computed at most once however many of its descendants are queried
+  if (this->dataPtr->worldPoseDirty)
+  {
+    if (this->dataPtr->parent)
+    {
+      this->dataPtr->worldPose =
+          this->dataPtr->parent->GetWorldPose() * this->dataPtr->pose;
+    }
+    else
+    {
+      this->dataPtr->worldPose = this->dataPtr->pose;
+    }
+    this->dataPtr->worldPoseDirty = false;
+  }
 
-  return this->dataPtr->pose;
+  return this->dataPtr->worldPose;
 }
 
 //////////////////////////////////////////////////
@@ -184,7 +211,7 @@ Entity &Entity::GetChildById(std::size_t _id) const
     return *it->second;
   }
 
-  return kNullEntity;
+  return NullEntity();
 }
 
 //////////////////////////////////////////////////
@@ -199,14 +226,14 @@ Entity &Entity::GetChildByName(const std::string &_name) const
     }
   }
 
-  return kNullEntity;
+  return NullEntity();
 }
 
 //////////////////////////////////////////////////
 Entity &Entity::GetChildByIndex(unsigned int _index) const
 {
   if (_index >= this->dataPtr->children.size())
-    return kNullEntity;
+    return NullEntity();
 
   auto it = this->dataPtr->children.begin();
   std::advance(it, _index);
@@ -215,7 +242,7 @@ Entity &Entity::GetChildByIndex(unsigned int _index) const
     return *it->second;
   }
 
-  return kNullEntity;
+  return NullEntity();
 }
 
 //////////////////////////////////////////////////
@@ -306,7 +333,14 @@ std::map<std::size_t, std::shared_ptr<Entity>> &Entity::GetChildren() const
 //////////////////////////////////////////////////
 std::size_t Entity::GetNextId()
 {
-  return nextId++;
+  return gNextEntityId.fetch_add(1u, std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+Entity &Entity::NullEntity()
+{
+  thread_local Entity nullEntity(kNullEntityId);
+  return nullEntity;
 }
 
 //////////////////////////////////////////////////
@@ -323,6 +357,19 @@ void Entity::ChildrenChanged()
 void Entity::SetParent(Entity *_parent)
 {
   this->dataPtr->parent = _parent;
+  this->WorldPoseChanged();
+}
+
+//////////////////////////////////////////////////
+void Entity::WorldPoseChanged()
+{
+  // Descendants of a dirty entity are already dirty, so the walk stops there
+  if (this->dataPtr->worldPoseDirty)
+    return;
+
+  this->dataPtr->worldPoseDirty = true;
+  for (auto &it : this->dataPtr->children)
+    it.second->WorldPoseChanged();
 }
 
 //////////////////////////////////////////////////
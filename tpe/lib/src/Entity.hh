@@ -102,7 +102,8 @@ class GZ_PHYSICS_TPELIB_VISIBLE Entity
   /// \return Pose of entity
   public: virtual math::Pose3d GetPose() const;
 
-  /// \brief Get the world pose of the entity
+  /// \brief Get the world pose of the entity. The result is cached until
+  /// the pose of the entity or of one of its ancestors is set.
   /// \return World pose of entity
   public: virtual math::Pose3d GetWorldPose() const;
 
@@ -176,20 +177,26 @@ class GZ_PHYSICS_TPELIB_VISIBLE Entity
   public: std::map<std::size_t, std::shared_ptr<Entity>> &GetChildren()
       const;
 
+  /// \brief Mark the cached world pose of this entity and of all its
+  /// descendants as out of date
+  private: void WorldPoseChanged();
+
   /// \brief Update the entity bounding box
   /// \param[in] _force True to force update children's bounding box
   private: virtual void UpdateBoundingBox(bool _force = false);
 
-  /// \brief An invalid vertex.
-  public: static Entity kNullEntity;
+  /// \brief Get an invalid entity, whose id is kNullEntityId. It is
+  /// returned by the functions that look up an entity that does not exist.
+  /// Each thread has its own null entity, so that worlds can be built and
+  /// stepped on different threads.
+  /// \return Null entity of the calling thread
+  public: static Entity &NullEntity();
 
-  /// \brief Get the id of next entity
+  /// \brief Get the id of next entity. Ids are unique across all the
+  /// worlds of the process, and can be requested from any thread.
   /// \return size_t id of next entity
   protected: static std::size_t GetNextId();
 
-  /// \brief Entity id counter
-  private: static std::size_t nextId;
-
   /// \brief Pointer to private data class
   private: EntityPrivate *dataPtr = nullptr;
 };
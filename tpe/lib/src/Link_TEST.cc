@@ -105,6 +105,6 @@ TEST(Link, Collision)
   EXPECT_EQ(1u, link.GetChildCount());
 
   Entity nullEnt = link.GetChildById(collisionId);
-  EXPECT_EQ(Entity::kNullEntity.GetId(), nullEnt.GetId());
+  EXPECT_EQ(kNullEntityId, nullEnt.GetId());
 }
 
@@ -0,0 +1,459 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/math/Vector3.hh>
+
+#include "MeshBounds.hh"
+
+using namespace gz;
+using namespace physics;
+using namespace tpelib;
+
+/// \brief Private data class for MeshBoundsCache
+class gz::physics::tpelib::MeshBoundsCachePrivate
+{
+  /// \brief Protects the members below
+  public: mutable std::mutex mutex;
+
+  /// \brief Bounding boxes by hash of the mesh file content
+  public: std::unordered_map<uint64_t, math::AxisAlignedBox> bounds;
+
+  /// \brief Content hash of a file when it had a given modification time
+  /// and size
+  public: struct FileHash
+  {
+    std::filesystem::file_time_type time;
+    std::uintmax_t size;
+    uint64_t hash;
+  };
+
+  /// \brief Content hashes of the files that were looked up, by path
+  public: std::unordered_map<std::string, FileHash> fileHashes;
+
+  /// \brief Backing file, empty if the cache is in memory only
+  public: std::string file;
+
+  /// \brief Whether entries were added since the file was written
+  public: bool dirty = false;
+};
+
+namespace
+{
+/// \brief First line of a cache file
+constexpr char kCacheFileHeader[] = "# gz-physics tpe mesh bounds 1";
+
+/// \brief common::MeshManager is a singleton that must not be used from
+/// several threads at once
+std::mutex gMeshManagerMutex;
+
+/////////////////////////////////////////////////
+/// \brief Grows a bounding box vertex by vertex
+struct BoundsBuilder
+{
+  void Add(double _x, double _y, double _z)
+  {
+    this->min.Set(std::min(this->min.X(), _x), std::min(this->min.Y(), _y),
+        std::min(this->min.Z(), _z));
+    this->max.Set(std::max(this->max.X(), _x), std::max(this->max.Y(), _y),
+        std::max(this->max.Z(), _z));
+    this->empty = false;
+  }
+
+  math::Vector3d min{math::INF_D, math::INF_D, math::INF_D};
+  math::Vector3d max{-math::INF_D, -math::INF_D, -math::INF_D};
+  bool empty = true;
+};
+
+/////////////////////////////////////////////////
+bool ReadFile(const std::string &_path, std::string &_data)
+{
+  std::ifstream file(_path, std::ios::binary | std::ios::ate);
+  if (!file)
+    return false;
+
+  const std::streamsize size = file.tellg();
+  if (size < 0)
+    return false;
+  _data.resize(static_cast<std::size_t>(size));
+  file.seekg(0);
+  return static_cast<bool>(file.read(_data.data(), size));
+}
+
+/////////////////////////////////////////////////
+/// \brief 64 bit FNV-1a hash of the content of a file
+uint64_t Hash(const std::string &_data)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : _data)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/////////////////////////////////////////////////
+std::string Extension(const std::string &_path)
+{
+  std::string extension = std::filesystem::path(_path).extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+      [](unsigned char _c) { return static_cast<char>(std::tolower(_c)); });
+  return extension;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the bounds of a binary or ASCII STL file
+bool ReadStlBounds(const std::string &_data, BoundsBuilder &_builder)
+{
+  // Binary STL: an 80 byte header, the number of triangles, then 50 bytes
+  // per triangle: the normal, the 3 vertices and an attribute.
+  constexpr std::size_t kHeaderSize = 84;
+  constexpr std::size_t kTriangleSize = 50;
+  if (_data.size() >= kHeaderSize)
+  {
+    uint32_t count = 0;
+    std::memcpy(&count, _data.data() + 80, sizeof(count));
+    if (_data.size() == kHeaderSize + kTriangleSize * count)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const char *triangle = _data.data() + kHeaderSize + kTriangleSize * i;
+        for (std::size_t v = 0; v < 3; ++v)
+        {
+          float p[3];
+          std::memcpy(p, triangle + 12 * (v + 1), sizeof(p));
+          _builder.Add(p[0], p[1], p[2]);
+        }
+      }
+      return true;
+    }
+  }
+
+  // ASCII STL: "vertex x y z" lines
+  if (_data.compare(0, 5, "solid") != 0)
+    return false;
+
+  for (std::size_t pos = _data.find("vertex"); pos != std::string::npos;
+       pos = _data.find("vertex", pos))
+  {
+    const char *p = _data.c_str() + pos + 6;
+    char *end = nullptr;
+    const double x = std::strtod(p, &end);
+    const double y = std::strtod(end, &end);
+    const double z = std::strtod(end, &end);
+    _builder.Add(x, y, z);
+    pos = static_cast<std::size_t>(end - _data.c_str());
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the bounds of the "v x y z" lines of an OBJ file
+bool ReadObjBounds(const std::string &_data, BoundsBuilder &_builder)
+{
+  const char *p = _data.c_str();
+  const char *const last = p + _data.size();
+  while (p < last)
+  {
+    while (p < last && (*p == ' ' || *p == '\t'))
+      ++p;
+
+    if (p + 1 < last && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+    {
+      char *end = nullptr;
+      const double x = std::strtod(p + 2, &end);
+      const double y = std::strtod(end, &end);
+      const double z = std::strtod(end, &end);
+      _builder.Add(x, y, z);
+      p = end;
+    }
+
+    p = static_cast<const char *>(
+        std::memchr(p, '\n', static_cast<std::size_t>(last - p)));
+    if (!p)
+      break;
+    ++p;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the bounds of a mesh
+/// \param[in] _path Path to the mesh file
+/// \param[in] _data Content of the file
+/// \param[out] _bounds Bounds of the mesh
+/// \return True if the bounds were read
+bool ReadBounds(const std::string &_path, const std::string &_data,
+    math::AxisAlignedBox &_bounds)
+{
+  const std::string extension = Extension(_path);
+  BoundsBuilder builder;
+  if (extension == ".stl")
+  {
+    if (!ReadStlBounds(_data, builder))
+      return false;
+  }
+  else if (extension == ".obj")
+  {
+    if (!ReadObjBounds(_data, builder))
+      return false;
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(gMeshManagerMutex);
+    const common::Mesh *mesh = common::MeshManager::Instance()->Load(_path);
+    if (!mesh)
+      return false;
+
+    math::Vector3d center;
+    math::Vector3d min;
+    math::Vector3d max;
+    mesh->AABB(center, min, max);
+    _bounds = math::AxisAlignedBox(min, max);
+    return true;
+  }
+
+  if (builder.empty)
+    return false;
+
+  _bounds = math::AxisAlignedBox(builder.min, builder.max);
+  return true;
+}
+}
+
+/////////////////////////////////////////////////
+bool tpelib::ReadMeshBounds(const std::string &_path,
+    math::AxisAlignedBox &_bounds)
+{
+  std::string data;
+  if (!ReadFile(_path, data))
+    return false;
+
+  return ReadBounds(_path, data, _bounds);
+}
+
+/////////////////////////////////////////////////
+bool tpelib::ReadSubMeshBounds(const std::string &_path,
+    const std::string &_submesh, bool _center, math::AxisAlignedBox &_bounds)
+{
+  std::lock_guard<std::mutex> lock(gMeshManagerMutex);
+  const common::Mesh *mesh = common::MeshManager::Instance()->Load(_path);
+  if (!mesh)
+    return false;
+
+  const auto submesh = mesh->SubMeshByName(_submesh).lock();
+  if (!submesh)
+  {
+    gzwarn << "Submesh [" << _submesh << "] not found in mesh [" << _path
+           << "]." << std::endl;
+    return false;
+  }
+
+  math::Vector3d min = submesh->Min();
+  math::Vector3d max = submesh->Max();
+  if (_center)
+  {
+    const math::Vector3d center = (min + max) * 0.5;
+    min -= center;
+    max -= center;
+  }
+  _bounds = math::AxisAlignedBox(min, max);
+  return true;
+}
+
+/////////////////////////////////////////////////
+MeshBoundsCache::MeshBoundsCache()
+  : dataPtr(std::make_unique<MeshBoundsCachePrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+MeshBoundsCache::~MeshBoundsCache()
+{
+  this->Flush();
+}
+
+/////////////////////////////////////////////////
+bool MeshBoundsCache::SetFile(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->file = _path;
+
+  std::ifstream file(_path);
+  if (!file)
+  {
+    // Nothing was saved yet
+    this->dataPtr->dirty = !this->dataPtr->bounds.empty();
+    return true;
+  }
+
+  std::string line;
+  if (!std::getline(file, line) || line != kCacheFileHeader)
+  {
+    gzwarn << "Ignoring mesh bounds cache [" << _path << "] with an unknown "
+           << "format." << std::endl;
+    this->dataPtr->dirty = true;
+    return false;
+  }
+
+  std::size_t added = 0;
+  while (std::getline(file, line))
+  {
+    std::istringstream stream(line);
+    uint64_t hash = 0;
+    double v[6];
+    stream >> std::hex >> hash >> std::dec >> v[0] >> v[1] >> v[2]
+           >> v[3] >> v[4] >> v[5];
+    if (!stream)
+      continue;
+
+    added += this->dataPtr->bounds.emplace(hash, math::AxisAlignedBox(
+        math::Vector3d(v[0], v[1], v[2]),
+        math::Vector3d(v[3], v[4], v[5]))).second ? 1 : 0;
+  }
+
+  // Entries that were only in memory still need to be written
+  this->dataPtr->dirty = this->dataPtr->bounds.size() > added;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MeshBoundsCache::Flush()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->file.empty() || !this->dataPtr->dirty)
+    return true;
+
+  // Write a temporary file next to the cache and move it in place, so that
+  // readers never see a partial file
+  std::ostringstream tmpPath;
+  tmpPath << this->dataPtr->file << ".tmp."
+          << std::hash<std::thread::id>()(std::this_thread::get_id());
+  {
+    std::ofstream file(tmpPath.str(), std::ios::trunc);
+    if (!file)
+    {
+      gzwarn << "Unable to write mesh bounds cache [" << this->dataPtr->file
+             << "]." << std::endl;
+      return false;
+    }
+
+    file << kCacheFileHeader << "\n"
+         << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (const auto &[hash, box] : this->dataPtr->bounds)
+    {
+      file << std::hex << hash << std::dec << " "
+           << box.Min().X() << " " << box.Min().Y() << " " << box.Min().Z()
+           << " "
+           << box.Max().X() << " " << box.Max().Y() << " " << box.Max().Z()
+           << "\n";
+    }
+    if (!file)
+      return false;
+  }
+
+  std::error_code error;
+  std::filesystem::rename(tmpPath.str(), this->dataPtr->file, error);
+  if (error)
+  {
+    gzwarn << "Unable to write mesh bounds cache [" << this->dataPtr->file
+           << "]: " << error.message() << std::endl;
+    std::filesystem::remove(tmpPath.str(), error);
+    return false;
+  }
+
+  this->dataPtr->dirty = false;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MeshBoundsCache::Bounds(const std::string &_path,
+    math::AxisAlignedBox &_bounds)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(_path, error);
+  if (error)
+    return false;
+  const std::uintmax_t size = std::filesystem::file_size(_path, error);
+  if (error)
+    return false;
+
+  // Files that did not change since they were last looked up are not read
+  // again
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    const auto fileIt = this->dataPtr->fileHashes.find(_path);
+    if (fileIt != this->dataPtr->fileHashes.end() &&
+        fileIt->second.time == time && fileIt->second.size == size)
+    {
+      const auto it = this->dataPtr->bounds.find(fileIt->second.hash);
+      if (it != this->dataPtr->bounds.end())
+      {
+        _bounds = it->second;
+        return true;
+      }
+    }
+  }
+
+  std::string data;
+  if (!ReadFile(_path, data))
+    return false;
+
+  const uint64_t hash = Hash(data);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->fileHashes[_path] = {time, size, hash};
+    const auto it = this->dataPtr->bounds.find(hash);
+    if (it != this->dataPtr->bounds.end())
+    {
+      _bounds = it->second;
+      return true;
+    }
+  }
+
+  if (!ReadBounds(_path, data, _bounds))
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->bounds.emplace(hash, _bounds);
+  this->dataPtr->dirty = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t MeshBoundsCache::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->bounds.size();
+}
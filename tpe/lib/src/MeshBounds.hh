@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_PHYSICS_TPE_LIB_SRC_MESHBOUNDS_HH_
+#define GZ_PHYSICS_TPE_LIB_SRC_MESHBOUNDS_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/utils/SuppressWarning.hh>
+
+#include "gz/physics/tpelib/Export.hh"
+
+namespace gz {
+namespace physics {
+namespace tpelib {
+
+// forward declaration
+class MeshBoundsCachePrivate;
+
+/// \brief Read the axis aligned bounding box of the mesh in a file without
+/// building the mesh. STL and OBJ files are scanned for their vertex
+/// positions only. Other formats, which may transform their vertices while
+/// they are loaded, go through common::MeshManager.
+/// \param[in] _path Path to the mesh file
+/// \param[out] _bounds Bounding box of the mesh, in the mesh frame
+/// \return True if the bounds were read
+GZ_PHYSICS_TPELIB_VISIBLE
+bool ReadMeshBounds(const std::string &_path, math::AxisAlignedBox &_bounds);
+
+/// \brief Read the axis aligned bounding box of a submesh. The mesh is
+/// loaded through common::MeshManager, which is only used by one thread at a
+/// time.
+/// \param[in] _path Path to the mesh file
+/// \param[in] _submesh Name of the submesh
+/// \param[in] _center Whether the submesh is centered at its origin
+/// \param[out] _bounds Bounding box of the submesh, in the mesh frame, or
+/// around its origin if it is centered
+/// \return True if the bounds were read
+GZ_PHYSICS_TPELIB_VISIBLE
+bool ReadSubMeshBounds(const std::string &_path, const std::string &_submesh,
+    bool _center, math::AxisAlignedBox &_bounds);
+
+/// \brief MeshBoundsCache keeps the bounding boxes of meshes, keyed by a
+/// hash of the content of their file, so that a mesh that is used by many
+/// collisions or that is found under several paths is only read once. The
+/// hash of each path is remembered along with the modification time and size
+/// of its file, so a file is only read and hashed again when it changes.
+///
+/// The cache can be backed by a file so that the bounds persist across
+/// runs. The cache is safe to use from several threads.
+class GZ_PHYSICS_TPELIB_VISIBLE MeshBoundsCache
+{
+  /// \brief Constructor
+  public: MeshBoundsCache();
+
+  /// \brief Destructor. Saves the new entries to the backing file, if any.
+  public: ~MeshBoundsCache();
+
+  /// \brief Back the cache with a file. The entries of the file are added
+  /// to the cache, and Flush() writes the cache to it.
+  /// \param[in] _path Path of the file. It does not need to exist.
+  /// \return False if the file exists but could not be read
+  public: bool SetFile(const std::string &_path);
+
+  /// \brief Write the cache to its backing file if entries were added since
+  /// it was last written. The file is replaced atomically, so that several
+  /// processes can share it.
+  /// \return False if the file could not be written
+  public: bool Flush();
+
+  /// \brief Get the bounding box of the mesh in a file, reading it only if
+  /// no mesh with the same content is in the cache.
+  /// \param[in] _path Path to the mesh file
+  /// \param[out] _bounds Bounding box of the mesh, in the mesh frame
+  /// \return True if the bounds are known
+  public: bool Bounds(const std::string &_path, math::AxisAlignedBox &_bounds);
+
+  /// \brief Get the number of meshes in the cache
+  /// \return Number of cached bounding boxes
+  public: std::size_t Size() const;
+
+  /// \brief Pointer to the private data
+  GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+  private: std::unique_ptr<MeshBoundsCachePrivate> dataPtr;
+  GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+};
+}
+}
+}
+
+#endif
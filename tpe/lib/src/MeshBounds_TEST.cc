@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "MeshBounds.hh"
+
+using namespace gz;
+using namespace physics;
+using namespace tpelib;
+
+/////////////////////////////////////////////////
+/// \brief Write an OBJ file whose vertices span [-1, 2] x [-4, 2] x [0, 7]
+std::string WriteObj(const std::string &_name)
+{
+  const std::string path = testing::TempDir() + _name;
+  std::ofstream file(path);
+  file << "# comment\n"
+       << "v 1 2 3\n"
+       << "vn 9 9 9\n"
+       << "  v -1 0.5 7\n"
+       << "vt 100 100\n"
+       << "v 2 -4 0\n"
+       << "f 1 2 3\n";
+  return path;
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBounds, Obj)
+{
+  math::AxisAlignedBox bounds;
+  ASSERT_TRUE(ReadMeshBounds(WriteObj("MeshBounds_TEST.obj"), bounds));
+  EXPECT_EQ(math::Vector3d(-1, -4, 0), bounds.Min());
+  EXPECT_EQ(math::Vector3d(2, 2, 7), bounds.Max());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBounds, AsciiStl)
+{
+  const std::string path = testing::TempDir() + "MeshBounds_TEST_ascii.stl";
+  {
+    std::ofstream file(path);
+    file << "solid triangle\n"
+         << "  facet normal 0 0 1\n"
+         << "    outer loop\n"
+         << "      vertex 0 0 0\n"
+         << "      vertex 1 2 -3\n"
+         << "      vertex 5 0 0\n"
+         << "    endloop\n"
+         << "  endfacet\n"
+         << "endsolid triangle\n";
+  }
+
+  math::AxisAlignedBox bounds;
+  ASSERT_TRUE(ReadMeshBounds(path, bounds));
+  EXPECT_EQ(math::Vector3d(0, 0, -3), bounds.Min());
+  EXPECT_EQ(math::Vector3d(5, 2, 0), bounds.Max());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBounds, BinaryStl)
+{
+  const std::string path = testing::TempDir() + "MeshBounds_TEST_binary.stl";
+  {
+    std::ofstream file(path, std::ios::binary);
+    // Binary files may start with "solid" too
+    char header[80] = "solid but binary";
+    file.write(header, sizeof(header));
+    const uint32_t count = 2;
+    file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const float normalAndVertices[12] =
+          {0, 0, 1, 1, 2, 3, -4, 5, 6, 7, -8, 10.0f * i};
+      file.write(reinterpret_cast<const char *>(normalAndVertices),
+                 sizeof(normalAndVertices));
+      const uint16_t attribute = 0;
+      file.write(reinterpret_cast<const char *>(&attribute),
+                 sizeof(attribute));
+    }
+  }
+
+  math::AxisAlignedBox bounds;
+  ASSERT_TRUE(ReadMeshBounds(path, bounds));
+  EXPECT_EQ(math::Vector3d(-4, -8, 0), bounds.Min());
+  EXPECT_EQ(math::Vector3d(7, 5, 10), bounds.Max());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBounds, Invalid)
+{
+  math::AxisAlignedBox bounds;
+  EXPECT_FALSE(ReadMeshBounds(
+      testing::TempDir() + "MeshBounds_TEST_missing.obj", bounds));
+
+  // A file without vertices has no bounds
+  const std::string path = testing::TempDir() + "MeshBounds_TEST_empty.obj";
+  std::ofstream(path) << "# nothing\n";
+  EXPECT_FALSE(ReadMeshBounds(path, bounds));
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBounds, Cache)
+{
+  const std::string cacheFile =
+      testing::TempDir() + "MeshBounds_TEST.cache";
+  std::remove(cacheFile.c_str());
+
+  const std::string path1 = WriteObj("MeshBounds_TEST_1.obj");
+  const std::string path2 = WriteObj("MeshBounds_TEST_2.obj");
+
+  math::AxisAlignedBox bounds;
+  {
+    MeshBoundsCache cache;
+    EXPECT_TRUE(cache.SetFile(cacheFile));
+    EXPECT_TRUE(cache.Bounds(path1, bounds));
+    EXPECT_EQ(math::Vector3d(-1, -4, 0), bounds.Min());
+
+    // Files with the same content share their entry
+    EXPECT_TRUE(cache.Bounds(path2, bounds));
+    EXPECT_EQ(1u, cache.Size());
+    EXPECT_TRUE(cache.Flush());
+  }
+
+  // The entries are read back from the file
+  MeshBoundsCache cache;
+  EXPECT_EQ(0u, cache.Size());
+  EXPECT_TRUE(cache.SetFile(cacheFile));
+  EXPECT_EQ(1u, cache.Size());
+  EXPECT_TRUE(cache.Bounds(path1, bounds));
+  EXPECT_EQ(math::Vector3d(-1, -4, 0), bounds.Min());
+  EXPECT_EQ(math::Vector3d(2, 2, 7), bounds.Max());
+  EXPECT_EQ(1u, cache.Size());
+
+  // A file that changed is read again
+  std::ofstream(path1) << "v 0 0 0\nv 1 1 1\n";
+  EXPECT_TRUE(cache.Bounds(path1, bounds));
+  EXPECT_EQ(math::Vector3d(1, 1, 1), bounds.Max());
+  EXPECT_EQ(2u, cache.Size());
+
+  // Files in an unknown format are not used as a cache
+  std::ofstream(cacheFile) << "not a cache\n";
+  MeshBoundsCache otherCache;
+  EXPECT_FALSE(otherCache.SetFile(cacheFile));
+  EXPECT_EQ(0u, otherCache.Size());
+}
@@ -146,7 +146,7 @@ Entity &Model::GetCanonicalLink()
       }
     }
   }
-  return kNullEntity;
+  return NullEntity();
 }
 
 //////////////////////////////////////////////////
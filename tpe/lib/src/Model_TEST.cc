@@ -112,7 +112,7 @@ TEST(Model, Link)
 
   // test canonical link
   model.SetCanonicalLink(link->GetId());
-  EXPECT_NE(Entity::kNullEntity.GetId(), model.GetCanonicalLink().GetId());
+  EXPECT_NE(kNullEntityId, model.GetCanonicalLink().GetId());
   EXPECT_EQ(link->GetId(), model.GetCanonicalLink().GetId());
 
   // test remove child by id
@@ -120,7 +120,7 @@ TEST(Model, Link)
   EXPECT_EQ(1u, model.GetChildCount());
 
   Entity nullEnt = model.GetChildById(linkId);
-  EXPECT_EQ(Entity::kNullEntity.GetId(), nullEnt.GetId());
+  EXPECT_EQ(kNullEntityId, nullEnt.GetId());
 }
 
 /////////////////////////////////////////////////
@@ -314,7 +314,7 @@ TEST(Model, NestedModel)
   EXPECT_EQ(1u, model.GetChildCount());
 
   Entity nullEnt = model.GetChildById(modelId);
-  EXPECT_EQ(Entity::kNullEntity.GetId(), nullEnt.GetId());
+  EXPECT_EQ(kNullEntityId, nullEnt.GetId());
 
   // test canonical link within nested model
   Model m0;
@@ -344,3 +344,38 @@ TEST(Model, NestedModel)
   m2->SetCanonicalLink();
   EXPECT_EQ(linkEnt2.GetId(), m2->GetCanonicalLink().GetId());
 }
+
+/////////////////////////////////////////////////
+TEST(Model, NestedWorldPose)
+{
+  // m0 -> m1 -> m2 -> link -> collision
+  Model m0;
+  m0.SetPose(math::Pose3d(1, 0, 0, 0, 0, 0));
+  Entity &m1Ent = m0.AddModel();
+  m1Ent.SetPose(math::Pose3d(0, 1, 0, 0, 0, 0));
+  Entity &m2Ent = static_cast<Model *>(&m1Ent)->AddModel();
+  m2Ent.SetPose(math::Pose3d(0, 0, 1, 0, 0, GZ_PI_2));
+  Entity &linkEnt = static_cast<Model *>(&m2Ent)->AddLink();
+  linkEnt.SetPose(math::Pose3d(1, 0, 0, 0, 0, 0));
+  Entity &collisionEnt = static_cast<Link *>(&linkEnt)->AddCollision();
+
+  EXPECT_EQ(math::Pose3d(1, 2, 1, 0, 0, GZ_PI_2), collisionEnt.GetWorldPose());
+  EXPECT_EQ(math::Pose3d(1, 2, 1, 0, 0, GZ_PI_2), linkEnt.GetWorldPose());
+  EXPECT_EQ(math::Pose3d(1, 1, 1, 0, 0, GZ_PI_2), m2Ent.GetWorldPose());
+
+  // Setting the pose of an ancestor updates the world pose of every
+  // descendant, including the ones that were already queried
+  m0.SetPose(math::Pose3d(2, 0, 0, 0, 0, 0));
+  EXPECT_EQ(math::Pose3d(2, 1, 0, 0, 0, 0), m1Ent.GetWorldPose());
+  EXPECT_EQ(math::Pose3d(2, 2, 1, 0, 0, GZ_PI_2), collisionEnt.GetWorldPose());
+
+  m2Ent.SetPose(math::Pose3d(0, 0, 2, 0, 0, 0));
+  EXPECT_EQ(math::Pose3d(3, 1, 2, 0, 0, 0), linkEnt.GetWorldPose());
+  EXPECT_EQ(math::Pose3d(2, 1, 0, 0, 0, 0), m1Ent.GetWorldPose());
+
+  // Several ancestors change before the next query
+  m1Ent.SetPose(math::Pose3d(0, 3, 0, 0, 0, 0));
+  m0.SetPose(math::Pose3d(0, 0, 0, 0, 0, 0));
+  EXPECT_EQ(math::Pose3d(1, 3, 2, 0, 0, 0), collisionEnt.GetWorldPose());
+  EXPECT_EQ(math::Pose3d(0, 3, 2, 0, 0, 0), m2Ent.GetWorldPose());
+}
@@ -15,6 +15,14 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Helpers.hh>
+
 #include "Shape.hh"
 
 using namespace gz;
@@ -232,7 +240,13 @@ void MeshShape::SetMesh(const common::Mesh &_mesh)
   math::Vector3d min;
   math::Vector3d max;
   _mesh.AABB(center, min, max);
-  this->meshAABB = math::AxisAlignedBox(min, max);
+  this->SetMeshBounds(math::AxisAlignedBox(min, max));
+}
+
+//////////////////////////////////////////////////
+void MeshShape::SetMeshBounds(const math::AxisAlignedBox &_bounds)
+{
+  this->meshAABB = _bounds;
   this->dirty = true;
 }
 
@@ -242,3 +256,160 @@ void MeshShape::UpdateBoundingBox()
   this->bbox = math::AxisAlignedBox(
       this->scale * this->meshAABB.Min(), this->scale * this->meshAABB.Max());
 }
+
+//////////////////////////////////////////////////
+HeightmapShape::HeightmapShape() : Shape()
+{
+  this->type = ShapeType::HEIGHTMAP;
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::SetHeightmap(const common::HeightmapData &_data,
+    const math::Vector3d &_size, int _subSampling)
+{
+  // Sample the data the same way the dartsim and bullet heightmaps do
+  const float heightmapSizeZ = _data.MaxElevation() - _data.MinElevation();
+  const unsigned int vertSize =
+      (_data.Width() * _subSampling) - _subSampling + 1;
+
+  math::Vector3d scale;
+  scale.X(_size.X() / vertSize);
+  scale.Y(_size.Y() / vertSize);
+  if (math::equal(heightmapSizeZ, 0.0f))
+    scale.Z(1.0);
+  else
+    scale.Z(std::fabs(_size.Z()) / heightmapSizeZ);
+
+  std::vector<float> heightsFloat;
+  _data.FillHeightMap(_subSampling, vertSize, _size, scale, false,
+      heightsFloat);
+
+  // The samples are scale apart, so the grid spans one sample less than
+  // _size, like the dartsim heightmap
+  this->SetHeights(vertSize, vertSize, std::move(heightsFloat),
+      math::Vector2d(scale.X() * (vertSize - 1), scale.Y() * (vertSize - 1)));
+}
+
+//////////////////////////////////////////////////
+bool HeightmapShape::SetHeights(std::size_t _columns, std::size_t _rows,
+    std::vector<float> _heights, const math::Vector2d &_size)
+{
+  if (_columns < 2 || _rows < 2 || _heights.size() != _columns * _rows)
+  {
+    gzerr << "Heightmap needs a grid of at least 2x2 heights, got "
+          << _heights.size() << " heights for a " << _columns << "x" << _rows
+          << " grid." << std::endl;
+    return false;
+  }
+
+  const auto [minIt, maxIt] =
+      std::minmax_element(_heights.begin(), _heights.end());
+  this->minHeight = *minIt;
+  this->maxHeight = *maxIt;
+
+  this->heights = std::move(_heights);
+  this->columns = _columns;
+  this->rows = _rows;
+  this->size = _size;
+  this->spacing.Set(_size.X() / static_cast<double>(_columns - 1),
+      _size.Y() / static_cast<double>(_rows - 1));
+  this->dirty = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::size_t HeightmapShape::GetColumns() const
+{
+  return this->columns;
+}
+
+//////////////////////////////////////////////////
+std::size_t HeightmapShape::GetRows() const
+{
+  return this->rows;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapShape::HeightAt(double _x, double _y, double &_height,
+    math::Vector3d &_normal) const
+{
+  if (this->heights.empty())
+    return false;
+
+  // Position in the grid, in samples
+  const double u = (_x + this->size.X() * 0.5) / this->spacing.X();
+  const double v = (this->size.Y() * 0.5 - _y) / this->spacing.Y();
+  const double lastColumn = static_cast<double>(this->columns - 1);
+  const double lastRow = static_cast<double>(this->rows - 1);
+
+  // Written so that NaN coordinates are rejected too
+  if (!(u >= 0.0 && u <= lastColumn && v >= 0.0 && v <= lastRow))
+    return false;
+
+  // Cell of the point. Points on the last column or row use the cell
+  // before it.
+  const std::size_t c =
+      std::min(static_cast<std::size_t>(u), this->columns - 2);
+  const std::size_t r = std::min(static_cast<std::size_t>(v), this->rows - 2);
+  const double du = u - static_cast<double>(c);
+  const double dv = v - static_cast<double>(r);
+
+  const float *row0 = this->heights.data() + r * this->columns + c;
+  const float *row1 = row0 + this->columns;
+  const double h00 = row0[0];
+  const double h10 = row0[1];
+  const double h01 = row1[0];
+  const double h11 = row1[1];
+
+  _height = h00 * (1.0 - du) * (1.0 - dv) + h10 * du * (1.0 - dv) +
+      h01 * (1.0 - du) * dv + h11 * du * dv;
+
+  // Gradient of the bilinear patch. Rows go along -y.
+  const double dhdu = (h10 - h00) * (1.0 - dv) + (h11 - h01) * dv;
+  const double dhdv = (h01 - h00) * (1.0 - du) + (h11 - h10) * du;
+  _normal.Set(-dhdu / this->spacing.X(), dhdv / this->spacing.Y(), 1.0);
+  _normal.Normalize();
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::size_t HeightmapShape::HeightsAt(
+    const std::vector<math::Vector2d> &_points,
+    std::vector<double> &_heights,
+    std::vector<math::Vector3d> &_normals) const
+{
+  _heights.resize(_points.size());
+  _normals.resize(_points.size());
+
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < _points.size(); ++i)
+  {
+    if (this->HeightAt(_points[i].X(), _points[i].Y(), _heights[i],
+        _normals[i]))
+    {
+      ++count;
+    }
+    else
+    {
+      _heights[i] = std::numeric_limits<double>::quiet_NaN();
+      _normals[i] = math::Vector3d::UnitZ;
+    }
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::UpdateBoundingBox()
+{
+  if (this->heights.empty())
+  {
+    this->bbox = math::AxisAlignedBox();
+    return;
+  }
+
+  this->bbox = math::AxisAlignedBox(
+      math::Vector3d(-this->size.X() * 0.5, -this->size.Y() * 0.5,
+        this->minHeight),
+      math::Vector3d(this->size.X() * 0.5, this->size.Y() * 0.5,
+        this->maxHeight));
+}
@@ -20,8 +20,11 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include <gz/common/Mesh.hh>
+#include <gz/common/geospatial/HeightmapData.hh>
+#include <gz/math/Vector2.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/AxisAlignedBox.hh>
 #include <gz/utils/SuppressWarning.hh>
@@ -59,6 +62,9 @@ enum class GZ_PHYSICS_TPELIB_VISIBLE ShapeType
 
   /// \brief A ellipsoid shape.
   ELLIPSOID = 7,
+
+  /// \brief A heightmap shape.
+  HEIGHTMAP = 8,
 };
 
 
@@ -251,6 +257,11 @@ class GZ_PHYSICS_TPELIB_VISIBLE MeshShape : public Shape
   /// \param[in] _mesh Mesh object
   public: void SetMesh(const common::Mesh &_mesh);
 
+  /// \brief Set the bounding box of the mesh, for when the mesh itself is
+  /// not loaded. This is all the mesh shape needs.
+  /// \param[in] _bounds Bounding box of the unscaled mesh
+  public: void SetMeshBounds(const math::AxisAlignedBox &_bounds);
+
   /// \brief Get mesh scale
   /// \return Mesh scale
   public: math::Vector3d GetScale() const;
@@ -271,6 +282,93 @@ class GZ_PHYSICS_TPELIB_VISIBLE MeshShape : public Shape
   private: math::AxisAlignedBox meshAABB;
 };
 
+/// \brief Heightmap geometry. The heights are kept in a row major grid of
+/// floats that spans the size of the heightmap and is centered on its
+/// origin. Columns go along +x, and rows go along -y so that the first row
+/// of an image is at the +y edge, like in the other engines.
+class GZ_PHYSICS_TPELIB_VISIBLE HeightmapShape : public Shape
+{
+  /// \brief Constructor
+  public: HeightmapShape();
+
+  /// \brief Destructor
+  public: virtual ~HeightmapShape() = default;
+
+  /// \brief Sample heightmap data into the grid of heights. Like in the
+  /// dartsim heightmap, the N samples along each side are _size / N apart,
+  /// so the grid spans (N - 1) / N of _size.
+  /// \param[in] _data Heightmap data, such as an image or a DEM
+  /// \param[in] _size Size of the heightmap in meters
+  /// \param[in] _subSampling Number of samples per data point
+  public: void SetHeightmap(const common::HeightmapData &_data,
+              const math::Vector3d &_size, int _subSampling = 1);
+
+  /// \brief Set the grid of heights
+  /// \param[in] _columns Number of samples along x, at least 2
+  /// \param[in] _rows Number of samples along y, at least 2
+  /// \param[in] _heights Row major heights, in meters
+  /// \param[in] _size Size of the heightmap along x and y in meters
+  /// \return False if the number of heights does not match the grid
+  public: bool SetHeights(std::size_t _columns, std::size_t _rows,
+              std::vector<float> _heights, const math::Vector2d &_size);
+
+  /// \brief Get the number of samples along x
+  /// \return Number of columns of the grid
+  public: std::size_t GetColumns() const;
+
+  /// \brief Get the number of samples along y
+  /// \return Number of rows of the grid
+  public: std::size_t GetRows() const;
+
+  /// \brief Get the height and normal of the heightmap at a point,
+  /// interpolated bilinearly between the four surrounding samples.
+  /// \param[in] _x X coordinate in the heightmap frame
+  /// \param[in] _y Y coordinate in the heightmap frame
+  /// \param[out] _height Height of the surface in the heightmap frame
+  /// \param[out] _normal Unit normal of the surface in the heightmap frame
+  /// \return False if the point is not above the heightmap, in which case
+  /// the outputs are not modified
+  public: bool HeightAt(double _x, double _y, double &_height,
+              math::Vector3d &_normal) const;
+
+  /// \brief Get the heights and normals of the heightmap at many points.
+  /// \param[in] _points X and Y coordinates in the heightmap frame
+  /// \param[out] _heights Heights of the surface, NaN for points that are
+  /// not above the heightmap
+  /// \param[out] _normals Unit normals of the surface, +z for points that
+  /// are not above the heightmap
+  /// \return Number of points above the heightmap
+  public: std::size_t HeightsAt(const std::vector<math::Vector2d> &_points,
+              std::vector<double> &_heights,
+              std::vector<math::Vector3d> &_normals) const;
+
+  // Documentation inherited
+  protected: virtual void UpdateBoundingBox() override;
+
+  GZ_UTILS_WARN_IGNORE__DLL_INTERFACE_MISSING
+  /// \brief Row major heights
+  private: std::vector<float> heights;
+
+  /// \brief Size of the heightmap along x and y
+  private: math::Vector2d size;
+
+  /// \brief Distance between samples along x and y
+  private: math::Vector2d spacing;
+  GZ_UTILS_WARN_RESUME__DLL_INTERFACE_MISSING
+
+  /// \brief Number of samples along x
+  private: std::size_t columns = 0;
+
+  /// \brief Number of samples along y
+  private: std::size_t rows = 0;
+
+  /// \brief Lowest height
+  private: double minHeight = 0.0;
+
+  /// \brief Highest height
+  private: double maxHeight = 0.0;
+};
+
 }
 }
 }
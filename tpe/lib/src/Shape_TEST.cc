@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include <gz/common/Mesh.hh>
 #include <gz/common/SubMesh.hh>
 
@@ -154,3 +157,77 @@ TEST(Shape, MeshShape)
   EXPECT_EQ(v0, bbox.Min());
   EXPECT_EQ(v2, bbox.Max());
 }
+
+/////////////////////////////////////////////////
+TEST(Shape, HeightmapShape)
+{
+  HeightmapShape shape;
+  EXPECT_EQ(ShapeType::HEIGHTMAP, shape.GetType());
+
+  double height = 0.0;
+  math::Vector3d normal;
+  EXPECT_FALSE(shape.HeightAt(0, 0, height, normal));
+
+  // Grids need at least 2x2 heights, one for each sample
+  EXPECT_FALSE(shape.SetHeights(1, 2, {0, 0}, math::Vector2d(1, 1)));
+  EXPECT_FALSE(shape.SetHeights(2, 2, {0, 0, 0}, math::Vector2d(1, 1)));
+
+  // A 3x3 grid over 2x2 meters, sampling the plane z = 1 + 0.5x + 0.25y.
+  // Rows go along -y.
+  auto plane = [](double _x, double _y) { return 1.0 + 0.5 * _x + 0.25 * _y; };
+  std::vector<float> heights;
+  for (int r = 0; r < 3; ++r)
+  {
+    for (int c = 0; c < 3; ++c)
+      heights.push_back(static_cast<float>(plane(c - 1.0, 1.0 - r)));
+  }
+  ASSERT_TRUE(shape.SetHeights(3, 3, heights, math::Vector2d(2, 2)));
+  EXPECT_EQ(3u, shape.GetColumns());
+  EXPECT_EQ(3u, shape.GetRows());
+
+  math::AxisAlignedBox bbox = shape.GetBoundingBox();
+  EXPECT_EQ(math::Vector3d(-1, -1, 0.25), bbox.Min());
+  EXPECT_EQ(math::Vector3d(1, 1, 1.75), bbox.Max());
+
+  // Bilinear interpolation is exact on a plane, including on the edges
+  const math::Vector3d planeNormal =
+      math::Vector3d(-0.5, -0.25, 1.0).Normalized();
+  for (const auto &point : {math::Vector2d(0, 0), math::Vector2d(0.3, -0.7),
+                            math::Vector2d(-1, 1), math::Vector2d(1, -1),
+                            math::Vector2d(1, 0.2)})
+  {
+    ASSERT_TRUE(shape.HeightAt(point.X(), point.Y(), height, normal))
+        << point;
+    EXPECT_NEAR(plane(point.X(), point.Y()), height, 1e-6) << point;
+    EXPECT_EQ(planeNormal, normal) << point;
+  }
+
+  EXPECT_FALSE(shape.HeightAt(1.01, 0, height, normal));
+  EXPECT_FALSE(shape.HeightAt(0, -1.01, height, normal));
+  EXPECT_FALSE(shape.HeightAt(std::nan(""), 0, height, normal));
+
+  // Batched queries
+  std::vector<double> batchHeights;
+  std::vector<math::Vector3d> batchNormals;
+  EXPECT_EQ(2u, shape.HeightsAt(
+      {math::Vector2d(0.5, 0.5), math::Vector2d(5, 0), math::Vector2d(0, 0)},
+      batchHeights, batchNormals));
+  ASSERT_EQ(3u, batchHeights.size());
+  ASSERT_EQ(3u, batchNormals.size());
+  EXPECT_NEAR(plane(0.5, 0.5), batchHeights[0], 1e-6);
+  EXPECT_TRUE(std::isnan(batchHeights[1]));
+  EXPECT_EQ(math::Vector3d::UnitZ, batchNormals[1]);
+  EXPECT_NEAR(1.0, batchHeights[2], 1e-6);
+  EXPECT_EQ(planeNormal, batchNormals[2]);
+
+  // A bump in the middle of a flat grid is interpolated between samples
+  std::vector<float> bump(9, 0.0f);
+  bump[4] = 1.0f;
+  ASSERT_TRUE(shape.SetHeights(3, 3, bump, math::Vector2d(2, 2)));
+  ASSERT_TRUE(shape.HeightAt(0.5, 0.5, height, normal));
+  EXPECT_NEAR(0.25, height, 1e-6);
+  ASSERT_TRUE(shape.HeightAt(0.5, 0, height, normal));
+  EXPECT_NEAR(0.5, height, 1e-6);
+  EXPECT_GT(normal.X(), 0.0);
+  EXPECT_GT(normal.Z(), 0.0);
+}
@@ -83,8 +83,7 @@ void World::Step()
   // check colliisions
   // the last bool arg tells the collision checker to return one single contact
   // point for each pair of collisions
-  this->contacts = std::move(
-      this->collisionDetector.CheckCollisions(children, true));
+  this->collisionDetector.CheckCollisions(children, this->contacts, true);
 
   for (auto it = children.begin(); it != children.end(); ++it)
     it->second->ResetPoseDirty();
@@ -103,7 +102,13 @@ Entity &World::AddModel()
 }
 
 /////////////////////////////////////////////////
-std::vector<Contact> World::GetContacts() const
+const std::vector<Contact> &World::GetContacts() const
 {
   return this->contacts;
 }
+
+/////////////////////////////////////////////////
+void World::SetScratchMemoryResource(std::pmr::memory_resource *_resource)
+{
+  this->collisionDetector.SetScratchMemoryResource(_resource);
+}
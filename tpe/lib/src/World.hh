@@ -18,6 +18,7 @@
 #ifndef GZ_PHYSICS_TPE_LIB_SRC_WORLD_HH_
 #define GZ_PHYSICS_TPE_LIB_SRC_WORLD_HH_
 
+#include <memory_resource>
 #include <vector>
 #include <gz/utils/SuppressWarning.hh>
 
@@ -66,7 +67,13 @@ class GZ_PHYSICS_TPELIB_VISIBLE World : public Entity
 
   /// \brief Get contacts from last step
   /// \return Contacts from last step
-  public: std::vector<Contact> GetContacts() const;
+  public: const std::vector<Contact> &GetContacts() const;
+
+  /// \brief Set the memory resource of the temporary containers that are
+  /// created during a step, see CollisionDetector::SetScratchMemoryResource.
+  /// \param[in] _resource The memory resource. It must outlive this world, or
+  /// be replaced before it is destroyed.
+  public: void SetScratchMemoryResource(std::pmr::memory_resource *_resource);
 
   /// \brief World time
   protected: double time{0.0};
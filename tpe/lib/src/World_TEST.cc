@@ -89,5 +89,5 @@ TEST(World, Model)
   EXPECT_EQ(1u, world.GetChildCount());
 
   Entity nullEnt = world.GetChildById(modelId);
-  EXPECT_EQ(Entity::kNullEntity.GetId(), nullEnt.GetId());
+  EXPECT_EQ(kNullEntityId, nullEnt.GetId());
 }
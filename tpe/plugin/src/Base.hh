@@ -19,6 +19,7 @@
 #define GZ_PHYSICS_TPE_PLUGIN_SRC_BASE_HH_
 
 #include <gz/physics/Implements.hh>
+#include <gz/physics/ScratchArena.hh>
 
 #include <map>
 #include <memory>
@@ -42,6 +43,16 @@ namespace tpeplugin {
 struct WorldInfo
 {
   std::shared_ptr<tpelib::World> world;
+
+  /// \brief Memory of the temporary containers of a step. It is reset at the
+  /// start of each step.
+  ScratchArena scratch;
+
+  ~WorldInfo()
+  {
+    if (this->world)
+      this->world->SetScratchMemoryResource(nullptr);
+  }
 };
 
 struct ModelInfo
@@ -127,6 +138,7 @@ class Base : public Implements3d<FeatureList<Feature>>
     size_t worldId = _world->GetId();
     auto worldPtr = std::make_shared<WorldInfo>();
     worldPtr->world = _world;
+    _world->SetScratchMemoryResource(&worldPtr->scratch);
     this->worlds.insert({worldId, worldPtr});
     this->childIdToParentId.insert({worldId, -1});
     return this->GenerateIdentity(worldId, worldPtr);
@@ -15,6 +15,9 @@
  *
 */
 
+#include <utility>
+#include <vector>
+
 #include <Eigen/Geometry>
 
 #include <gz/common/Console.hh>
@@ -224,3 +227,187 @@ void FreeGroupFeatures::SetFreeGroupWorldAngularVelocity(
     }
   }
 }
+
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::SetWorldFreeGroupBatch(
+  const Identity &_worldID,
+  const std::vector<BaseFreeGroup3dPtr> &_groups)
+{
+  std::vector<FreeGroupBatchEntry> entries;
+  entries.reserve(_groups.size());
+  for (const auto &group : _groups)
+  {
+    if (!group)
+    {
+      gzerr << "Unable to declare free group batch: invalid free group."
+        << std::endl;
+      return false;
+    }
+
+    FreeGroupBatchEntry entry;
+    entry.groupId = group->FullIdentity().id;
+    entry.groupModel = nullptr;
+    entry.rootLink = nullptr;
+    auto modelIt = this->models.find(entry.groupId);
+    if (modelIt != this->models.end())
+    {
+      if (modelIt->second != nullptr)
+      {
+        entry.groupModel = modelIt->second->model;
+        entry.rootLink = FindModelRootLink(entry.groupModel);
+      }
+    }
+    else
+    {
+      auto linkIt = this->links.find(entry.groupId);
+      if (linkIt != this->links.end() && linkIt->second != nullptr)
+        entry.rootLink = linkIt->second->link;
+    }
+
+    if (!entry.rootLink)
+    {
+      gzerr << "No free group with id [" << entry.groupId << "] found. "
+        << "Unable to declare free group batch." << std::endl;
+      return false;
+    }
+
+    // get top level model
+    tpelib::Entity *parent = entry.rootLink->GetParent();
+    tpelib::Model *model = nullptr;
+    while (parent && dynamic_cast<tpelib::Model *>(parent))
+    {
+      model = static_cast<tpelib::Model *>(parent);
+      parent = model->GetParent();
+    }
+    auto worldIt = model ?
+      this->childIdToParentId.find(model->GetId()) :
+      this->childIdToParentId.end();
+    if (worldIt == this->childIdToParentId.end() ||
+        worldIt->second != _worldID.id)
+    {
+      gzerr << "Unable to declare free group batch: free group ["
+        << entry.groupId << "] is not in this world." << std::endl;
+      return false;
+    }
+    entry.topModel = model;
+    entry.topModelId = model->GetId();
+
+    entries.push_back(entry);
+  }
+
+  this->freeGroupBatches[_worldID.id] = std::move(entries);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::IsValid(const FreeGroupBatchEntry &_entry) const
+{
+  // Removing a model destroys its tpelib entities, so make sure the cached
+  // pointers are still alive before using them.
+  if (this->models.find(_entry.topModelId) == this->models.end())
+    return false;
+  if (_entry.groupModel &&
+      this->models.find(_entry.groupId) == this->models.end())
+  {
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::SetWorldFreeGroupPoses(
+  const Identity &_worldID,
+  const std::vector<PoseType> &_poses)
+{
+  static const std::vector<FreeGroupBatchEntry> kEmpty;
+  auto batchIt = this->freeGroupBatches.find(_worldID.id);
+  const auto &entries = batchIt == this->freeGroupBatches.end() ?
+      kEmpty : batchIt->second;
+  if (_poses.size() != entries.size())
+  {
+    gzerr << "Unable to set free group poses: expected [" << entries.size()
+      << "] poses, got [" << _poses.size() << "]." << std::endl;
+    return false;
+  }
+
+  bool result = true;
+  for (std::size_t i = 0; i < entries.size(); ++i)
+  {
+    const FreeGroupBatchEntry &entry = entries[i];
+    if (!this->IsValid(entry))
+    {
+      gzerr << "Free group with id [" << entry.groupId << "] no longer "
+        << "exists. Its pose will not be set." << std::endl;
+      result = false;
+      continue;
+    }
+
+    // Same as SetFreeGroupWorldPose: compute the top level model world pose
+    // that places the root link at the target world pose.
+    math::Pose3d targetWorldPose = math::eigen3::convert(_poses[i]);
+    math::Pose3d linkWorldPose = entry.rootLink->GetWorldPose();
+    math::Pose3d tfChange = targetWorldPose * linkWorldPose.Inverse();
+
+    math::Pose3d modelWorldPose = entry.topModel->GetWorldPose();
+    math::Pose3d targetModelWorldPose;
+    targetModelWorldPose.Pos() = targetWorldPose.Pos() - tfChange.Rot() *
+       (linkWorldPose.Pos() - modelWorldPose.Pos());
+    targetModelWorldPose.Rot() = tfChange.Rot() * modelWorldPose.Rot();
+
+    entry.topModel->SetPose(targetModelWorldPose);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool FreeGroupFeatures::SetWorldFreeGroupVelocities(
+  const Identity &_worldID,
+  const std::vector<LinearVelocity> &_linearVelocities,
+  const std::vector<AngularVelocity> &_angularVelocities)
+{
+  static const std::vector<FreeGroupBatchEntry> kEmpty;
+  auto batchIt = this->freeGroupBatches.find(_worldID.id);
+  const auto &entries = batchIt == this->freeGroupBatches.end() ?
+      kEmpty : batchIt->second;
+  if (_linearVelocities.size() != entries.size() ||
+      _angularVelocities.size() != entries.size())
+  {
+    gzerr << "Unable to set free group velocities: expected ["
+      << entries.size() << "] linear and angular velocities, got ["
+      << _linearVelocities.size() << "] and ["
+      << _angularVelocities.size() << "]." << std::endl;
+    return false;
+  }
+
+  bool result = true;
+  for (std::size_t i = 0; i < entries.size(); ++i)
+  {
+    const FreeGroupBatchEntry &entry = entries[i];
+    if (!this->IsValid(entry))
+    {
+      gzerr << "Free group with id [" << entry.groupId << "] no longer "
+        << "exists. Its velocity will not be set." << std::endl;
+      result = false;
+      continue;
+    }
+
+    if (entry.groupModel)
+    {
+      entry.groupModel->SetLinearVelocity(
+        math::eigen3::convert(_linearVelocities[i]));
+      entry.groupModel->SetAngularVelocity(
+        math::eigen3::convert(_angularVelocities[i]));
+    }
+    else
+    {
+      // Link velocities are expressed in the link frame
+      const math::Quaterniond invRot =
+        entry.rootLink->GetWorldPose().Rot().Inverse();
+      entry.rootLink->SetLinearVelocity(
+        invRot * math::eigen3::convert(_linearVelocities[i]));
+      entry.rootLink->SetAngularVelocity(
+        invRot * math::eigen3::convert(_angularVelocities[i]));
+    }
+  }
+  return result;
+}
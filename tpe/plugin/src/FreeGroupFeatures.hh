@@ -18,6 +18,9 @@
 #ifndef GZ_PHYSICS_TPE_PLUGIN_SRC_FREEGROUPFEATURES_HH_
 #define GZ_PHYSICS_TPE_PLUGIN_SRC_FREEGROUPFEATURES_HH_
 
+#include <map>
+#include <vector>
+
 #include <gz/physics/FreeGroup.hh>
 
 #include "Base.hh"
@@ -29,7 +32,8 @@ namespace tpeplugin {
 struct FreeGroupFeatureList : FeatureList<
   FindFreeGroupFeature,
   SetFreeGroupWorldPose,
-  SetFreeGroupWorldVelocity
+  SetFreeGroupWorldVelocity,
+  SetFreeGroupWorldStateBatch
 > { };
 
 class FreeGroupFeatures :
@@ -54,6 +58,46 @@ class FreeGroupFeatures :
   void SetFreeGroupWorldAngularVelocity(
     const Identity &_groupID,
     const AngularVelocity &_angularVelocity) override;
+
+  // SetFreeGroupWorldStateBatch
+  bool SetWorldFreeGroupBatch(
+    const Identity &_worldID,
+    const std::vector<BaseFreeGroup3dPtr> &_groups) override;
+
+  bool SetWorldFreeGroupPoses(
+    const Identity &_worldID,
+    const std::vector<PoseType> &_poses) override;
+
+  bool SetWorldFreeGroupVelocities(
+    const Identity &_worldID,
+    const std::vector<LinearVelocity> &_linearVelocities,
+    const std::vector<AngularVelocity> &_angularVelocities) override;
+
+  /// \brief A FreeGroup declared with SetFreeGroupWorldStateBatch, with the
+  /// entities needed to set its state resolved up front.
+  struct FreeGroupBatchEntry
+  {
+    /// \brief Id of the free group
+    std::size_t groupId;
+
+    /// \brief Model of the free group, or nullptr if the free group is a link
+    tpelib::Model *groupModel;
+
+    /// \brief Root link of the free group
+    tpelib::Link *rootLink;
+
+    /// \brief Id of the top level model that contains the root link
+    std::size_t topModelId;
+
+    /// \brief Top level model that contains the root link
+    tpelib::Model *topModel;
+  };
+
+  /// \brief Check that the entities cached in a batch entry still exist
+  bool IsValid(const FreeGroupBatchEntry &_entry) const;
+
+  /// \brief Map from world id to the free groups declared for that world
+  std::map<std::size_t, std::vector<FreeGroupBatchEntry>> freeGroupBatches;
 };
 
 }
@@ -23,8 +23,11 @@
 #include <sdf/Ellipsoid.hh>
 #include <sdf/Sphere.hh>
 #include <sdf/Geometry.hh>
+#include <sdf/Mesh.hh>
 #include <sdf/World.hh>
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
 
 namespace gz {
 namespace physics {
@@ -78,6 +81,9 @@ Identity SDFFeatures::ConstructSdfWorld(
     }
   }
 
+  // Persist the bounds of the meshes that were read for this world
+  this->meshBoundsCache.Flush();
+
   return worldID;
 }
 
@@ -314,14 +320,28 @@ Identity SDFFeatures::ConstructSdfCollision(
     shape.SetRadius(sphereSdf->Radius());
     collision->SetShape(shape);
   }
+  else if (geom->Type() == ::sdf::GeometryType::MESH)
+  {
+    const auto meshSdf = geom->MeshShape();
+    math::AxisAlignedBox bounds;
+    if (this->MeshBounds(*meshSdf, bounds))
+    {
+      tpelib::MeshShape shape;
+      shape.SetMeshBounds(bounds);
+      shape.SetScale(meshSdf->Scale());
+      collision->SetShape(shape);
+    }
+    else
+    {
+      gzwarn << "Failed to load mesh [" << meshSdf->Uri()
+             << "] for collision [" << name << "]." << std::endl;
+    }
+  }
   else
   {
     gzwarn << "Geometry type not supported for collision [" << name << "]."
             << std::endl;
   }
-  // \todo(anyone) add mesh. currently mesh has to be loaded externally
-  // and passed in as argument as there is no logic for searching resources
-  // in gz-physics
   const auto collisionIdentity = this->AddCollision(link->GetId(), *collision);
 
   // set collide bitmask
@@ -348,6 +368,38 @@ Identity SDFFeatures::ConstructSdfCollision(
   return collisionIdentity;
 }
 
+/////////////////////////////////////////////////
+bool SDFFeatures::MeshBounds(const ::sdf::Mesh &_meshSdf,
+    math::AxisAlignedBox &_bounds)
+{
+  if (!this->meshBoundsCacheFileSet)
+  {
+    std::string cacheFile;
+    if (common::env("GZ_PHYSICS_TPE_MESH_BOUNDS_CACHE", cacheFile) &&
+        !cacheFile.empty())
+    {
+      this->meshBoundsCache.SetFile(cacheFile);
+    }
+    this->meshBoundsCacheFileSet = true;
+  }
+
+  // Paths that are not found in the resource paths may be relative to the
+  // SDF file
+  std::string path = common::findFile(_meshSdf.Uri());
+  if (path.empty() && !_meshSdf.FilePath().empty())
+  {
+    path = common::joinPaths(
+        common::parentPath(_meshSdf.FilePath()), _meshSdf.Uri());
+  }
+
+  if (_meshSdf.Submesh().empty())
+    return this->meshBoundsCache.Bounds(path, _bounds);
+
+  // The bounds of a submesh are not cached, since they need the mesh
+  return tpelib::ReadSubMeshBounds(
+      path, _meshSdf.Submesh(), _meshSdf.CenterSubmesh(), _bounds);
+}
+
 }
 }
 }
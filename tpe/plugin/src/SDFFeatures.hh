@@ -27,6 +27,7 @@
 #include <gz/physics/Implements.hh>
 
 #include "EntityManagementFeatures.hh"
+#include "lib/src/MeshBounds.hh"
 
 namespace gz {
 namespace physics {
@@ -63,6 +64,23 @@ class SDFFeatures :
   private: Identity ConstructSdfCollision(
     const Identity &_linkID,
     const ::sdf::Collision &_sdfCollision) override;
+
+  /// \brief Get the bounding box of an SDF mesh without loading the mesh,
+  /// unless it refers to a submesh.
+  /// \param[in] _meshSdf SDF mesh
+  /// \param[out] _bounds Bounding box of the unscaled mesh
+  /// \return True if the bounds were found
+  private: bool MeshBounds(const ::sdf::Mesh &_meshSdf,
+                           math::AxisAlignedBox &_bounds);
+
+  /// \brief Bounds of the meshes of this engine. If the
+  /// GZ_PHYSICS_TPE_MESH_BOUNDS_CACHE environment variable is set, the
+  /// cache is stored in the file it names, so that the meshes are only read
+  /// once across runs.
+  private: tpelib::MeshBoundsCache meshBoundsCache;
+
+  /// \brief Whether the backing file of meshBoundsCache was looked up
+  private: bool meshBoundsCacheFileSet = false;
 };
 
 }
@@ -17,11 +17,17 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #include <sdf/Root.hh>
 #include <sdf/World.hh>
 
+#include <test/Resources.hh>
 #include <test/Utils.hh>
 #include <test/common_test/Worlds.hh>
 
@@ -37,6 +43,7 @@
 #include <gz/physics/sdf/ConstructNestedModel.hh>
 #include <gz/physics/sdf/ConstructWorld.hh>
 
+#include "lib/src/Collision.hh"
 #include "lib/src/Entity.hh"
 #include "lib/src/Model.hh"
 #include "lib/src/World.hh"
@@ -101,7 +108,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
   {
     physics::tpelib::Entity &model =
         tpeWorld->GetChildByName("ground_plane");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         model.GetId());
     EXPECT_EQ("ground_plane", model.GetName());
     EXPECT_EQ(math::Pose3d::Zero, model.GetPose());
@@ -109,7 +116,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
     EXPECT_EQ(1u, model.GetChildCount());
 
     physics::tpelib::Entity &link = model.GetChildByName("link");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link.GetId());
     EXPECT_EQ("link", link.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link.GetPose());
@@ -118,7 +125,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &collision =
         link.GetChildByName("collision");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         collision.GetId());
     EXPECT_EQ("collision", collision.GetName());
     EXPECT_EQ(math::Pose3d::Zero, collision.GetPose());
@@ -129,7 +136,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
   {
     physics::tpelib::Entity &model =
         tpeWorld->GetChildByName("double_pendulum_with_base");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         model.GetId());
     EXPECT_EQ("double_pendulum_with_base", model.GetName());
     EXPECT_EQ(math::Pose3d(1, 0, 0, 0, 0, 0), model.GetPose());
@@ -137,7 +144,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
     EXPECT_EQ(3u, model.GetChildCount());
 
     physics::tpelib::Entity &link = model.GetChildByName("base");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link.GetId());
     EXPECT_EQ("base", link.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link.GetPose());
@@ -146,7 +153,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &collision =
         link.GetChildByName("col_plate_on_ground");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         collision.GetId());
     EXPECT_EQ("col_plate_on_ground", collision.GetName());
     EXPECT_EQ(math::Pose3d(0, 0, 0.01, 0, 0, 0), collision.GetPose());
@@ -155,7 +162,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &collision02 =
         link.GetChildByName("col_pole");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         collision.GetId());
     EXPECT_EQ("col_pole", collision02.GetName());
     EXPECT_EQ(math::Pose3d(-0.275, 0, 1.1, 0, 0, 0),
@@ -165,7 +172,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &link02 =
         model.GetChildByName("upper_link");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link02.GetId());
     EXPECT_EQ("upper_link", link02.GetName());
     EXPECT_EQ(math::Pose3d(0, 0, 2.1, -1.5708, 0, 0),
@@ -176,7 +183,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &collision03 =
         link02.GetChildByName("col_upper_joint");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         collision03.GetId());
     EXPECT_EQ("col_upper_joint", collision03.GetName());
     EXPECT_EQ(math::Pose3d(-0.05, 0, 0, 0, 1.5708, 0),
@@ -187,7 +194,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &collision04 =
         link02.GetChildByName("col_lower_joint");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         collision04.GetId());
     EXPECT_EQ("col_lower_joint", collision04.GetName());
     EXPECT_EQ(math::Pose3d(0, 0, 1.0, 0, 1.5708, 0),
@@ -198,7 +205,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &collision05 =
         link02.GetChildByName("col_cylinder");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         collision05.GetId());
     EXPECT_EQ("col_cylinder", collision05.GetName());
     EXPECT_EQ(math::Pose3d(0, 0, 0.5, 0, 0, 0),
@@ -208,7 +215,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &link03 =
         model.GetChildByName("lower_link");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link03.GetId());
     EXPECT_EQ("lower_link", link03.GetName());
     EXPECT_EQ(math::Pose3d(0.25, 1.0, 2.1, -2, 0, 0),
@@ -219,7 +226,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &collision06 =
         link03.GetChildByName("col_lower_joint");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         collision06.GetId());
     EXPECT_EQ("col_lower_joint", collision06.GetName());
     EXPECT_EQ(math::Pose3d(0, 0, 0, 0, 1.5708, 0),
@@ -230,7 +237,7 @@ TEST(SDFFeatures_TEST, CheckTpeData)
 
     physics::tpelib::Entity &collision07 =
         link03.GetChildByName("col_cylinder");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         collision07.GetId());
     EXPECT_EQ("col_cylinder", collision07.GetName());
     EXPECT_EQ(math::Pose3d(0, 0, 0.5, 0, 0, 0),
@@ -243,21 +250,21 @@ TEST(SDFFeatures_TEST, CheckTpeData)
   {
     physics::tpelib::Entity &model =
         tpeWorld->GetChildByName("free_body");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         model.GetId());
     EXPECT_EQ("free_body", model.GetName());
     EXPECT_EQ(math::Pose3d(0, 10, 10, 0, 0, 0), model.GetPose());
     EXPECT_EQ(1u, model.GetChildCount());
 
     physics::tpelib::Entity &link = model.GetChildByName("link");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link.GetId());
     EXPECT_EQ("link", link.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link.GetPose());
     EXPECT_EQ(1u, link.GetChildCount());
 
     auto &collision = link.GetChildByName("collision1");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         collision.GetId());
     EXPECT_EQ("collision1", collision.GetName());
     EXPECT_EQ(0u, collision.GetChildCount());
@@ -267,21 +274,21 @@ TEST(SDFFeatures_TEST, CheckTpeData)
   {
     physics::tpelib::Entity &model =
         tpeWorld->GetChildByName("joint_limit_test");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         model.GetId());
     EXPECT_EQ("joint_limit_test", model.GetName());
     EXPECT_EQ(math::Pose3d(10, 0, 2, 0, 0, 0), model.GetPose());
     EXPECT_EQ(2u, model.GetChildCount());
 
     physics::tpelib::Entity &link = model.GetChildByName("base");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link.GetId());
     EXPECT_EQ("base", link.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link.GetPose());
     EXPECT_EQ(0u, link.GetChildCount());
 
     physics::tpelib::Entity &link02 = model.GetChildByName("bar");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link02.GetId());
     EXPECT_EQ("bar", link02.GetName());
     EXPECT_EQ(math::Pose3d(1, 0, 0, 0, 0, 0), link02.GetPose());
@@ -292,21 +299,21 @@ TEST(SDFFeatures_TEST, CheckTpeData)
   {
     physics::tpelib::Entity &model =
         tpeWorld->GetChildByName("screw_joint_test");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         model.GetId());
     EXPECT_EQ("screw_joint_test", model.GetName());
     EXPECT_EQ(math::Pose3d::Zero, model.GetPose());
     EXPECT_EQ(2u, model.GetChildCount());
 
     physics::tpelib::Entity &link = model.GetChildByName("link0");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link.GetId());
     EXPECT_EQ("link0", link.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link.GetPose());
     EXPECT_EQ(0u, link.GetChildCount());
 
     physics::tpelib::Entity &link02 = model.GetChildByName("link1");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link02.GetId());
     EXPECT_EQ("link1", link02.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link02.GetPose());
@@ -317,49 +324,49 @@ TEST(SDFFeatures_TEST, CheckTpeData)
   {
     physics::tpelib::Entity &model =
         tpeWorld->GetChildByName("unsupported_joint_test");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         model.GetId());
     EXPECT_EQ("unsupported_joint_test", model.GetName());
     EXPECT_EQ(math::Pose3d::Zero, model.GetPose());
     EXPECT_EQ(6u, model.GetChildCount());
 
     physics::tpelib::Entity &link = model.GetChildByName("link0");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link.GetId());
     EXPECT_EQ("link0", link.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link.GetPose());
     EXPECT_EQ(0u, link.GetChildCount());
 
     physics::tpelib::Entity &link02 = model.GetChildByName("link1");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link02.GetId());
     EXPECT_EQ("link1", link02.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link02.GetPose());
     EXPECT_EQ(0u, link02.GetChildCount());
 
     physics::tpelib::Entity &link03 = model.GetChildByName("link2");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link03.GetId());
     EXPECT_EQ("link2", link03.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link03.GetPose());
     EXPECT_EQ(0u, link03.GetChildCount());
 
     physics::tpelib::Entity &link04 = model.GetChildByName("link3");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link04.GetId());
     EXPECT_EQ("link3", link04.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link04.GetPose());
     EXPECT_EQ(0u, link04.GetChildCount());
 
     physics::tpelib::Entity &link05 = model.GetChildByName("link4");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link05.GetId());
     EXPECT_EQ("link4", link05.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link05.GetPose());
     EXPECT_EQ(0u, link05.GetChildCount());
 
     physics::tpelib::Entity &link06 = model.GetChildByName("link5");
-    ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+    ASSERT_NE(physics::tpelib::kNullEntityId,
         link06.GetId());
     EXPECT_EQ("link5", link06.GetName());
     EXPECT_EQ(math::Pose3d::Zero, link06.GetPose());
@@ -380,14 +387,14 @@ TEST(SDFFeatures_TEST, NestedModel)
   // check top level model
   physics::tpelib::Entity &model =
       tpeWorld->GetChildByName("parent_model");
-  ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+  ASSERT_NE(physics::tpelib::kNullEntityId,
       model.GetId());
   EXPECT_EQ("parent_model", model.GetName());
   EXPECT_EQ(math::Pose3d::Zero, model.GetPose());
   EXPECT_EQ(4u, model.GetChildCount());
 
   physics::tpelib::Entity &link = model.GetChildByName("link1");
-  ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+  ASSERT_NE(physics::tpelib::kNullEntityId,
       link.GetId());
   EXPECT_EQ("link1", link.GetName());
   EXPECT_EQ(math::Pose3d::Zero, link.GetPose());
@@ -395,7 +402,7 @@ TEST(SDFFeatures_TEST, NestedModel)
 
   physics::tpelib::Entity &collision =
       link.GetChildByName("collision");
-  ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+  ASSERT_NE(physics::tpelib::kNullEntityId,
       collision.GetId());
   EXPECT_EQ("collision", collision.GetName());
   EXPECT_EQ(math::Pose3d::Zero, collision.GetPose());
@@ -403,7 +410,7 @@ TEST(SDFFeatures_TEST, NestedModel)
   // check nested model
   physics::tpelib::Entity &nestedModel =
       model.GetChildByName("nested_model");
-  ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+  ASSERT_NE(physics::tpelib::kNullEntityId,
       nestedModel.GetId());
   EXPECT_EQ("nested_model", nestedModel.GetName());
   EXPECT_EQ(math::Pose3d(1, 2, 2, 0, 0, 0), nestedModel.GetPose());
@@ -411,7 +418,7 @@ TEST(SDFFeatures_TEST, NestedModel)
 
   physics::tpelib::Entity &nestedLink =
       nestedModel.GetChildByName("nested_link1");
-  ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+  ASSERT_NE(physics::tpelib::kNullEntityId,
       nestedLink.GetId());
   EXPECT_EQ("nested_link1", nestedLink.GetName());
   EXPECT_EQ(math::Pose3d(3, 1, 1, 0, 0, 1.5707),
@@ -420,7 +427,7 @@ TEST(SDFFeatures_TEST, NestedModel)
 
   physics::tpelib::Entity &nestedCollision =
       nestedLink.GetChildByName("nested_collision1");
-  ASSERT_NE(physics::tpelib::Entity::kNullEntity.GetId(),
+  ASSERT_NE(physics::tpelib::kNullEntityId,
       nestedCollision.GetId());
   EXPECT_EQ("nested_collision1", nestedCollision.GetName());
   EXPECT_EQ(math::Pose3d::Zero, nestedCollision.GetPose());
@@ -457,3 +464,125 @@ TEST(SDFFeatures_TEST, ConstructModel)
   EXPECT_NE(nullptr, nestedModelByModel);
   EXPECT_EQ("nested_model_by_model", nestedModelByModel->GetName());
 }
+
+/////////////////////////////////////////////////
+/// \brief Add the ids of an entity and of all its descendants to _ids
+void CollectEntityIds(const physics::tpelib::Entity &_entity,
+    std::vector<std::size_t> &_ids)
+{
+  _ids.push_back(_entity.GetId());
+  for (const auto &child : _entity.GetChildren())
+    CollectEntityIds(*child.second, _ids);
+}
+
+// Test that independent worlds can be constructed on different threads
+TEST(SDFFeatures_TEST, ParallelConstructWorld)
+{
+  constexpr std::size_t kWorldCount = 8;
+
+  plugin::Loader loader;
+  loader.LoadLib(tpe_plugin_LIB);
+
+  // Each thread gets its own engine and its own copy of the SDF world
+  std::vector<plugin::PluginPtr> plugins;
+  std::vector<sdf::Root> roots(kWorldCount);
+  for (auto &root : roots)
+  {
+    plugins.push_back(loader.Instantiate("gz::physics::tpeplugin::Plugin"));
+    ASSERT_TRUE(root.Load(common_test::worlds::kTestWorld).empty());
+  }
+
+  std::vector<WorldPtr> worlds(kWorldCount);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < kWorldCount; ++i)
+  {
+    threads.emplace_back([&, i]()
+    {
+      auto engine =
+          physics::RequestEngine3d<TestFeatureList>::From(plugins[i]);
+      if (engine)
+        worlds[i] = engine->ConstructWorld(*roots[i].WorldByIndex(0));
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  std::vector<std::size_t> ids;
+  for (const auto &world : worlds)
+  {
+    ASSERT_NE(nullptr, world);
+    auto tpeWorld = world->GetTpeLibWorld();
+    ASSERT_NE(nullptr, tpeWorld);
+    EXPECT_EQ(7u, tpeWorld->GetChildCount());
+
+    const auto &model = tpeWorld->GetChildByName("double_pendulum_with_base");
+    EXPECT_EQ(math::Pose3d(1, 0, 0, 0, 0, 0), model.GetWorldPose());
+    EXPECT_EQ(3u, model.GetChildCount());
+
+    CollectEntityIds(*tpeWorld, ids);
+  }
+
+  // Entity ids are unique across all the worlds
+  const std::set<std::size_t> uniqueIds(ids.begin(), ids.end());
+  EXPECT_EQ(ids.size(), uniqueIds.size());
+  EXPECT_EQ(0u, uniqueIds.count(physics::tpelib::kNullEntityId));
+}
+
+// Test that mesh collisions get the bounds of their mesh
+TEST(SDFFeatures_TEST, MeshCollision)
+{
+  const std::string objPath = testing::TempDir() + "SDFFeatures_TEST.obj";
+  std::ofstream(objPath) << "v -1 -2 -3\nv 1 2 3\nf 1 2 1\n";
+
+  const std::string sdfString = R"(
+    <sdf version="1.9">
+      <world name="default">
+        <model name="model">
+          <link name="link">
+            <collision name="obj">
+              <geometry>
+                <mesh>
+                  <uri>)" + objPath + R"(</uri>
+                  <scale>2 1 0.5</scale>
+                </mesh>
+              </geometry>
+            </collision>
+            <collision name="dae">
+              <geometry>
+                <mesh>
+                  <uri>)" + physics::test::resources::kChassisDae + R"(</uri>
+                </mesh>
+              </geometry>
+            </collision>
+          </link>
+        </model>
+      </world>
+    </sdf>)";
+
+  sdf::Root root;
+  ASSERT_TRUE(root.LoadSdfString(sdfString).empty());
+  auto engine = LoadEngine();
+  ASSERT_NE(nullptr, engine);
+  auto world = engine->ConstructWorld(*root.WorldByIndex(0));
+  ASSERT_NE(nullptr, world);
+
+  auto tpeWorld = world->GetTpeLibWorld();
+  ASSERT_NE(nullptr, tpeWorld);
+  auto &link = tpeWorld->GetChildByName("model").GetChildByName("link");
+
+  auto &obj = static_cast<physics::tpelib::Collision &>(
+      link.GetChildByName("obj"));
+  ASSERT_NE(nullptr, obj.GetShape());
+  EXPECT_EQ(physics::tpelib::ShapeType::MESH, obj.GetShape()->GetType());
+  EXPECT_EQ(math::AxisAlignedBox(math::Vector3d(-2, -2, -1.5),
+                                 math::Vector3d(2, 2, 1.5)),
+            obj.GetShape()->GetBoundingBox());
+
+  auto &dae = static_cast<physics::tpelib::Collision &>(
+      link.GetChildByName("dae"));
+  ASSERT_NE(nullptr, dae.GetShape());
+  EXPECT_EQ(physics::tpelib::ShapeType::MESH, dae.GetShape()->GetType());
+  const auto daeBounds = dae.GetShape()->GetBoundingBox();
+  EXPECT_LT(daeBounds.Min().X(), daeBounds.Max().X());
+  EXPECT_LT(daeBounds.Min().Z(), daeBounds.Max().Z());
+}
@@ -15,10 +15,15 @@
  *
 */
 
+#include <limits>
+#include <vector>
+
 #include <gz/math/eigen3/Conversions.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/common/Console.hh>
 
+#include "lib/src/Utils.hh"
+
 #include "ShapeFeatures.hh"
 
 using namespace gz;
@@ -347,6 +352,102 @@ Identity ShapeFeatures::AttachSphereShape(
   return this->GenerateInvalidId();
 }
 
+/////////////////////////////////////////////////
+Identity ShapeFeatures::CastToHeightmapShape(
+  const Identity &_shapeID) const
+{
+  auto it = this->collisions.find(_shapeID);
+  if (it != this->collisions.end() && it->second != nullptr)
+  {
+    auto *shape = it->second->collision->GetShape();
+    if (shape != nullptr && dynamic_cast<tpelib::HeightmapShape*>(shape))
+      return this->GenerateIdentity(_shapeID, it->second);
+  }
+  return this->GenerateInvalidId();
+}
+
+/////////////////////////////////////////////////
+LinearVector3d ShapeFeatures::GetHeightmapShapeSize(
+  const Identity &_heightmapID) const
+{
+  auto it = this->collisions.find(_heightmapID);
+  if (it != this->collisions.end() && it->second != nullptr)
+  {
+    auto *shape = it->second->collision->GetShape();
+    if (shape != nullptr)
+      return math::eigen3::convert(shape->GetBoundingBox().Size());
+  }
+  // return invalid size if collision not found
+  return math::eigen3::convert(math::Vector3d(-1.0, -1.0, -1.0));
+}
+
+/////////////////////////////////////////////////
+Identity ShapeFeatures::AttachHeightmapShape(
+  const Identity &_linkID,
+  const std::string &_name,
+  const common::HeightmapData &_heightmapData,
+  const Pose3d &_pose,
+  const LinearVector3d &_size,
+  int _subSampling)
+{
+  auto it = this->links.find(_linkID);
+  if (it != this->links.end() && it->second != nullptr)
+  {
+    auto &collision = static_cast<tpelib::Collision&>(
+      it->second->link->AddCollision());
+    collision.SetName(_name);
+    collision.SetPose(math::eigen3::convert(_pose));
+
+    tpelib::HeightmapShape heightmap;
+    heightmap.SetHeightmap(_heightmapData, math::eigen3::convert(_size),
+        _subSampling);
+    collision.SetShape(heightmap);
+
+    return this->AddCollision(_linkID, collision);
+  }
+  return this->GenerateInvalidId();
+}
+
+/////////////////////////////////////////////////
+std::size_t ShapeFeatures::GetHeightmapShapeHeightsAndNormals(
+  const Identity &_heightmapID,
+  const std::vector<Vector2d> &_points,
+  std::vector<double> &_heights,
+  std::vector<LinearVector3d> &_normals) const
+{
+  _heights.assign(_points.size(), std::numeric_limits<double>::quiet_NaN());
+  _normals.assign(_points.size(), LinearVector3d::UnitZ());
+
+  auto it = this->collisions.find(_heightmapID);
+  if (it == this->collisions.end() || it->second == nullptr)
+    return 0u;
+
+  const auto *heightmap = dynamic_cast<const tpelib::HeightmapShape *>(
+      it->second->collision->GetShape());
+  if (heightmap == nullptr)
+    return 0u;
+
+  // The heightmap is upright, so a vertical line in the world is a vertical
+  // line in the heightmap frame.
+  const math::Pose3d pose = it->second->collision->GetWorldPose();
+  std::size_t count = 0u;
+  double height = 0.0;
+  math::Vector3d normal;
+  for (std::size_t i = 0; i < _points.size(); ++i)
+  {
+    const math::Vector3d local = pose.Rot().RotateVectorReverse(
+        math::Vector3d(_points[i].x() - pose.Pos().X(),
+                       _points[i].y() - pose.Pos().Y(), 0.0));
+    if (!heightmap->HeightAt(local.X(), local.Y(), height, normal))
+      continue;
+
+    _heights[i] = pose.Pos().Z() + height;
+    _normals[i] = math::eigen3::convert(pose.Rot().RotateVector(normal));
+    ++count;
+  }
+  return count;
+}
+
 /////////////////////////////////////////////////
 Identity ShapeFeatures::CastToMeshShape(
   const Identity &_shapeID) const
@@ -437,3 +538,74 @@ AlignedBox3d ShapeFeatures::GetShapeAxisAlignedBoundingBox(
   // return invalid bounding box if collision not found
   return math::eigen3::convert(math::AxisAlignedBox());
 }
+
+///////////////////////////////////////////////
+void ShapeFeatures::GetWorldModelAxisAlignedBoundingBoxes(
+  const Identity &_worldID,
+  std::vector<std::size_t> &_modelIds,
+  std::vector<AlignedBox3d> &_boxes) const
+{
+  _modelIds.clear();
+  _boxes.clear();
+
+  auto worldIt = this->worlds.find(_worldID);
+  if (worldIt == this->worlds.end() || worldIt->second == nullptr)
+    return;
+
+  // These are the same world boxes that the collision detector inserts into
+  // its AABB tree, computed from the cached entity bounding boxes so that
+  // they are also up to date between steps.
+  for (const auto &[id, model] : worldIt->second->world->GetChildren())
+  {
+    math::AxisAlignedBox box = model->GetBoundingBox();
+    if (box == math::AxisAlignedBox())
+      continue;
+
+    _modelIds.push_back(id);
+    _boxes.push_back(math::eigen3::convert(
+      tpelib::transformAxisAlignedBox(box, model->GetWorldPose())));
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Append the world bounding boxes of the links of a model and its
+/// nested models.
+static void AppendLinkAxisAlignedBoundingBoxes(
+  const tpelib::Entity &_model,
+  std::vector<std::size_t> &_linkIds,
+  std::vector<AlignedBox3d> &_boxes)
+{
+  for (const auto &[id, child] : _model.GetChildren())
+  {
+    if (dynamic_cast<tpelib::Model *>(child.get()))
+    {
+      AppendLinkAxisAlignedBoundingBoxes(*child, _linkIds, _boxes);
+      continue;
+    }
+
+    math::AxisAlignedBox box = child->GetBoundingBox();
+    if (box == math::AxisAlignedBox())
+      continue;
+
+    _linkIds.push_back(id);
+    _boxes.push_back(math::eigen3::convert(
+      tpelib::transformAxisAlignedBox(box, child->GetWorldPose())));
+  }
+}
+
+///////////////////////////////////////////////
+void ShapeFeatures::GetWorldLinkAxisAlignedBoundingBoxes(
+  const Identity &_worldID,
+  std::vector<std::size_t> &_linkIds,
+  std::vector<AlignedBox3d> &_boxes) const
+{
+  _linkIds.clear();
+  _boxes.clear();
+
+  auto worldIt = this->worlds.find(_worldID);
+  if (worldIt == this->worlds.end() || worldIt->second == nullptr)
+    return;
+
+  for (const auto &[id, model] : worldIt->second->world->GetChildren())
+    AppendLinkAxisAlignedBoundingBoxes(*model, _linkIds, _boxes);
+}
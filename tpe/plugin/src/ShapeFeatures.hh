@@ -19,12 +19,15 @@
 #define GZ_PHYSICS_TPE_PLUGIN_SRC_SHAPEFEATURES_HH_
 
 #include <string>
+#include <vector>
 
+#include <gz/physics/GetBoundingBox.hh>
 #include <gz/physics/Shape.hh>
 #include <gz/physics/BoxShape.hh>
 #include <gz/physics/CapsuleShape.hh>
 #include <gz/physics/CylinderShape.hh>
 #include <gz/physics/EllipsoidShape.hh>
+#include <gz/physics/heightmap/HeightmapShape.hh>
 #include <gz/physics/mesh/MeshShape.hh>
 #include <gz/physics/SphereShape.hh>
 
@@ -38,6 +41,7 @@ struct ShapeFeatureList : FeatureList<
   GetBoxShapeProperties,
   AttachBoxShapeFeature,
   GetShapeBoundingBox,
+  GetWorldEntityBoundingBoxes,
 
   GetCapsuleShapeProperties,
   AttachCapsuleShapeFeature,
@@ -48,6 +52,10 @@ struct ShapeFeatureList : FeatureList<
   GetEllipsoidShapeProperties,
   AttachEllipsoidShapeFeature,
 
+  heightmap::GetHeightmapShapeProperties,
+  heightmap::AttachHeightmapShapeFeature,
+  heightmap::GetHeightmapShapeHeightsFeature,
+
   GetSphereShapeProperties,
   AttachSphereShapeFeature,
 
@@ -133,6 +141,27 @@ class ShapeFeatures :
     const Pose3d &_pose) override;
 
 
+  // ----- Heightmap Features -----
+  public: Identity CastToHeightmapShape(
+    const Identity &_shapeID) const override;
+
+  public: LinearVector3d GetHeightmapShapeSize(
+    const Identity &_heightmapID) const override;
+
+  public: Identity AttachHeightmapShape(
+    const Identity &_linkID,
+    const std::string &_name,
+    const common::HeightmapData &_heightmapData,
+    const Pose3d &_pose,
+    const LinearVector3d &_size,
+    int _subSampling) override;
+
+  public: std::size_t GetHeightmapShapeHeightsAndNormals(
+    const Identity &_heightmapID,
+    const std::vector<Vector2d> &_points,
+    std::vector<double> &_heights,
+    std::vector<LinearVector3d> &_normals) const override;
+
   // ----- Mesh Features -----
   public: Identity CastToMeshShape(
     const Identity &_shapeID) const override;
@@ -153,6 +182,16 @@ class ShapeFeatures :
   // ----- Boundingbox Features -----
   public: AlignedBox3d GetShapeAxisAlignedBoundingBox(
     const Identity &_shapeID) const override;
+
+  public: void GetWorldModelAxisAlignedBoundingBoxes(
+    const Identity &_worldID,
+    std::vector<std::size_t> &_modelIds,
+    std::vector<AlignedBox3d> &_boxes) const override;
+
+  public: void GetWorldLinkAxisAlignedBoundingBoxes(
+    const Identity &_worldID,
+    std::vector<std::size_t> &_linkIds,
+    std::vector<AlignedBox3d> &_boxes) const override;
 };
 
 }
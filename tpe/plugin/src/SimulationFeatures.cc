@@ -15,7 +15,9 @@
  *
 */
 
+#include <memory_resource>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include <gz/common/Console.hh>
@@ -61,19 +63,28 @@ void SimulationFeatures::WorldForwardStep(
         << std::endl;
     }
   }
+
+  // Everything that used the scratch memory during the last step is gone
+  it->second->scratch.Reset();
   world->Step();
-  this->Write(_h.Get<ChangedWorldPoses>());
+  this->WriteChangedPoses(_h.Get<ChangedWorldPoses>(), &it->second->scratch);
 }
 
 void SimulationFeatures::Write(ChangedWorldPoses &_changedPoses) const
+{
+  this->WriteChangedPoses(_changedPoses, std::pmr::get_default_resource());
+}
+
+void SimulationFeatures::WriteChangedPoses(
+    ChangedWorldPoses &_changedPoses,
+    std::pmr::memory_resource *_scratch) const
 {
   // remove link poses from the previous iteration
   _changedPoses.entries.clear();
   _changedPoses.entries.reserve(this->links.size());
 
-  std::unordered_map<std::size_t, math::Pose3d> newPoses;
   // Store the updated links to avoid duplicated entries in _changedPoses
-  std::unordered_set<std::size_t> updatedLinkIds;
+  std::pmr::unordered_set<std::size_t> updatedLinkIds(_scratch);
 
   for (const auto &[id, info] : this->links)
   {
@@ -94,10 +105,8 @@ void SimulationFeatures::Write(ChangedWorldPoses &_changedPoses) const
         wp.body = id;
         _changedPoses.entries.push_back(wp);
         updatedLinkIds.insert(id);
-        newPoses[id] = nextPose;
+        this->prevEntityPoses[id] = nextPose;
       }
-      else
-        newPoses[id] = iter->second;
     }
   }
 
@@ -133,18 +142,29 @@ void SimulationFeatures::Write(ChangedWorldPoses &_changedPoses) const
             _changedPoses.entries.push_back(wp);
             updatedLinkIds.insert(linkId);
           }
-          newPoses[id] = linkEnt.second->GetPose();
+          this->prevEntityPoses[id] = linkEnt.second->GetPose();
         }
       }
-      else
-        newPoses[id] = iter->second;
     }
   }
 
-  // Save the new poses so that they can be used to check for updates in the
-  // next iteration. Re-setting this->prevEntityPoses with the contents of
-  // newPoses ensures that we aren't caching data for links that were removed
-  this->prevEntityPoses = std::move(newPoses);
+  // The poses are updated in place so that they can be used to check for
+  // updates in the next iteration. Drop the entities that were removed, and
+  // the models that became static, so that we aren't caching stale data.
+  for (auto iter = this->prevEntityPoses.begin();
+       iter != this->prevEntityPoses.end();)
+  {
+    const auto linkIt = this->links.find(iter->first);
+    const auto modelIt = this->models.find(iter->first);
+    const bool cached =
+        (linkIt != this->links.end() && linkIt->second) ||
+        (modelIt != this->models.end() && modelIt->second &&
+         !modelIt->second->model->GetStatic());
+    if (cached)
+      ++iter;
+    else
+      iter = this->prevEntityPoses.erase(iter);
+  }
 }
 
 std::vector<SimulationFeatures::ContactInternal>
@@ -153,7 +173,8 @@ SimulationFeatures::GetContactsFromLastStep(const Identity &_worldID) const
   GZ_PROFILE("SimulationFeatures::GetContactFromLastStep");
   std::vector<SimulationFeatures::ContactInternal> outContacts;
   auto const world = this->ReferenceInterface<WorldInfo>(_worldID)->world;
-  const auto contacts = world->GetContacts();
+  const auto &contacts = world->GetContacts();
+  outContacts.reserve(contacts.size());
 
   for (const auto &c : contacts)
   {
@@ -162,8 +183,8 @@ SimulationFeatures::GetContactsFromLastStep(const Identity &_worldID) const
     // Contact expects identity to be associated with shapes not models
     // but tpe computes collisions between models
     // Workaround is to return the first shape of a model
-    auto s1 = this->GetModelCollision(c.entity1);
-    auto s2 = this->GetModelCollision(c.entity2);
+    const auto &s1 = this->GetModelCollision(c.entity1);
+    const auto &s2 = this->GetModelCollision(c.entity2);
 
     outContacts.push_back(
         {this->GenerateIdentity(s1.GetId(), this->collisions.at(s1.GetId())),
@@ -178,11 +199,11 @@ tpelib::Entity &SimulationFeatures::GetModelCollision(std::size_t _id) const
 {
   auto m = this->models.at(_id);
   if (!m || !m->model)
-    return tpelib::Entity::kNullEntity;
+    return tpelib::Entity::NullEntity();
 
   tpelib::Entity &link = m->model->GetCanonicalLink();
   if (link.GetChildCount() == 0u)
-    return tpelib::Entity::kNullEntity;
+    return tpelib::Entity::NullEntity();
 
   return link.GetChildByIndex(0u);
 }
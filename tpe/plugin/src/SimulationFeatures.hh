@@ -18,6 +18,7 @@
 #ifndef GZ_PHYSICS_TPE_PLUGIN_SRC_SIMULATIONFEATURES_HH_
 #define GZ_PHYSICS_TPE_PLUGIN_SRC_SIMULATIONFEATURES_HH_
 
+#include <memory_resource>
 #include <vector>
 #include <unordered_map>
 
@@ -53,6 +54,12 @@ class SimulationFeatures :
 
   public: void Write(ChangedWorldPoses &_changedPoses) const;
 
+  /// \brief Write the poses that changed since the last call
+  /// \param[out] _changedPoses The poses that changed
+  /// \param[in] _scratch Memory resource of the temporary containers
+  private: void WriteChangedPoses(ChangedWorldPoses &_changedPoses,
+                                  std::pmr::memory_resource *_scratch) const;
+
   public: std::vector<ContactInternal> GetContactsFromLastStep(
     const Identity &_worldID) const override;
 
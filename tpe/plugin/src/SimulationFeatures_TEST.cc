@@ -17,7 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include <gz/common/Console.hh>
+#include <gz/common/geospatial/ImageHeightmap.hh>
 
 #include <gz/math/Vector3.hh>
 #include <gz/math/eigen3/Conversions.hh>
@@ -43,6 +47,7 @@
 
 #include <test/common_test/Worlds.hh>
 #include <test/PhysicsPluginsList.hh>
+#include <test/Resources.hh>
 #include <test/Utils.hh>
 
 #include "EntityManagementFeatures.hh"
@@ -433,6 +438,67 @@ TEST_P(SimulationFeatures_TEST, ShapeFeatures)
   }
 }
 
+TEST_P(SimulationFeatures_TEST, HeightmapShape)
+{
+  const std::string library = GetParam();
+  if (library.empty())
+    return;
+
+  auto worlds = LoadWorlds(library, common_test::worlds::kShapesWorld);
+  for (const auto &world : worlds)
+  {
+    auto model = world->ConstructEmptyModel("heightmap");
+    ASSERT_NE(nullptr, model);
+    auto link = model->ConstructEmptyLink("heightmap_link");
+    ASSERT_NE(nullptr, link);
+
+    common::ImageHeightmap data;
+    ASSERT_EQ(0, data.Load(physics::test::resources::kHeightmapBowlPng));
+
+    const math::Vector3d size(129, 129, 10);
+    const math::Pose3d pose(10, 20, 1, 0, 0, GZ_PI_4);
+    auto heightmap = link->AttachHeightmapShape("heightmap", data,
+        math::eigen3::convert(pose), math::eigen3::convert(size));
+    ASSERT_NE(nullptr, heightmap);
+    EXPECT_NEAR(size.X(), heightmap->GetSize()[0], 1e-6);
+    EXPECT_NEAR(size.Y(), heightmap->GetSize()[1], 1e-6);
+    EXPECT_NEAR(size.Z(), heightmap->GetSize()[2], 1e-3);
+
+    auto shape = link->GetShape("heightmap");
+    ASSERT_NE(nullptr, shape);
+    EXPECT_EQ(nullptr, shape->CastToBoxShape());
+    ASSERT_NE(nullptr, shape->CastToHeightmapShape());
+
+    // Query the center of the bowl, points on its slope on either side of
+    // the center, and a point outside of the heightmap, in the world frame
+    using Point = physics::Vector2d;
+    const Point center(pose.Pos().X(), pose.Pos().Y());
+    const std::vector<Point> points{center, center + Point(30, 0),
+        center - Point(30, 0), center + Point(200, 0)};
+    std::vector<double> heights;
+    std::vector<physics::LinearVector3d> normals;
+    EXPECT_EQ(3u, heightmap->GetHeightsAndNormals(points, heights, normals));
+    ASSERT_EQ(points.size(), heights.size());
+    ASSERT_EQ(points.size(), normals.size());
+
+    for (std::size_t i = 0; i < 3u; ++i)
+    {
+      EXPECT_TRUE(std::isfinite(heights[i])) << i;
+      EXPECT_NEAR(1.0, normals[i].norm(), 1e-6) << i;
+      EXPECT_GT(normals[i].z(), 0.0) << i;
+    }
+
+    // The bowl is lowest in the middle, and its slopes face the middle
+    EXPECT_LT(heights[0], heights[1]);
+    EXPECT_LT(heights[0], heights[2]);
+    EXPECT_LT(normals[1].x(), 0.0);
+    EXPECT_GT(normals[2].x(), 0.0);
+
+    EXPECT_TRUE(std::isnan(heights[3]));
+    EXPECT_EQ(physics::LinearVector3d::UnitZ(), normals[3]);
+  }
+}
+
 TEST_P(SimulationFeatures_TEST, FreeGroup)
 {
   const std::string library = GetParam();